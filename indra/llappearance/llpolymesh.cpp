@@ -39,6 +39,7 @@
 #include "lldir.h"
 #include "llvolume.h"
 #include "llendianswizzle.h"
+#include "workstealingqueue.h"
 
 
 #define HEADER_ASCII "Linden Mesh 1.0"
@@ -59,6 +60,8 @@ LLPolyMorphData *clone_morph_param_cleavage(const LLPolyMorphData *src_data,
 // Global table of loaded LLPolyMeshes
 //-----------------------------------------------------------------------------
 LLPolyMesh::LLPolyMeshSharedDataTable LLPolyMesh::sGlobalSharedMeshList;
+S32 LLPolyMesh::sMorphBatchDepth = 0;
+std::vector<LLPolyMesh*> LLPolyMesh::sMorphBatch;
 
 //-----------------------------------------------------------------------------
 // LLPolyMeshSharedData()
@@ -757,6 +760,7 @@ LLPolyMesh::LLPolyMesh(LLPolyMeshSharedData *shared_data, LLPolyMesh *reference_
     mReferenceMesh = reference_mesh;
     mAvatarp = NULL;
     mVertexData = NULL;
+    mInMorphBatch = false;
 
     mCurVertexCount = 0;
     mFaceIndexCount = 0;
@@ -810,6 +814,10 @@ LLPolyMesh::LLPolyMesh(LLPolyMeshSharedData *shared_data, LLPolyMesh *reference_
 //-----------------------------------------------------------------------------
 LLPolyMesh::~LLPolyMesh()
 {
+    if (mInMorphBatch)
+    {
+        vector_replace_with_last(sMorphBatch, this);
+    }
     delete_and_clear(mJointRenderData);
     ll_aligned_free_16(mVertexData);
 }
@@ -971,6 +979,101 @@ LLVector4a *LLPolyMesh::getScaledBinormals()
 }
 
 
+//-----------------------------------------------------------------------------
+// beginMorphBatch()
+//-----------------------------------------------------------------------------
+// static
+void LLPolyMesh::beginMorphBatch()
+{
+    sMorphBatchDepth++;
+}
+
+//-----------------------------------------------------------------------------
+// endMorphBatch()
+//-----------------------------------------------------------------------------
+// static
+void LLPolyMesh::endMorphBatch(LL::WorkQueueBase* queue)
+{
+    llassert(sMorphBatchDepth > 0);
+    if (--sMorphBatchDepth > 0 || sMorphBatch.empty())
+    {
+        return;
+    }
+
+    LL_PROFILE_ZONE_SCOPED;
+
+    // each mesh has arrays of its own
+    auto apply_morphs = [](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            sMorphBatch[i]->applyPendingMorphs();
+        }
+    };
+
+    if (queue && sMorphBatch.size() > 1)
+    {
+        LL::parallel_for(*queue, 0, sMorphBatch.size(), 1, apply_morphs);
+    }
+    else
+    {
+        apply_morphs(0, sMorphBatch.size());
+    }
+
+    for (LLPolyMesh* mesh : sMorphBatch)
+    {
+        mesh->mInMorphBatch = false;
+    }
+    sMorphBatch.clear();
+}
+
+//-----------------------------------------------------------------------------
+// applyMorph()
+//-----------------------------------------------------------------------------
+void LLPolyMesh::applyMorph(const LLPolyMorphBatch::Deltas& deltas, F32 delta_weight, const F32* mask_weights, bool clothing)
+{
+    if (!sMorphBatchDepth)
+    {
+        LLPolyMorphBatch::applyMorph(getMorphArrays(), deltas, delta_weight, mask_weights, clothing);
+        return;
+    }
+
+    mPendingMorphs.add(deltas, delta_weight, mask_weights, clothing);
+    if (!mInMorphBatch)
+    {
+        mInMorphBatch = true;
+        sMorphBatch.push_back(this);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// applyPendingMorphs()
+//-----------------------------------------------------------------------------
+void LLPolyMesh::applyPendingMorphs()
+{
+    if (!mPendingMorphs.empty())
+    {
+        mPendingMorphs.apply(getMorphArrays());
+    }
+}
+
+//-----------------------------------------------------------------------------
+// getMorphArrays()
+//-----------------------------------------------------------------------------
+LLPolyMorphBatch::Mesh LLPolyMesh::getMorphArrays()
+{
+    LLPolyMorphBatch::Mesh arrays;
+    arrays.mNumVertices = mSharedData->mNumVertices;
+    arrays.mCoords = mCoords;
+    arrays.mScaledNormals = mScaledNormals;
+    arrays.mNormals = mNormals;
+    arrays.mScaledBinormals = mScaledBinormals;
+    arrays.mBinormals = mBinormals;
+    arrays.mClothingWeights = mClothingWeights;
+    arrays.mTexCoords = mTexCoords;
+    return arrays;
+}
+
 //-----------------------------------------------------------------------------
 // initializeForMorph()
 //-----------------------------------------------------------------------------
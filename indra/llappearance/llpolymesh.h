@@ -35,11 +35,16 @@
 #include "v2math.h"
 #include "llquaternion.h"
 #include "llpolymorph.h"
+#include "llpolymorphbatch.h"
 #include "lljoint.h"
 
 class LLSkinJoint;
 class LLAvatarAppearance;
 class LLWearable;
+namespace LL
+{
+    class WorkQueueBase;
+}
 
 //#define USE_STRIPS    // Use tri-strips for rendering.
 
@@ -321,6 +326,23 @@ public:
     void setAvatar(LLAvatarAppearance* avatarp) { mAvatarp = avatarp; }
     LLAvatarAppearance* getAvatar() { return mAvatarp; }
 
+    //--------------------------------------------------------------------
+    // Morph batching
+    //--------------------------------------------------------------------
+    // Between beginMorphBatch() and endMorphBatch(), the morph targets
+    // applied to a mesh are queued on it, and endMorphBatch() applies the
+    // morphs of each mesh together (see LLPolyMorphBatch), the meshes spread
+    // over the threads servicing queue if there is one.  Main thread only;
+    // batches nest.
+    static void beginMorphBatch();
+    static void endMorphBatch(LL::WorkQueueBase* queue = NULL);
+
+    // Applies a morph target's weight change now, or queues it in a batch
+    void applyMorph(const LLPolyMorphBatch::Deltas& deltas, F32 delta_weight, const F32* mask_weights, bool clothing);
+
+    // Applies the morphs queued on this mesh now
+    void applyPendingMorphs();
+
     std::vector<LLJointRenderData*> mJointRenderData;
 
     U32             mFaceVertexOffset;
@@ -330,6 +352,7 @@ public:
     U32             mCurVertexCount;
 private:
     void initializeForMorph();
+    LLPolyMorphBatch::Mesh getMorphArrays();
 
     // Dumps diagnostic information about the global mesh table
     static void dumpDiagInfo();
@@ -362,6 +385,12 @@ protected:
 
     // Backlink only; don't make this an LLPointer.
     LLAvatarAppearance* mAvatarp;
+
+    LLPolyMorphBatch        mPendingMorphs;
+    bool                    mInMorphBatch;
+
+    static S32 sMorphBatchDepth;
+    static std::vector<LLPolyMesh*> sMorphBatch;    // meshes with morphs queued
 };
 
 #endif // LL_LLPOLYMESHINTERFACE_H
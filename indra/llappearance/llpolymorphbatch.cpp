@@ -0,0 +1,153 @@
+/**
+ * @file llpolymorphbatch.cpp
+ * @brief Implementation of LLPolyMorphBatch
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+//-----------------------------------------------------------------------------
+// Header Files
+//-----------------------------------------------------------------------------
+#include "linden_common.h"
+
+#include "llpolymorphbatch.h"
+
+namespace
+{
+    // guard against degenerate input data before we create NaNs
+    inline void sanitize_binormal(LLVector4a& binorm)
+    {
+        if (!binorm.isFinite3() || (binorm.dot3(binorm).getF32() <= F_APPROXIMATELY_ZERO))
+        {
+            binorm.set(1,0,0,1);
+        }
+    }
+
+    // normal and binormal of a vertex from its morphed, unnormalized ones
+    inline void renormalize(const LLPolyMorphBatch::Mesh& mesh, U32 vert)
+    {
+        LLVector4a norm = mesh.mScaledNormals[vert];
+        norm.normalize3fast();
+        mesh.mNormals[vert] = norm;
+
+        LLVector4a tangent;
+        tangent.setCross3(mesh.mScaledBinormals[vert], norm);
+        LLVector4a& normalized_binormal = mesh.mBinormals[vert];
+        normalized_binormal.setCross3(norm, tangent);
+        normalized_binormal.normalize3fast();
+    }
+
+    // adds a vertex's share of a morph, everything but the renormalization
+    inline void add_deltas(const LLPolyMorphBatch::Mesh& mesh, const LLPolyMorphBatch::Deltas& deltas, U32 index,
+                           F32 delta_weight, F32 mask_weight, bool clothing)
+    {
+        const U32 vert = deltas.mVertexIndices[index];
+        const F32 weight = delta_weight * mask_weight;
+
+        LLVector4a pos = deltas.mCoords[index];
+        pos.mul(weight);
+        mesh.mCoords[vert].add(pos);
+
+        if (clothing && mesh.mClothingWeights)
+        {
+            LLVector4a* clothing_weight = &mesh.mClothingWeights[vert];
+            clothing_weight->add(pos);
+            clothing_weight->getF32ptr()[VW] = mask_weight;
+        }
+
+        const LLVector4a soften(weight * NORMAL_SOFTEN_FACTOR);
+
+        LLVector4a norm = deltas.mNormals[index];
+        norm.mul(soften);
+        mesh.mScaledNormals[vert].add(norm);
+
+        LLVector4a binorm = deltas.mBinormals[index];
+        sanitize_binormal(binorm);
+        binorm.mul(soften);
+        mesh.mScaledBinormals[vert].add(binorm);
+
+        mesh.mTexCoords[vert] += deltas.mTexCoords[index] * delta_weight * mask_weight;
+    }
+}
+
+// static
+void LLPolyMorphBatch::applyMorph(const Mesh& mesh, const Deltas& deltas, F32 delta_weight,
+                                  const F32* mask_weights, bool clothing)
+{
+    for (U32 i = 0; i < deltas.mCount; ++i)
+    {
+        add_deltas(mesh, deltas, i, delta_weight, mask_weights ? mask_weights[i] : 1.f, clothing);
+        // calculate new normals and binormals based on half angles
+        renormalize(mesh, deltas.mVertexIndices[i]);
+    }
+}
+
+void LLPolyMorphBatch::add(const Deltas& deltas, F32 delta_weight, const F32* mask_weights, bool clothing)
+{
+    if (deltas.mCount)
+    {
+        mMorphs.push_back({ deltas, delta_weight, mask_weights, clothing });
+    }
+}
+
+void LLPolyMorphBatch::apply(const Mesh& mesh)
+{
+    if (mMorphs.empty())
+    {
+        return;
+    }
+
+    LL_PROFILE_ZONE_SCOPED;
+
+    if (mIsMoved.size() < mesh.mNumVertices)
+    {
+        mIsMoved.resize(mesh.mNumVertices, 0);
+    }
+    mMoved.clear();
+
+    // in the order they were added, for the clothing weights' mask
+    // weight: the last morph to move a vertex sets it
+    for (const Morph& morph : mMorphs)
+    {
+        const Deltas& deltas = morph.mDeltas;
+        for (U32 i = 0; i < deltas.mCount; ++i)
+        {
+            add_deltas(mesh, deltas, i, morph.mDeltaWeight, morph.mMaskWeights ? morph.mMaskWeights[i] : 1.f,
+                       morph.mClothing);
+
+            const U32 vert = deltas.mVertexIndices[i];
+            if (!mIsMoved[vert])
+            {
+                mIsMoved[vert] = 1;
+                mMoved.push_back(vert);
+            }
+        }
+    }
+
+    for (U32 vert : mMoved)
+    {
+        renormalize(mesh, vert);
+        mIsMoved[vert] = 0;
+    }
+
+    mMorphs.clear();
+}
@@ -0,0 +1,111 @@
+/**
+ * @file llpolymorphbatch.h
+ * @brief Morph targets applied to a mesh together rather than one by one
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLPOLYMORPHBATCH_H
+#define LL_LLPOLYMORPHBATCH_H
+
+#include <vector>
+
+#include "llmath.h"
+#include "v2math.h"
+
+// share of the normal and binormal deltas a morph applies
+const F32 NORMAL_SOFTEN_FACTOR = 0.65f;
+
+//-----------------------------------------------------------------------------
+// LLPolyMorphBatch
+// LLPolyMorphTarget::apply() adds its morph's weight change to the mesh
+// vertices, then renormalizes the normal and binormal of every vertex the
+// morph moves.  A shape change or a new appearance applies a couple of
+// hundred morphs to the same few meshes, so most vertices get renormalized
+// many times over.
+//
+// Only the last renormalization of a vertex counts, so a batch adds up the
+// deltas of all the morphs added to it, in one pass over each morph's
+// sparse arrays, and renormalizes every vertex they moved once at the end.
+// The results are those of applying the morphs one by one in the same
+// order.
+//-----------------------------------------------------------------------------
+class LLPolyMorphBatch
+{
+public:
+    // One morph's deltas, as LLPolyMorphData keeps them: mCount vertices,
+    // by index into the mesh
+    struct Deltas
+    {
+        U32                 mCount = 0;
+        const U32*          mVertexIndices = NULL;
+        const LLVector4a*   mCoords = NULL;
+        const LLVector4a*   mNormals = NULL;
+        const LLVector4a*   mBinormals = NULL;
+        const LLVector2*    mTexCoords = NULL;
+    };
+
+    // The LLPolyMesh arrays morphs write to.  mClothingWeights may be NULL.
+    struct Mesh
+    {
+        U32                 mNumVertices = 0;
+        LLVector4a*         mCoords = NULL;
+        LLVector4a*         mScaledNormals = NULL;
+        LLVector4a*         mNormals = NULL;
+        LLVector4a*         mScaledBinormals = NULL;
+        LLVector4a*         mBinormals = NULL;
+        LLVector4a*         mClothingWeights = NULL;
+        LLVector2*          mTexCoords = NULL;
+    };
+
+    // Applies one morph on its own, as LLPolyMorphTarget::apply() always
+    // has.  mask_weights, if any, has one weight per delta; clothing also
+    // moves the clothing weights.
+    static void applyMorph(const Mesh& mesh, const Deltas& deltas, F32 delta_weight,
+                           const F32* mask_weights, bool clothing);
+
+    // Queues a morph.  The arrays, and the mask weights, must stay as they
+    // are until apply().
+    void add(const Deltas& deltas, F32 delta_weight, const F32* mask_weights, bool clothing);
+
+    bool empty() const { return mMorphs.empty(); }
+    U32 size() const { return (U32)mMorphs.size(); }
+
+    // Applies the queued morphs to mesh and empties the batch.
+    void apply(const Mesh& mesh);
+
+private:
+    struct Morph
+    {
+        Deltas      mDeltas;
+        F32         mDeltaWeight;
+        const F32*  mMaskWeights;
+        bool        mClothing;
+    };
+    std::vector<Morph> mMorphs;
+
+    // vertices moved by the batch, and a flag per mesh vertex
+    std::vector<U32> mMoved;
+    std::vector<U8> mIsMoved;
+};
+
+#endif // LL_LLPOLYMORPHBATCH_H
@@ -0,0 +1,234 @@
+/**
+ * @file   llpolymorphbatch_test.cpp
+ * @brief  Test for llpolymorphbatch.h.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "../llpolymorphbatch.h"
+// STL headers
+#include <iostream>
+#include <memory>
+#include <vector>
+// std headers
+// external library headers
+// other Linden headers
+#include "llalignedarray.h"
+#include "lltimer.h"
+#include "lltut.h"
+
+namespace
+{
+    const U32 VERTICES = 3000;  // about the size of the avatar body meshes
+    const U32 MORPHS = 200;     // about as many as a full appearance applies
+
+    // the arrays of a mesh, with the same smooth starting values each time
+    struct TestMesh
+    {
+        LLAlignedArray<LLVector4a, 64> mCoords, mScaledNormals, mNormals, mScaledBinormals, mBinormals, mClothingWeights;
+        std::vector<LLVector2> mTexCoords;
+
+        TestMesh()
+        {
+            mCoords.resize(VERTICES);
+            mScaledNormals.resize(VERTICES);
+            mNormals.resize(VERTICES);
+            mScaledBinormals.resize(VERTICES);
+            mBinormals.resize(VERTICES);
+            mClothingWeights.resize(VERTICES);
+            mTexCoords.resize(VERTICES);
+            for (U32 i = 0; i < VERTICES; ++i)
+            {
+                const F32 t = 0.01f * (F32)i;
+                mCoords[i].set(cosf(t), sinf(t), 0.001f * (F32)i, 1.f);
+                mScaledNormals[i].set(cosf(t), sinf(t), 0.2f, 0.f);
+                mNormals[i] = mScaledNormals[i];
+                mNormals[i].normalize3fast();
+                mScaledBinormals[i].set(-sinf(t), cosf(t), 0.f, 0.f);
+                mBinormals[i] = mScaledBinormals[i];
+                mClothingWeights[i].clear();
+                mTexCoords[i].set(0.5f, t);
+            }
+        }
+
+        LLPolyMorphBatch::Mesh arrays()
+        {
+            LLPolyMorphBatch::Mesh mesh;
+            mesh.mNumVertices = VERTICES;
+            mesh.mCoords = mCoords.mArray;
+            mesh.mScaledNormals = mScaledNormals.mArray;
+            mesh.mNormals = mNormals.mArray;
+            mesh.mScaledBinormals = mScaledBinormals.mArray;
+            mesh.mBinormals = mBinormals.mArray;
+            mesh.mClothingWeights = mClothingWeights.mArray;
+            mesh.mTexCoords = mTexCoords.data();
+            return mesh;
+        }
+    };
+
+    // a sparse morph over a run of vertices, as LLPolyMorphData has them
+    struct TestMorph
+    {
+        std::vector<U32> mVertexIndices;
+        LLAlignedArray<LLVector4a, 64> mCoords, mNormals, mBinormals;
+        std::vector<LLVector2> mTexCoords;
+        std::vector<F32> mMaskWeights;
+        F32 mWeight;
+        bool mClothing;
+
+        explicit TestMorph(U32 n)
+        {
+            const U32 count = 50 + (n * 37) % 400;
+            const U32 first = (n * 131) % (VERTICES - count);
+            mCoords.resize(count);
+            mNormals.resize(count);
+            mBinormals.resize(count);
+            for (U32 i = 0; i < count; ++i)
+            {
+                const F32 t = 0.1f * (F32)(n + i);
+                mVertexIndices.push_back(first + i);
+                mCoords[i].set(0.01f * sinf(t), 0.01f * cosf(t), 0.005f, 0.f);
+                mNormals[i].set(0.1f * cosf(t), 0.f, 0.1f * sinf(t), 0.f);
+                // every so often a degenerate binormal, as some morphs have
+                if (i % 97 == 0)
+                {
+                    mBinormals[i].clear();
+                }
+                else
+                {
+                    mBinormals[i].set(0.f, 0.1f * sinf(t), 0.1f, 0.f);
+                }
+                mTexCoords.push_back(LLVector2(0.001f * sinf(t), 0.f));
+                mMaskWeights.push_back(0.5f + 0.5f * cosf(t));
+            }
+            mWeight = 0.2f + 0.6f * sinf((F32)n);
+            mClothing = (n % 5 == 0);
+            if (n % 3)
+            {
+                mMaskWeights.clear();
+            }
+        }
+
+        LLPolyMorphBatch::Deltas deltas() const
+        {
+            LLPolyMorphBatch::Deltas deltas;
+            deltas.mCount = (U32)mVertexIndices.size();
+            deltas.mVertexIndices = mVertexIndices.data();
+            deltas.mCoords = mCoords.mArray;
+            deltas.mNormals = mNormals.mArray;
+            deltas.mBinormals = mBinormals.mArray;
+            deltas.mTexCoords = mTexCoords.data();
+            return deltas;
+        }
+
+        const F32* maskWeights() const { return mMaskWeights.empty() ? NULL : mMaskWeights.data(); }
+    };
+
+    bool close_enough(const LLVector4a& a, const LLVector4a& b)
+    {
+        for (S32 i = 0; i < 4; ++i)
+        {
+            if (fabsf(a[i] - b[i]) > 1.e-4f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llpolymorphbatch_data
+    {
+        std::vector<std::unique_ptr<TestMorph> > mMorphs;  // LLAlignedArray can't be copied
+
+        llpolymorphbatch_data()
+        {
+            for (U32 n = 0; n < MORPHS; ++n)
+            {
+                mMorphs.emplace_back(new TestMorph(n));
+            }
+        }
+    };
+    typedef test_group<llpolymorphbatch_data> llpolymorphbatch_group;
+    typedef llpolymorphbatch_group::object object;
+    llpolymorphbatch_group llpolymorphbatchgrp("llpolymorphbatch");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("same mesh as applying the morphs one by one");
+
+        TestMesh serial, batched;
+        LLPolyMorphBatch batch;
+        for (const std::unique_ptr<TestMorph>& morph : mMorphs)
+        {
+            LLPolyMorphBatch::applyMorph(serial.arrays(), morph->deltas(), morph->mWeight, morph->maskWeights(), morph->mClothing);
+            batch.add(morph->deltas(), morph->mWeight, morph->maskWeights(), morph->mClothing);
+        }
+        ensure_equals("queued", batch.size(), MORPHS);
+        batch.apply(batched.arrays());
+        ensure("emptied", batch.empty());
+
+        for (U32 i = 0; i < VERTICES; ++i)
+        {
+            ensure(llformat("coords %d", i), close_enough(serial.mCoords[i], batched.mCoords[i]));
+            ensure(llformat("scaled normal %d", i), close_enough(serial.mScaledNormals[i], batched.mScaledNormals[i]));
+            ensure(llformat("normal %d", i), close_enough(serial.mNormals[i], batched.mNormals[i]));
+            ensure(llformat("binormal %d", i), close_enough(serial.mBinormals[i], batched.mBinormals[i]));
+            ensure(llformat("clothing weight %d", i), close_enough(serial.mClothingWeights[i], batched.mClothingWeights[i]));
+            ensure_distance(llformat("tex coord %d", i), serial.mTexCoords[i].mV[VY], batched.mTexCoords[i].mV[VY], 1.e-4f);
+        }
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("morph batch benchmark");
+
+        // Not a pass/fail test.  Times a full appearance's worth of morphs
+        // on one mesh, applied one by one and as a batch.
+        if (! getenv("LL_TEST_BENCHMARKS"))
+        {
+            skip("set LL_TEST_BENCHMARKS to run the benchmark");
+        }
+
+        const S32 REPEATS = 20;
+        TestMesh serial, batched;
+        LLPolyMorphBatch batch;
+
+        U64 start = LLTimer::getTotalTime();
+        for (S32 r = 0; r < REPEATS; ++r)
+        {
+            for (const std::unique_ptr<TestMorph>& morph : mMorphs)
+            {
+                LLPolyMorphBatch::applyMorph(serial.arrays(), morph->deltas(), morph->mWeight, morph->maskWeights(), morph->mClothing);
+            }
+        }
+        const U64 serial_time = LLTimer::getTotalTime() - start;
+
+        start = LLTimer::getTotalTime();
+        for (S32 r = 0; r < REPEATS; ++r)
+        {
+            for (const std::unique_ptr<TestMorph>& morph : mMorphs)
+            {
+                batch.add(morph->deltas(), morph->mWeight, morph->maskWeights(), morph->mClothing);
+            }
+            batch.apply(batched.arrays());
+        }
+        const U64 batched_time = LLTimer::getTotalTime() - start;
+
+        std::cout << std::endl << MORPHS << " morphs on " << VERTICES << " vertices: " << serial_time / REPEATS
+                  << " uS one by one, " << batched_time / REPEATS << " uS batched (" << serial.mCoords[0][0] + batched.mCoords[0][0]
+                  << ")" << std::endl;
+    }
+} // namespace tut
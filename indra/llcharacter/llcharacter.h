@@ -157,6 +157,13 @@ public:
     enum e_update_t { NORMAL_UPDATE, HIDDEN_UPDATE, FORCE_UPDATE };
     void updateMotions(e_update_t update_type);
 
+    // updateMotions() split for evaluating poses off the main thread (see
+    // LLMotionController::prepareUpdate()).  prepareMotions() runs on the
+    // main thread and returns true if evaluateMotions() has a pose to
+    // evaluate; evaluateMotions() may then run on any one thread.
+    bool prepareMotions(e_update_t update_type);
+    void evaluateMotions(e_update_t update_type);
+
     LLAnimPauseRequest requestPause();
     bool areAnimationsPaused() const { return mMotionController.isPaused(); }
     void setAnimTimeFactor(F32 factor) { mMotionController.setTimeFactor(factor); }
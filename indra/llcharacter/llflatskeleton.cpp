@@ -0,0 +1,289 @@
+/**
+ * @file llflatskeleton.cpp
+ * @brief Implementation of LLFlatSkeleton
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+//-----------------------------------------------------------------------------
+// Header Files
+//-----------------------------------------------------------------------------
+#include "linden_common.h"
+
+#include "llflatskeleton.h"
+
+#include "lljoint.h"
+
+namespace
+{
+    // a * b, as LLQuaternion's operator*
+    inline void quat_mul(const LLVector4a& a, const LLVector4a& b, LLVector4a& result)
+    {
+        LLVector4a aw, bw;
+        aw.splat<3>(a);
+        bw.splat<3>(b);
+
+        LLVector4a xyz;
+        xyz.setMul(bw, a);
+        LLVector4a t;
+        t.setMul(aw, b);
+        xyz.add(t);
+        t.setCross3(b, a);
+        xyz.add(t);
+
+        LLVector4a w;
+        w.setMul(bw, a);
+        w.splat<3>(w);
+        w.sub(LLVector4a(b.dot3(a)));
+
+        LLVector4Logical w_mask;
+        w_mask.clear();
+        w_mask.setElement<3>();
+        result.setSelectWithMask(w_mask, w, xyz);
+    }
+
+    // v rotated by q, as LLVector3 * LLQuaternion.  Same as
+    // LLVector4a::setRotated(), without going through an LLQuaternion2.
+    inline void rotate(const LLVector4a& q, const LLVector4a& v, LLVector4a& result)
+    {
+        LLVector4a temp;
+        temp.setCross3(q, v);
+        temp.add(temp);
+
+        LLVector4a w;
+        w.splat<3>(q);
+        LLVector4a temp_times_w;
+        temp_times_w.setMul(temp, w);
+
+        result = v;
+        result.add(temp_times_w);
+
+        LLVector4a q_cross_temp;
+        q_cross_temp.setCross3(q, temp);
+        result.add(q_cross_temp);
+    }
+
+    // What LLMatrix4::initAll() computes: the axes rotated and scaled,
+    // then the position.
+    inline void compose_matrix(const LLVector4a& scale, const LLVector4a& rot, const LLVector4a& pos, LLMatrix4a& mat)
+    {
+        static const LLVector4a x_axis(1.f, 0.f, 0.f, 0.f);
+        static const LLVector4a y_axis(0.f, 1.f, 0.f, 0.f);
+        static const LLVector4a z_axis(0.f, 0.f, 1.f, 0.f);
+        static const LLVector4a w_one(0.f, 0.f, 0.f, 1.f);
+
+        LLVector4a s;
+        rotate(rot, x_axis, mat.mMatrix[0]);
+        s.splat<0>(scale);
+        mat.mMatrix[0].mul(s);
+        rotate(rot, y_axis, mat.mMatrix[1]);
+        s.splat<1>(scale);
+        mat.mMatrix[1].mul(s);
+        rotate(rot, z_axis, mat.mMatrix[2]);
+        s.splat<2>(scale);
+        mat.mMatrix[2].mul(s);
+
+        LLVector4Logical w_mask;
+        w_mask.clear();
+        w_mask.setElement<3>();
+        mat.mMatrix[3].setSelectWithMask(w_mask, w_one, pos);
+    }
+}
+
+LLFlatSkeleton::LLFlatSkeleton():
+    mRoot(NULL),
+    mTopology(0)
+{
+}
+
+void LLFlatSkeleton::build(LLJoint* root)
+{
+    mRoot = root;
+    mTopology = root ? root->getTopologyGeneration() : 0;
+
+    mJoints.clear();
+    mParents.clear();
+    mIndexByJointNum.clear();
+    if (!root)
+    {
+        mUpdated.clear();
+        mMatrixSerials.clear();
+        mWorldRotations.resize(0);
+        mWorldPositions.resize(0);
+        mWorldMatrices.resize(0);
+        return;
+    }
+
+    // depth first, so that a joint comes right after its parent and
+    // before its children
+    std::vector<std::pair<LLJoint*, S32> > stack;
+    stack.emplace_back(root, -1);
+    while (!stack.empty())
+    {
+        LLJoint* joint = stack.back().first;
+        const S32 parent = stack.back().second;
+        stack.pop_back();
+
+        const S32 index = (S32)mJoints.size();
+        mJoints.push_back(joint);
+        mParents.push_back(parent);
+        if (joint->getJointNum() >= 0)
+        {
+            if (joint->getJointNum() >= (S32)mIndexByJointNum.size())
+            {
+                mIndexByJointNum.resize(joint->getJointNum() + 1, -1);
+            }
+            mIndexByJointNum[joint->getJointNum()] = index;
+        }
+
+        // pushed in reverse, so that they come out in the order
+        // updateWorldMatrixChildren() visits them
+        for (LLJoint::joints_t::reverse_iterator iter = joint->mChildren.rbegin(); iter != joint->mChildren.rend(); ++iter)
+        {
+            stack.emplace_back(*iter, index);
+        }
+    }
+
+    const U32 count = (U32)mJoints.size();
+    mUpdated.assign(count, 0);
+    mMatrixSerials.assign(count, 0);
+    mWorldRotations.resize(count);
+    mWorldPositions.resize(count);
+    mWorldMatrices.resize(count);
+}
+
+bool LLFlatSkeleton::isCurrent() const
+{
+    return mRoot && mTopology == mRoot->getTopologyGeneration();
+}
+
+void LLFlatSkeleton::update(LLJoint* root)
+{
+    if (root != mRoot || !isCurrent())
+    {
+        build(root);
+    }
+
+    S32 updates = 0;
+    const S32 count = size();
+    for (S32 i = 0; i < count; ++i)
+    {
+        LLJoint* joint = mJoints[i];
+        const S32 parent = mParents[i];
+        if (!joint->mUpdateXform || (parent >= 0 && !mUpdated[parent]))
+        {
+            // updateWorldMatrixChildren() stops there
+            mUpdated[i] = 0;
+            continue;
+        }
+        mUpdated[i] = 1;
+
+        LLXformMatrix& xform = joint->mXform;
+        LLVector4a& world_rot = mWorldRotations[i];
+        LLVector4a& world_pos = mWorldPositions[i];
+        if (!(joint->mDirtyFlags & LLJoint::MATRIX_DIRTY))
+        {
+            // up to date: only its children may need it
+            world_rot.loadua(xform.getWorldRotation().mQ);
+            world_pos.load3(xform.getWorldPosition().mV);
+            mWorldMatrices[i] = joint->mWorldMatrix;
+            mMatrixSerials[i] = joint->mMatrixSerial;
+            continue;
+        }
+
+        // LLXformMatrix::update()
+        LLVector4a rot;
+        rot.loadua(xform.getRotation().mQ);
+        LLVector4a pos;
+        pos.load3(xform.getPosition().mV);
+
+        const LLXform* parent_xform = xform.getParent();
+        if (parent_xform)
+        {
+            LLVector4a parent_rot, parent_pos;
+            if (parent >= 0)
+            {
+                parent_rot = mWorldRotations[parent];
+                parent_pos = mWorldPositions[parent];
+            }
+            else
+            {
+                parent_rot.loadua(parent_xform->getWorldRotation().mQ);
+                parent_pos.load3(parent_xform->getWorldPosition().mV);
+            }
+
+            if (parent_xform->getScaleChildOffset())
+            {
+                LLVector4a parent_scale;
+                parent_scale.load3(parent_xform->getScale().mV);
+                pos.mul(parent_scale);
+            }
+            rotate(parent_rot, pos, world_pos);
+            world_pos.add(parent_pos);
+            quat_mul(rot, parent_rot, world_rot);
+        }
+        else
+        {
+            world_pos = pos;
+            world_rot = rot;
+        }
+
+        // LLXformMatrix::updateMatrix(false)
+        LLVector4a scale;
+        scale.load3(xform.getScale().mV);
+        LLMatrix4a& world_matrix = mWorldMatrices[i];
+        compose_matrix(scale, world_rot, world_pos, world_matrix);
+
+        // LLJoint::updateWorldMatrix(): the joint reads as if it had
+        // been updated itself
+        LLQuaternion joint_rot;
+        memcpy(joint_rot.mQ, world_rot.getF32ptr(), sizeof(joint_rot.mQ));
+        xform.setWorldTransform(LLVector3(world_pos.getF32ptr()), joint_rot, world_matrix.asMatrix4());
+        joint->mWorldMatrix = world_matrix;
+        joint->mDirtyFlags = 0x0;
+        mMatrixSerials[i] = ++joint->mMatrixSerial;
+        ++updates;
+    }
+    if (LLJoint::sCountUpdates)
+    {
+        LLJoint::sNumUpdates.fetch_add(updates, std::memory_order_relaxed);
+    }
+}
+
+const LLMatrix4a* LLFlatSkeleton::findWorldMatrix(S32 joint_num) const
+{
+    if (!isCurrent())
+    {
+        return NULL;
+    }
+    const S32 index = getIndex(joint_num);
+    if (index < 0 || !mUpdated[index])
+    {
+        return NULL;
+    }
+    const LLJoint* joint = mJoints[index];
+    if ((joint->mDirtyFlags & LLJoint::MATRIX_DIRTY) || joint->mMatrixSerial != mMatrixSerials[index])
+    {
+        return NULL;
+    }
+    return &mWorldMatrices[index];
+}
@@ -0,0 +1,108 @@
+/**
+ * @file llflatskeleton.h
+ * @brief A joint hierarchy laid out in arrays, parents first, for updating
+ *        world transforms in one pass.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLFLATSKELETON_H
+#define LL_LLFLATSKELETON_H
+
+#include "llalignedarray.h"
+#include "llmath.h"
+#include "llmatrix4a.h"
+
+#include <vector>
+
+class LLJoint;
+
+//
+// LLJoint::updateWorldMatrixChildren() walks the skeleton recursively, one
+// separately allocated joint at a time, and whoever wants a world matrix
+// afterwards (the rigged mesh matrix palettes) asks each joint for it,
+// which walks up its parents to check they're current.
+//
+// LLFlatSkeleton lists the joints under a root parents first, with the
+// index of each one's parent, and keeps their world rotations, positions
+// and matrices in arrays.  update() goes through the list once, composing
+// the world transform of every joint that changed from its parent's with
+// SIMD math, and stores it in the joint as well, so the joints read the
+// same as after updateWorldMatrixChildren().  Readers then index the
+// arrays by joint number.
+//
+// The layout is rebuilt by update() whenever joints were added to,
+// removed from or renumbered under the root since it was built.
+//
+class LLFlatSkeleton
+{
+public:
+    LLFlatSkeleton();
+
+    // Lists the joints under root.  update() calls it when needed.
+    void build(LLJoint* root);
+
+    // Does what root->updateWorldMatrixChildren() does, in one pass.
+    void update(LLJoint* root);
+
+    // Whether the arrays still describe the joints they were built from
+    bool isCurrent() const;
+
+    S32 size() const { return (S32)mJoints.size(); }
+
+    // Index of the joint with this joint number, -1 if none
+    S32 getIndex(S32 joint_num) const
+    {
+        return (joint_num >= 0 && joint_num < (S32)mIndexByJointNum.size()) ? mIndexByJointNum[joint_num] : -1;
+    }
+
+    LLJoint* getJoint(S32 index) const { return mJoints[index]; }
+    S32 getParent(S32 index) const { return mParents[index]; }
+
+    // False for joints updateWorldMatrixChildren() leaves alone (the
+    // joint, or one of its parents, doesn't update its transform): their
+    // matrix here is not maintained.
+    bool isUpdated(S32 index) const { return mUpdated[index]; }
+
+    const LLMatrix4a& getWorldMatrix(S32 index) const { return mWorldMatrices[index]; }
+
+    // The world matrix of the joint with this joint number as of the last
+    // update(), or NULL if the joint has to be asked for it instead: it
+    // isn't in this skeleton, isn't maintained here, or has moved since.
+    const LLMatrix4a* findWorldMatrix(S32 joint_num) const;
+
+private:
+    LLJoint* mRoot;
+    U32 mTopology;                  // mRoot's topology generation when built
+
+    std::vector<LLJoint*> mJoints;  // parents before children
+    std::vector<S32> mParents;      // -1 for the root
+    std::vector<S32> mIndexByJointNum;
+    std::vector<U8> mUpdated;
+    std::vector<U32> mMatrixSerials; // LLJoint::mMatrixSerial at update()
+
+    LLAlignedArray<LLVector4a, 64> mWorldRotations;
+    LLAlignedArray<LLVector4a, 64> mWorldPositions;
+    LLAlignedArray<LLMatrix4a, 64> mWorldMatrices;
+};
+
+#endif // LL_LLFLATSKELETON_H
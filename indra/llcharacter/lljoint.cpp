@@ -34,8 +34,9 @@
 #include "llmath.h"
 #include <boost/algorithm/string.hpp>
 
-S32 LLJoint::sNumUpdates = 0;
-S32 LLJoint::sNumTouches = 0;
+bool LLJoint::sCountUpdates = false;
+std::atomic<S32> LLJoint::sNumUpdates(0);
+std::atomic<S32> LLJoint::sNumTouches(0);
 
 template <class T>
 bool attachment_map_iter_compare_key(const T& a, const T& b)
@@ -108,6 +109,8 @@ void LLJoint::init()
     mXform.setScale(LLVector3(1.0f, 1.0f, 1.0f));
     mDirtyFlags = MATRIX_DIRTY | ROTATION_DIRTY | POSITION_DIRTY;
     mUpdateXform = true;
+    mMatrixSerial = 0;
+    mTopologyGeneration = 0;
     mSupport = SUPPORT_BASE;
     mEnd = LLVector3(0.0f, 0.0f, 0.0f);
 }
@@ -199,7 +202,10 @@ void LLJoint::touch(U32 flags)
 {
     if ((flags | mDirtyFlags) != mDirtyFlags)
     {
-        sNumTouches++;
+        if (sCountUpdates)
+        {
+            sNumTouches.fetch_add(1, std::memory_order_relaxed);
+        }
         mDirtyFlags |= flags;
         U32 child_flags = flags;
         if (flags & ROTATION_DIRTY)
@@ -220,6 +226,7 @@ void LLJoint::touch(U32 flags)
 void LLJoint::setJointNum(S32 joint_num)
 {
     mJointNum = joint_num;
+    touchTopology();
     if (mJointNum + 2 >= LL_CHARACTER_MAX_ANIMATED_JOINTS)
     {
         LL_INFOS() << "LL_CHARACTER_MAX_ANIMATED_JOINTS needs to be increased" << LL_ENDL;
@@ -238,6 +245,18 @@ LLJoint *LLJoint::getRoot()
     return getParent()->getRoot();
 }
 
+//-----------------------------------------------------------------------------
+// touchTopology()
+//-----------------------------------------------------------------------------
+void LLJoint::touchTopology()
+{
+    // only the hierarchies this joint is part of need to know
+    for (LLJoint* joint = this; joint; joint = joint->mParent)
+    {
+        joint->mTopologyGeneration++;
+    }
+}
+
 
 //-----------------------------------------------------------------------------
 // findJoint()
@@ -274,6 +293,7 @@ void LLJoint::addChild(LLJoint* joint)
     joint->mXform.setParent(&mXform);
     joint->mParent = this;
     joint->touch();
+    joint->touchTopology();
 }
 
 
@@ -290,6 +310,8 @@ void LLJoint::removeChild(LLJoint* joint)
         joint->mXform.setParent(NULL);
         joint->mParent = NULL;
         joint->touch();
+        joint->touchTopology();
+        touchTopology();
     }
 }
 
@@ -306,9 +328,14 @@ void LLJoint::removeAllChildren()
             joint->mXform.setParent(NULL);
             joint->mParent = NULL;
             joint->touch();
+            joint->touchTopology();
             //delete joint;
         }
     }
+    if (!mChildren.empty())
+    {
+        touchTopology();
+    }
     mChildren.clear();
 }
 
@@ -984,10 +1011,14 @@ void LLJoint::updateWorldMatrix()
 {
     if (mDirtyFlags & MATRIX_DIRTY)
     {
-        sNumUpdates++;
+        if (sCountUpdates)
+        {
+            sNumUpdates.fetch_add(1, std::memory_order_relaxed);
+        }
         mXform.updateMatrix(false);
         mWorldMatrix.loadu(mXform.getWorldMatrix());
         mDirtyFlags = 0x0;
+        mMatrixSerial++;
     }
 }
 
@@ -32,6 +32,7 @@
 //-----------------------------------------------------------------------------
 #include <string>
 #include <list>
+#include <atomic>
 
 #include "v3math.h"
 #include "v4math.h"
@@ -90,6 +91,7 @@ LL_ALIGN_PREFIX(16)
 class LLJoint
 {
     LL_ALIGN_NEW
+    friend class LLFlatSkeleton;
 public:
     // priority levels, from highest to lowest
     enum JointPriority
@@ -134,6 +136,8 @@ protected:
 public:
     U32             mDirtyFlags;
     bool            mUpdateXform;
+    U32             mMatrixSerial;  // bumped whenever mWorldMatrix is recomputed
+    U32             mTopologyGeneration; // bumped whenever a joint under this one is attached, detached or renumbered
 
     // describes the skin binding pose
     LLVector3       mSkinOffset;
@@ -149,8 +153,11 @@ public:
     joints_t mChildren;
 
     // debug statics
-    static S32      sNumTouches;
-    static S32      sNumUpdates;
+    // counted only while sCountUpdates is set, from whichever threads are
+    // evaluating poses; set and read between pose evaluations
+    static bool sCountUpdates;
+    static std::atomic<S32> sNumTouches;
+    static std::atomic<S32> sNumUpdates;
     typedef std::set<std::string> debug_joint_name_t;
     static debug_joint_name_t s_debugJointNames;
     static void setDebugJointNames(const debug_joint_name_t& names);
@@ -191,6 +198,8 @@ public:
 
 private:
     void init();
+    // bumps the topology generation of this joint and of those above it
+    void touchTopology();
 
 public:
     // set name and parent
@@ -221,6 +230,10 @@ public:
     // getRoot
     LLJoint *getRoot();
 
+    // changes whenever joints are attached to, detached from or renumbered
+    // in the hierarchy under this joint
+    U32 getTopologyGeneration() const { return mTopologyGeneration; }
+
     // search for child joints by name
     LLJoint* findJoint(std::string_view name);
 
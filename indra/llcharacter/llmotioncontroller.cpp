@@ -819,6 +819,18 @@ void LLMotionController::updateLoadingMotions()
 // updateMotion()
 //-----------------------------------------------------------------------------
 void LLMotionController::updateMotions(bool force_update)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    if (prepareUpdate())
+    {
+        evaluatePose(force_update);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// prepareUpdate()
+//-----------------------------------------------------------------------------
+bool LLMotionController::prepareUpdate()
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
     // SL-763: "Distant animated objects run at super fast speed"
@@ -861,7 +873,7 @@ void LLMotionController::updateMotions(bool force_update)
 
                 updateLoadingMotions();
 
-                return;
+                return false;
             }
 
             // is calculating a new keyframe pose, make sure the last one gets applied
@@ -880,6 +892,17 @@ void LLMotionController::updateMotions(bool force_update)
 
     updateLoadingMotions();
 
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// evaluatePose()
+//-----------------------------------------------------------------------------
+void LLMotionController::evaluatePose(bool force_update)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    bool use_quantum = (mTimeStep != 0.f);
+
     resetJointSignatures();
 
     if (mPaused && !force_update)
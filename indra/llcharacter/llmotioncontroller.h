@@ -132,6 +132,15 @@ public:
     // deactivates terminated motions`
     void updateMotions(bool force_update = false);
 
+    // updateMotions() in two steps, for callers evaluating poses away from
+    // the main thread: prepareUpdate() advances the clock and finishes
+    // loading motions, and must run on the main thread; evaluatePose()
+    // runs the active motions and blends them into the joints, touching
+    // nothing but this character.  Returns false when there is no new pose
+    // to evaluate this frame.
+    bool prepareUpdate();
+    void evaluatePose(bool force_update = false);
+
     // minimal update (e.g. while hidden)
     void updateMotionsMinimal();
 
@@ -0,0 +1,191 @@
+/**
+ * @file   llflatskeleton_test.cpp
+ * @brief  Test for llflatskeleton.h.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "../llflatskeleton.h"
+// STL headers
+#include <memory>
+#include <vector>
+// std headers
+// external library headers
+// other Linden headers
+#include "../lljoint.h"
+#include "lltut.h"
+
+namespace
+{
+    const S32 JOINTS = 150;     // about the bones and collision volumes of an avatar
+
+    typedef std::vector<std::unique_ptr<LLJoint> > skeleton_t;
+
+    // JOINTS joints, three children to a joint, some scaled
+    void make_skeleton(skeleton_t& joints)
+    {
+        for (S32 i = 0; i < JOINTS; ++i)
+        {
+            joints.emplace_back(new LLJoint(i));
+            LLJoint* joint = joints.back().get();
+            joint->setName(llformat("joint%d", i));
+            joint->setPosition(LLVector3(0.02f * (i % 5), 0.05f * (i % 3), 0.1f));
+            if (i % 7 == 0)
+            {
+                joint->setScale(LLVector3(1.1f, 0.9f, 1.2f));
+            }
+            if (i)
+            {
+                joints[(i - 1) / 3]->addChild(joint);
+            }
+        }
+    }
+
+    // what a motion does to the skeleton in a frame
+    void pose(skeleton_t& joints, F32 phase)
+    {
+        joints[0]->setWorldPosition(LLVector3(128.f, 64.f + phase, 22.f));
+        for (S32 i = 0; i < JOINTS; ++i)
+        {
+            const F32 t = phase + 0.1f * (F32)i;
+            LLQuaternion rot(0.3f * sinf(t), LLVector3(cosf(t), sinf(2.f * t), 1.f));
+            joints[i]->setRotation(rot);
+        }
+    }
+
+    bool close_enough(const LLMatrix4a& a, const LLMatrix4a& b)
+    {
+        for (S32 i = 0; i < 16; ++i)
+        {
+            if (fabsf(a.getF32ptr()[i] - b.getF32ptr()[i]) > 1.e-4f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llflatskeleton_data
+    {
+    };
+    typedef test_group<llflatskeleton_data> llflatskeleton_group;
+    typedef llflatskeleton_group::object object;
+    llflatskeleton_group llflatskeletongrp("llflatskeleton");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("same world matrices as updateWorldMatrixChildren()");
+
+        skeleton_t expected, flat;
+        make_skeleton(expected);
+        make_skeleton(flat);
+        LLFlatSkeleton skeleton;
+        for (S32 frame = 0; frame < 5; ++frame)
+        {
+            pose(expected, 0.1f * frame);
+            pose(flat, 0.1f * frame);
+            expected[0]->updateWorldMatrixChildren();
+            skeleton.update(flat[0].get());
+            ensure_equals("all joints", skeleton.size(), JOINTS);
+            for (S32 i = 0; i < JOINTS; ++i)
+            {
+                ensure(llformat("joint %d, frame %d", i, frame),
+                       close_enough(expected[i]->getWorldMatrix4a(), flat[i]->getWorldMatrix4a()));
+                ensure_equals("clean", flat[i]->mDirtyFlags, 0U);
+                const LLMatrix4a* world = skeleton.findWorldMatrix(i);
+                ensure("in the arrays", world != NULL);
+                ensure("same as the joint", close_enough(*world, flat[i]->getWorldMatrix4a()));
+            }
+        }
+
+        // parents come first
+        for (S32 i = 1; i < skeleton.size(); ++i)
+        {
+            ensure("parent first", skeleton.getParent(i) >= 0 && skeleton.getParent(i) < i);
+        }
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("joints moved or left alone are not read from the arrays");
+
+        skeleton_t joints;
+        make_skeleton(joints);
+        LLFlatSkeleton skeleton;
+        pose(joints, 0.f);
+        skeleton.update(joints[0].get());
+
+        // moved since, whether or not someone updated it meanwhile
+        joints[5]->setRotation(LLQuaternion(0.5f, LLVector3::z_axis));
+        ensure("dirty", skeleton.findWorldMatrix(5) == NULL);
+        joints[5]->getWorldMatrix4a();
+        ensure("recomputed", skeleton.findWorldMatrix(5) == NULL);
+        ensure("untouched", skeleton.findWorldMatrix(4) != NULL);
+
+        // updateWorldMatrixChildren() skips those, and their children
+        joints[1]->mUpdateXform = false;
+        joints[0]->touch();
+        skeleton.update(joints[0].get());
+        ensure("skipped", skeleton.findWorldMatrix(1) == NULL);
+        ensure("child skipped", skeleton.findWorldMatrix(4) == NULL);
+        ensure("still dirty", joints[4]->mDirtyFlags & LLJoint::MATRIX_DIRTY);
+        ensure("sibling updated", skeleton.findWorldMatrix(2) != NULL);
+        joints[1]->mUpdateXform = true;
+
+        // a joint attached: rebuilt by the next update
+        std::unique_ptr<LLJoint> extra(new LLJoint(JOINTS));
+        joints[10]->addChild(extra.get());
+        ensure("stale", !skeleton.isCurrent());
+        ensure("not read while stale", skeleton.findWorldMatrix(10) == NULL);
+        skeleton.update(joints[0].get());
+        ensure_equals("rebuilt", skeleton.size(), JOINTS + 1);
+        ensure("attached joint", skeleton.findWorldMatrix(JOINTS) != NULL);
+        joints[10]->removeChild(extra.get());
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("only changes to its own joints rebuild a skeleton");
+
+        skeleton_t joints, other;
+        make_skeleton(joints);
+        make_skeleton(other);
+        LLFlatSkeleton skeleton;
+        skeleton.update(joints[0].get());
+
+        // another avatar attaching, detaching and renumbering joints
+        std::unique_ptr<LLJoint> extra(new LLJoint(JOINTS));
+        other[10]->addChild(extra.get());
+        other[10]->removeChild(extra.get());
+        other[20]->setJointNum(JOINTS + 1);
+        other[5]->removeAllChildren();
+        ensure("still current", skeleton.isCurrent());
+
+        // the root itself attached under another joint
+        other[3]->addChild(joints[0].get());
+        ensure("root attached", !skeleton.isCurrent());
+        other[3]->removeChild(joints[0].get());
+        skeleton.update(joints[0].get());
+        ensure("rebuilt", skeleton.isCurrent());
+
+        // a joint deep down renumbered
+        joints[JOINTS - 1]->setJointNum(JOINTS + 2);
+        ensure("renumbered", !skeleton.isCurrent());
+        skeleton.update(joints[0].get());
+        ensure("found by its new number", skeleton.findWorldMatrix(JOINTS + 2) != NULL);
+    }
+} // namespace tut
@@ -0,0 +1,306 @@
+/**
+ * @file   llmotioncontroller_test.cpp
+ * @brief  Test for llmotioncontroller.h: poses evaluated apart from the
+ *         rest of the update.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "../llmotioncontroller.h"
+// STL headers
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+// std headers
+// external library headers
+// other Linden headers
+#include "../llcharacter.h"
+#include "../lljoint.h"
+#include "../lljointstate.h"
+#include "../llmotion.h"
+#include "lltimer.h"
+#include "lltut.h"
+#include "v3dmath.h"
+#include "workstealingqueue.h"
+
+namespace
+{
+    const S32 JOINTS = 150;     // about the bones and collision volumes of an avatar
+    const LLUUID SWAY_ID("8d4d2f0a-3b6e-4c43-9a3c-6f1d1b2f5a01");
+
+    // An avatar for the motion controller alone: a skeleton of JOINTS
+    // joints, three children to a joint, and nothing else.
+    class SyntheticAvatar : public LLCharacter
+    {
+    public:
+        SyntheticAvatar(S32 seed):
+            mID(LLUUID::generateNewID()),
+            mSeed(seed),
+            mPhase(0.f)
+        {
+            for (S32 i = 0; i < JOINTS; ++i)
+            {
+                mJoints.emplace_back(new LLJoint(i));
+                mJoints.back()->setName(llformat("joint%d", i));
+                mJoints.back()->setPosition(LLVector3(0.f, 0.05f * (i % 3), 0.1f));
+                if (i)
+                {
+                    mJoints[(i - 1) / 3]->addChild(mJoints.back().get());
+                }
+            }
+        }
+
+        ~SyntheticAvatar()
+        {
+            flushAllMotions();
+            while (!mJoints.empty())
+            {
+                mJoints.pop_back();
+            }
+        }
+
+        const char* getAnimationPrefix() override { return "synthetic"; }
+        LLJoint* getRootJoint() override { return mJoints.front().get(); }
+        LLVector3 getCharacterPosition() override { return LLVector3::zero; }
+        LLQuaternion getCharacterRotation() override { return LLQuaternion::DEFAULT; }
+        LLVector3 getCharacterVelocity() override { return LLVector3::zero; }
+        LLVector3 getCharacterAngularVelocity() override { return LLVector3::zero; }
+        void getGround(const LLVector3& in_pos, LLVector3& out_pos, LLVector3& out_norm) override
+        {
+            out_pos = in_pos;
+            out_norm = LLVector3::z_axis;
+        }
+        LLJoint* getCharacterJoint(U32 i) override { return i < mJoints.size() ? mJoints[i].get() : NULL; }
+        F32 getTimeDilation() override { return 1.f; }
+        F32 getPixelArea() const override { return 100000.f; }
+        LLPolyMesh* getHeadMesh() override { return NULL; }
+        LLPolyMesh* getUpperBodyMesh() override { return NULL; }
+        LLVector3d getPosGlobalFromAgent(const LLVector3& position) override { return LLVector3d(position); }
+        LLVector3 getPosAgentFromGlobal(const LLVector3d& position) override { return LLVector3(position); }
+        void addDebugText(const std::string& text) override {}
+        const LLUUID& getID() const override { return mID; }
+
+        LLUUID mID;
+        S32 mSeed;
+        F32 mPhase;             // stands for the animation time
+        std::vector<std::unique_ptr<LLJoint> > mJoints;
+    };
+
+    // Sways every joint of a SyntheticAvatar, about as much arithmetic per
+    // joint as a keyframe motion evaluating its curves.
+    class SwayMotion : public LLMotion
+    {
+    public:
+        SwayMotion(const LLUUID& id): LLMotion(id), mAvatar(NULL) { mName = "sway"; }
+        static LLMotion* create(const LLUUID& id) { return new SwayMotion(id); }
+
+        bool getLoop() override { return true; }
+        F32 getDuration() override { return 0.f; }
+        F32 getEaseInDuration() override { return 0.f; }
+        F32 getEaseOutDuration() override { return 0.f; }
+        LLJoint::JointPriority getPriority() override { return LLJoint::MEDIUM_PRIORITY; }
+        LLMotionBlendType getBlendType() override { return NORMAL_BLEND; }
+        F32 getMinPixelArea() override { return 0.f; }
+
+        LLMotionInitStatus onInitialize(LLCharacter* character) override
+        {
+            mAvatar = static_cast<SyntheticAvatar*>(character);
+            for (S32 i = 0; i < JOINTS; ++i)
+            {
+                LLPointer<LLJointState> state = new LLJointState(mAvatar->getCharacterJoint(i));
+                state->setUsage(LLJointState::ROT);
+                addJointState(state);
+                mStates.push_back(state);
+            }
+            return STATUS_SUCCESS;
+        }
+
+        bool onActivate() override { return true; }
+
+        bool onUpdate(F32 time, U8* joint_mask) override
+        {
+            for (S32 i = 0; i < (S32)mStates.size(); ++i)
+            {
+                const F32 t = mAvatar->mPhase + 0.1f * (F32)(i + mAvatar->mSeed);
+                LLQuaternion rot(0.3f * sinf(t), LLVector3(cosf(t), sinf(2.f * t), 1.f));
+                rot *= LLQuaternion(0.1f * cosf(3.f * t), LLVector3::x_axis);
+                mStates[i]->setRotation(rot);
+            }
+            return true;
+        }
+
+        void onDeactivate() override {}
+
+    private:
+        SyntheticAvatar* mAvatar;
+        std::vector<LLPointer<LLJointState> > mStates;
+    };
+
+    typedef std::vector<std::unique_ptr<SyntheticAvatar> > avatars_t;
+
+    void make_avatars(avatars_t& avatars, S32 count)
+    {
+        for (S32 i = 0; i < count; ++i)
+        {
+            avatars.emplace_back(new SyntheticAvatar(i));
+            avatars.back()->registerMotion(SWAY_ID, SwayMotion::create);
+            avatars.back()->startMotion(SWAY_ID);
+        }
+    }
+
+    // What LLVOAvatar::updateCharacter() does for each avatar in turn
+    void update_serially(avatars_t& avatars)
+    {
+        for (auto& avatar : avatars)
+        {
+            avatar->updateMotions(LLCharacter::NORMAL_UPDATE);
+            avatar->getRootJoint()->updateWorldMatrixChildren();
+        }
+    }
+
+    // What LLVOAvatar::endPoseBatch() does: prepare on this thread,
+    // evaluate the poses and skeletons on the pool
+    void update_in_parallel(avatars_t& avatars, LL::WorkQueueBase& queue)
+    {
+        std::vector<SyntheticAvatar*> batch;
+        for (auto& avatar : avatars)
+        {
+            if (avatar->prepareMotions(LLCharacter::NORMAL_UPDATE))
+            {
+                batch.push_back(avatar.get());
+            }
+        }
+        LL::parallel_for(queue, 0, batch.size(), 1,
+                         [&batch](size_t first, size_t last)
+                         {
+                             for (size_t i = first; i < last; ++i)
+                             {
+                                 batch[i]->evaluateMotions(LLCharacter::NORMAL_UPDATE);
+                                 batch[i]->getRootJoint()->updateWorldMatrixChildren();
+                             }
+                         });
+    }
+
+    void advance(avatars_t& avatars, F32 phase)
+    {
+        for (auto& avatar : avatars)
+        {
+            avatar->mPhase = phase;
+        }
+    }
+
+    bool same_pose(SyntheticAvatar& a, SyntheticAvatar& b)
+    {
+        for (S32 i = 0; i < JOINTS; ++i)
+        {
+            const LLMatrix4& ma = a.mJoints[i]->getWorldMatrix();
+            const LLMatrix4& mb = b.mJoints[i]->getWorldMatrix();
+            for (S32 row = 0; row < 4; ++row)
+            {
+                for (S32 col = 0; col < 4; ++col)
+                {
+                    if (ma.mMatrix[row][col] != mb.mMatrix[row][col])
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llmotioncontroller_data
+    {
+    };
+    typedef test_group<llmotioncontroller_data> llmotioncontroller_group;
+    typedef llmotioncontroller_group::object object;
+    llmotioncontroller_group llmotioncontrollergrp("llmotioncontroller");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("poses evaluated in parallel match updateMotions()");
+
+        LL::WorkStealingThreadPool pool("llmotioncontroller_test", 4);
+        pool.start();
+
+        avatars_t serial, parallel;
+        make_avatars(serial, 16);
+        make_avatars(parallel, 16);
+        for (S32 frame = 0; frame < 5; ++frame)
+        {
+            advance(serial, 0.1f * frame);
+            advance(parallel, 0.1f * frame);
+            update_serially(serial);
+            update_in_parallel(parallel, pool.getQueue());
+            for (size_t i = 0; i < serial.size(); ++i)
+            {
+                ensure(llformat("avatar %d, frame %d", (S32)i, frame), same_pose(*serial[i], *parallel[i]));
+            }
+        }
+        // the motion really moves the skeleton
+        ensure("animated", serial[0]->mJoints[JOINTS - 1]->getWorldPosition()
+                           != serial[1]->mJoints[JOINTS - 1]->getWorldPosition());
+        pool.close();
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("synthetic avatar update benchmark");
+
+        // Not a pass/fail test.  Times the motion and joint update of a
+        // crowd of avatars, one after the other on this thread as the
+        // viewer did, and spread over a pool the way endPoseBatch() does.
+        if (! getenv("LL_TEST_BENCHMARKS"))
+        {
+            skip("set LL_TEST_BENCHMARKS to run the benchmark");
+        }
+
+        const S32 FRAMES = 100;
+        const size_t width = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+        LL::WorkStealingThreadPool pool("llmotioncontroller_bench", width - 1);
+        pool.start();
+
+        std::cout << std::endl;
+        for (S32 count : { 10, 50, 200 })
+        {
+            avatars_t avatars;
+            make_avatars(avatars, count);
+
+            U64 start = LLTimer::getTotalTime();
+            for (S32 frame = 0; frame < FRAMES; ++frame)
+            {
+                advance(avatars, 0.02f * frame);
+                update_serially(avatars);
+            }
+            const U64 serial_time = LLTimer::getTotalTime() - start;
+
+            start = LLTimer::getTotalTime();
+            for (S32 frame = 0; frame < FRAMES; ++frame)
+            {
+                advance(avatars, 0.02f * frame);
+                update_in_parallel(avatars, pool.getQueue());
+            }
+            const U64 parallel_time = LLTimer::getTotalTime() - start;
+
+            std::cout << count << " avatars x " << JOINTS << " joints: " << serial_time / FRAMES
+                      << " uS/frame serially, " << parallel_time / FRAMES << " uS/frame on "
+                      << width << " threads" << std::endl;
+        }
+        pool.close();
+    }
+} // namespace tut
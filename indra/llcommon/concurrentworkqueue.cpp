@@ -0,0 +1,132 @@
+/**
+ * @file   concurrentworkqueue.cpp
+ * @date   2026-03-02
+ * @brief  Implementation for ConcurrentWorkQueue.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "concurrentworkqueue.h"
+// STL headers
+// std headers
+#include <thread>
+// external library headers
+// other Linden headers
+#include "llexception.h"
+
+namespace
+{
+    // mState bit set by close(); the low bits count post() calls in flight
+    constexpr U32 CLOSED = 1u << 31;
+}
+
+LL::ConcurrentWorkQueue::ConcurrentWorkQueue(const std::string& name, size_t capacity, bool auto_shutdown):
+    WorkQueue(name, auto_shutdown, NoQueue()),
+    mCapacity(capacity),
+    mState(0)
+{
+}
+
+void LL::ConcurrentWorkQueue::close()
+{
+    if (mState.fetch_or(CLOSED) & CLOSED)
+    {
+        return;
+    }
+    // Posts that saw the queue open are only a few instructions from done.
+    while (mState.load(std::memory_order_acquire) != CLOSED)
+    {
+        std::this_thread::yield();
+    }
+    // Nothing more can be queued. Wake one blocked worker; whichever worker
+    // finds the queue drained passes this permit on to the next, see
+    // takeItem().
+    mItems.signal();
+}
+
+size_t LL::ConcurrentWorkQueue::size()
+{
+    return mQueue.size_approx();
+}
+
+bool LL::ConcurrentWorkQueue::isClosed()
+{
+    return (mState.load() & CLOSED) != 0;
+}
+
+bool LL::ConcurrentWorkQueue::done()
+{
+    return mState.load() == CLOSED && mQueue.size_approx() == 0;
+}
+
+bool LL::ConcurrentWorkQueue::post(const Work& callable)
+{
+    if (!callable)
+    {
+        return false;
+    }
+    // Checking for close() and counting ourselves in flight is one atomic
+    // step, so close() cannot return between our check and our enqueue.
+    if (mState.fetch_add(1, std::memory_order_acquire) & CLOSED)
+    {
+        mState.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+    bool posted = mQueue.enqueue(callable);
+    if (posted)
+    {
+        mItems.signal();
+    }
+    mState.fetch_sub(1, std::memory_order_release);
+    return posted;
+}
+
+bool LL::ConcurrentWorkQueue::tryPost(const Work& callable)
+{
+    if (mQueue.size_approx() >= mCapacity)
+    {
+        return false;
+    }
+    return post(callable);
+}
+
+bool LL::ConcurrentWorkQueue::takeItem(Work& work)
+{
+    // The caller holds a permit from mItems. Its item was fully enqueued
+    // before the permit was signalled, so try_dequeue() only fails briefly
+    // while other threads are mid-operation -- unless the permit is the one
+    // close() signalled and the queue is drained.
+    while (!mQueue.try_dequeue(work))
+    {
+        if (mState.load(std::memory_order_acquire) == CLOSED)
+        {
+            // closed and drained: pass the wakeup on to the next worker
+            mItems.signal();
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+LL::ConcurrentWorkQueue::Work LL::ConcurrentWorkQueue::pop_()
+{
+    Work work;
+    mItems.wait();
+    if (!takeItem(work))
+    {
+        // closed and drained, same as LLThreadSafeQueue::pop()
+        LLTHROW(Closed());
+    }
+    return work;
+}
+
+bool LL::ConcurrentWorkQueue::tryPop_(Work& work)
+{
+    return mItems.tryWait() && takeItem(work);
+}
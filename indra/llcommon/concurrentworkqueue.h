@@ -0,0 +1,80 @@
+/**
+ * @file   concurrentworkqueue.h
+ * @date   2026-03-02
+ * @brief  WorkQueue backed by a lock-free multi-producer, multi-consumer
+ *         queue.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_CONCURRENTWORKQUEUE_H)
+#define LL_CONCURRENTWORKQUEUE_H
+
+#include "workqueue.h"
+#include "concurrentqueue.h"
+#include "lightweightsemaphore.h"
+#include <atomic>
+
+namespace LL
+{
+
+/*****************************************************************************
+*   ConcurrentWorkQueue: WorkQueue without a queue lock
+*****************************************************************************/
+    /**
+     * ConcurrentWorkQueue is a drop-in WorkQueue: it is found by
+     * WorkQueue::getInstance(name) and supports the same post(), postTo(),
+     * waitForResult() and worker API. Instead of LLThreadSafeQueue's mutex
+     * and condition variable it uses moodycamel::ConcurrentQueue, so
+     * producers posting many small work items never contend on a lock, and
+     * idle workers block on a lightweight semaphore counting queued items.
+     *
+     * Differences with WorkQueue:
+     *
+     * * Work items are FIFO per posting thread. Items posted by different
+     *   threads may be interleaved in any order.
+     * * capacity only limits tryPost(). post() never blocks on a full queue.
+     * * size() is approximate while other threads are posting or popping.
+     *
+     * As with WorkQueue, every post() that returns true is run by a worker
+     * draining the queue: close() waits for post() calls already past their
+     * closed check to finish enqueueing.
+     *
+     * ThreadPool creates one for a named pool if the "ThreadPoolLockFree"
+     * setting says so, see ThreadPoolBase::getConfiguredLockFree().
+     */
+    class ConcurrentWorkQueue: public WorkQueue
+    {
+    public:
+        ConcurrentWorkQueue(const std::string& name = std::string(), size_t capacity=1024, bool auto_shutdown = true);
+
+        void close() override;
+        size_t size() override;
+        bool isClosed() override;
+        bool done() override;
+
+        bool post(const Work&) override;
+        bool tryPost(const Work&) override;
+
+    private:
+        Work pop_() override;
+        bool tryPop_(Work&) override;
+
+        bool takeItem(Work&);
+
+        using Queue = moodycamel::ConcurrentQueue<Work>;
+        Queue mQueue;
+        // one permit per queued item, plus one handed from worker to worker
+        // once the queue is closed and drained
+        moodycamel::LightweightSemaphore mItems;
+        const size_t mCapacity;
+        // CLOSED bit, plus the number of post() calls between their closed
+        // check and the end of their enqueue
+        std::atomic<U32> mState;
+    };
+
+} // namespace LL
+
+#endif /* ! defined(LL_CONCURRENTWORKQUEUE_H) */
@@ -104,46 +104,50 @@ LLCallbackList::find(callback_t func, void *data)
 void LLCallbackList::deleteAllFunctions()
 {
     mCallbackList.clear();
+    mOnceFunctions.clear();
 }
 
+void LLCallbackList::addOnceFunction(const nullary_func_t& func)
+{
+    if (func)
+    {
+        mOnceFunctions.push_back(func);
+    }
+}
 
 void LLCallbackList::callFunctions()
+{
+    callFunctionsUntil(std::chrono::steady_clock::time_point::max());
+}
+
+size_t LLCallbackList::callFunctionsUntil(const std::chrono::steady_clock::time_point& until)
 {
     for (callback_list_t::iterator iter = mCallbackList.begin(); iter != mCallbackList.end(); )
     {
         callback_list_t::iterator curiter = iter++;
         curiter->first(curiter->second);
     }
-}
 
-// Shim class to allow arbitrary boost::bind
-// expressions to be run as one-time idle callbacks.
-class OnIdleCallbackOneTime
-{
-public:
-    OnIdleCallbackOneTime(nullary_func_t callable):
-        mCallable(callable)
+    // Only what was queued before we started: callables queued by these
+    // run next time.  One may also empty the queue (deleteAllFunctions()).
+    size_t count = mOnceFunctions.size();
+    for (size_t i = 0; i < count && !mOnceFunctions.empty(); ++i)
     {
+        if (i && std::chrono::steady_clock::now() >= until)
+        {
+            break;
+        }
+        // pop first: the callable may queue more
+        nullary_func_t func = std::move(mOnceFunctions.front());
+        mOnceFunctions.pop_front();
+        func();
     }
-    static void onIdle(void *data)
-    {
-        gIdleCallbacks.deleteFunction(onIdle, data);
-        OnIdleCallbackOneTime* self = reinterpret_cast<OnIdleCallbackOneTime*>(data);
-        self->call();
-        delete self;
-    }
-    void call()
-    {
-        mCallable();
-    }
-private:
-    nullary_func_t mCallable;
-};
+    return mOnceFunctions.size();
+}
 
 void doOnIdleOneTime(nullary_func_t callable)
 {
-    OnIdleCallbackOneTime* cb_functor = new OnIdleCallbackOneTime(callable);
-    gIdleCallbacks.addFunction(&OnIdleCallbackOneTime::onIdle,cb_functor);
+    gIdleCallbacks.addOnceFunction(callable);
 }
 
 // Shim class to allow generic boost functions to be run as
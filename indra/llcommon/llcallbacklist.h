@@ -29,8 +29,13 @@
 
 #include "llstl.h"
 #include <boost/function.hpp>
+#include <chrono>
+#include <deque>
 #include <list>
 
+typedef boost::function<void ()> nullary_func_t;
+typedef boost::function<bool ()> bool_func_t;
+
 class LLCallbackList
 {
 public:
@@ -50,6 +55,17 @@ public:
     void callFunctions();                                                       // calls all functions
     void deleteAllFunctions();
 
+    // One-time callables run after the registered functions, in the order
+    // they were added, and may be spread over several frames: see
+    // callFunctionsUntil().
+    void addOnceFunction(const nullary_func_t& func);
+    size_t getOnceFunctionCount() const { return mOnceFunctions.size(); }
+
+    // Calls all functions, but stops calling one-time callables at 'until'.
+    // At least one runs per call so none of them starves.  Returns the
+    // number left for the next call.
+    size_t callFunctionsUntil(const std::chrono::steady_clock::time_point& until);
+
     static void test();
 
 protected:
@@ -57,12 +73,11 @@ protected:
     inline callback_list_t::iterator find(callback_t func, void *data);
 
     callback_list_t mCallbackList;
+    std::deque<nullary_func_t> mOnceFunctions;
 };
 
-typedef boost::function<void ()> nullary_func_t;
-typedef boost::function<bool ()> bool_func_t;
-
-// Call a given callable once in idle loop.
+// Call a given callable once in idle loop, after the registered functions.
+// When the main thread is short of time it may wait a frame or more.
 void doOnIdleOneTime(nullary_func_t callable);
 
 // Repeatedly call a callable in idle loop until it returns true.
@@ -0,0 +1,392 @@
+/**
+ * @file llframeprofiler.cpp
+ * @brief Always-on recorder of LL_PROFILE_ZONE_* zones into per-thread ring
+ *        buffers, exportable as a Chrome trace.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llframeprofiler.h"
+
+#include "llfasttimer.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+std::atomic<LLFrameProfiler::Mode> LLFrameProfiler::sMode{ LLFrameProfiler::MODE_OFF };
+
+namespace
+{
+    const char* const FRAME_ZONE_NAME = "Frame";
+
+    // One event slot. The owning thread is the only writer; capture() may
+    // read a slot while it is being overwritten and throws such reads
+    // away, so the fields are atomics only to make that race well defined.
+    struct Slot
+    {
+        std::atomic<const char*> mName;
+        std::atomic<U64> mBegin;
+        std::atomic<U64> mEnd;
+    };
+
+    struct ThreadBuffer
+    {
+        ThreadBuffer(U32 id, U32 events):
+            mSlots(new Slot[events]),
+            mMask(events - 1),
+            mHead(0),
+            mId(id),
+            mExited(false)
+        {}
+
+        std::unique_ptr<Slot[]> mSlots;
+        const U64 mMask;
+        // number of events ever written, the next one goes to
+        // mSlots[mHead & mMask]
+        std::atomic<U64> mHead;
+        const U32 mId;
+        std::string mName;      // guarded by Registry::mMutex
+        std::atomic<bool> mExited;
+    };
+
+    struct Registry
+    {
+        std::mutex mMutex;
+        std::vector<std::shared_ptr<ThreadBuffer> > mBuffers;
+        U32 mNextId = 1;
+    };
+
+    Registry& get_registry()
+    {
+        // Never destroyed: zones may run in static constructors and
+        // destructors.
+        static Registry* sRegistry = new Registry;
+        return *sRegistry;
+    }
+
+    std::atomic<U32> sBufferEvents{ 32768 };
+    std::atomic<U64> sMinZoneCounts{ 0 };
+    std::atomic<U32> sMainThreadDepth{ 12 };
+
+    F64 counts_per_second()
+    {
+        static const F64 sCountsPerSecond = (F64)LLTrace::BlockTimer::countsPerSecond();
+        return sCountsPerSecond;
+    }
+
+    // Trivially destructible, so zones in other thread_local destructors
+    // may still look at them.
+    thread_local ThreadBuffer* sThreadBuffer = nullptr;
+    thread_local bool sThreadExited = false;
+    thread_local char sThreadName[64] = "";
+    // Set on the thread calling endFrame(). The depth of its open zones is
+    // only counted in MODE_MAIN_THREAD; a coroutine yielding inside a zone
+    // leaves it counted until the coroutine resumes and closes it.
+    thread_local bool sFrameThread = false;
+    thread_local U32 sMainThreadZoneDepth = 0;
+
+    // Lets the next registering thread drop this thread's buffer
+    struct ThreadExitMarker
+    {
+        ~ThreadExitMarker()
+        {
+            sThreadExited = true;
+            if (sThreadBuffer)
+            {
+                sThreadBuffer->mExited = true;
+            }
+        }
+    };
+    thread_local ThreadExitMarker sThreadExitMarker;
+
+    ThreadBuffer* get_thread_buffer()
+    {
+        if (! sThreadBuffer && ! sThreadExited)
+        {
+            Registry& registry = get_registry();
+            std::lock_guard<std::mutex> lock(registry.mMutex);
+            // Buffers of exited threads stay until the next thread registers,
+            // so a capture taken just after a worker finished still has it.
+            registry.mBuffers.erase(
+                std::remove_if(registry.mBuffers.begin(), registry.mBuffers.end(),
+                               [](const std::shared_ptr<ThreadBuffer>& other){ return other->mExited.load(); }),
+                registry.mBuffers.end());
+            auto buffer = std::make_shared<ThreadBuffer>(registry.mNextId++, sBufferEvents.load());
+            buffer->mName = sThreadName;
+            registry.mBuffers.push_back(buffer);
+            sThreadBuffer = buffer.get();
+            // constructs the marker, so its destructor runs at thread exit
+            (void)&sThreadExitMarker;
+        }
+        return sThreadBuffer;
+    }
+
+    void write_event(const char* name, U64 begin, U64 end)
+    {
+        ThreadBuffer* buffer = get_thread_buffer();
+        if (! buffer)
+        {
+            return;
+        }
+        const U64 head = buffer->mHead.load(std::memory_order_relaxed);
+        Slot& slot = buffer->mSlots[head & buffer->mMask];
+        slot.mName.store(name, std::memory_order_relaxed);
+        slot.mBegin.store(begin, std::memory_order_relaxed);
+        slot.mEnd.store(end, std::memory_order_relaxed);
+        buffer->mHead.store(head + 1, std::memory_order_release);
+    }
+
+    void write_json_string(std::ostream& out, const char* str)
+    {
+        out << '"';
+        for (const char* c = str; *c; ++c)
+        {
+            switch (*c)
+            {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            default:
+                if ((U8)*c < 0x20)
+                {
+                    out << ' ';
+                }
+                else
+                {
+                    out << *c;
+                }
+                break;
+            }
+        }
+        out << '"';
+    }
+}
+
+// static
+U64 LLFrameProfiler::now()
+{
+    return LLTrace::BlockTimer::getCPUClockCount64();
+}
+
+// static
+void LLFrameProfiler::record(const char* name, U64 begin)
+{
+    const U64 end = now();
+    if (end - begin >= sMinZoneCounts.load(std::memory_order_relaxed))
+    {
+        write_event(name, begin, end);
+    }
+}
+
+// static
+U64 LLFrameProfiler::enterMainThreadZone(bool& nested)
+{
+    if (! sFrameThread)
+    {
+        return 0;
+    }
+    nested = true;
+    return sMainThreadZoneDepth++ < sMainThreadDepth.load(std::memory_order_relaxed) ? now() : 0;
+}
+
+// static
+void LLFrameProfiler::leaveMainThreadZone()
+{
+    if (sMainThreadZoneDepth)
+    {
+        --sMainThreadZoneDepth;
+    }
+}
+
+// static
+void LLFrameProfiler::setMainThreadDepth(U32 depth)
+{
+    sMainThreadDepth = depth;
+}
+
+// static
+void LLFrameProfiler::setMinZoneMicroseconds(F64 microseconds)
+{
+    sMinZoneCounts = (U64)(llmax(microseconds, 0.0) * counts_per_second() / 1000000.0);
+}
+
+// static
+void LLFrameProfiler::setBufferEvents(U32 events)
+{
+    U32 size = 1024;
+    while (size < events && size < (1U << 24))
+    {
+        size <<= 1;
+    }
+    sBufferEvents = size;
+}
+
+// static
+void LLFrameProfiler::setThreadName(const char* name)
+{
+    strncpy(sThreadName, name ? name : "", sizeof(sThreadName) - 1);
+    sThreadName[sizeof(sThreadName) - 1] = '\0';
+    if (sThreadBuffer)
+    {
+        std::lock_guard<std::mutex> lock(get_registry().mMutex);
+        sThreadBuffer->mName = sThreadName;
+    }
+}
+
+// static
+F64 LLFrameProfiler::endFrame()
+{
+    static thread_local U64 sFrameStart = 0;
+    sFrameThread = true;
+    const U64 frame_end = now();
+    F64 seconds = 0.0;
+    if (sFrameStart)
+    {
+        seconds = (F64)(frame_end - sFrameStart) / counts_per_second();
+        if (isEnabled())
+        {
+            write_event(FRAME_ZONE_NAME, sFrameStart, frame_end);
+        }
+    }
+    sFrameStart = frame_end;
+    return seconds;
+}
+
+// static
+LLFrameProfiler::Capture LLFrameProfiler::capture(F64 seconds, bool this_thread_only)
+{
+    LL_PROFILE_ZONE_SCOPED;
+    Capture capture;
+    capture.mCountsPerMicrosecond = counts_per_second() / 1000000.0;
+
+    std::vector<std::shared_ptr<ThreadBuffer> > buffers;
+    {
+        Registry& registry = get_registry();
+        std::lock_guard<std::mutex> lock(registry.mMutex);
+        if (this_thread_only)
+        {
+            for (const auto& buffer : registry.mBuffers)
+            {
+                if (buffer.get() == sThreadBuffer)
+                {
+                    buffers.push_back(buffer);
+                }
+            }
+        }
+        else
+        {
+            buffers = registry.mBuffers;
+        }
+        capture.mThreads.resize(buffers.size());
+        for (size_t i = 0; i < buffers.size(); ++i)
+        {
+            capture.mThreads[i].mName = buffers[i]->mName;
+            capture.mThreads[i].mId = buffers[i]->mId;
+        }
+    }
+
+    const U64 capture_end = now();
+    const U64 window = (U64)(llmax(seconds, 0.0) * counts_per_second());
+    const U64 since = capture_end > window ? capture_end - window : 0;
+    for (size_t i = 0; i < buffers.size(); ++i)
+    {
+        const ThreadBuffer& buffer = *buffers[i];
+        const U64 size = buffer.mMask + 1;
+        const U64 head = buffer.mHead.load(std::memory_order_acquire);
+        const U64 first = head > size ? head - size : 0;
+
+        std::vector<Event>& events = capture.mThreads[i].mEvents;
+        events.reserve((size_t)(head - first));
+        for (U64 index = first; index < head; ++index)
+        {
+            const Slot& slot = buffer.mSlots[index & buffer.mMask];
+            Event event;
+            event.mName = slot.mName.load(std::memory_order_relaxed);
+            event.mBegin = slot.mBegin.load(std::memory_order_relaxed);
+            event.mEnd = slot.mEnd.load(std::memory_order_relaxed);
+            events.push_back(event);
+        }
+
+        // The owner kept writing while we copied. Slots it reached, plus
+        // the one it may be writing right now, hold a mix of old and new
+        // events: drop them.
+        const U64 new_head = buffer.mHead.load(std::memory_order_acquire);
+        const U64 valid = new_head + 1 > size ? new_head + 1 - size : 0;
+        if (valid > first)
+        {
+            events.erase(events.begin(), events.begin() + (size_t)llmin(valid - first, (U64)events.size()));
+        }
+        events.erase(std::remove_if(events.begin(), events.end(),
+                                    [since](const Event& event){ return event.mEnd < since; }),
+                     events.end());
+    }
+    return capture;
+}
+
+// static
+size_t LLFrameProfiler::writeChromeTrace(std::ostream& out, const Capture& capture)
+{
+    LL_PROFILE_ZONE_SCOPED;
+    U64 origin = 0;
+    for (const Capture::Thread& thread : capture.mThreads)
+    {
+        for (const Event& event : thread.mEvents)
+        {
+            if (! origin || event.mBegin < origin)
+            {
+                origin = event.mBegin;
+            }
+        }
+    }
+
+    size_t count = 0;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    const char* separator = "\n";
+    for (const Capture::Thread& thread : capture.mThreads)
+    {
+        out << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.mId
+            << ",\"args\":{\"name\":";
+        write_json_string(out, thread.mName.empty() ? ("Thread " + std::to_string(thread.mId)).c_str() : thread.mName.c_str());
+        out << "}}";
+        separator = ",\n";
+
+        for (const Event& event : thread.mEvents)
+        {
+            out << ",\n{\"name\":";
+            write_json_string(out, event.mName ? event.mName : "?");
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.mId
+                << ",\"ts\":" << (F64)(event.mBegin - origin) / capture.mCountsPerMicrosecond
+                << ",\"dur\":" << (F64)(event.mEnd - event.mBegin) / capture.mCountsPerMicrosecond
+                << "}";
+            ++count;
+        }
+    }
+    out << "\n]}\n";
+    return count;
+}
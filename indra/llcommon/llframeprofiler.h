@@ -0,0 +1,175 @@
+/**
+ * @file llframeprofiler.h
+ * @brief Always-on recorder of LL_PROFILE_ZONE_* zones into per-thread ring
+ *        buffers, exportable as a Chrome trace.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLFRAMEPROFILER_H
+#define LL_LLFRAMEPROFILER_H
+
+// Included by llprofiler.h, hence by every file: keep this light.
+#include "llpreprocessor.h"
+#include "stdtypes.h"
+#include <atomic>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// LLFrameProfiler keeps the last few seconds of profiler zones without a
+// Tracy build or client. In the default LL_PROFILER_CONFIG_FAST_TIMER
+// configuration LL_PROFILE_ZONE_SCOPED, LL_PROFILE_ZONE_NAMED and the
+// category variants declare an LLFrameProfiler::Zone, which
+//
+// * costs a relaxed atomic load when recording is off,
+// * in MODE_ALL_THREADS, reads the fast timer clock on entry and exit and
+//   writes one event to a ring buffer owned by the current thread: no
+//   locks, no allocation after the thread's first zone, and
+// * in MODE_MAIN_THREAD, does the same only for the zones of the thread
+//   calling endFrame() that are nested no deeper than
+//   setMainThreadDepth(). Other threads' zones cost an out-of-line call
+//   reading a thread local. This mode is cheap enough to stay on, and
+//   keeps what frame spike reports need: the main loop sections, and the
+//   message handlers and callbacks they call.
+//
+// Zones shorter than setMinZoneMicroseconds() are dropped on exit, so the
+// ring buffers cover seconds rather than milliseconds of a busy thread.
+// Parent zones are always at least as long as their children, so the
+// trace keeps its structure.
+//
+// capture() copies the recent events of every thread without stopping
+// them, and writeChromeTrace() saves a capture in the Chrome trace event
+// format that chrome://tracing and https://ui.perfetto.dev load.
+class LLFrameProfiler
+{
+public:
+    struct Event
+    {
+        const char* mName;  // string literal or __FUNCTION__
+        U64 mBegin;         // fast timer clock counts
+        U64 mEnd;
+    };
+
+    struct Capture
+    {
+        struct Thread
+        {
+            std::string mName;
+            U32 mId;
+            std::vector<Event> mEvents;
+        };
+        std::vector<Thread> mThreads;
+        F64 mCountsPerMicrosecond = 1.0;
+    };
+
+    enum Mode
+    {
+        MODE_OFF,
+        MODE_MAIN_THREAD,   // the thread calling endFrame(), shallow zones
+        MODE_ALL_THREADS
+    };
+
+    class Zone
+    {
+    public:
+        Zone(const char* name):
+            mName(name),
+            mBegin(0),
+            mNested(false)
+        {
+            switch (sMode.load(std::memory_order_relaxed))
+            {
+            case MODE_ALL_THREADS:
+                mBegin = now();
+                break;
+            case MODE_MAIN_THREAD:
+                mBegin = enterMainThreadZone(mNested);
+                break;
+            default:
+                break;
+            }
+        }
+
+        ~Zone()
+        {
+            if (mNested)
+            {
+                leaveMainThreadZone();
+            }
+            if (mBegin)
+            {
+                record(mName, mBegin);
+            }
+        }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char* mName;
+        U64 mBegin;
+        bool mNested;
+    };
+
+    static void setMode(Mode mode) { sMode.store(mode, std::memory_order_relaxed); }
+    static Mode getMode() { return sMode.load(std::memory_order_relaxed); }
+    static bool isEnabled() { return getMode() != MODE_OFF; }
+
+    // How many levels of nested zones MODE_MAIN_THREAD records
+    static void setMainThreadDepth(U32 depth);
+
+    // Zones shorter than this are not recorded. Frames always are.
+    static void setMinZoneMicroseconds(F64 microseconds);
+
+    // Ring buffer size, in events, of threads recording their first zone
+    // from now on. Rounded up to a power of 2.
+    static void setBufferEvents(U32 events);
+
+    // Names the calling thread in captures, see LL_PROFILER_SET_THREAD_NAME
+    static void setThreadName(const char* name);
+
+    // Call once per frame from the thread that drives frames, which makes
+    // it the main thread for MODE_MAIN_THREAD. Records a "Frame" zone since
+    // the previous call and returns its length in seconds, or 0 on the
+    // first call.
+    static F64 endFrame();
+
+    // Events of every thread, or of the calling thread only, that ended
+    // within the last seconds
+    static Capture capture(F64 seconds, bool this_thread_only = false);
+
+    // Returns the number of events written
+    static size_t writeChromeTrace(std::ostream& out, const Capture& capture);
+
+private:
+    static U64 now();
+    static void record(const char* name, U64 begin);
+    // Returns the clock if this zone is to be recorded. Sets nested if the
+    // zone was counted in the main thread's depth.
+    static U64 enterMainThreadZone(bool& nested);
+    static void leaveMainThreadZone();
+
+    static std::atomic<Mode> sMode;
+};
+
+#endif // LL_LLFRAMEPROFILER_H
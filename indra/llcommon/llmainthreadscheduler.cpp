@@ -0,0 +1,288 @@
+/**
+ * @file llmainthreadscheduler.cpp
+ * @brief Shares a per-frame time budget between the kinds of work other
+ *        subsystems hand to the main thread.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llmainthreadscheduler.h"
+
+#include "llcoros.h"
+#include "lleventcoro.h"
+#include "lltrace.h"
+
+namespace
+{
+    // "No limit", kept small enough to add to a time_point
+    const LLMainThreadScheduler::duration_t UNLIMITED = std::chrono::hours(1);
+
+    const char* const CATEGORY_NAMES[LLMainThreadScheduler::CATEGORY_COUNT] =
+    {
+        "Coroutines",
+        "Timers",
+        "Main WorkQueue",
+        "Idle callbacks"
+    };
+
+    LLTrace::SampleStatHandle<> sCoroutineBacklog("mainthreadcoroutinebacklog", "Coroutines waiting for main thread time");
+    LLTrace::SampleStatHandle<> sWorkBacklog("mainthreadworkbacklog", "Mainloop WorkQueue items left for the next frame");
+    LLTrace::SampleStatHandle<> sIdleBacklog("mainthreadidlebacklog", "One-time idle callbacks left for the next frame");
+
+    LLTrace::SampleStatHandle<F64Milliseconds> sCoroutineTime("mainthreadcoroutinetime", "Main thread time spent in coroutines");
+    LLTrace::SampleStatHandle<F64Milliseconds> sTimerTime("mainthreadtimertime", "Main thread time spent in event timers and main thread tasks");
+    LLTrace::SampleStatHandle<F64Milliseconds> sWorkTime("mainthreadworktime", "Main thread time spent on the mainloop WorkQueue");
+    LLTrace::SampleStatHandle<F64Milliseconds> sIdleTime("mainthreadidletime", "Main thread time spent in idle callbacks");
+
+    LLTrace::SampleStatHandle<>* const BACKLOG_STATS[LLMainThreadScheduler::CATEGORY_COUNT] =
+    {
+        &sCoroutineBacklog,
+        nullptr,
+        &sWorkBacklog,
+        &sIdleBacklog
+    };
+
+    LLTrace::SampleStatHandle<F64Milliseconds>* const TIME_STATS[LLMainThreadScheduler::CATEGORY_COUNT] =
+    {
+        &sCoroutineTime,
+        &sTimerTime,
+        &sWorkTime,
+        &sIdleTime
+    };
+}
+
+LLMainThreadScheduler::LLMainThreadScheduler():
+    mNow(&clock_type::now),
+    mFrameBudget(duration_t::zero()),
+    mEnabled(true),
+    mActiveSlice(nullptr),
+    mWaitingCoroutines(0),
+    mHeadroomFrames(0)
+{
+    // Timers first: the thread waiting on an LLMainThreadTask is blocked.
+    // Then coroutines, which mostly finish requests the user is waiting
+    // for, worker thread replies, and idle callbacks.
+    setCategory(TIMERS, 0, 0.1f);
+    setCategory(COROUTINES, 1, 0.3f);
+    setCategory(WORK, 2, 0.4f);
+    setCategory(IDLE, 3, 0.2f);
+}
+
+// static
+const char* LLMainThreadScheduler::getCategoryName(ECategory category)
+{
+    return category < CATEGORY_COUNT ? CATEGORY_NAMES[category] : "?";
+}
+
+void LLMainThreadScheduler::setCategory(ECategory category, U32 priority, F32 share, duration_t min_slice)
+{
+    llassert(category < CATEGORY_COUNT);
+    Category& cat = mCategories[category];
+    cat.mPriority = priority;
+    cat.mShare = llclamp(share, 0.f, 1.f);
+    setMinSlice(category, min_slice);
+}
+
+void LLMainThreadScheduler::setMinSlice(ECategory category, duration_t min_slice)
+{
+    llassert(category < CATEGORY_COUNT);
+    mCategories[category].mMinSlice = llmax(min_slice, duration_t::zero());
+}
+
+void LLMainThreadScheduler::beginFrame(F32 target_fps, F32 budget_fraction, bool enabled)
+{
+    endFrame();
+
+    mEnabled = enabled;
+    const F64 frame_seconds = 1.0 / llmax((F64)target_fps, 1.0);
+    mFrameBudget = std::chrono::duration_cast<duration_t>(
+        std::chrono::duration<F64>(frame_seconds * llclamp((F64)budget_fraction, 0.0, 1.0)));
+}
+
+void LLMainThreadScheduler::endFrame()
+{
+    duration_t frame_used = duration_t::zero();
+    bool backlog = false;
+    for (S32 i = 0; i < CATEGORY_COUNT; ++i)
+    {
+        Category& cat = mCategories[i];
+        if (i == COROUTINES)
+        {
+            cat.mBacklog = mWaitingCoroutines;
+        }
+
+        frame_used += cat.mUsed;
+        backlog = backlog || cat.mBacklog;
+
+        Stats& stats = cat.mStats;
+        stats.mUsed = cat.mUsed;
+        stats.mBacklog = cat.mBacklog;
+        stats.mPeakBacklog = llmax(stats.mPeakBacklog, cat.mBacklog);
+        if (cat.mBacklog)
+        {
+            ++stats.mDeferredFrames;
+            ++stats.mDeferredStreak;
+        }
+        else
+        {
+            stats.mDeferredStreak = 0;
+        }
+
+        if (BACKLOG_STATS[i])
+        {
+            LLTrace::sample(*BACKLOG_STATS[i], (F64)cat.mBacklog);
+        }
+        LLTrace::sample(*TIME_STATS[i], F64Milliseconds(std::chrono::duration<F64, std::milli>(cat.mUsed).count()));
+
+        cat.mUsed = duration_t::zero();
+        cat.mServiced = false;
+    }
+
+    if (! backlog && frame_used < mFrameBudget)
+    {
+        ++mHeadroomFrames;
+    }
+    else
+    {
+        mHeadroomFrames = 0;
+    }
+}
+
+LLMainThreadScheduler::duration_t LLMainThreadScheduler::getUsed(ECategory category, clock_type::time_point now) const
+{
+    duration_t used = mCategories[category].mUsed;
+    if (mActiveSlice && mActiveSlice->mCategory == category)
+    {
+        used += std::chrono::duration_cast<duration_t>(now - mActiveStart);
+    }
+    return used;
+}
+
+LLMainThreadScheduler::duration_t LLMainThreadScheduler::getGuaranteed(ECategory category) const
+{
+    const Category& cat = mCategories[category];
+    const duration_t share = std::chrono::duration_cast<duration_t>(mFrameBudget * (F64)cat.mShare);
+    return llmax(share, cat.mMinSlice);
+}
+
+LLMainThreadScheduler::duration_t LLMainThreadScheduler::getRemaining(ECategory category) const
+{
+    const Category& cat = mCategories[category];
+    const clock_type::time_point now = mNow();
+    const duration_t used = getUsed(category, now);
+    if (! mEnabled)
+    {
+        return cat.mMinSlice > duration_t::zero() ? llmax(cat.mMinSlice - used, duration_t::zero()) : UNLIMITED;
+    }
+
+    // Whatever is left of the frame budget, less what is still promised to
+    // higher priority categories that haven't run yet.  A category's share
+    // only protects it from lower priorities: once the frame is over
+    // budget, nothing but its minimum slice is left.
+    duration_t remaining = mFrameBudget;
+    for (S32 i = 0; i < CATEGORY_COUNT; ++i)
+    {
+        const ECategory other = (ECategory)i;
+        const duration_t other_used = (other == category) ? used : getUsed(other, now);
+        remaining -= other_used;
+        const Category& other_cat = mCategories[i];
+        if (other != category && ! other_cat.mServiced && other_cat.mPriority < cat.mPriority)
+        {
+            remaining -= llmax(getGuaranteed(other) - other_used, duration_t::zero());
+        }
+    }
+
+    return llclamp(llmax(cat.mMinSlice - used, remaining), duration_t::zero(), UNLIMITED);
+}
+
+// static
+bool LLMainThreadScheduler::yieldForBudget()
+{
+    if (! instanceExists() || LLCoros::on_main_coro() || instance().hasBudget(COROUTINES))
+    {
+        return false;
+    }
+
+    // counted as backlog while we wait
+    struct Waiting
+    {
+        Waiting()  { ++instance().mWaitingCoroutines; }
+        ~Waiting() { if (instanceExists()) --instance().mWaitingCoroutines; }
+    } waiting;
+
+    do
+    {
+        llcoro::suspend();
+    } while (instanceExists() && ! instance().hasBudget(COROUTINES));
+    return true;
+}
+
+LLMainThreadScheduler::Slice::Slice(ECategory category):
+    mScheduler(LLMainThreadScheduler::getInstance()),
+    mCategory(category),
+    mStart(mScheduler ? mScheduler->now() : clock_type::now()),
+    mBudget(UNLIMITED),
+    mBacklog(0),
+    mOuter(nullptr)
+{
+    if (! mScheduler)
+    {
+        return;
+    }
+
+    Category& cat = mScheduler->mCategories[category];
+    mBudget = mScheduler->getRemaining(category);
+    if (! cat.mServiced)
+    {
+        cat.mServiced = true;
+        cat.mStats.mBudget = mBudget;
+    }
+
+    // Charge the enclosing slice for its time so far and pause it
+    mOuter = mScheduler->mActiveSlice;
+    if (mOuter)
+    {
+        mScheduler->mCategories[mOuter->mCategory].mUsed +=
+            std::chrono::duration_cast<duration_t>(mStart - mScheduler->mActiveStart);
+    }
+    mScheduler->mActiveSlice = this;
+    mScheduler->mActiveStart = mStart;
+}
+
+LLMainThreadScheduler::Slice::~Slice()
+{
+    if (! mScheduler || ! instanceExists())
+    {
+        return;
+    }
+
+    const clock_type::time_point now = mScheduler->now();
+    Category& cat = mScheduler->mCategories[mCategory];
+    cat.mUsed += std::chrono::duration_cast<duration_t>(now - mScheduler->mActiveStart);
+    cat.mBacklog = mBacklog;
+
+    // resume the enclosing slice, if any
+    mScheduler->mActiveSlice = mOuter;
+    mScheduler->mActiveStart = now;
+}
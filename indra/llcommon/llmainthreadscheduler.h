@@ -0,0 +1,176 @@
+/**
+ * @file llmainthreadscheduler.h
+ * @brief Shares a per-frame time budget between the kinds of work other
+ *        subsystems hand to the main thread.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLMAINTHREADSCHEDULER_H
+#define LL_LLMAINTHREADSCHEDULER_H
+
+#include "llsingleton.h"
+
+#include <chrono>
+
+//
+// Worker threads, LLMainThreadTask, idle callbacks and coroutines woken
+// by HTTP replies all hand work to the main thread, and without a common
+// budget a burst of it (a teleport, a large inventory fetch) runs in a
+// single frame.
+//
+// Every frame gets a budget of MainThreadBudgetFraction of the target frame
+// time.  A category may use whatever is left of it, except the shares of
+// higher priority categories that haven't run yet this frame, so work that
+// is serviced early in the frame can't crowd out more important work that
+// comes later.  Once the frame is over budget, a category only gets its
+// minimum slice, if any, and the rest of its work waits for a later frame.
+//
+// The main loop wraps the code servicing each category in a Slice, which
+// measures the time spent and gives deferrable work a deadline:
+//
+//     LLMainThreadScheduler::Slice slice(LLMainThreadScheduler::WORK);
+//     gMainloopWork.runUntil(slice.getDeadline());
+//     slice.setBacklog(gMainloopWork.size());
+//
+// Timers (and so LLMainThreadTask, whose caller is blocked), the frame's
+// coroutine pass and repeating idle callbacks are charged but never cut
+// short.  Long-running coroutines can call yieldForBudget() between pieces
+// of work instead.
+//
+// Threads:  main thread only
+//
+class LLMainThreadScheduler : public LLSimpleton<LLMainThreadScheduler>
+{
+public:
+    // In the order the main loop services them
+    enum ECategory
+    {
+        COROUTINES,     // coroutines resumed by the main loop's llcoro::suspend()
+        TIMERS,         // LLEventTimer::updateClass(), which runs LLMainThreadTask
+        WORK,           // the "mainloop" WorkQueue
+        IDLE,           // gIdleCallbacks, whose one-time callables can wait
+        CATEGORY_COUNT
+    };
+
+    typedef std::chrono::steady_clock clock_type;
+    typedef std::chrono::nanoseconds duration_t;
+
+    struct Stats
+    {
+        duration_t mUsed{};         // last frame
+        duration_t mBudget{};       // last frame, when first serviced
+        size_t mBacklog = 0;        // work left over after the last frame
+        size_t mPeakBacklog = 0;
+        U64 mDeferredFrames = 0;    // frames that left work over
+        U32 mDeferredStreak = 0;    // consecutive such frames, up to now
+    };
+
+    LLMainThreadScheduler();
+
+    // Starts a frame budgeted at budget_fraction of 1 / target_fps seconds.
+    // When disabled, categories with a minimum slice get just that and the
+    // others are unlimited, as before this class existed.
+    void beginFrame(F32 target_fps, F32 budget_fraction, bool enabled = true);
+
+    // priority: lower is more important.  share: fraction of the frame
+    // budget held back for the category from lower priorities.  min_slice:
+    // time the category gets every frame, even over budget.
+    void setCategory(ECategory category, U32 priority, F32 share,
+                     duration_t min_slice = duration_t::zero());
+    void setMinSlice(ECategory category, duration_t min_slice);
+
+    // Time the category may still use this frame, zero when it is over
+    duration_t getRemaining(ECategory category) const;
+    bool hasBudget(ECategory category) const { return getRemaining(category) > duration_t::zero(); }
+
+    // Where the scheduler gets the time, clock_type::now() unless a test
+    // hands it another clock.  NULL restores the default.
+    typedef clock_type::time_point (*now_func_t)();
+    void setClock(now_func_t now) { mNow = now ? now : &clock_type::now; }
+    clock_type::time_point now() const { return mNow(); }
+
+    duration_t getFrameBudget() const { return mFrameBudget; }
+    const Stats& getStats(ECategory category) const { return mCategories[category].mStats; }
+    // Consecutive frames, up to the last one, in which every category
+    // finished its work and all of them together stayed within the frame
+    // budget.  Optional work that may take longer than a slice waits for
+    // a few of these.
+    U32 getHeadroomFrames() const { return mHeadroomFrames; }
+    static const char* getCategoryName(ECategory category);
+
+    // Called from a coroutine between pieces of work: suspends it until the
+    // COROUTINES category has budget again.  Returns true if it suspended,
+    // so the caller knows to call LLCoros::checkStop().  Does nothing on
+    // the main coroutine or without an instance.
+    static bool yieldForBudget();
+
+    class Slice
+    {
+    public:
+        Slice(ECategory category);
+        ~Slice();
+
+        duration_t getBudget() const { return mBudget; }
+        clock_type::time_point getDeadline() const { return mStart + mBudget; }
+
+        // Work still pending when the slice ends
+        void setBacklog(size_t pending) { mBacklog = pending; }
+
+    private:
+        friend class LLMainThreadScheduler;
+
+        LLMainThreadScheduler* mScheduler;
+        ECategory mCategory;
+        clock_type::time_point mStart;
+        duration_t mBudget;
+        size_t mBacklog;
+        Slice* mOuter;
+    };
+
+private:
+    struct Category
+    {
+        U32 mPriority = 0;
+        F32 mShare = 0.f;
+        duration_t mMinSlice{};
+        duration_t mUsed{};         // this frame
+        bool mServiced = false;     // this frame
+        size_t mBacklog = 0;        // when last serviced
+        Stats mStats;
+    };
+
+    duration_t getUsed(ECategory category, clock_type::time_point now) const;
+    duration_t getGuaranteed(ECategory category) const;
+    void endFrame();
+
+    Category mCategories[CATEGORY_COUNT];
+    now_func_t mNow;
+    duration_t mFrameBudget;
+    bool mEnabled;
+    Slice* mActiveSlice;
+    clock_type::time_point mActiveStart;
+    size_t mWaitingCoroutines;
+    U32 mHeadroomFrames;
+};
+
+#endif // LL_LLMAINTHREADSCHEDULER_H
@@ -139,15 +139,18 @@ namespace LLProfiler
         // </FS:Beq>
     #endif
     #if LL_PROFILER_CONFIGURATION == LL_PROFILER_CONFIG_FAST_TIMER
+        // Zones go to the always-on LLFrameProfiler ring buffers instead of Tracy
+        #include "llframeprofiler.h"
+
         #define LL_PROFILER_FRAME_END
-        #define LL_PROFILER_SET_THREAD_NAME( name )     (void)(name);
+        #define LL_PROFILER_SET_THREAD_NAME( name )     LLFrameProfiler::setThreadName( name );
         #define LL_PROFILER_THREAD_BEGIN(name)          (void)(name); // Not supported
         #define LL_PROFILER_THREAD_END(name)            (void)(name); // Not supported
 
         #define LL_RECORD_BLOCK_TIME(name)                                                                  const LLTrace::BlockTimer& LL_GLUE_TOKENS(block_time_recorder, __LINE__)(LLTrace::timeThisBlock(name)); (void)LL_GLUE_TOKENS(block_time_recorder, __LINE__);
-        #define LL_PROFILE_ZONE_NAMED(name)             // LL_PROFILE_ZONE_NAMED is a no-op when Tracy is disabled
-        #define LL_PROFILE_ZONE_NAMED_COLOR(name,color) // LL_PROFILE_ZONE_NAMED_COLOR is a no-op when Tracy is disabled
-        #define LL_PROFILE_ZONE_SCOPED                  // LL_PROFILE_ZONE_SCOPED is a no-op when Tracy is disabled
+        #define LL_PROFILE_ZONE_NAMED(name)             LLFrameProfiler::Zone LL_GLUE_TOKENS(frame_profiler_zone, __LINE__)(name);
+        #define LL_PROFILE_ZONE_NAMED_COLOR(name,color) LLFrameProfiler::Zone LL_GLUE_TOKENS(frame_profiler_zone, __LINE__)(name); (void)(color);
+        #define LL_PROFILE_ZONE_SCOPED                  LLFrameProfiler::Zone LL_GLUE_TOKENS(frame_profiler_zone, __LINE__)(__FUNCTION__);
 
         #define LL_PROFILE_ZONE_NUM( val )              (void)( val );                // Not supported
         #define LL_PROFILE_ZONE_TEXT( text, size )      (void)( text ); void( size ); // Not supported
@@ -0,0 +1,346 @@
+/**
+ * @file lluuidflatmap.h
+ * @brief Open addressing hash map keyed by LLUUID.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLUUIDFLATMAP_H
+#define LL_LLUUIDFLATMAP_H
+
+#include "lluuid.h"
+
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//
+// LLUUIDFlatMap stores its entries in one flat array and resolves
+// collisions by linear probing.  UUIDs are already uniformly distributed,
+// so std::hash<LLUUID> (a fold of the 128 bits) is used as is and the
+// home slot is just its low bits.  Lookups touch one or two cache lines
+// instead of walking the tree of a std::map.
+//
+// Erasing shifts the following entries of the probe run back instead of
+// leaving tombstones, so lookups never slow down over time.
+//
+// Differences with std::map and std::unordered_map:
+//  - iteration order is unspecified and changes on insertion,
+//  - inserting invalidates all iterators, references and pointers,
+//  - erase(iterator) returns the iterator to continue from;  an entry
+//    may be visited twice when its probe run wraps around the end of the
+//    array, but none is skipped,
+//  - the key of a visited entry must not be modified,
+//  - VALUE must be default constructible and movable.  Empty slots hold
+//    a default constructed VALUE, so a cheap default (LLPointer, plain
+//    structs) is preferred.
+//
+// KEY defaults to LLUUID but any key with std::hash (or HASH) and
+// operator== works, e.g. a UUID plus a small tag.
+//
+template <typename VALUE, typename KEY = LLUUID, typename HASH = std::hash<KEY> >
+class LLUUIDFlatMap
+{
+public:
+    typedef KEY key_type;
+    typedef VALUE mapped_type;
+    typedef std::pair<KEY, VALUE> value_type;
+    typedef size_t size_type;
+
+private:
+    template <bool CONST>
+    class iterator_base
+    {
+        friend class LLUUIDFlatMap;
+        typedef typename std::conditional<CONST, const LLUUIDFlatMap, LLUUIDFlatMap>::type map_t;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename LLUUIDFlatMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<CONST, const value_type, value_type>::type& reference;
+        typedef typename std::conditional<CONST, const value_type, value_type>::type* pointer;
+
+        iterator_base() : mMap(nullptr), mSlot(0) {}
+        // iterator to const_iterator
+        template <bool OTHER, typename = typename std::enable_if<CONST && !OTHER>::type>
+        iterator_base(const iterator_base<OTHER>& other) : mMap(other.mMap), mSlot(other.mSlot) {}
+
+        reference operator*() const  { return mMap->mSlots[mSlot]; }
+        pointer operator->() const   { return &mMap->mSlots[mSlot]; }
+
+        iterator_base& operator++()
+        {
+            mSlot = mMap->nextFull(mSlot + 1);
+            return *this;
+        }
+        iterator_base operator++(int)
+        {
+            iterator_base tmp(*this);
+            ++*this;
+            return tmp;
+        }
+
+        template <bool OTHER>
+        bool operator==(const iterator_base<OTHER>& other) const { return mSlot == other.mSlot; }
+        template <bool OTHER>
+        bool operator!=(const iterator_base<OTHER>& other) const { return mSlot != other.mSlot; }
+
+        // Position in the slot array, see iterAt()
+        size_t getSlot() const { return mSlot; }
+
+    private:
+        iterator_base(map_t* map, size_t slot) : mMap(map), mSlot(slot) {}
+
+        template <bool> friend class iterator_base;
+
+        map_t* mMap;
+        size_t mSlot;
+    };
+
+public:
+    typedef iterator_base<false> iterator;
+    typedef iterator_base<true> const_iterator;
+
+    LLUUIDFlatMap() : mSize(0), mMask(0) {}
+    LLUUIDFlatMap(const LLUUIDFlatMap&) = default;
+    LLUUIDFlatMap(LLUUIDFlatMap&& other) noexcept
+    :   mSlots(std::move(other.mSlots)),
+        mFull(std::move(other.mFull)),
+        mSize(other.mSize),
+        mMask(other.mMask)
+    {
+        other.mSize = 0;
+        other.mMask = 0;
+    }
+    LLUUIDFlatMap& operator=(const LLUUIDFlatMap&) = default;
+    LLUUIDFlatMap& operator=(LLUUIDFlatMap&& other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    void swap(LLUUIDFlatMap& other) noexcept
+    {
+        mSlots.swap(other.mSlots);
+        mFull.swap(other.mFull);
+        std::swap(mSize, other.mSize);
+        std::swap(mMask, other.mMask);
+    }
+
+    size_type size() const  { return mSize; }
+    bool empty() const      { return mSize == 0; }
+    size_type capacity() const { return mFull.size(); }
+
+    iterator begin()                { return iterator(this, nextFull(0)); }
+    iterator end()                  { return iterator(this, capacity()); }
+    const_iterator begin() const    { return const_iterator(this, nextFull(0)); }
+    const_iterator end() const      { return const_iterator(this, capacity()); }
+    const_iterator cbegin() const   { return begin(); }
+    const_iterator cend() const     { return end(); }
+
+    // First entry at or after the given slot, end() if there is none.
+    // Lets callers walk the map round robin across frames:  remember
+    // getSlot() of the last visited entry and resume from the next one.
+    iterator iterAt(size_t slot)                { return iterator(this, nextFull(slot)); }
+    const_iterator iterAt(size_t slot) const    { return const_iterator(this, nextFull(slot)); }
+
+    iterator find(const KEY& key)               { return iterator(this, findSlot(key)); }
+    const_iterator find(const KEY& key) const   { return const_iterator(this, findSlot(key)); }
+    size_type count(const KEY& key) const       { return findSlot(key) != capacity() ? 1 : 0; }
+    bool contains(const KEY& key) const         { return findSlot(key) != capacity(); }
+
+    template <typename... ARGS>
+    std::pair<iterator, bool> try_emplace(const KEY& key, ARGS&&... args)
+    {
+        size_t slot = findSlot(key);
+        if (slot != capacity())
+        {
+            return std::make_pair(iterator(this, slot), false);
+        }
+        if ((mSize + 1) * 4 > capacity() * 3)
+        {
+            rehash(capacity() ? capacity() * 2 : MIN_CAPACITY);
+        }
+        slot = emptySlotFor(key);
+        mSlots[slot] = value_type(std::piecewise_construct,
+                                  std::forward_as_tuple(key),
+                                  std::forward_as_tuple(std::forward<ARGS>(args)...));
+        mFull[slot] = 1;
+        ++mSize;
+        return std::make_pair(iterator(this, slot), true);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return try_emplace(value.first, value.second);
+    }
+
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(const KEY& key, V&& value)
+    {
+        std::pair<iterator, bool> result = try_emplace(key);
+        result.first->second = std::forward<V>(value);
+        return result;
+    }
+
+    VALUE& operator[](const KEY& key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    size_type erase(const KEY& key)
+    {
+        size_t slot = findSlot(key);
+        if (slot == capacity())
+        {
+            return 0;
+        }
+        eraseSlot(slot);
+        return 1;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        size_t slot = pos.mSlot;
+        eraseSlot(slot);
+        // the next entry of the probe run, if any, was shifted into slot
+        return iterator(this, nextFull(slot));
+    }
+
+    // Releases the storage, like std::map.
+    void clear()
+    {
+        // values are destroyed once the map is consistent again, their
+        // destructors may look things up in it
+        std::vector<value_type> old_slots;
+        old_slots.swap(mSlots);
+        std::vector<U8>().swap(mFull);
+        mSize = 0;
+        mMask = 0;
+    }
+
+    void reserve(size_type count)
+    {
+        size_t wanted = MIN_CAPACITY;
+        while (count * 4 > wanted * 3)
+        {
+            wanted *= 2;
+        }
+        if (wanted > capacity())
+        {
+            rehash(wanted);
+        }
+    }
+
+private:
+    static constexpr size_t MIN_CAPACITY = 16;
+
+    size_t homeSlot(const KEY& key) const
+    {
+        return HASH()(key) & mMask;
+    }
+
+    size_t nextFull(size_t slot) const
+    {
+        const size_t cap = capacity();
+        while (slot < cap && !mFull[slot])
+        {
+            ++slot;
+        }
+        return llmin(slot, cap);
+    }
+
+    size_t findSlot(const KEY& key) const
+    {
+        if (!mSize)
+        {
+            return capacity();
+        }
+        for (size_t slot = homeSlot(key); mFull[slot]; slot = (slot + 1) & mMask)
+        {
+            if (mSlots[slot].first == key)
+            {
+                return slot;
+            }
+        }
+        return capacity();
+    }
+
+    size_t emptySlotFor(const KEY& key) const
+    {
+        size_t slot = homeSlot(key);
+        while (mFull[slot])
+        {
+            slot = (slot + 1) & mMask;
+        }
+        return slot;
+    }
+
+    void eraseSlot(size_t hole)
+    {
+        // destroyed on return, see clear()
+        value_type erased(std::move(mSlots[hole]));
+
+        // Backward shift:  move each following entry of the run into the
+        // hole unless that would put it before its home slot.
+        for (size_t slot = (hole + 1) & mMask; mFull[slot]; slot = (slot + 1) & mMask)
+        {
+            const size_t home = homeSlot(mSlots[slot].first);
+            if (((slot - home) & mMask) >= ((slot - hole) & mMask))
+            {
+                mSlots[hole] = std::move(mSlots[slot]);
+                hole = slot;
+            }
+        }
+        mSlots[hole] = value_type();
+        mFull[hole] = 0;
+        --mSize;
+    }
+
+    void rehash(size_t new_capacity)
+    {
+        std::vector<value_type> old_slots(new_capacity);
+        std::vector<U8> old_full(new_capacity, 0);
+        old_slots.swap(mSlots);
+        old_full.swap(mFull);
+        mMask = new_capacity - 1;
+        for (size_t i = 0; i < old_full.size(); ++i)
+        {
+            if (old_full[i])
+            {
+                const size_t slot = emptySlotFor(old_slots[i].first);
+                mSlots[slot] = std::move(old_slots[i]);
+                mFull[slot] = 1;
+            }
+        }
+    }
+
+    std::vector<value_type> mSlots;
+    std::vector<U8> mFull;
+    size_t mSize;
+    size_t mMask;
+};
+
+#endif // LL_LLUUIDFLATMAP_H
@@ -0,0 +1,217 @@
+/**
+ * @file   llframeprofiler_test.cpp
+ * @brief  Test for llframeprofiler.h.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llframeprofiler.h"
+// STL headers
+#include <iostream>
+#include <sstream>
+#include <thread>
+// std headers
+// external library headers
+// other Linden headers
+#include "lltimer.h"
+#include "../test/lltut.h"
+
+namespace
+{
+    size_t count_events(const LLFrameProfiler::Capture& capture, const std::string& name)
+    {
+        size_t count = 0;
+        for (const auto& thread : capture.mThreads)
+        {
+            for (const auto& event : thread.mEvents)
+            {
+                count += (name == event.mName);
+            }
+        }
+        return count;
+    }
+
+    void nested_zones(size_t count, const char* outer_name = "test outer", const char* inner_name = "test inner")
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            LLFrameProfiler::Zone outer(outer_name);
+            {
+                LLFrameProfiler::Zone inner(inner_name);
+            }
+        }
+    }
+
+    U64 time_zones(size_t count)
+    {
+        U64 start = LLTimer::getTotalTime();
+        for (size_t i = 0; i < count; ++i)
+        {
+            LLFrameProfiler::Zone zone("benchmark");
+        }
+        return LLTimer::getTotalTime() - start;
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llframeprofiler_data
+    {
+        llframeprofiler_data()
+        {
+            LLFrameProfiler::setMinZoneMicroseconds(0.0);
+            LLFrameProfiler::setMode(LLFrameProfiler::MODE_ALL_THREADS);
+        }
+        ~llframeprofiler_data()
+        {
+            LLFrameProfiler::setMode(LLFrameProfiler::MODE_OFF);
+        }
+    };
+    typedef test_group<llframeprofiler_data> llframeprofiler_group;
+    typedef llframeprofiler_group::object object;
+    llframeprofiler_group llframeprofilergrp("llframeprofiler");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("capture and Chrome trace export");
+
+        nested_zones(10);
+        std::thread worker([]()
+        {
+            LLFrameProfiler::setThreadName("test \"worker\"");
+            nested_zones(5);
+        });
+        worker.join();
+
+        LLFrameProfiler::Capture capture = LLFrameProfiler::capture(60.0);
+        ensure_equals("outer zones", count_events(capture, "test outer"), 15U);
+        ensure_equals("inner zones", count_events(capture, "test inner"), 15U);
+        ensure_equals("this thread only", count_events(LLFrameProfiler::capture(60.0, true), "test outer"), 10U);
+        for (const auto& thread : capture.mThreads)
+        {
+            for (const auto& event : thread.mEvents)
+            {
+                ensure("zone ends after it begins", event.mEnd >= event.mBegin);
+            }
+        }
+
+        std::ostringstream out;
+        size_t written = LLFrameProfiler::writeChromeTrace(out, capture);
+        ensure("wrote the zones", written >= 30);
+        const std::string json = out.str();
+        ensure("complete events", json.find("\"ph\":\"X\"") != std::string::npos);
+        ensure("escaped thread name", json.find("test \\\"worker\\\"") != std::string::npos);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("ring buffer wraps, disabled and short zones");
+
+        // much more than any ring buffer holds: only the newest survive
+        nested_zones(200000);
+        LLFrameProfiler::Capture capture = LLFrameProfiler::capture(60.0);
+        ensure("buffer wrapped", count_events(capture, "test inner") < 200000);
+        ensure("kept the newest", count_events(capture, "test inner") > 0);
+
+        LLFrameProfiler::setMode(LLFrameProfiler::MODE_OFF);
+        {
+            LLFrameProfiler::Zone zone("test disabled");
+        }
+        LLFrameProfiler::setMode(LLFrameProfiler::MODE_ALL_THREADS);
+
+        LLFrameProfiler::setMinZoneMicroseconds(1000000.0);
+        {
+            LLFrameProfiler::Zone zone("test short");
+        }
+        LLFrameProfiler::setMinZoneMicroseconds(0.0);
+
+        capture = LLFrameProfiler::capture(60.0);
+        ensure_equals("disabled zone", count_events(capture, "test disabled"), 0U);
+        ensure_equals("short zone", count_events(capture, "test short"), 0U);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("main thread mode");
+
+        // this thread drives frames
+        LLFrameProfiler::endFrame();
+        LLFrameProfiler::setMode(LLFrameProfiler::MODE_MAIN_THREAD);
+        LLFrameProfiler::setMainThreadDepth(1);
+        nested_zones(10, "main outer", "main inner");
+        std::thread worker([]()
+        {
+            nested_zones(5, "main outer", "main inner");
+        });
+        worker.join();
+        LLFrameProfiler::setMainThreadDepth(12);
+
+        LLFrameProfiler::Capture capture = LLFrameProfiler::capture(60.0);
+        ensure_equals("outer zones", count_events(capture, "main outer"), 10U);
+        ensure_equals("inner zones", count_events(capture, "main inner"), 0U);
+        ensure("still enabled", LLFrameProfiler::isEnabled());
+
+        // depth is counted back down as zones close
+        nested_zones(3, "main outer", "main inner");
+        capture = LLFrameProfiler::capture(60.0);
+        ensure_equals("outer zones again", count_events(capture, "main outer"), 13U);
+        ensure_equals("inner zones now", count_events(capture, "main inner"), 3U);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("overhead benchmark");
+
+        // Not a pass/fail test.  Cost of one zone with recording off, on,
+        // on but dropped as too short, in main thread mode on the main
+        // thread below and within its depth, and on another thread.
+        if (! getenv("LL_TEST_BENCHMARKS"))
+        {
+            skip("set LL_TEST_BENCHMARKS to run the benchmark");
+        }
+
+        const size_t COUNT = 1000000;
+        LLFrameProfiler::endFrame();
+        LLFrameProfiler::setMode(LLFrameProfiler::MODE_OFF);
+        const U64 disabled = time_zones(COUNT);
+        LLFrameProfiler::setMode(LLFrameProfiler::MODE_ALL_THREADS);
+        const U64 enabled = time_zones(COUNT);
+        LLFrameProfiler::setMinZoneMicroseconds(20.0);
+        const U64 filtered = time_zones(COUNT);
+
+        LLFrameProfiler::setMode(LLFrameProfiler::MODE_MAIN_THREAD);
+        const U64 main_filtered = time_zones(COUNT);
+        U64 main_deep = 0;
+        {
+            LLFrameProfiler::setMainThreadDepth(0);
+            main_deep = time_zones(COUNT);
+            LLFrameProfiler::setMainThreadDepth(12);
+        }
+        U64 other_thread = 0;
+        std::thread worker([&other_thread, COUNT]()
+        {
+            other_thread = time_zones(COUNT);
+        });
+        worker.join();
+        LLFrameProfiler::setMinZoneMicroseconds(0.0);
+        LLFrameProfiler::setMode(LLFrameProfiler::MODE_ALL_THREADS);
+
+        std::cout << std::endl << COUNT << " zones:  disabled " << disabled
+                  << " uS, recorded " << enabled << " uS, filtered " << filtered
+                  << " uS; main thread mode: filtered " << main_filtered
+                  << " uS, too deep " << main_deep << " uS, other thread "
+                  << other_thread << " uS" << std::endl;
+    }
+} // namespace tut
@@ -0,0 +1,239 @@
+/**
+ * @file   llmainthreadscheduler_test.cpp
+ * @brief  Test for llmainthreadscheduler.h.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llmainthreadscheduler.h"
+// STL headers
+// std headers
+// external library headers
+// other Linden headers
+#include "llcallbacklist.h"
+#include "../test/lltut.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    typedef LLMainThreadScheduler Sched;
+
+    // The scheduler's clock:  only moves when a test says so
+    Sched::clock_type::time_point sNow;
+
+    Sched::clock_type::time_point fake_now()
+    {
+        return sNow;
+    }
+
+    void spend(Sched::duration_t duration)
+    {
+        sNow += duration;
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llmainthreadscheduler_data
+    {
+        llmainthreadscheduler_data()
+        {
+            Sched::createInstance();
+            Sched::instance().setClock(&fake_now);
+        }
+        ~llmainthreadscheduler_data()
+        {
+            Sched::deleteSingleton();
+        }
+    };
+    typedef test_group<llmainthreadscheduler_data> llmainthreadscheduler_group;
+    typedef llmainthreadscheduler_group::object object;
+    llmainthreadscheduler_group llmainthreadschedulergrp("llmainthreadscheduler");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("shares and priorities");
+
+        // 10 fps, all of it: 100 ms.  Default shares: coroutines 30%,
+        // timers 10%, work 40%, idle 20%, serviced in that order but with
+        // timers first in priority.
+        Sched& sched = Sched::instance();
+        sched.beginFrame(10.f, 1.f);
+        ensure_equals("frame budget", sched.getFrameBudget(), Sched::duration_t(100ms));
+
+        // Before anyone ran, idle may only count on what isn't promised
+        // to higher priorities
+        ensure_equals("idle", sched.getRemaining(Sched::IDLE), Sched::duration_t(20ms));
+        // and coroutines on all but the timers' share
+        ensure_equals("coroutines", sched.getRemaining(Sched::COROUTINES), Sched::duration_t(90ms));
+
+        {
+            Sched::Slice slice(Sched::COROUTINES);
+            spend(30ms);
+        }
+        {
+            Sched::Slice slice(Sched::TIMERS);
+        }
+        // Coroutines used 30 ms, timers nothing, and nothing more important
+        // is left: work may have the rest
+        ensure_equals("work gets unused time", sched.getRemaining(Sched::WORK), Sched::duration_t(70ms));
+
+        {
+            Sched::Slice slice(Sched::WORK);
+            ensure_equals("slice budget", slice.getBudget(), Sched::duration_t(70ms));
+            ensure("deadline", slice.getDeadline() == sNow + 70ms);
+            spend(75ms);
+            slice.setBacklog(7);
+        }
+        // The frame is over budget: idle has to wait
+        ensure("idle over budget", ! sched.hasBudget(Sched::IDLE));
+
+        sched.beginFrame(10.f, 1.f);
+        const Sched::Stats& work = sched.getStats(Sched::WORK);
+        ensure_equals("work backlog", work.mBacklog, 7U);
+        ensure_equals("deferred frames", work.mDeferredFrames, 1ULL);
+        ensure_equals("work time", work.mUsed, Sched::duration_t(75ms));
+        ensure_equals("no timer backlog", sched.getStats(Sched::TIMERS).mBacklog, 0U);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("minimum slice, nesting, disabled");
+
+        Sched& sched = Sched::instance();
+        sched.setMinSlice(Sched::WORK, 50ms);
+        // 1000 fps, 10%: 100 us, but work's minimum holds
+        sched.beginFrame(1000.f, 0.1f);
+        ensure_equals("minimum slice", sched.getRemaining(Sched::WORK), Sched::duration_t(50ms));
+
+        {
+            Sched::Slice outer(Sched::IDLE);
+            spend(5ms);
+            {
+                // time in here is not charged to the outer slice
+                Sched::Slice inner(Sched::TIMERS);
+                spend(10ms);
+            }
+        }
+        sched.beginFrame(1000.f, 0.1f, false);
+        ensure_equals("idle charged for its own time", sched.getStats(Sched::IDLE).mUsed, Sched::duration_t(5ms));
+        ensure_equals("timers charged", sched.getStats(Sched::TIMERS).mUsed, Sched::duration_t(10ms));
+
+        // disabled: categories with a minimum get it, the others no limit
+        ensure_equals("disabled work", sched.getRemaining(Sched::WORK), Sched::duration_t(50ms));
+        ensure("disabled idle", sched.getRemaining(Sched::IDLE) >= Sched::duration_t(1h));
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("one-time idle callables spread over calls");
+
+        LLCallbackList callbacks;
+        S32 repeating = 0, once = 0;
+        callbacks.addFunction([](void* data){ ++*static_cast<S32*>(data); }, &repeating);
+        for (S32 i = 0; i < 5; ++i)
+        {
+            callbacks.addOnceFunction([&once, &callbacks, i]()
+            {
+                ++once;
+                if (i == 4)
+                {
+                    // queued during the call: waits for the next one
+                    callbacks.addOnceFunction([&once](){ ++once; });
+                }
+            });
+        }
+
+        // a deadline already past still runs one
+        size_t left = callbacks.callFunctionsUntil(Sched::clock_type::now());
+        ensure_equals("repeating", repeating, 1);
+        ensure_equals("one at least", once, 1);
+        ensure_equals("left", left, 4U);
+
+        left = callbacks.callFunctionsUntil(Sched::clock_type::now() + 1h);
+        ensure_equals("repeating again", repeating, 2);
+        ensure_equals("the rest, not the newly queued one", once, 5);
+        ensure_equals("queued during the call", left, 1U);
+
+        callbacks.callFunctions();
+        ensure_equals("all", once, 6);
+        ensure_equals("none left", callbacks.getOnceFunctionCount(), 0U);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("one-time idle callable deleting all the others");
+
+        LLCallbackList callbacks;
+        S32 once = 0;
+        callbacks.addOnceFunction([&once, &callbacks]()
+        {
+            ++once;
+            callbacks.deleteAllFunctions();
+        });
+        for (S32 i = 0; i < 3; ++i)
+        {
+            callbacks.addOnceFunction([&once](){ ++once; });
+        }
+
+        ensure_equals("none left", callbacks.callFunctionsUntil(Sched::clock_type::now() + 1h), 0U);
+        ensure_equals("only the first ran", once, 1);
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("headroom frames");
+
+        // 10 fps, all of it: 100 ms
+        Sched& sched = Sched::instance();
+        sched.beginFrame(10.f, 1.f);
+        for (S32 frame = 0; frame < 3; ++frame)
+        {
+            {
+                Sched::Slice slice(Sched::WORK);
+                spend(40ms);
+            }
+            sched.beginFrame(10.f, 1.f);
+        }
+        ensure_equals("quiet frames", sched.getHeadroomFrames(), 3U);
+
+        {
+            Sched::Slice slice(Sched::IDLE);
+            spend(10ms);
+            slice.setBacklog(1);
+        }
+        sched.beginFrame(10.f, 1.f);
+        ensure_equals("work left over", sched.getHeadroomFrames(), 0U);
+
+        {
+            Sched::Slice slice(Sched::IDLE);
+        }
+        sched.beginFrame(10.f, 1.f);
+        ensure_equals("quiet again", sched.getHeadroomFrames(), 1U);
+
+        {
+            Sched::Slice slice(Sched::COROUTINES);
+            spend(60ms);
+        }
+        {
+            Sched::Slice slice(Sched::WORK);
+            spend(60ms);
+        }
+        sched.beginFrame(10.f, 1.f);
+        ensure_equals("over budget", sched.getHeadroomFrames(), 0U);
+    }
+} // namespace tut
@@ -0,0 +1,217 @@
+/**
+ * @file   lluuidflatmap_test.cpp
+ * @brief  Test for lluuidflatmap.h.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "lluuidflatmap.h"
+// STL headers
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <unordered_map>
+#include <vector>
+// std headers
+// external library headers
+// other Linden headers
+#include "lltimer.h"
+#include "../test/lltut.h"
+
+namespace
+{
+    std::vector<LLUUID> make_ids(size_t count)
+    {
+        std::vector<LLUUID> ids(count);
+        for (LLUUID& id : ids)
+        {
+            id.generate();
+        }
+        return ids;
+    }
+
+    // Insert, look up every key (hits), look up as many unknown keys
+    // (misses) and erase half of the keys, timing each phase.
+    template <typename MAP>
+    void time_map(const char* name, const std::vector<LLUUID>& ids, const std::vector<LLUUID>& missing)
+    {
+        MAP map;
+        U64 sum = 0;
+
+        U64 start = LLTimer::getTotalTime();
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            map[ids[i]] = (U32)i;
+        }
+        const U64 insert_time = LLTimer::getTotalTime() - start;
+
+        start = LLTimer::getTotalTime();
+        for (const LLUUID& id : ids)
+        {
+            auto it = map.find(id);
+            sum += it != map.end() ? it->second : 0;
+        }
+        const U64 hit_time = LLTimer::getTotalTime() - start;
+
+        start = LLTimer::getTotalTime();
+        for (const LLUUID& id : missing)
+        {
+            sum += map.find(id) != map.end() ? 1 : 0;
+        }
+        const U64 miss_time = LLTimer::getTotalTime() - start;
+
+        start = LLTimer::getTotalTime();
+        for (size_t i = 0; i < ids.size(); i += 2)
+        {
+            map.erase(ids[i]);
+        }
+        const U64 erase_time = LLTimer::getTotalTime() - start;
+
+        std::cout << name << ":  insert " << insert_time << " uS, find hit " << hit_time
+                  << " uS, find miss " << miss_time << " uS, erase " << erase_time
+                  << " uS (" << (sum & 1) << ")" << std::endl;
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct lluuidflatmap_data
+    {
+    };
+    typedef test_group<lluuidflatmap_data> lluuidflatmap_group;
+    typedef lluuidflatmap_group::object object;
+    lluuidflatmap_group lluuidflatmapgrp("lluuidflatmap");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("insert, find, erase");
+
+        LLUUIDFlatMap<S32> map;
+        ensure("starts empty", map.empty());
+        ensure("find in empty map", map.find(LLUUID::generateNewID()) == map.end());
+        ensure_equals("erase from empty map", map.erase(LLUUID::generateNewID()), 0U);
+
+        std::vector<LLUUID> ids = make_ids(1000);
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            ensure("new key", map.try_emplace(ids[i], (S32)i).second);
+        }
+        ensure_equals("size", map.size(), ids.size());
+        ensure("duplicate key", !map.try_emplace(ids[0], -1).second);
+        ensure_equals("duplicate kept value", map[ids[0]], 0);
+
+        // null is an ordinary key
+        map[LLUUID::null] = 42;
+        ensure_equals("null key", map.find(LLUUID::null)->second, 42);
+        ensure_equals("null erased", map.erase(LLUUID::null), 1U);
+
+        for (size_t i = 0; i < ids.size(); i += 2)
+        {
+            ensure_equals("erase", map.erase(ids[i]), 1U);
+        }
+        ensure_equals("size after erase", map.size(), ids.size() / 2);
+
+        // every remaining key is still reachable after the backward shifts
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            LLUUIDFlatMap<S32>::const_iterator it = map.find(ids[i]);
+            if (i % 2)
+            {
+                ensure("kept key", it != map.end());
+                ensure_equals("kept value", it->second, (S32)i);
+            }
+            else
+            {
+                ensure("erased key", it == map.end());
+            }
+        }
+
+        map.clear();
+        ensure("cleared", map.empty() && map.begin() == map.end());
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("iteration and erase while iterating");
+
+        // tiny map with crowded probe runs, forces wrap around
+        std::vector<LLUUID> ids = make_ids(12);
+        LLUUIDFlatMap<S32> map;
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            map[ids[i]] = (S32)i;
+        }
+
+        std::vector<S32> seen;
+        for (const auto& pair : map)
+        {
+            seen.push_back(pair.second);
+        }
+        std::sort(seen.begin(), seen.end());
+        ensure_equals("visited all", seen.size(), ids.size());
+        for (size_t i = 0; i < seen.size(); ++i)
+        {
+            ensure_equals("visited once", seen[i], (S32)i);
+        }
+
+        // erase the odd values while iterating;  none may be skipped
+        for (auto it = map.begin(); it != map.end(); )
+        {
+            if (it->second % 2)
+            {
+                it = map.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        ensure_equals("size after erase", map.size(), ids.size() / 2);
+        for (const auto& pair : map)
+        {
+            ensure("only even values left", !(pair.second % 2));
+        }
+
+        // round robin restart from a slot
+        size_t visited = 0;
+        for (auto it = map.iterAt(map.begin().getSlot() + 1); it != map.end(); ++it)
+        {
+            ++visited;
+        }
+        ensure_equals("iterAt skips the first", visited, map.size() - 1);
+        ensure("iterAt past the end", map.iterAt(map.capacity() + 5) == map.end());
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("lookup benchmark");
+
+        // Not a pass/fail test.  Compares the containers the viewer
+        // registries used with the flat map, at registry sizes seen in
+        // busy regions.
+        if (! getenv("LL_TEST_BENCHMARKS"))
+        {
+            skip("set LL_TEST_BENCHMARKS to run the benchmark");
+        }
+
+        const size_t COUNT = 200000;
+        std::vector<LLUUID> ids = make_ids(COUNT);
+        std::vector<LLUUID> missing = make_ids(COUNT);
+
+        std::cout << std::endl << COUNT << " UUID keys" << std::endl;
+        time_map<std::map<LLUUID, U32> >("std::map          ", ids, missing);
+        time_map<std::unordered_map<LLUUID, U32> >("std::unordered_map", ids, missing);
+        time_map<LLUUIDFlatMap<U32> >("LLUUIDFlatMap     ", ids, missing);
+    }
+} // namespace tut
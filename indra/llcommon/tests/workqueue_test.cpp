@@ -15,12 +15,21 @@
 #include "workqueue.h"
 // STL headers
 // std headers
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <deque>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
 // external library headers
 // other Linden headers
 #include "../test/lltut.h"
 #include "../test/catch_and_store_what_in.h"
+#include "concurrentworkqueue.h"
+#include "workstealingqueue.h"
 #include "llcond.h"
 #include "llcoros.h"
 #include "lleventcoro.h"
@@ -31,6 +40,139 @@ using namespace LL;
 using namespace std::literals::chrono_literals; // ms suffix
 using namespace std::literals::string_literals; // s suffix
 
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // producers threads post items tiny work items each to queue, serviced
+    // by consumers worker threads; returns elapsed microseconds
+    long long time_throughput(WorkQueue& queue, int producers, int consumers, int items)
+    {
+        std::atomic<int> ran{ 0 };
+        std::vector<std::thread> workers;
+        for (int i = 0; i < consumers; ++i)
+        {
+            workers.emplace_back([&queue](){ queue.runUntilClose(); });
+        }
+
+        auto start{ Clock::now() };
+        std::vector<std::thread> posters;
+        for (int i = 0; i < producers; ++i)
+        {
+            posters.emplace_back([&queue, &ran, items]()
+                {
+                    for (int j = 0; j < items; ++j)
+                    {
+                        queue.post([&ran](){ ++ran; });
+                    }
+                });
+        }
+        for (auto& thread : posters)
+        {
+            thread.join();
+        }
+        queue.close();
+        for (auto& thread : workers)
+        {
+            thread.join();
+        }
+        auto elapsed{ Clock::now() - start };
+        tut::ensure_equals("not all work ran", ran.load(), producers * items);
+        return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    }
+
+    // one producer posts items spaced work items, each measuring the time
+    // from post() to being run by one of consumers worker threads; returns
+    // mean and max latency in microseconds
+    std::pair<long long, long long> time_latency(WorkQueue& queue, int consumers, int items)
+    {
+        std::atomic<long long> total{ 0 }, worst{ 0 };
+        std::vector<std::thread> workers;
+        for (int i = 0; i < consumers; ++i)
+        {
+            workers.emplace_back([&queue](){ queue.runUntilClose(); });
+        }
+        for (int i = 0; i < items; ++i)
+        {
+            auto posted{ Clock::now() };
+            queue.post([&total, &worst, posted]()
+                {
+                    long long us = std::chrono::duration_cast<std::chrono::microseconds>(
+                        Clock::now() - posted).count();
+                    total += us;
+                    long long prev = worst.load();
+                    while (us > prev && ! worst.compare_exchange_weak(prev, us))
+                        ;
+                });
+            // let the workers go back to sleep, so we measure wakeups
+            std::this_thread::sleep_for(200us);
+        }
+        queue.close();
+        for (auto& thread : workers)
+        {
+            thread.join();
+        }
+        return { total.load() / items, worst.load() };
+    }
+
+    // Spin until counter reaches target, helping queue meanwhile
+    void wait_for_count(WorkQueue& queue, std::atomic<int>& counter, int target)
+    {
+        while (counter.load() < target)
+        {
+            queue.runOne();
+            std::this_thread::yield();
+        }
+    }
+
+    // Synthetic mix of what the viewer's pools see in one frame: a fan-out
+    // of tiny jobs from the main thread, medium jobs that post follow-up
+    // jobs from the worker, and one large batch split with parallel_for().
+    // Returns elapsed microseconds.
+    long long time_mixed_workload(WorkQueue& queue)
+    {
+        const int tiny = 20000, medium = 200, followups = 50;
+        std::vector<float> batch(1 << 20);
+        std::iota(batch.begin(), batch.end(), 0.f);
+        std::atomic<int> ran{ 0 };
+        std::atomic<int>* ranp = &ran;
+        WorkQueue* queuep = &queue;
+
+        auto start{ Clock::now() };
+        for (int i = 0; i < tiny; ++i)
+        {
+            queue.post([ranp](){ ++*ranp; });
+        }
+        for (int i = 0; i < medium; ++i)
+        {
+            queue.post([ranp, queuep]()
+                {
+                    volatile float x = 0.f;
+                    for (int j = 0; j < 2000; ++j)
+                    {
+                        x = x + std::sqrt(float(j));
+                    }
+                    for (int j = 0; j < followups; ++j)
+                    {
+                        queuep->post([ranp](){ ++*ranp; });
+                    }
+                    ++*ranp;
+                });
+        }
+        parallel_for(queue, 0, batch.size(), 4096,
+                     [&batch](size_t first, size_t last)
+                     {
+                         for (size_t i = first; i < last; ++i)
+                         {
+                             batch[i] = std::sqrt(batch[i]) * 0.5f;
+                         }
+                     });
+        wait_for_count(queue, ran, tiny + medium * (followups + 1));
+        auto elapsed{ Clock::now() - start };
+        return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    }
+}
+
 /*****************************************************************************
 *   TUT
 *****************************************************************************/
@@ -236,4 +378,217 @@ namespace tut
         ensure_equals("didn't run coroutine", stored, "ran");
         ensure("void waitForResult() didn't return", done);
     }
+
+    template<> template<>
+    void object::test<7>()
+    {
+        set_test_name("ConcurrentWorkQueue");
+        ConcurrentWorkQueue cqueue("cqueue");
+        ensure("not findable as WorkQueue",
+               WorkQueue::getInstance("cqueue") == cqueue.getWeak().lock());
+
+        std::string observe;
+        WorkSchedule main("main");
+        main.postTo(
+            cqueue.getWeak(),
+            [](){ return "cqueue"s; },
+            [&observe](const std::string& s){ observe = s; });
+        cqueue.post([&observe](){ observe.append(";second"); });
+        ensure_equals("size", cqueue.size(), size_t(2));
+        ensure("run postTo work", cqueue.runOne());
+        main.runOne();
+        ensure_equals("postTo callback", observe, "cqueue");
+        cqueue.runPending();
+        ensure_equals("post", observe, "cqueue;second");
+
+        // workers blocked on an empty queue leave when it is closed
+        std::thread worker([&cqueue](){ cqueue.runUntilClose(); });
+        cqueue.post([&observe](){ observe = "thread"; });
+        cqueue.close();
+        worker.join();
+        ensure_equals("worker drained queue", observe, "thread");
+        ensure("closed", cqueue.isClosed() && cqueue.done());
+        ensure("post after close", ! cqueue.post([](){}));
+
+        // every post() accepted while racing close() is run
+        ConcurrentWorkQueue racy("racy", 1024, false);
+        std::atomic<int> accepted{ 0 }, ran{ 0 };
+        std::thread drain([&racy](){ racy.runUntilClose(); });
+        std::vector<std::thread> posters;
+        for (int i = 0; i < 4; ++i)
+        {
+            posters.emplace_back([&racy, &accepted, &ran]()
+                {
+                    while (racy.post([&ran](){ ++ran; }))
+                    {
+                        ++accepted;
+                    }
+                });
+        }
+        std::this_thread::sleep_for(1ms);
+        racy.close();
+        for (auto& thread : posters)
+        {
+            thread.join();
+        }
+        drain.join();
+        ensure_equals("accepted work not run", ran.load(), accepted.load());
+    }
+
+    template<> template<>
+    void object::test<8>()
+    {
+        set_test_name("WorkQueue vs. ConcurrentWorkQueue benchmark");
+        // Not a pass/fail test. Fan-out of many tiny items, as posted by
+        // texture and mesh decode, then wakeup latency of an idle pool.
+        if (! getenv("LL_TEST_BENCHMARKS"))
+        {
+            skip("set LL_TEST_BENCHMARKS to run the benchmark");
+        }
+
+        const int items = 100000;
+        const int workers = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+        std::cout << std::endl;
+        for (int producers : { 1, 4 })
+        {
+            WorkQueue locked("locked", 1024*1024, false);
+            ConcurrentWorkQueue lockfree("lockfree", 1024*1024, false);
+            long long locked_us = time_throughput(locked, producers, workers, items);
+            long long lockfree_us = time_throughput(lockfree, producers, workers, items);
+            std::cout << producers << " producer(s) x " << items << " items, " << workers
+                      << " workers:  WorkQueue " << locked_us << " uS, ConcurrentWorkQueue "
+                      << lockfree_us << " uS" << std::endl;
+        }
+
+        WorkQueue locked("locked", 1024, false);
+        ConcurrentWorkQueue lockfree("lockfree", 1024, false);
+        auto locked_latency = time_latency(locked, workers, 2000);
+        auto lockfree_latency = time_latency(lockfree, workers, 2000);
+        std::cout << "wakeup latency mean/max:  WorkQueue " << locked_latency.first << "/"
+                  << locked_latency.second << " uS, ConcurrentWorkQueue " << lockfree_latency.first
+                  << "/" << lockfree_latency.second << " uS" << std::endl;
+    }
+
+    template<> template<>
+    void object::test<9>()
+    {
+        set_test_name("WorkStealingThreadPool and parallel_for");
+        WorkStealingThreadPool pool("stealing", 4);
+        pool.start();
+        WorkStealingQueue& squeue = pool.getQueue();
+        ensure("not findable as WorkQueue",
+               WorkQueue::getInstance("stealing") == squeue.getWeak().lock());
+        ensure_equals("outside thread is no worker", squeue.getWorkerIndex(), -1);
+
+        // every element visited exactly once
+        std::vector<int> visits(100000, 0);
+        parallel_for(squeue, 0, visits.size(), 1000,
+                     [&visits](size_t first, size_t last)
+                     {
+                         for (size_t i = first; i < last; ++i)
+                         {
+                             ++visits[i];
+                         }
+                     });
+        ensure("visited once", std::all_of(visits.begin(), visits.end(), [](int v){ return v == 1; }));
+
+        // work posted from a worker, including nested parallel_for
+        std::atomic<int> ran{ 0 };
+        squeue.post([&squeue, &ran]()
+            {
+                parallel_for(squeue, 0, 64, 1, [&ran](size_t first, size_t last){ ran += int(last - first); });
+                for (int i = 0; i < 100; ++i)
+                {
+                    squeue.post([&ran](){ ++ran; });
+                }
+            });
+        wait_for_count(squeue, ran, 164);
+        ensure_equals("nested work", ran.load(), 164);
+
+        // first exception thrown by a chunk reaches the caller
+        std::string what{ catch_what<std::runtime_error>(
+            [&squeue]()
+            {
+                parallel_for(squeue, 0, 100, 10, [](size_t first, size_t)
+                    {
+                        if (first == 50)
+                        {
+                            throw std::runtime_error("chunk 50");
+                        }
+                    });
+            }) };
+        ensure_equals("exception", what, "chunk 50");
+
+        // parallel_for on a plain WorkQueue without workers runs inline
+        WorkQueue plain("plain");
+        int sum = 0;
+        parallel_for(plain, 0, 10, 3, [&sum](size_t first, size_t last){ sum += int(last - first); });
+        ensure_equals("plain queue", sum, 10);
+
+        // every post() accepted while racing close() is run, whether it
+        // went to the injection deque or a worker's own deque
+        WorkStealingQueue racy("racy", 1024, false);
+        std::atomic<int> accepted{ 0 };
+        ran = 0;
+        std::vector<std::thread> drains, posters;
+        for (int i = 0; i < 3; ++i)
+        {
+            drains.emplace_back([&racy](){ racy.runUntilClose(); });
+        }
+        auto flood = [&racy, &accepted, &ran]()
+            {
+                while (racy.post([&ran](){ ++ran; }))
+                {
+                    ++accepted;
+                }
+            };
+        for (int i = 0; i < 3; ++i)
+        {
+            posters.emplace_back(flood);
+        }
+        // one flood runs on a worker, posting to its own deque
+        ensure("post flood", racy.post(flood));
+        std::this_thread::sleep_for(1ms);
+        racy.close();
+        for (auto& thread : posters)
+        {
+            thread.join();
+        }
+        for (auto& thread : drains)
+        {
+            thread.join();
+        }
+        ensure("racy closed", racy.done());
+        ensure_equals("accepted work not run", ran.load(), accepted.load());
+    }
+    template<> template<>
+    void object::test<10>()
+    {
+        set_test_name("ThreadPool vs. WorkStealingThreadPool benchmark");
+        // Not a pass/fail test.
+        if (! getenv("LL_TEST_BENCHMARKS"))
+        {
+            skip("set LL_TEST_BENCHMARKS to run the benchmark");
+        }
+
+        const size_t width = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+        long long shared_us, stealing_us;
+        U64 steals;
+        {
+            ThreadPool pool("shared", width);
+            pool.start();
+            time_mixed_workload(pool.getQueue()); // warm up
+            shared_us = time_mixed_workload(pool.getQueue());
+        }
+        {
+            WorkStealingThreadPool pool("stealing", width);
+            pool.start();
+            time_mixed_workload(pool.getQueue());
+            stealing_us = time_mixed_workload(pool.getQueue());
+            steals = pool.getQueue().getStealCount();
+        }
+        std::cout << std::endl << "mixed workload, " << width << " threads:  ThreadPool "
+                  << shared_us << " uS, WorkStealingThreadPool " << stealing_us << " uS ("
+                  << steals << " steals)" << std::endl;
+    }
 } // namespace tut
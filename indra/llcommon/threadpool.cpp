@@ -18,6 +18,7 @@
 // external library headers
 // other Linden headers
 #include "commoncontrol.h"
+#include "concurrentworkqueue.h"
 #include "llerror.h"
 #include "llevents.h"
 #include "llsd.h"
@@ -152,39 +153,48 @@ void LL::ThreadPoolBase::run()
     mQueue->runUntilClose();
 }
 
-//static
-size_t LL::ThreadPoolBase::getConfiguredWidth(const std::string& name, size_t dft)
+namespace
 {
-    LLSD poolSizes;
-    try
+    // Fetch the per-pool override map stored in the named setting
+    LLSD get_pool_settings(const std::string& setting, const std::string& name)
     {
-        poolSizes = LL::CommonControl::get("Global", "ThreadPoolSizes");
-        // "ThreadPoolSizes" is actually a map containing the sizes of
-        // interest -- or should be, if this process has an
-        // LLViewerControlListener instance and its settings include
-        // "ThreadPoolSizes". If we failed to retrieve it, perhaps we're in a
-        // program that doesn't define that, or perhaps there's no such
-        // setting, or perhaps we're asking too early, before the LLEventAPI
-        // itself has been instantiated. In any of those cases, it seems worth
-        // warning.
-        if (! poolSizes.isDefined())
+        LLSD poolSettings;
+        try
         {
-            // Note: we don't warn about absence of an override key for a
-            // particular ThreadPool name, that's fine. This warning is about
-            // complete absence of a ThreadPoolSizes setting, which we expect
-            // in a normal viewer session.
-            LL_WARNS("ThreadPool") << "No 'ThreadPoolSizes' setting for ThreadPool '"
-                                   << name << "'" << LL_ENDL;
+            poolSettings = LL::CommonControl::get("Global", setting);
+            // The setting is actually a map keyed by ThreadPool name -- or
+            // should be, if this process has an LLViewerControlListener
+            // instance and its settings include it. If we failed to
+            // retrieve it, perhaps we're in a program that doesn't define
+            // that, or perhaps there's no such setting, or perhaps we're
+            // asking too early, before the LLEventAPI itself has been
+            // instantiated. In any of those cases, it seems worth warning.
+            if (! poolSettings.isDefined())
+            {
+                // Note: we don't warn about absence of an override key for
+                // a particular ThreadPool name, that's fine. This warning is
+                // about complete absence of the setting, which we expect in
+                // a normal viewer session.
+                LL_WARNS("ThreadPool") << "No '" << setting << "' setting for ThreadPool '"
+                                       << name << "'" << LL_ENDL;
+            }
         }
+        catch (const LL::CommonControl::Error& exc)
+        {
+            // We don't want ThreadPool to *require* LLViewerControlListener.
+            // Just log it and carry on.
+            LL_WARNS("ThreadPool") << "Can't check '" << setting << "': " << exc.what() << LL_ENDL;
+        }
+
+        LL_DEBUGS("ThreadPool") << setting << " = " << poolSettings << LL_ENDL;
+        return poolSettings;
     }
-    catch (const LL::CommonControl::Error& exc)
-    {
-        // We don't want ThreadPool to *require* LLViewerControlListener.
-        // Just log it and carry on.
-        LL_WARNS("ThreadPool") << "Can't check 'ThreadPoolSizes': " << exc.what() << LL_ENDL;
-    }
+} // anonymous namespace
 
-    LL_DEBUGS("ThreadPool") << "ThreadPoolSizes = " << poolSizes << LL_ENDL;
+//static
+size_t LL::ThreadPoolBase::getConfiguredWidth(const std::string& name, size_t dft)
+{
+    LLSD poolSizes{ get_pool_settings("ThreadPoolSizes", name) };
     // LLSD treats an undefined value as an empty map when asked to retrieve a
     // key, so we don't need this to be conditional.
     LLSD sizeSpec{ poolSizes[name] };
@@ -206,3 +216,21 @@ size_t LL::ThreadPoolBase::getWidth(const std::string& name, size_t dft)
         return getConfiguredWidth(name, dft);
     }
 }
+
+//static
+bool LL::ThreadPoolBase::getConfiguredLockFree(const std::string& name, bool dft)
+{
+    LLSD lockFree{ get_pool_settings("ThreadPoolLockFree", name)[name] };
+    return lockFree.isBoolean() ? lockFree.asBoolean() : dft;
+}
+
+//static
+LL::WorkQueue* LL::ThreadPoolBase::makeWorkQueue(const std::string& name, size_t capacity)
+{
+    if (getConfiguredLockFree(name))
+    {
+        LL_INFOS("ThreadPool") << "ThreadPool " << name << " using lock-free queue" << LL_ENDL;
+        return new ConcurrentWorkQueue(name, capacity, false);
+    }
+    return new WorkQueue(name, capacity, false);
+}
@@ -18,6 +18,7 @@
 #include <memory>                   // std::unique_ptr
 #include <string>
 #include <thread>
+#include <type_traits>              // std::is_same_v
 #include <utility>                  // std::pair
 #include <vector>
 
@@ -85,7 +86,23 @@ namespace LL
         static
         size_t getWidth(const std::string& name, size_t dft);
 
+        /**
+         * getConfiguredLockFree() returns the setting, if any, for the
+         * specified ThreadPool name in the "ThreadPoolLockFree" map: true
+         * to service that pool with a ConcurrentWorkQueue instead of a
+         * WorkQueue. Returns dft if the map does not contain the name.
+         */
+        static
+        bool getConfiguredLockFree(const std::string& name, bool dft=false);
+
     protected:
+        /**
+         * Queue for a ThreadPoolUsing<WorkQueue>: a ConcurrentWorkQueue if
+         * getConfiguredLockFree(name), else a plain WorkQueue.
+         */
+        static
+        WorkQueue* makeWorkQueue(const std::string& name, size_t capacity);
+
         std::unique_ptr<WorkQueueBase> mQueue;
         std::vector<std::pair<std::string, std::thread>> mThreads;
         bool mAutomaticShutdown;
@@ -122,7 +139,7 @@ namespace LL
                         size_t threads=1,
                         size_t capacity=1024*1024,
                         bool auto_shutdown = true):
-            ThreadPoolBase(name, threads, new queue_t(name, capacity, false), auto_shutdown)
+            ThreadPoolBase(name, threads, makeQueue(name, capacity), auto_shutdown)
         {}
         ~ThreadPoolUsing() override {}
 
@@ -131,6 +148,19 @@ namespace LL
          * post work to it
          */
         queue_t& getQueue() { return static_cast<queue_t&>(*mQueue); }
+
+    private:
+        static queue_t* makeQueue(const std::string& name, size_t capacity)
+        {
+            if constexpr (std::is_same_v<queue_t, WorkQueue>)
+            {
+                return makeWorkQueue(name, capacity);
+            }
+            else
+            {
+                return new queue_t(name, capacity, false);
+            }
+        }
     };
 
     /// ThreadPool is shorthand for using the simpler WorkQueue
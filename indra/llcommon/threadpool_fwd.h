@@ -20,6 +20,9 @@ namespace LL
     struct ThreadPoolUsing;
 
     using ThreadPool = ThreadPoolUsing<WorkQueue>;
+
+    class WorkStealingQueue;
+    using WorkStealingThreadPool = ThreadPoolUsing<WorkStealingQueue>;
 } // namespace LL
 
 #endif /* ! defined(LL_THREADPOOL_FWD_H) */
@@ -250,48 +250,53 @@ void LL::WorkQueueBase::checkCoroutine(const std::string& method)
 *****************************************************************************/
 LL::WorkQueue::WorkQueue(const std::string& name, size_t capacity, bool auto_shutdown):
     super(name, auto_shutdown),
-    mQueue(capacity)
+    mQueue(std::in_place, capacity)
+{
+}
+
+LL::WorkQueue::WorkQueue(const std::string& name, bool auto_shutdown, NoQueue):
+    super(name, auto_shutdown)
 {
 }
 
 void LL::WorkQueue::close()
 {
-    mQueue.close();
+    mQueue->close();
 }
 
 size_t LL::WorkQueue::size()
 {
-    return mQueue.size();
+    return mQueue->size();
 }
 
 bool LL::WorkQueue::isClosed()
 {
-    return mQueue.isClosed();
+    return mQueue->isClosed();
 }
 
 bool LL::WorkQueue::done()
 {
-    return mQueue.done();
+    return mQueue->done();
 }
 
 bool LL::WorkQueue::post(const Work& callable)
 {
-    return mQueue.pushIfOpen(callable);
+    return mQueue->pushIfOpen(callable);
 }
 
 bool LL::WorkQueue::tryPost(const Work& callable)
 {
-    return mQueue.tryPush(callable);
+    return mQueue->tryPush(callable);
 }
 
 LL::WorkQueue::Work LL::WorkQueue::pop_()
 {
-    return mQueue.pop();
+    return mQueue->pop();
 }
 
 bool LL::WorkQueue::tryPop_(Work& work)
 {
-    return mQueue.tryPop(work);
+    return mQueue->tryPop(work);
 }
 
 /*****************************************************************************
@@ -20,6 +20,7 @@
 #include <chrono>
 #include <exception>                // std::current_exception
 #include <functional>               // std::function
+#include <optional>
 #include <string>
 
 namespace LL
@@ -259,9 +260,17 @@ namespace LL
          */
         bool tryPost(const Work&) override;
 
+    protected:
+        /**
+         * For a subclass that overrides every queue operation with its own
+         * queue: skip constructing the LLThreadSafeQueue.
+         */
+        struct NoQueue {};
+        WorkQueue(const std::string& name, bool auto_shutdown, NoQueue);
+
     private:
         using Queue = LLThreadSafeQueue<Work>;
-        Queue mQueue;
+        std::optional<Queue> mQueue;
 
         Work pop_() override;
         bool tryPop_(Work&) override;
@@ -0,0 +1,227 @@
+/**
+ * @file   workstealingqueue.cpp
+ * @date   2026-03-09
+ * @brief  Implementation for WorkStealingQueue.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "workstealingqueue.h"
+// STL headers
+// std headers
+#include <thread>
+// external library headers
+// other Linden headers
+#include "llexception.h"
+
+namespace
+{
+    // Identifies the queue the current thread services, if any. Queues get
+    // distinct ids rather than being compared by address, since a new queue
+    // may be allocated where a destroyed one was.
+    std::atomic<U64> sNextQueueId{ 1 };
+    thread_local U64 sWorkerQueue = 0;
+    thread_local size_t sWorkerDeque = 0;
+
+    // mState bit set by close(); the low bits count post() calls in flight
+    constexpr U32 CLOSED = 1u << 31;
+}
+
+LL::WorkStealingQueue::WorkStealingQueue(const std::string& name, size_t capacity, bool auto_shutdown):
+    WorkQueue(name, auto_shutdown, NoQueue()),
+    mDeques(new Deque[MAX_WORKERS + 1]),
+    mCapacity(capacity),
+    mId(sNextQueueId++),
+    mWorkerCount(0),
+    mPending(0),
+    mSteals(0),
+    mState(0)
+{
+}
+
+void LL::WorkStealingQueue::close()
+{
+    if (mState.fetch_or(CLOSED) & CLOSED)
+    {
+        return;
+    }
+    // Posts that saw the queue open are only a few instructions from done.
+    while (mState.load(std::memory_order_acquire) != CLOSED)
+    {
+        std::this_thread::yield();
+    }
+    // Nothing more can be queued. Wake one blocked worker; whichever worker
+    // finds the queue drained passes this permit on to the next, see
+    // takeItem().
+    mItems.signal();
+}
+
+size_t LL::WorkStealingQueue::size()
+{
+    return (size_t)llmax(mPending.load(), (S64)0);
+}
+
+bool LL::WorkStealingQueue::isClosed()
+{
+    return (mState.load() & CLOSED) != 0;
+}
+
+bool LL::WorkStealingQueue::done()
+{
+    return mState.load() == CLOSED && mPending.load() <= 0;
+}
+
+bool LL::WorkStealingQueue::post(const Work& work)
+{
+    return push(ownDeque(), work);
+}
+
+bool LL::WorkStealingQueue::post(const Work& work, size_t worker)
+{
+    if (worker >= mWorkerCount)
+    {
+        return post(work);
+    }
+    return push(worker + 1, work);
+}
+bool LL::WorkStealingQueue::tryPost(const Work& work)
+{
+    if (mPending.load() >= (S64)mCapacity)
+    {
+        return false;
+    }
+    return post(work);
+}
+
+S32 LL::WorkStealingQueue::getWorkerIndex() const
+{
+    return ownDeque() ? (S32)ownDeque() - 1 : -1;
+}
+
+size_t LL::WorkStealingQueue::registerWorker()
+{
+    if (sWorkerQueue != mId)
+    {
+        size_t index = mWorkerCount++;
+        if (index >= MAX_WORKERS)
+        {
+            // Serve as an outside thread: injection deque and stealing only
+            --mWorkerCount;
+            return 0;
+        }
+        sWorkerQueue = mId;
+        sWorkerDeque = index + 1;
+    }
+    return sWorkerDeque;
+}
+
+size_t LL::WorkStealingQueue::ownDeque() const
+{
+    return sWorkerQueue == mId ? sWorkerDeque : 0;
+}
+
+bool LL::WorkStealingQueue::push(size_t deque, const Work& work)
+{
+    // Checking for close() and counting ourselves in flight is one atomic
+    // step, so close() cannot return between our check and our push.
+    if (mState.fetch_add(1, std::memory_order_acquire) & CLOSED)
+    {
+        mState.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mDeques[deque].mMutex);
+        mDeques[deque].mWork.push_back(work);
+    }
+    ++mPending;
+    mItems.signal();
+    mState.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool LL::WorkStealingQueue::popFrom(size_t deque, bool newest, Work& work)
+{
+    Deque& source = mDeques[deque];
+    std::lock_guard<std::mutex> lock(source.mMutex);
+    if (source.mWork.empty())
+    {
+        return false;
+    }
+    if (newest)
+    {
+        work = std::move(source.mWork.back());
+        source.mWork.pop_back();
+    }
+    else
+    {
+        work = std::move(source.mWork.front());
+        source.mWork.pop_front();
+    }
+    --mPending;
+    return true;
+}
+
+bool LL::WorkStealingQueue::take(size_t own, Work& work)
+{
+    // own deque newest first, then injection deque oldest first
+    if ((own && popFrom(own, true, work)) || popFrom(0, false, work))
+    {
+        return true;
+    }
+    // then steal the oldest item of the others, starting next to us so
+    // thieves spread over the victims
+    const size_t workers = llmin(mWorkerCount.load(), MAX_WORKERS);
+    for (size_t i = 1; i <= workers; ++i)
+    {
+        size_t victim = (own + i - 1) % workers + 1;
+        if (victim != own && popFrom(victim, false, work))
+        {
+            ++mSteals;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LL::WorkStealingQueue::takeItem(size_t own, Work& work)
+{
+    // The caller holds a permit from mItems. Its item was queued before the
+    // permit was signalled, so take() only misses it briefly while other
+    // workers are taking theirs -- unless the permit is the one close()
+    // signalled and the queue is drained. Once closed, deques only empty,
+    // so a take() finding them all empty means drained.
+    while (!take(own, work))
+    {
+        if (mState.load(std::memory_order_acquire) == CLOSED)
+        {
+            // closed and drained: pass the wakeup on to the next worker
+            mItems.signal();
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+LL::WorkStealingQueue::Work LL::WorkStealingQueue::pop_()
+{
+    const size_t own = registerWorker();
+    Work work;
+    mItems.wait();
+    if (!takeItem(own, work))
+    {
+        // closed and drained, same as LLThreadSafeQueue::pop()
+        LLTHROW(Closed());
+    }
+    return work;
+}
+
+bool LL::WorkStealingQueue::tryPop_(Work& work)
+{
+    return mItems.tryWait() && takeItem(ownDeque(), work);
+}
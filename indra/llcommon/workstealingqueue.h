@@ -0,0 +1,217 @@
+/**
+ * @file   workstealingqueue.h
+ * @date   2026-03-09
+ * @brief  WorkQueue with one deque per worker thread and work stealing,
+ *         plus a parallel_for() helper.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+#if ! defined(LL_WORKSTEALINGQUEUE_H)
+#define LL_WORKSTEALINGQUEUE_H
+
+#include "threadpool.h"
+#include "workqueue.h"
+#include "concurrentqueue.h"        // for lightweightsemaphore.h macros
+#include "lightweightsemaphore.h"
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace LL
+{
+
+/*****************************************************************************
+*   WorkStealingQueue
+*****************************************************************************/
+    /**
+     * WorkStealingQueue gives each thread servicing it (via runUntilClose(),
+     * as ThreadPool threads do) a deque of its own:
+     *
+     * * Work posted by a worker goes to that worker's deque, and the worker
+     *   takes its newest item first, so a task split into subtasks tends to
+     *   stay on the core that has its data in cache.
+     * * Work posted by any other thread goes to a shared injection deque.
+     * * A worker whose deque is empty takes from the injection deque, then
+     *   steals the oldest item of another worker's deque.
+     *
+     * Each deque has its own lock, so workers only contend when stealing.
+     *
+     * post(work, worker) is a hint: it queues work on that worker's deque,
+     * but an idle worker may still steal it.
+     *
+     * As with ConcurrentWorkQueue, capacity only limits tryPost() and post()
+     * never blocks. Every post() that returns true is run by a worker
+     * draining the queue: close() waits for post() calls already past their
+     * closed check to finish queueing. Idle workers block on a semaphore
+     * counting queued items.
+     *
+     * Use it through WorkStealingThreadPool. It derives from WorkQueue, so
+     * WorkQueue::getInstance(name) finds it.
+     */
+    class WorkStealingQueue: public WorkQueue
+    {
+    public:
+        WorkStealingQueue(const std::string& name = std::string(), size_t capacity=1024, bool auto_shutdown = true);
+
+        void close() override;
+        size_t size() override;
+        bool isClosed() override;
+        bool done() override;
+
+        bool post(const Work&) override;
+        bool tryPost(const Work&) override;
+
+        /**
+         * post work to the deque of a specific worker, 0 based in the order
+         * workers started servicing this queue. Falls back to post(work) if
+         * there is no such worker.
+         */
+        bool post(const Work& work, size_t worker);
+
+        /// 0 based index of the calling worker thread, or -1 if the calling
+        /// thread is not servicing this queue
+        S32 getWorkerIndex() const;
+
+        /// number of worker threads that have started servicing this queue
+        size_t getWorkerCount() const { return mWorkerCount; }
+
+        /// work items stolen from another worker's deque since creation
+        U64 getStealCount() const { return mSteals; }
+
+    private:
+        Work pop_() override;
+        bool tryPop_(Work&) override;
+
+        // Deque 0 is the injection deque, worker N uses deque N + 1
+        static constexpr size_t MAX_WORKERS = 64;
+        struct alignas(64) Deque
+        {
+            std::mutex mMutex;
+            std::deque<Work> mWork;
+        };
+
+        size_t registerWorker();
+        size_t ownDeque() const;
+        bool push(size_t deque, const Work& work);
+        bool popFrom(size_t deque, bool newest, Work& work);
+        bool take(size_t own, Work& work);
+        bool takeItem(size_t own, Work& work);
+
+        std::unique_ptr<Deque[]> mDeques;
+        const size_t mCapacity;
+        const U64 mId;
+        std::atomic<size_t> mWorkerCount;
+        std::atomic<S64> mPending;
+        std::atomic<U64> mSteals;
+        // one permit per queued item, plus one handed from worker to worker
+        // once the queue is closed and drained
+        moodycamel::LightweightSemaphore mItems;
+        // CLOSED bit, plus the number of post() calls between their closed
+        // check and the end of their push
+        std::atomic<U32> mState;
+    };
+
+    /// ThreadPool servicing a WorkStealingQueue. Its width comes from the
+    /// "ThreadPoolSizes" setting like any other ThreadPool.
+    using WorkStealingThreadPool = ThreadPoolUsing<WorkStealingQueue>;
+
+/*****************************************************************************
+*   parallel_for
+*****************************************************************************/
+    namespace detail
+    {
+        template <typename FUNC>
+        struct ParallelFor
+        {
+            ParallelFor(WorkQueueBase& queue, const FUNC& func, size_t grain, size_t count):
+                mQueue(queue),
+                mFunc(func),
+                mGrain(grain),
+                mRemaining(count)
+            {}
+
+            void run(size_t first, size_t last)
+            {
+                // Hand the upper halves to the queue and keep the lowest
+                // chunk. On a WorkStealingQueue worker the halves land on
+                // its own deque, where idle workers steal the biggest ones
+                // first.
+                while (last - first > mGrain)
+                {
+                    size_t mid = first + (last - first) / 2;
+                    if (! mQueue.post([this, mid, last](){ run(mid, last); }))
+                    {
+                        // queue closed, do the rest here
+                        break;
+                    }
+                    last = mid;
+                }
+                try
+                {
+                    mFunc(first, last);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mExceptionMutex);
+                    if (! mException)
+                    {
+                        mException = std::current_exception();
+                    }
+                }
+                // last access to *this: the caller may return right after
+                mRemaining -= last - first;
+            }
+
+            WorkQueueBase& mQueue;
+            const FUNC& mFunc;
+            const size_t mGrain;
+            std::atomic<size_t> mRemaining;
+            std::mutex mExceptionMutex;
+            std::exception_ptr mException;
+        };
+    } // namespace detail
+
+    /**
+     * Call func(first, last) over subranges of [begin, end) no larger than
+     * grain, spread over the threads servicing queue, and return when all
+     * of them are done. The calling thread runs chunks too, and while it
+     * waits it helps with whatever else is queued, so a long unrelated item
+     * may delay the return. If func throws, the first exception is rethrown
+     * here once every chunk has finished.
+     *
+     * Works with any WorkQueue; a WorkStealingQueue keeps the splitting
+     * local to each worker.
+     */
+    template <typename FUNC>
+    void parallel_for(WorkQueueBase& queue, size_t begin, size_t end, size_t grain, const FUNC& func)
+    {
+        LL_PROFILE_ZONE_SCOPED;
+        if (end <= begin)
+        {
+            return;
+        }
+        detail::ParallelFor<FUNC> state(queue, func, grain ? grain : 1, end - begin);
+        state.run(begin, end);
+        while (state.mRemaining.load())
+        {
+            queue.runOne();
+            if (state.mRemaining.load())
+            {
+                std::this_thread::yield();
+            }
+        }
+        if (state.mException)
+        {
+            std::rethrow_exception(state.mException);
+        }
+    }
+
+} // namespace LL
+
+#endif /* ! defined(LL_WORKSTEALINGQUEUE_H) */
@@ -38,13 +38,11 @@
 // - Implement policy classes.  Structure is mostly there just didn't
 //   need it for the first consumer.  [Classes are there.  More
 //   advanced features, like borrowing, aren't there yet.]
-// - Consider Removing 'priority' from the request interface.  Its use
-//   in an always active class can lead to starvation of low-priority
-//   requests.  Requires coodination of priority values across all
-//   components that share a class.  Changing priority across threads
-//   is slightly expensive (relative to gain) and hasn't been completely
-//   implemented.  And the major user of priority, texture fetches,
-//   may not really need it.
+// - Priority is per-request and may be changed while a request is
+//   waiting on the ready queue (requestSetPriority()).  Use in an
+//   always active class can still lead to starvation of low-priority
+//   requests so consumers should pair it with a cancel threshold
+//   (PO_PRIORITY_CANCEL_THRESHOLD) or age their priorities.
 // - Set/get for global policy and policy classes is clumsy.  Rework
 //   it heading in a direction that allows for more dynamic behavior.
 //   [Mostly fixed]
@@ -92,14 +90,6 @@
 // --------------------------------------------------------------------
 
 
-// If '1', internal ready queues will not order ready
-// requests by priority, instead it's first-come-first-served.
-// Reprioritization requests have the side-effect of then
-// putting the modified request at the back of the ready queue.
-
-#define LLCORE_HTTP_READY_QUEUE_IGNORES_PRIORITY        1
-
-
 namespace LLCore
 {
 
@@ -156,6 +146,7 @@ constexpr long HTTP_PIPELINING_MAX = 20L;
 // Miscellaneous defaults
 constexpr bool HTTP_USE_RETRY_AFTER_DEFAULT = true;
 constexpr long HTTP_THROTTLE_RATE_DEFAULT = 0L;
+constexpr long HTTP_PRIORITY_CANCEL_THRESHOLD_DEFAULT = 0L;   // Never cancel
 
 // Tuning parameters
 
@@ -166,6 +157,11 @@ constexpr int HTTP_SERVICE_LOOP_SLEEP_NORMAL_MS = 2;
 // Block allocation size (a tuning parameter) is found
 // in bufferarray.h.
 
+// Largest Content-Length for which a response body will be
+// allocated as a single contiguous block up front.  Anything
+// larger is collected in regular blocks.
+constexpr size_t HTTP_BODY_RESERVE_MAX = 32U * 1024U * 1024U;
+
 }  // end namespace LLCore
 
 #endif  // _LLCORE_HTTP_INTERNAL_H_
@@ -148,6 +148,7 @@ HttpOpRequest::HttpOpRequest()
       mReplyOffset(0),
       mReplyLength(0),
       mReplyFullLength(0),
+      mReplyConLength(0),
       mReplyHeaders(),
       mPolicyRetries(0),
       mPolicy503Retries(0),
@@ -155,7 +156,10 @@ HttpOpRequest::HttpOpRequest()
       mPolicyRetryLimit(HTTP_RETRY_COUNT_DEFAULT),
       mPolicyMinRetryBackoff(HttpTime(HTTP_RETRY_BACKOFF_MIN_DEFAULT)),
       mPolicyMaxRetryBackoff(HttpTime(HTTP_RETRY_BACKOFF_MAX_DEFAULT)),
-      mCallbackSSLVerify(NULL)
+      mCallbackSSLVerify(NULL),
+      mReqPriority(0U),
+      mReadySequence(0U),
+      mReadyIndex(-1)
 {
     // *NOTE:  As members are added, retry initialization/cleanup
     // may need to be extended in @see prepareRequest().
@@ -458,6 +462,7 @@ void HttpOpRequest::setupCommon(HttpRequest::policy_t policy_id,
 
         mPolicyMinRetryBackoff = llclamp(options->getMinBackoff(), HttpTime(0), HTTP_RETRY_BACKOFF_MAX);
         mPolicyMaxRetryBackoff = llclamp(options->getMaxBackoff(), mPolicyMinRetryBackoff, HTTP_RETRY_BACKOFF_MAX);
+        mReqPriority = options->getPriority();
     }
 }
 
@@ -491,6 +496,7 @@ HttpStatus HttpOpRequest::prepareRequest(HttpService * service)
     mReplyOffset = 0;
     mReplyLength = 0;
     mReplyFullLength = 0;
+    mReplyConLength = 0;
     mReplyHeaders.reset();
     mReplyConType.clear();
 
@@ -803,6 +809,12 @@ size_t HttpOpRequest::writeCallback(void * data, size_t size, size_t nmemb, void
     if (! op->mReplyBody)
     {
         op->mReplyBody = new BufferArray();
+        if (op->mReplyConLength)
+        {
+            // Known size, get the body in one piece so consumers
+            // can use it in place rather than copying it out.
+            op->mReplyBody->reserve(op->mReplyConLength);
+        }
     }
     const size_t req_size(size * nmemb);
     const size_t write_size(op->mReplyBody->append(static_cast<char *>(data), req_size));
@@ -882,6 +894,7 @@ size_t HttpOpRequest::headerCallback(void * data, size_t size, size_t nmemb, voi
     static const size_t status_line_len = sizeof(status_line) - 1;
     static const char con_ran_line[] = "content-range";
     static const char con_retry_line[] = "retry-after";
+    static const char con_len_line[] = "content-length";
 
     HttpOpRequest::ptr_t op(HttpOpRequest::fromHandle<HttpOpRequest>(userdata));
 
@@ -896,6 +909,7 @@ size_t HttpOpRequest::headerCallback(void * data, size_t size, size_t nmemb, voi
         op->mReplyOffset = 0;
         op->mReplyLength = 0;
         op->mReplyFullLength = 0;
+        op->mReplyConLength = 0;
         op->mReplyRetryAfter = 0;
         op->mStatus = HttpStatus();
         if (op->mReplyHeaders)
@@ -1028,6 +1042,19 @@ size_t HttpOpRequest::headerCallback(void * data, size_t size, size_t nmemb, voi
         }
     }
 
+    // Detect 'Content-Length' headers to pre-size the body
+    if (is_header
+        && value && *value
+        && ! strcmp(name, con_len_line))
+    {
+        char * end(NULL);
+        const unsigned long long length(strtoull(value, &end, 10));
+        if (end != value && length <= HTTP_BODY_RESERVE_MAX)
+        {
+            op->mReplyConLength = static_cast<size_t>(length);
+        }
+    }
+
     return hdr_size;
 }
 
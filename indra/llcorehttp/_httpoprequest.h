@@ -215,6 +215,7 @@ public:
     off_t               mReplyOffset;
     size_t              mReplyLength;
     size_t              mReplyFullLength;
+    size_t              mReplyConLength;        // From Content-Length, 0 if absent
     HttpHeaders::ptr_t  mReplyHeaders;
     std::string         mReplyConType;
     int                 mReplyRetryAfter;
@@ -226,6 +227,11 @@ public:
     int                 mPolicyRetryLimit;
     HttpTime            mPolicyMinRetryBackoff; // initial delay between retries (mcs)
     HttpTime            mPolicyMaxRetryBackoff;
+
+    // Ready queue data.  Maintained by HttpReadyQueue.
+    HttpRequest::priority_t mReqPriority;
+    U64                 mReadySequence;         // Arrival order for FIFO among equal priorities
+    int                 mReadyIndex;            // Position in ready queue heap or -1
 };  // end class HttpOpRequest
 
 
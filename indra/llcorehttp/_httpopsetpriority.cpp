@@ -24,7 +24,6 @@
  * $/LicenseInfo$
  */
 
-#if 0 // DEPRECATED
 #include "_httpopsetpriority.h"
 
 #include "httpresponse.h"
@@ -62,5 +61,3 @@ void HttpOpSetPriority::stageFromRequest(HttpService * service)
 
 
 }   // end namespace LLCore
-
-#endif
@@ -27,7 +27,7 @@
 #ifndef _LLCORE_HTTP_SETPRIORITY_H_
 #define _LLCORE_HTTP_SETPRIORITY_H_
 
-#if 0 // DEPRECATED
+
 #include "httpcommon.h"
 #include "httprequest.h"
 #include "_httpoperation.h"
@@ -39,17 +39,16 @@ namespace LLCore
 
 
 /// HttpOpSetPriority is an immediate request that
-/// searches the various queues looking for a given
-/// request handle and changing it's priority if
-/// found.
-///
-/// *NOTE:  This will very likely be removed in the near future
-/// when priority is removed from the library.
+/// searches the ready queues looking for a given
+/// request handle and changing its priority if
+/// found.  A request on a ready queue is reordered
+/// in place and may be canceled if the new priority
+/// falls below its class's PO_PRIORITY_CANCEL_THRESHOLD.
 
 class HttpOpSetPriority : public HttpOperation
 {
 public:
-    HttpOpSetPriority(HttpHandle handle);
+    HttpOpSetPriority(HttpHandle handle, HttpRequest::priority_t priority);
 
     virtual ~HttpOpSetPriority();
 
@@ -63,10 +62,10 @@ public:
 protected:
     // Request Data
     HttpHandle                  mHandle;
+    HttpRequest::priority_t     mPriority;
 }; // end class HttpOpSetPriority
 
 }  // end namespace LLCore
-#endif
 
 #endif  // _LLCORE_HTTP_SETPRIORITY_H_
 
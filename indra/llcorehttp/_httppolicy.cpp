@@ -248,6 +248,8 @@ HttpService::ELoopSpeed HttpPolicy::processReadyQueue()
             continue;
         }
 
+        const HttpRequest::priority_t cancel_threshold(
+            static_cast<HttpRequest::priority_t>(state.mOptions.mPriorityCancelThreshold));
         int active(transport.getActiveCountInClass(policy_class));
         int active_limit(state.mOptions.mPipelining > 1L
                          ? (state.mOptions.mPerHostConnectionLimit
@@ -295,6 +297,14 @@ HttpService::ELoopSpeed HttpPolicy::processReadyQueue()
                 HttpOpRequest::ptr_t op(readyq.top());
                 readyq.pop();
 
+                if (op->mReqPriority < cancel_threshold)
+                {
+                    // Highest remaining request is below the floor,
+                    // so are the rest.  Drop them as they come up.
+                    op->cancel();
+                    continue;
+                }
+
                 op->stageFromReady(mService);
                 op.reset();
 
@@ -351,20 +361,16 @@ bool HttpPolicy::cancel(HttpHandle handle)
                 return true;
             }
         }
+    }
 
-        // Scan ready queue
-        HttpReadyQueue::container_type & c2(state.mReadyQueue.get_container());
-        for (HttpReadyQueue::container_type::iterator iter(c2.begin()); c2.end() != iter;)
+    // Ready queue entries know where they are, no need to scan
+    HttpOpRequest::ptr_t op(HttpOpRequest::fromHandle<HttpOpRequest>(handle));
+    if (op && op->mReqPolicy < mClasses.size())
+    {
+        if (mClasses[op->mReqPolicy]->mReadyQueue.remove(op))
         {
-            HttpReadyQueue::container_type::iterator cur(iter++);
-
-            if ((*cur)->getHandle() == handle)
-            {
-                HttpOpRequest::ptr_t op(*cur);
-                c2.erase(cur);                                  // All iterators are now invalidated
-                op->cancel();
-                return true;
-            }
+            op->cancel();
+            return true;
         }
     }
 
@@ -372,6 +378,38 @@ bool HttpPolicy::cancel(HttpHandle handle)
 }
 
 
+bool HttpPolicy::changePriority(HttpHandle handle, HttpRequest::priority_t priority)
+{
+    HttpOpRequest::ptr_t op(HttpOpRequest::fromHandle<HttpOpRequest>(handle));
+    if (! op || op->mReqPolicy >= mClasses.size())
+    {
+        return false;
+    }
+
+    ClassState & state(*mClasses[op->mReqPolicy]);
+    if (! state.mReadyQueue.reprioritize(op, priority))
+    {
+        // Retrying or active.  Remember the value for any future
+        // trip through the ready queue but nothing to reorder.
+        op->mReqPriority = priority;
+        return true;
+    }
+
+    const HttpRequest::priority_t cancel_threshold(
+        static_cast<HttpRequest::priority_t>(state.mOptions.mPriorityCancelThreshold));
+    if (priority < cancel_threshold)
+    {
+        LL_DEBUGS(LOG_CORE) << "HTTP request " << handle
+                            << " canceled, priority " << priority
+                            << " below threshold " << cancel_threshold
+                            << LL_ENDL;
+        state.mReadyQueue.remove(op);
+        op->cancel();
+    }
+    return true;
+}
+
+
 bool HttpPolicy::stageAfterCompletion(const HttpOpRequest::ptr_t &op)
 {
     // Retry or finalize
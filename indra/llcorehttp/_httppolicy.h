@@ -116,6 +116,16 @@ public:
     /// Threading:  called by worker thread
     bool cancel(HttpHandle handle);
 
+    /// Change the priority of a request.  If the request is
+    /// waiting on a ready queue, it is reordered in place and,
+    /// should the new priority fall below the class's cancel
+    /// threshold, canceled.
+    ///
+    /// @return         True if the request handle is known.
+    ///
+    /// Threading:  called by worker thread
+    bool changePriority(HttpHandle handle, HttpRequest::priority_t priority);
+
     /// When transport is finished with an op and takes it off the
     /// active queue, it is delivered here for dispatch.  Policy
     /// may send it back to the ready/retry queues if it needs another
@@ -28,7 +28,7 @@
 #define _LLCORE_HTTP_READY_QUEUE_H_
 
 
-#include <queue>
+#include <vector>
 
 #include "_httpinternal.h"
 #include "_httpoprequest.h"
@@ -37,84 +37,211 @@
 namespace LLCore
 {
 
-/// HttpReadyQueue provides a simple priority queue for HttpOpRequest objects.
+/// HttpReadyQueue provides an indexed priority queue for HttpOpRequest
+/// objects.
 ///
-/// This uses the priority_queue adaptor class to provide the queue
-/// as well as the ordering scheme while allowing us access to the
-/// raw container if we follow a few simple rules.  One of the more
-/// important of those rules is that any iterator becomes invalid
-/// on element erasure.  So pay attention.
+/// Requests are ordered by their mReqPriority value, highest first.
+/// Requests of equal priority are served first-come-first-served so
+/// a queue where everyone uses the default priority behaves exactly
+/// like the old deque-based queue.
 ///
-/// If LLCORE_HTTP_READY_QUEUE_IGNORES_PRIORITY tests true, the class
-/// implements a std::priority_queue interface but on std::deque
-/// behavior to eliminate sensitivity to priority.  In the future,
-/// this will likely become the only behavior or it may become
-/// a run-time election.
+/// The queue is a binary heap that records each request's position
+/// in the request itself (mReadyIndex).  This allows a request that
+/// is already queued to be reprioritized or removed in O(log n)
+/// without scanning the queue, which is what makes reordering of
+/// mesh and texture fetches on camera movement affordable.
 ///
 /// Threading:  not thread-safe.  Expected to be used entirely by
 /// a single thread, typically a worker thread of some sort.
 
-#if LLCORE_HTTP_READY_QUEUE_IGNORES_PRIORITY
-
-typedef std::deque<HttpOpRequest::ptr_t> HttpReadyQueueBase;
-
-#else
-
-typedef std::priority_queue<HttpOpRequest::ptr_t,
-                            std::deque<HttpOpRequest::ptr_t>,
-                            LLCore::HttpOpRequestCompare> HttpReadyQueueBase;
-
-#endif // LLCORE_HTTP_READY_QUEUE_IGNORES_PRIORITY
-
-class HttpReadyQueue : public HttpReadyQueueBase
+class HttpReadyQueue
 {
 public:
+    typedef HttpOpRequest::ptr_t value_type;
+    typedef std::vector<value_type> container_type;
+    typedef container_type::size_type size_type;
+
     HttpReadyQueue()
-        : HttpReadyQueueBase()
+        : mNextSequence(0)
         {}
 
     ~HttpReadyQueue()
-        {}
+        {
+            clear();
+        }
 
 protected:
     HttpReadyQueue(const HttpReadyQueue &);     // Not defined
     void operator=(const HttpReadyQueue &);     // Not defined
 
 public:
+    bool empty() const
+        {
+            return mHeap.empty();
+        }
 
-#if LLCORE_HTTP_READY_QUEUE_IGNORES_PRIORITY
-    // Types and methods needed to make a std::deque look
-    // more like a std::priority_queue, at least for our
-    // purposes.
-    typedef HttpReadyQueueBase container_type;
+    size_type size() const
+        {
+            return mHeap.size();
+        }
 
-    const_reference top() const
+    const value_type & top() const
         {
-            return front();
+            return mHeap.front();
+        }
+
+    void push(const value_type & op)
+        {
+            op->mReadySequence = mNextSequence++;
+            op->mReadyIndex = static_cast<int>(mHeap.size());
+            mHeap.push_back(op);
+            siftUp(mHeap.size() - 1);
         }
 
     void pop()
         {
-            pop_front();
+            removeAt(0);
         }
 
-    void push(const value_type & v)
+    /// @return         True if the request is currently held by
+    ///                 this queue.
+    bool contains(const value_type & op) const
         {
-            push_back(v);
+            return (op->mReadyIndex >= 0
+                    && size_type(op->mReadyIndex) < mHeap.size()
+                    && mHeap[op->mReadyIndex] == op);
         }
 
-#endif // LLCORE_HTTP_READY_QUEUE_IGNORES_PRIORITY
+    /// Remove a request from anywhere in the queue.
+    ///
+    /// @return         True if the request was found and removed.
+    bool remove(const value_type & op)
+        {
+            if (! contains(op))
+            {
+                return false;
+            }
+            removeAt(op->mReadyIndex);
+            return true;
+        }
 
-    const container_type & get_container() const
+    /// Change the priority of a queued request and restore
+    /// heap order.  The request keeps its original arrival
+    /// sequence so it stays FIFO relative to its new peers.
+    ///
+    /// @return         True if the request was found on the queue.
+    bool reprioritize(const value_type & op, HttpRequest::priority_t priority)
         {
-            return *this;
+            if (! contains(op))
+            {
+                return false;
+            }
+            const HttpRequest::priority_t old_priority(op->mReqPriority);
+            op->mReqPriority = priority;
+            if (priority > old_priority)
+            {
+                siftUp(op->mReadyIndex);
+            }
+            else if (priority < old_priority)
+            {
+                siftDown(op->mReadyIndex);
+            }
+            return true;
         }
 
-    container_type & get_container()
+    void clear()
         {
-            return *this;
+            for (container_type::iterator it(mHeap.begin()); mHeap.end() != it; ++it)
+            {
+                (*it)->mReadyIndex = -1;
+            }
+            mHeap.clear();
         }
 
+protected:
+    // Strict ordering:  higher priority first, then earlier arrival.
+    static bool before(const value_type & lhs, const value_type & rhs)
+        {
+            if (lhs->mReqPriority != rhs->mReqPriority)
+            {
+                return lhs->mReqPriority > rhs->mReqPriority;
+            }
+            return lhs->mReadySequence < rhs->mReadySequence;
+        }
+
+    void place(size_type pos, const value_type & op)
+        {
+            mHeap[pos] = op;
+            op->mReadyIndex = static_cast<int>(pos);
+        }
+
+    void siftUp(size_type pos)
+        {
+            value_type op(mHeap[pos]);
+            while (pos > 0)
+            {
+                const size_type parent((pos - 1) / 2);
+                if (! before(op, mHeap[parent]))
+                {
+                    break;
+                }
+                place(pos, mHeap[parent]);
+                pos = parent;
+            }
+            place(pos, op);
+        }
+
+    void siftDown(size_type pos)
+        {
+            const size_type count(mHeap.size());
+            value_type op(mHeap[pos]);
+            for (;;)
+            {
+                size_type child(2 * pos + 1);
+                if (child >= count)
+                {
+                    break;
+                }
+                if (child + 1 < count && before(mHeap[child + 1], mHeap[child]))
+                {
+                    ++child;
+                }
+                if (! before(mHeap[child], op))
+                {
+                    break;
+                }
+                place(pos, mHeap[child]);
+                pos = child;
+            }
+            place(pos, op);
+        }
+
+    void removeAt(size_type pos)
+        {
+            mHeap[pos]->mReadyIndex = -1;
+            const size_type last(mHeap.size() - 1);
+            if (pos != last)
+            {
+                place(pos, mHeap[last]);
+                mHeap.pop_back();
+                if (pos > 0 && before(mHeap[pos], mHeap[(pos - 1) / 2]))
+                {
+                    siftUp(pos);
+                }
+                else
+                {
+                    siftDown(pos);
+                }
+            }
+            else
+            {
+                mHeap.pop_back();
+            }
+        }
+
+protected:
+    container_type      mHeap;
+    U64                 mNextSequence;
 }; // end class HttpReadyQueue
 
 
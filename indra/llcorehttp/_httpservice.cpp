@@ -63,7 +63,8 @@ const HttpService::OptionDescriptor HttpService::sOptionDesc[] =
     {   true,       true,       true,       false,      false   },      // PO_TRACE
     {   true,       true,       false,      true,       false   },      // PO_ENABLE_PIPELINING
     {   true,       true,       false,      true,       false   },      // PO_THROTTLE_RATE
-    {   false,      false,      true,       false,      true    }       // PO_SSL_VERIFY_CALLBACK
+    {   false,      false,      true,       false,      true    },      // PO_SSL_VERIFY_CALLBACK
+    {   true,       true,       false,      true,       false   }       // PO_PRIORITY_CANCEL_THRESHOLD
 };
 HttpService * HttpService::sInstance(NULL);
 volatile HttpService::EState HttpService::sState(NOT_INITIALIZED);
@@ -250,6 +251,22 @@ bool HttpService::cancel(HttpHandle handle)
 }
 
 
+/// Try to find the given request handle on the ready queues and
+/// change its priority.
+///
+/// @return         True if the request was found.
+///
+/// Threading:  callable by worker thread.
+bool HttpService::changePriority(HttpHandle handle, HttpRequest::priority_t priority)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+
+    // Request can't be on request queue so skip that.  Only the
+    // policy component orders by priority, transport doesn't care.
+    return mPolicy->changePriority(handle, priority);
+}
+
+
 /// Threading:  callable by worker thread.
 void HttpService::shutdown()
 {
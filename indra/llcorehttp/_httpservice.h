@@ -154,6 +154,14 @@ public:
     /// Threading:  callable by worker thread.
     bool cancel(HttpHandle handle);
 
+    /// Try to find the given request handle on any of the ready
+    /// queues and change its priority.
+    ///
+    /// @return         True if the request was found.
+    ///
+    /// Threading:  callable by worker thread.
+    bool changePriority(HttpHandle handle, HttpRequest::priority_t priority);
+
     /// Threading:  callable by worker thread.
     HttpPolicy & getPolicy()
         {
@@ -282,7 +282,80 @@ size_t BufferArray::write(size_t pos, const void * src, size_t len)
 }
 
 
-int BufferArray::findBlock(size_t pos, size_t * ret_offset)
+bool BufferArray::reserve(size_t len)
+{
+    if (mLen || ! mBlocks.empty() || len <= BLOCK_ALLOC_SIZE)
+    {
+        // Too late or nothing to gain over normal block allocation
+        return false;
+    }
+
+    Block * block;
+    try
+    {
+        block = Block::alloc(len);
+    }
+    catch (std::bad_alloc&)
+    {
+        LL_WARNS() << "Bad memory allocation reserving " << len
+                   << " bytes, falling back to block allocation." << LL_ENDL;
+        return false;
+    }
+    mBlocks.push_back(block);
+    return true;
+}
+
+
+size_t BufferArray::getSegments(size_t pos, size_t len, segments_t & segments) const
+{
+    segments.clear();
+    if (pos >= mLen)
+        return 0;
+    len = (std::min)(len, mLen - pos);
+    if (0 == len)
+        return 0;
+
+    size_t result(0), offset(0);
+    const auto block_limit(mBlocks.size());
+    int block_start(findBlock(pos, &offset));
+    if (block_start < 0)
+        return 0;
+
+    do
+    {
+        const Block & block(*mBlocks[block_start]);
+        size_t block_len((std::min)(block.mUsed - offset, len));
+
+        if (block_len)
+        {
+            segments.push_back(segment_t(&block.mData[offset], block_len));
+        }
+        result += block_len;
+        len -= block_len;
+        offset = 0;
+        ++block_start;
+    }
+    while (len && block_start < block_limit);
+
+    return result;
+}
+
+
+char * BufferArray::contiguousData(size_t pos, size_t len)
+{
+    if (0 == len || pos >= mLen || len > mLen - pos)
+        return NULL;
+
+    size_t offset(0);
+    int block(findBlock(pos, &offset));
+    if (block < 0 || mBlocks[block]->mUsed - offset < len)
+        return NULL;
+
+    return &mBlocks[block]->mData[offset];
+}
+
+
+int BufferArray::findBlock(size_t pos, size_t * ret_offset) const
 {
     *ret_offset = 0;
     if (pos >= mLen)
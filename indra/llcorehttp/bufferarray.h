@@ -29,6 +29,7 @@
 
 
 #include <cstdlib>
+#include <utility>
 #include <vector>
 
 #include "_refcounted.h"
@@ -120,8 +121,38 @@ public:
     /// size of the instance or do a mix of both.
     size_t write(size_t pos, const void * src, size_t len);
 
+    /// Pre-sizes an empty instance so that the next 'len' bytes
+    /// appended land in a single contiguous block.  Used with
+    /// a known Content-Length so that consumers can parse the
+    /// body in place (@see contiguousData()).  Does nothing if
+    /// data has already been added.
+    ///
+    /// @return         True if the reservation was made.
+    bool reserve(size_t len);
+
+    /// Scatter/gather view of the data:  a (pointer, length) pair
+    /// for each stretch of contiguous memory.
+    typedef std::pair<const char *, size_t> segment_t;
+    typedef std::vector<segment_t> segments_t;
+
+    /// Fills 'segments' with the memory ranges covering 'len'
+    /// bytes starting at 'pos' without copying any data.  The
+    /// pointers remain valid until the instance is modified
+    /// or released.
+    ///
+    /// @return         Count of bytes covered, may be short if
+    ///                 the range extends beyond the data.
+    size_t getSegments(size_t pos, size_t len, segments_t & segments) const;
+
+    /// Returns a pointer to 'len' bytes at 'pos' if the whole
+    /// range lies within a single block, allowing callers to use
+    /// the data in place.  Returns NULL if the range is split
+    /// across blocks (use @see read() or @see getSegments()) or
+    /// extends beyond the data.
+    char * contiguousData(size_t pos, size_t len);
+
 protected:
-    int findBlock(size_t pos, size_t * ret_offset);
+    int findBlock(size_t pos, size_t * ret_offset) const;
 
     bool getBlockStartEnd(int block, const char ** start, const char ** end);
 
@@ -48,6 +48,7 @@ HttpOptions::HttpOptions() :
     mVerifyHost(false),
     mDNSCacheTimeout(-1L),
     mNoBody(false),
+    mPriority(0U),
     mLastModified(0) // <FS:Ansariel> GetIfModified request
 {}
 
@@ -130,6 +131,11 @@ void HttpOptions::setHeadersOnly(bool nobody)
     }
 }
 
+void HttpOptions::setPriority(unsigned int priority)
+{
+    mPriority = priority;
+}
+
 void HttpOptions::setDefaultSSLVerifyPeer(bool verify)
 {
     sDefaultVerifyPeer = verify;
@@ -185,6 +185,16 @@ public:
     /// NoVerifySSLCert
     static void         setDefaultSSLVerifyPeer(bool verify);
 
+    /// Sets the initial ready-queue priority of the request.  Higher
+    /// values are issued first.  May be changed later with
+    /// HttpRequest::requestSetPriority().
+    /// Default: 0
+    void                setPriority(unsigned int priority);
+    unsigned int        getPriority() const
+    {
+        return mPriority;
+    }
+
     // <FS:Ansariel> GetIfModified request
     void                setLastModified(long last_modified);
     long                getLastModified() const
@@ -207,6 +217,7 @@ protected:
     bool                mVerifyHost;
     int                 mDNSCacheTimeout;
     bool                mNoBody;
+    unsigned int        mPriority;
 
     static bool         sDefaultVerifyPeer;
 
@@ -33,6 +33,7 @@
 #include "_httpoperation.h"
 #include "_httpoprequest.h"
 #include "_httpopcancel.h"
+#include "_httpopsetpriority.h"
 #include "_httpopsetget.h"
 
 #include "lltimer.h"
@@ -476,6 +477,24 @@ HttpHandle HttpRequest::requestCancel(HttpHandle request, HttpHandler::ptr_t use
 }
 
 
+HttpHandle HttpRequest::requestSetPriority(HttpHandle request, priority_t priority,
+                                           HttpHandler::ptr_t user_handler)
+{
+    HttpStatus status;
+
+    HttpOperation::ptr_t op(new HttpOpSetPriority(request, priority));
+    op->setReplyPath(mReplyQueue, user_handler);
+    if (! (status = mRequestQueue->addOp(op)))          // transfers refcount
+    {
+        mLastReqStatus = status;
+        return LLCORE_HTTP_HANDLE_INVALID;
+    }
+
+    mLastReqStatus = status;
+    return op->getHandle();
+}
+
+
 // ====================================
 // Utility Methods
 // ====================================
@@ -95,6 +95,7 @@ private:
 
 public:
     typedef unsigned int policy_t;
+    typedef unsigned int priority_t;
 
     typedef std::shared_ptr<HttpRequest> ptr_t;
     typedef std::weak_ptr<HttpRequest>   wptr_t;
@@ -232,6 +233,15 @@ public:
         /// Global only
         PO_SSL_VERIFY_CALLBACK,
 
+        /// Long value giving a priority floor for requests waiting
+        /// on the ready queue of this class.  Requests whose priority
+        /// is (or is changed to be) below this value are canceled
+        /// rather than issued.  A value of zero, the default,
+        /// disables cancellation.
+        ///
+        /// Per-class only
+        PO_PRIORITY_CANCEL_THRESHOLD,
+
         PO_LAST  // Always at end
     };
 
@@ -575,6 +585,23 @@ public:
 
     HttpHandle requestCancel(HttpHandle request, HttpHandler::ptr_t);
 
+    /// Change the priority of a previously issued request.  Requests
+    /// still waiting on a ready queue are reordered immediately (higher
+    /// values are issued first, equal values in submission order).
+    /// Requests already active are unaffected other than recording the
+    /// new value.  If the new priority falls below the policy class's
+    /// PO_PRIORITY_CANCEL_THRESHOLD, a waiting request is canceled and
+    /// its handler notified with a canceled status.
+    ///
+    /// @param  request         Handle of previously-issued request.
+    /// @param  priority        New priority value.
+    /// @param  handler         @see requestGet().  Completes with
+    ///                         HE_HANDLE_NOT_FOUND if the request is
+    ///                         no longer known to the library.
+    /// @return                 "
+    ///
+    HttpHandle requestSetPriority(HttpHandle request, priority_t priority, HttpHandler::ptr_t handler);
+
     /// @}
 
     /// @name UtilityMethods
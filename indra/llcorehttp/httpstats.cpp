@@ -45,6 +45,8 @@ void HTTPStats::resetStats()
     mDataDown.reset();
     mDataUp.reset();
     mRequests = 0;
+    mBodyBytesCopied = 0;
+    mBodyBytesInPlace = 0;
 }
 
 
@@ -93,6 +95,8 @@ void HTTPStats::dumpStats()
     out << "Data Sent: " << byte_count_converter(mDataUp.getSum()) << "   (" << mDataUp.getSum() << ")" << std::endl;
     out << "Data Recv: " << byte_count_converter(mDataDown.getSum()) << "   (" << mDataDown.getSum() << ")" << std::endl;
     out << "Total requests: " << mRequests << "(request objects created)" << std::endl;
+    out << "Body bytes copied: " << byte_count_converter((F32)mBodyBytesCopied) << "   (" << mBodyBytesCopied << ")" << std::endl;
+    out << "Body bytes used in place: " << byte_count_converter((F32)mBodyBytesInPlace) << "   (" << mBodyBytesInPlace << ")" << std::endl;
     out << std::endl;
     out << "Result Codes:" << std::endl << "--- -----" << std::endl;
 
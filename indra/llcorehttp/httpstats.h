@@ -33,6 +33,8 @@
 #include "llsingleton.h"
 #include "llsd.h"
 
+#include <atomic>
+
 namespace LLCore
 {
     class HTTPStats final : public LLSimpleton<HTTPStats>
@@ -57,6 +59,15 @@ namespace LLCore
 
         void    recordHTTPRequest() { ++mRequests; }
 
+        /// Response body bytes copied out of a BufferArray into
+        /// consumer storage, and bytes consumers used in place.
+        /// Callable from any thread.
+        void    recordBodyBytesCopied(size_t bytes) { mBodyBytesCopied += bytes; }
+        void    recordBodyBytesInPlace(size_t bytes) { mBodyBytesInPlace += bytes; }
+
+        U64     getBodyBytesCopied() const { return mBodyBytesCopied; }
+        U64     getBodyBytesInPlace() const { return mBodyBytesInPlace; }
+
         void    recordResultCode(S32 code);
 
         void    dumpStats();
@@ -66,6 +77,9 @@ namespace LLCore
 
         S32              mRequests;
 
+        std::atomic<U64> mBodyBytesCopied;
+        std::atomic<U64> mBodyBytesInPlace;
+
         std::map<S32, S32> mResutCodes;
     };
 
@@ -29,6 +29,7 @@
 #include "bufferarray.h"
 
 #include <iostream>
+#include <vector>
 
 
 using namespace LLCore;
@@ -374,6 +375,52 @@ void BufferArrayTestObjectType::test<8>()
     ba->release();
 }
 
+template <> template <>
+void BufferArrayTestObjectType::test<9>()
+{
+    set_test_name("BufferArray segments and in-place access");
+
+    BufferArray * ba = new BufferArray();
+
+    // Fill past one block so the data is split
+    std::vector<char> src(BufferArray::BLOCK_ALLOC_SIZE + 100);
+    for (size_t i(0); i < src.size(); ++i)
+    {
+        src[i] = char(i % 251);
+    }
+    ba->append(&src[0], src.size());
+
+    ensure("Contiguous within first block", NULL != ba->contiguousData(10, 100));
+    ensure("Contiguous data correct", 0 == memcmp(ba->contiguousData(10, 100), &src[10], 100));
+    ensure("Not contiguous across blocks", NULL == ba->contiguousData(BufferArray::BLOCK_ALLOC_SIZE - 10, 20));
+    ensure("Not contiguous past end", NULL == ba->contiguousData(src.size() - 10, 20));
+
+    BufferArray::segments_t segments;
+    size_t len(ba->getSegments(BufferArray::BLOCK_ALLOC_SIZE - 10, 20, segments));
+    ensure("Segments cover range", 20 == len);
+    ensure("Two segments", 2 == segments.size());
+    ensure("First segment length", 10 == segments[0].second);
+    ensure("First segment data", 0 == memcmp(segments[0].first, &src[BufferArray::BLOCK_ALLOC_SIZE - 10], 10));
+    ensure("Second segment data", 0 == memcmp(segments[1].first, &src[BufferArray::BLOCK_ALLOC_SIZE], 10));
+
+    len = ba->getSegments(src.size() - 5, 100, segments);
+    ensure("Short segment count at end", 5 == len);
+
+    ba->release();
+
+    // Reserved instance takes the same data in one piece
+    ba = new BufferArray();
+    ensure("Reserve on empty instance", ba->reserve(src.size()));
+    ba->append(&src[0], 1000);
+    ba->append(&src[1000], src.size() - 1000);
+    ensure("Size correct after reserve", src.size() == ba->size());
+    ensure("Whole body contiguous", NULL != ba->contiguousData(0, src.size()));
+    ensure("Whole body correct", 0 == memcmp(ba->contiguousData(0, src.size()), &src[0], src.size()));
+    ensure("No reserve after data", ! ba->reserve(2 * src.size()));
+
+    ba->release();
+}
+
 }  // end namespace tut
 
 
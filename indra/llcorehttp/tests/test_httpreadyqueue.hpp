@@ -0,0 +1,231 @@
+/**
+ * @file test_httpreadyqueue.hpp
+ * @brief unit tests for the LLCore::HttpReadyQueue class
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+#ifndef TEST_LLCORE_HTTP_READYQUEUE_H_
+#define TEST_LLCORE_HTTP_READYQUEUE_H_
+
+#include "_httpreadyqueue.h"
+
+#include <iostream>
+#include <vector>
+
+#include "_httpoprequest.h"
+#include "lltimer.h"
+
+
+using namespace LLCoreInt;
+
+
+
+namespace tut
+{
+
+struct HttpReadyqueueTestData
+{
+    // the test objects inherit from this so the member functions and variables
+    // can be referenced directly inside of the test functions.
+    HttpOpRequest::ptr_t makeOp(HttpRequest::priority_t priority)
+        {
+            HttpOpRequest::ptr_t op(new HttpOpRequest());
+            op->mReqPriority = priority;
+            return op;
+        }
+};
+
+typedef test_group<HttpReadyqueueTestData> HttpReadyqueueTestGroupType;
+typedef HttpReadyqueueTestGroupType::object HttpReadyqueueTestObjectType;
+HttpReadyqueueTestGroupType HttpReadyqueueTestGroup("HttpReadyqueue Tests");
+
+template <> template <>
+void HttpReadyqueueTestObjectType::test<1>()
+{
+    set_test_name("HttpReadyQueue is FIFO for equal priorities");
+
+    HttpReadyQueue rq;
+    std::vector<HttpOpRequest::ptr_t> ops;
+    for (int i(0); i < 10; ++i)
+    {
+        ops.push_back(makeOp(0));
+        rq.push(ops.back());
+    }
+    ensure("Ten go in", 10 == rq.size());
+
+    for (int i(0); i < 10; ++i)
+    {
+        ensure("Popped in submission order", rq.top() == ops[i]);
+        rq.pop();
+        ensure_equals("Popped request is no longer indexed", ops[i]->mReadyIndex, -1);
+    }
+    ensure("Queue drained", rq.empty());
+}
+
+template <> template <>
+void HttpReadyqueueTestObjectType::test<2>()
+{
+    set_test_name("HttpReadyQueue orders by priority");
+
+    HttpReadyQueue rq;
+    HttpOpRequest::ptr_t low(makeOp(1)), mid(makeOp(5)), high(makeOp(9)), mid2(makeOp(5));
+    rq.push(low);
+    rq.push(mid);
+    rq.push(high);
+    rq.push(mid2);
+
+    ensure("Highest first", rq.top() == high);
+    rq.pop();
+    ensure("Then first of the equals", rq.top() == mid);
+    rq.pop();
+    ensure("Then second of the equals", rq.top() == mid2);
+    rq.pop();
+    ensure("Lowest last", rq.top() == low);
+    rq.pop();
+    ensure("Queue drained", rq.empty());
+}
+
+template <> template <>
+void HttpReadyqueueTestObjectType::test<3>()
+{
+    set_test_name("HttpReadyQueue reprioritize and remove");
+
+    HttpReadyQueue rq;
+    std::vector<HttpOpRequest::ptr_t> ops;
+    for (int i(0); i < 8; ++i)
+    {
+        ops.push_back(makeOp(10));
+        rq.push(ops.back());
+    }
+
+    // Bump the last one to the front, sink the first one
+    ensure("Raise queued request", rq.reprioritize(ops[7], 20));
+    ensure("Lower queued request", rq.reprioritize(ops[0], 1));
+    ensure("Raised request on top", rq.top() == ops[7]);
+
+    // Remove one from the middle
+    ensure("Remove queued request", rq.remove(ops[4]));
+    ensure("Removed request is no longer indexed", ! rq.contains(ops[4]));
+    ensure("Can't remove twice", ! rq.remove(ops[4]));
+    ensure("Can't reprioritize removed request", ! rq.reprioritize(ops[4], 30));
+
+    const int expected[] = { 7, 1, 2, 3, 5, 6, 0 };
+    for (int i(0); i < 7; ++i)
+    {
+        ensure("Expected order after reprioritize/remove", rq.top() == ops[expected[i]]);
+        rq.pop();
+    }
+    ensure("Queue drained", rq.empty());
+}
+
+template <> template <>
+void HttpReadyqueueTestObjectType::test<4>()
+{
+    set_test_name("HttpReadyQueue randomized heap consistency");
+
+    HttpReadyQueue rq;
+    std::vector<HttpOpRequest::ptr_t> ops;
+    unsigned int seed(12345U);
+    for (int i(0); i < 500; ++i)
+    {
+        seed = seed * 1103515245U + 12345U;
+        ops.push_back(makeOp((seed >> 16) % 64));
+        rq.push(ops.back());
+    }
+    for (int i(0); i < 500; i += 3)
+    {
+        seed = seed * 1103515245U + 12345U;
+        rq.reprioritize(ops[i], (seed >> 16) % 64);
+    }
+    for (int i(1); i < 500; i += 7)
+    {
+        rq.remove(ops[i]);
+    }
+
+    HttpRequest::priority_t last(~0U);
+    U64 last_seq(0);
+    while (! rq.empty())
+    {
+        const HttpOpRequest::ptr_t & op(rq.top());
+        ensure("Priorities never increase", op->mReqPriority <= last);
+        if (op->mReqPriority == last)
+        {
+            ensure("FIFO among equals", op->mReadySequence > last_seq);
+        }
+        last = op->mReqPriority;
+        last_seq = op->mReadySequence;
+        rq.pop();
+    }
+}
+
+template <> template <>
+void HttpReadyqueueTestObjectType::test<5>()
+{
+    set_test_name("HttpReadyQueue benchmark");
+
+    // Not a pass/fail test.  Reports the cost of the operations
+    // HttpPolicy performs on a busy texture/mesh class:  fill,
+    // a camera turn reprioritizing everything, then drain.
+    if (! getenv("LL_TEST_BENCHMARKS"))
+    {
+        skip("set LL_TEST_BENCHMARKS to run the benchmark");
+    }
+
+    const int count(100000);
+    std::vector<HttpOpRequest::ptr_t> ops;
+    ops.reserve(count);
+    for (int i(0); i < count; ++i)
+    {
+        ops.push_back(makeOp(i % 1024));
+    }
+
+    HttpReadyQueue rq;
+    U64 start(totalTime());
+    for (int i(0); i < count; ++i)
+    {
+        rq.push(ops[i]);
+    }
+    const U64 push_time(totalTime() - start);
+
+    start = totalTime();
+    for (int i(0); i < count; ++i)
+    {
+        rq.reprioritize(ops[i], (i * 7919) % 1024);
+    }
+    const U64 reprio_time(totalTime() - start);
+
+    start = totalTime();
+    while (! rq.empty())
+    {
+        rq.pop();
+    }
+    const U64 pop_time(totalTime() - start);
+
+    std::cout << "HttpReadyQueue " << count << " requests:  push "
+              << push_time << " uS, reprioritize " << reprio_time
+              << " uS, pop " << pop_time << " uS" << std::endl;
+}
+
+}  // end namespace tut
+
+
+#endif  // TEST_LLCORE_HTTP_READYQUEUE_H_
@@ -2730,6 +2730,402 @@ bool LLVolume::unpackVolumeFacesInternal(const LLSD& mdl)
     return true;
 }
 
+namespace
+{
+    const U32 DECODED_FACES_MAGIC = 0x4656444c; // "LDVF"
+    const U32 DECODED_FACES_VERSION = 2;
+
+    enum
+    {
+        DECODED_FACE_HAS_TANGENTS = 0x1,
+        DECODED_FACE_HAS_WEIGHTS = 0x2
+    };
+
+    struct DecodedFacesHeader
+    {
+        U32 mMagic;
+        U32 mVersion;
+        U32 mFaceCount;
+        U32 mReserved;
+    };
+
+    // Vertex attributes follow the header quantized about as finely as the
+    // mesh asset has them:  positions and texture coordinates to U16 over
+    // the face's own domain, normals and tangents to S16, weights to a U16
+    // influence per joint index.
+    struct DecodedFaceHeader
+    {
+        S32 mNumVertices;
+        S32 mNumIndices;
+        U32 mFlags;
+        U32 mReserved;
+        F32 mExtents[12]; // min, max, center
+        F32 mTexCoordExtents[4];
+        F32 mNormalizedScale[4];
+        F32 mPositionDomain[6]; // min, max
+        F32 mTexCoordDomain[4]; // min, max
+    };
+
+    // bytes per vertex of each quantized attribute
+    const size_t DECODED_POSITION_SIZE = sizeof(U16) * 3;
+    const size_t DECODED_NORMAL_SIZE = sizeof(S16) * 3;
+    const size_t DECODED_TEXCOORD_SIZE = sizeof(U16) * 2;
+    const size_t DECODED_TANGENT_SIZE = sizeof(S16) * 4;
+    const size_t DECODED_WEIGHT_SIZE = sizeof(U16) * 4 + sizeof(U8) * 4;
+
+    U16 quantize_u16(F32 val, F32 min, F32 range)
+    {
+        return range > 0.f ? (U16) llclamp(ll_round((val - min) / range * 65535.f), 0, 65535) : 0;
+    }
+
+    F32 dequantize_u16(U16 val, F32 min, F32 range)
+    {
+        return min + (F32) val / 65535.f * range;
+    }
+
+    S16 quantize_s16(F32 val)
+    {
+        return (S16) llclamp(ll_round(val * 32767.f), -32767, 32767);
+    }
+
+    F32 dequantize_s16(S16 val)
+    {
+        return (F32) val / 32767.f;
+    }
+
+    void append_bytes(std::vector<U8>& out, const void* src, size_t bytes)
+    {
+        if (bytes)
+        {
+            const U8* p = (const U8*) src;
+            out.insert(out.end(), p, p + bytes);
+        }
+    }
+
+    bool read_bytes(const U8*& cur, const U8* end, void* dst, size_t bytes)
+    {
+        if (size_t(end - cur) < bytes)
+        {
+            return false;
+        }
+        if (bytes)
+        {
+            memcpy(dst, cur, bytes);
+            cur += bytes;
+        }
+        return true;
+    }
+
+    // Hands out the next bytes of the entry, if there are that many left
+    bool take_bytes(const U8*& cur, const U8* end, size_t bytes, const U8*& block)
+    {
+        if (size_t(end - cur) < bytes)
+        {
+            return false;
+        }
+        block = cur;
+        cur += bytes;
+        return true;
+    }
+}
+
+bool LLVolume::packDecodedVolumeFaces(std::vector<U8>& out) const
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
+
+    out.clear();
+    if (mVolumeFaces.empty())
+    {
+        return false;
+    }
+
+    size_t total = sizeof(DecodedFacesHeader);
+    for (const LLVolumeFace& face : mVolumeFaces)
+    {
+        if (!face.mOptimized)
+        { // only cache optimized faces are worth keeping
+            return false;
+        }
+        total += sizeof(DecodedFaceHeader) + face.mNumIndices * sizeof(U16)
+            + face.mNumVertices * (DECODED_POSITION_SIZE + DECODED_NORMAL_SIZE + DECODED_TEXCOORD_SIZE
+                                   + (face.mTangents ? DECODED_TANGENT_SIZE : 0)
+                                   + (face.mWeights ? DECODED_WEIGHT_SIZE : 0));
+    }
+    out.reserve(total);
+
+    DecodedFacesHeader header = { DECODED_FACES_MAGIC, DECODED_FACES_VERSION, (U32) mVolumeFaces.size(), 0 };
+    append_bytes(out, &header, sizeof(header));
+
+    for (const LLVolumeFace& face : mVolumeFaces)
+    {
+        const S32 num_verts = face.mNumVertices;
+
+        DecodedFaceHeader fh;
+        memset(&fh, 0, sizeof(fh));
+        fh.mNumVertices = num_verts;
+        fh.mNumIndices = face.mNumIndices;
+        fh.mFlags = (face.mTangents ? DECODED_FACE_HAS_TANGENTS : 0)
+            | (face.mWeights ? DECODED_FACE_HAS_WEIGHTS : 0);
+        for (S32 i = 0; i < 3; ++i)
+        {
+            memcpy(fh.mExtents + i * 4, face.mExtents[i].getF32ptr(), sizeof(LLVector4a));
+        }
+        fh.mTexCoordExtents[0] = face.mTexCoordExtents[0].mV[VX];
+        fh.mTexCoordExtents[1] = face.mTexCoordExtents[0].mV[VY];
+        fh.mTexCoordExtents[2] = face.mTexCoordExtents[1].mV[VX];
+        fh.mTexCoordExtents[3] = face.mTexCoordExtents[1].mV[VY];
+        fh.mNormalizedScale[0] = face.mNormalizedScale.mV[VX];
+        fh.mNormalizedScale[1] = face.mNormalizedScale.mV[VY];
+        fh.mNormalizedScale[2] = face.mNormalizedScale.mV[VZ];
+
+        // the domains are taken from the data rather than from the extents,
+        // so nothing gets clamped whatever the extents say
+        if (num_verts)
+        {
+            for (S32 k = 0; k < 3; ++k)
+            {
+                fh.mPositionDomain[k] = fh.mPositionDomain[k + 3] = face.mPositions[0][k];
+            }
+            fh.mTexCoordDomain[0] = fh.mTexCoordDomain[2] = face.mTexCoords[0].mV[VX];
+            fh.mTexCoordDomain[1] = fh.mTexCoordDomain[3] = face.mTexCoords[0].mV[VY];
+        }
+        for (S32 i = 1; i < num_verts; ++i)
+        {
+            for (S32 k = 0; k < 3; ++k)
+            {
+                fh.mPositionDomain[k] = llmin(fh.mPositionDomain[k], face.mPositions[i][k]);
+                fh.mPositionDomain[k + 3] = llmax(fh.mPositionDomain[k + 3], face.mPositions[i][k]);
+            }
+            for (S32 k = 0; k < 2; ++k)
+            {
+                fh.mTexCoordDomain[k] = llmin(fh.mTexCoordDomain[k], face.mTexCoords[i].mV[k]);
+                fh.mTexCoordDomain[k + 2] = llmax(fh.mTexCoordDomain[k + 2], face.mTexCoords[i].mV[k]);
+            }
+        }
+        append_bytes(out, &fh, sizeof(fh));
+
+        const F32* pos_min = fh.mPositionDomain;
+        const F32 pos_range[3] = { fh.mPositionDomain[3] - pos_min[0], fh.mPositionDomain[4] - pos_min[1],
+                                   fh.mPositionDomain[5] - pos_min[2] };
+        for (S32 i = 0; i < num_verts; ++i)
+        {
+            const F32* p = face.mPositions[i].getF32ptr();
+            U16 q[3] = { quantize_u16(p[0], pos_min[0], pos_range[0]), quantize_u16(p[1], pos_min[1], pos_range[1]),
+                         quantize_u16(p[2], pos_min[2], pos_range[2]) };
+            append_bytes(out, q, sizeof(q));
+        }
+
+        for (S32 i = 0; i < num_verts; ++i)
+        {
+            const F32* n = face.mNormals[i].getF32ptr();
+            S16 q[3] = { quantize_s16(n[0]), quantize_s16(n[1]), quantize_s16(n[2]) };
+            append_bytes(out, q, sizeof(q));
+        }
+
+        const F32* tc_min = fh.mTexCoordDomain;
+        const F32 tc_range[2] = { fh.mTexCoordDomain[2] - tc_min[0], fh.mTexCoordDomain[3] - tc_min[1] };
+        for (S32 i = 0; i < num_verts; ++i)
+        {
+            const LLVector2& tc = face.mTexCoords[i];
+            U16 q[2] = { quantize_u16(tc.mV[VX], tc_min[0], tc_range[0]),
+                         quantize_u16(tc.mV[VY], tc_min[1], tc_range[1]) };
+            append_bytes(out, q, sizeof(q));
+        }
+
+        if (face.mTangents)
+        {
+            for (S32 i = 0; i < num_verts; ++i)
+            {
+                const F32* t = face.mTangents[i].getF32ptr();
+                S16 q[4] = { quantize_s16(t[0]), quantize_s16(t[1]), quantize_s16(t[2]), (S16) (t[3] < 0.f ? -1 : 1) };
+                append_bytes(out, q, sizeof(q));
+            }
+        }
+
+        if (face.mWeights)
+        {
+            // joint index plus influence, as unpackVolumeFaces() combines them
+            for (S32 i = 0; i < num_verts; ++i)
+            {
+                const F32* w = face.mWeights[i].getF32ptr();
+                U16 influences[4];
+                U8 joints[4];
+                for (S32 k = 0; k < 4; ++k)
+                {
+                    const S32 joint = llclamp((S32) floorf(w[k]), 0, 255);
+                    const F32 influence = w[k] - (F32) joint;
+                    influences[k] = (U16) llclamp(ll_round(influence * 65535.f), 0, 65535);
+                    if (influence > 0.f && !influences[k])
+                    {
+                        influences[k] = 1;
+                    }
+                    joints[k] = (U8) joint;
+                }
+                append_bytes(out, influences, sizeof(influences));
+                append_bytes(out, joints, sizeof(joints));
+            }
+        }
+
+        append_bytes(out, face.mIndices, sizeof(U16) * face.mNumIndices);
+    }
+
+    return true;
+}
+
+bool LLVolume::unpackDecodedVolumeFaces(const U8* in_data, S32 size)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
+
+    if (!in_data || size < (S32) sizeof(DecodedFacesHeader))
+    {
+        return false;
+    }
+
+    const U8* cur = in_data;
+    const U8* end = in_data + size;
+
+    DecodedFacesHeader header;
+    read_bytes(cur, end, &header, sizeof(header));
+    if (header.mMagic != DECODED_FACES_MAGIC
+        || header.mVersion != DECODED_FACES_VERSION
+        || header.mFaceCount == 0
+        || header.mFaceCount > (size_t(size) - sizeof(header)) / sizeof(DecodedFaceHeader))
+    {
+        return false;
+    }
+
+    face_list_t faces(header.mFaceCount);
+    for (LLVolumeFace& face : faces)
+    {
+        DecodedFaceHeader fh;
+        if (!read_bytes(cur, end, &fh, sizeof(fh))
+            || fh.mNumVertices < 0 || fh.mNumVertices > 65536
+            || fh.mNumIndices < 0 || fh.mNumIndices % 3 != 0)
+        {
+            return false;
+        }
+
+        const S32 num_verts = fh.mNumVertices;
+        const U8* positions;
+        const U8* normals;
+        const U8* texcoords;
+        if (!take_bytes(cur, end, DECODED_POSITION_SIZE * num_verts, positions)
+            || !take_bytes(cur, end, DECODED_NORMAL_SIZE * num_verts, normals)
+            || !take_bytes(cur, end, DECODED_TEXCOORD_SIZE * num_verts, texcoords))
+        {
+            return false;
+        }
+
+        const U8* tangents = NULL;
+        if ((fh.mFlags & DECODED_FACE_HAS_TANGENTS)
+            && !take_bytes(cur, end, DECODED_TANGENT_SIZE * num_verts, tangents))
+        {
+            return false;
+        }
+
+        const U8* weights = NULL;
+        if ((fh.mFlags & DECODED_FACE_HAS_WEIGHTS)
+            && !take_bytes(cur, end, DECODED_WEIGHT_SIZE * num_verts, weights))
+        {
+            return false;
+        }
+
+        face.resizeVertices(num_verts);
+        face.resizeIndices(fh.mNumIndices);
+        if ((num_verts && !face.mPositions) || (fh.mNumIndices && !face.mIndices))
+        {
+            LL_WARNS() << "Failed to allocate " << num_verts << " vertices for decoded face" << LL_ENDL;
+            return false;
+        }
+
+        const F32* pos_min = fh.mPositionDomain;
+        const F32 pos_range[3] = { fh.mPositionDomain[3] - pos_min[0], fh.mPositionDomain[4] - pos_min[1],
+                                   fh.mPositionDomain[5] - pos_min[2] };
+        const F32* tc_min = fh.mTexCoordDomain;
+        const F32 tc_range[2] = { fh.mTexCoordDomain[2] - tc_min[0], fh.mTexCoordDomain[3] - tc_min[1] };
+        for (S32 i = 0; i < num_verts; ++i)
+        {
+            U16 p[3];
+            memcpy(p, positions + i * DECODED_POSITION_SIZE, sizeof(p));
+            face.mPositions[i].set(dequantize_u16(p[0], pos_min[0], pos_range[0]),
+                                   dequantize_u16(p[1], pos_min[1], pos_range[1]),
+                                   dequantize_u16(p[2], pos_min[2], pos_range[2]));
+
+            S16 n[3];
+            memcpy(n, normals + i * DECODED_NORMAL_SIZE, sizeof(n));
+            face.mNormals[i].set(dequantize_s16(n[0]), dequantize_s16(n[1]), dequantize_s16(n[2]));
+
+            U16 tc[2];
+            memcpy(tc, texcoords + i * DECODED_TEXCOORD_SIZE, sizeof(tc));
+            face.mTexCoords[i].set(dequantize_u16(tc[0], tc_min[0], tc_range[0]),
+                                   dequantize_u16(tc[1], tc_min[1], tc_range[1]));
+        }
+
+        if (tangents)
+        {
+            face.allocateTangents(num_verts);
+            for (S32 i = 0; i < num_verts; ++i)
+            {
+                S16 t[4];
+                memcpy(t, tangents + i * DECODED_TANGENT_SIZE, sizeof(t));
+                face.mTangents[i].set(dequantize_s16(t[0]), dequantize_s16(t[1]), dequantize_s16(t[2]),
+                                      t[3] < 0 ? -1.f : 1.f);
+            }
+        }
+
+        if (weights)
+        {
+            face.allocateWeights(num_verts);
+            for (S32 i = 0; i < num_verts; ++i)
+            {
+                const U8* src = weights + i * DECODED_WEIGHT_SIZE;
+                U16 influences[4];
+                memcpy(influences, src, sizeof(influences));
+                const U8* joints = src + sizeof(influences);
+                F32 w[4];
+                for (S32 k = 0; k < 4; ++k)
+                {
+                    w[k] = (F32) joints[k]
+                        + (influences[k] ? llclamp((F32) influences[k] / 65535.f, 0.001f, 0.999f) : 0.f);
+                }
+                face.mWeights[i].loadua(w);
+            }
+        }
+
+        if (!read_bytes(cur, end, face.mIndices, sizeof(U16) * fh.mNumIndices))
+        {
+            return false;
+        }
+
+        for (S32 i = 0; i < fh.mNumIndices; ++i)
+        { // a stale or damaged entry must never index past the vertex buffer
+            if (face.mIndices[i] >= num_verts)
+            {
+                return false;
+            }
+        }
+
+        for (S32 i = 0; i < 3; ++i)
+        {
+            face.mExtents[i].loadua(fh.mExtents + i * 4);
+        }
+        face.mTexCoordExtents[0].set(fh.mTexCoordExtents[0], fh.mTexCoordExtents[1]);
+        face.mTexCoordExtents[1].set(fh.mTexCoordExtents[2], fh.mTexCoordExtents[3]);
+        face.mNormalizedScale.set(fh.mNormalizedScale[0], fh.mNormalizedScale[1], fh.mNormalizedScale[2]);
+        face.mOptimized = true;
+    }
+
+    if (cur != end)
+    {
+        return false;
+    }
+
+    mVolumeFaces.swap(faces);
+    mSculptLevel = 0;
+
+    return true;
+}
+
 
 bool LLVolume::isMeshAssetLoaded() const
 {
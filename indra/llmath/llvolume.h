@@ -1126,6 +1126,13 @@ protected:
 public:
     bool unpackVolumeFaces(std::istream& is, S32 size);
     bool unpackVolumeFaces(U8* in_data, S32 size);
+
+    // Flat, native endian dump of already unpacked and cache optimized
+    // volume faces, with the vertex attributes quantized about as finely
+    // as the mesh asset has them.  Reloading it skips zlib, LLSD, tangent
+    // generation and meshoptimizer entirely.  Not portable between machines.
+    bool packDecodedVolumeFaces(std::vector<U8>& out) const;
+    bool unpackDecodedVolumeFaces(const U8* in_data, S32 size);
 private:
     bool unpackVolumeFacesInternal(const LLSD& mdl);
 
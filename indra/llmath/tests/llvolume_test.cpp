@@ -0,0 +1,267 @@
+/**
+ * @file   llvolume_test.cpp
+ * @brief  Test for the decoded mesh face format in llvolume.cpp.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../test/lltut.h"
+
+#include "llsdserialize.h"
+#include "lltimer.h"
+#include "lluuid.h"
+
+#include "../llvolume.h"
+
+#include <iostream>
+
+namespace
+{
+    // Build a mesh LOD block the way the uploader encodes one:  zlib
+    // compressed LLSD with quantized positions, normals and UVs of a
+    // grid_size x grid_size grid per face.
+    std::string make_mesh_lod(S32 face_count, S32 grid_size)
+    {
+        LLSD mdl = LLSD::emptyArray();
+        for (S32 f = 0; f < face_count; ++f)
+        {
+            LLSD::Binary pos, norm, tc, idx, weights;
+            for (S32 y = 0; y < grid_size; ++y)
+            {
+                for (S32 x = 0; x < grid_size; ++x)
+                {
+                    U16 p[3] = { U16(x * 65535 / (grid_size - 1)), U16(y * 65535 / (grid_size - 1)), U16((x * y * 37 + f) & 0xffff) };
+                    U16 n[3] = { 32767, 32767, 65535 };
+                    U16 t[2] = { p[0], p[1] };
+                    pos.insert(pos.end(), (U8*) p, (U8*) p + sizeof(p));
+                    norm.insert(norm.end(), (U8*) n, (U8*) n + sizeof(n));
+                    tc.insert(tc.end(), (U8*) t, (U8*) t + sizeof(t));
+                    // two influences, then the end marker
+                    U8 w[7] = { U8(x % 3), 0x40, 0x9c, U8(3 + y % 5), 0xbf, 0x63, 0xff };
+                    weights.insert(weights.end(), w, w + sizeof(w));
+                }
+            }
+            for (S32 y = 0; y < grid_size - 1; ++y)
+            {
+                for (S32 x = 0; x < grid_size - 1; ++x)
+                {
+                    U16 i0 = U16(y * grid_size + x);
+                    U16 tri[6] = { i0, U16(i0 + 1), U16(i0 + grid_size),
+                                   U16(i0 + 1), U16(i0 + grid_size + 1), U16(i0 + grid_size) };
+                    idx.insert(idx.end(), (U8*) tri, (U8*) tri + sizeof(tri));
+                }
+            }
+
+            LLSD face;
+            face["Position"] = pos;
+            face["Normal"] = norm;
+            face["TexCoord0"] = tc;
+            face["TriangleList"] = idx;
+            face["Weights"] = weights;
+            face["PositionDomain"]["Min"] = LLVector3(-0.5f, -0.5f, -0.5f).getValue();
+            face["PositionDomain"]["Max"] = LLVector3(0.5f, 0.5f, 0.5f).getValue();
+            face["TexCoord0Domain"]["Min"] = LLVector2(0.f, 0.f).getValue();
+            face["TexCoord0Domain"]["Max"] = LLVector2(1.f, 1.f).getValue();
+            mdl.append(face);
+        }
+        return zip_llsd(mdl);
+    }
+
+    LLVolumeParams mesh_params()
+    {
+        LLVolumeParams params;
+        params.setType(LL_PCODE_PROFILE_SQUARE, LL_PCODE_PATH_LINE);
+        params.setSculptID(LLUUID::generateNewID(), LL_SCULPT_TYPE_MESH);
+        return params;
+    }
+
+    bool same_bytes(const void* a, const void* b, size_t bytes)
+    {
+        return (!a && !b) || (a && b && memcmp(a, b, bytes) == 0);
+    }
+
+    // the first floats_per_vertex floats of each of count vertices agree
+    // to within tolerance
+    bool close_floats(const F32* a, const F32* b, S32 count, S32 stride, S32 floats_per_vertex, F32 tolerance)
+    {
+        if (!a || !b)
+        {
+            return !a && !b;
+        }
+        for (S32 i = 0; i < count; ++i)
+        {
+            for (S32 k = 0; k < floats_per_vertex; ++k)
+            {
+                if (fabsf(a[i * stride + k] - b[i * stride + k]) > tolerance)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+namespace tut
+{
+    struct LLVolumeData
+    {
+    };
+
+    typedef test_group<LLVolumeData> factory;
+    typedef factory::object object;
+}
+
+namespace
+{
+    tut::factory llvolume_test_factory("LLVolume");
+}
+
+namespace tut
+{
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("Decoded faces round trip");
+
+        std::string lod = make_mesh_lod(2, 16);
+        LLVolumeParams params(mesh_params());
+
+        LLPointer<LLVolume> source = new LLVolume(params, 1.f);
+        ensure("unpack asset", source->unpackVolumeFaces((U8*) lod.data(), (S32) lod.size()));
+
+        std::vector<U8> decoded;
+        ensure("pack decoded", source->packDecodedVolumeFaces(decoded));
+
+        // at most 16 bytes a vertex, 36 with tangents and weights, where
+        // the faces themselves take 88
+        size_t vertex_bytes = 0;
+        for (S32 i = 0; i < source->getNumVolumeFaces(); ++i)
+        {
+            vertex_bytes += source->getVolumeFace(i).mNumVertices * (sizeof(LLVector4a) * 4 + sizeof(LLVector2));
+        }
+        ensure("quantized", decoded.size() * 2 < vertex_bytes);
+
+        LLPointer<LLVolume> restored = new LLVolume(params, 1.f);
+        ensure("unpack decoded", restored->unpackDecodedVolumeFaces(decoded.data(), (S32) decoded.size()));
+        ensure_equals("face count", restored->getNumVolumeFaces(), source->getNumVolumeFaces());
+
+        for (S32 i = 0; i < source->getNumVolumeFaces(); ++i)
+        {
+            const LLVolumeFace& a = source->getVolumeFace(i);
+            const LLVolumeFace& b = restored->getVolumeFace(i);
+            ensure_equals("vertex count", b.mNumVertices, a.mNumVertices);
+            ensure_equals("index count", b.mNumIndices, a.mNumIndices);
+            // quantized to 16 bits over at most a unit domain
+            const F32 tolerance = 1.f / 32767.f;
+            ensure("positions", close_floats(a.mPositions[0].getF32ptr(), b.mPositions[0].getF32ptr(),
+                                             a.mNumVertices, 4, 3, tolerance));
+            ensure("normals", close_floats(a.mNormals[0].getF32ptr(), b.mNormals[0].getF32ptr(),
+                                           a.mNumVertices, 4, 3, tolerance));
+            ensure("texcoords", close_floats(a.mTexCoords[0].mV, b.mTexCoords[0].mV, a.mNumVertices, 2, 2, tolerance));
+            ensure("tangents", close_floats(a.mTangents ? a.mTangents[0].getF32ptr() : NULL,
+                                            b.mTangents ? b.mTangents[0].getF32ptr() : NULL,
+                                            a.mNumVertices, 4, 4, tolerance));
+            ensure("weights", close_floats(a.mWeights ? a.mWeights[0].getF32ptr() : NULL,
+                                           b.mWeights ? b.mWeights[0].getF32ptr() : NULL,
+                                           a.mNumVertices, 4, 4, tolerance));
+            ensure("indices", same_bytes(a.mIndices, b.mIndices, sizeof(U16) * a.mNumIndices));
+            ensure("extents", same_bytes(a.mExtents, b.mExtents, sizeof(LLVector4a) * 2));
+            ensure("optimized", b.mOptimized);
+        }
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("Damaged decoded faces are rejected");
+
+        std::string lod = make_mesh_lod(1, 8);
+        LLVolumeParams params(mesh_params());
+
+        LLPointer<LLVolume> source = new LLVolume(params, 1.f);
+        ensure("unpack asset", source->unpackVolumeFaces((U8*) lod.data(), (S32) lod.size()));
+
+        std::vector<U8> decoded;
+        ensure("pack decoded", source->packDecodedVolumeFaces(decoded));
+
+        LLPointer<LLVolume> restored = new LLVolume(params, 1.f);
+        ensure("truncated", !restored->unpackDecodedVolumeFaces(decoded.data(), (S32) decoded.size() - 1));
+
+        std::vector<U8> bad_magic(decoded);
+        bad_magic[0] ^= 0xff;
+        ensure("bad magic", !restored->unpackDecodedVolumeFaces(bad_magic.data(), (S32) bad_magic.size()));
+
+        // last index of the face points past the vertex buffer
+        std::vector<U8> bad_index(decoded);
+        U16 out_of_range = 0xffff;
+        memcpy(&bad_index[bad_index.size() - sizeof(U16)], &out_of_range, sizeof(U16));
+        ensure("bad index", !restored->unpackDecodedVolumeFaces(bad_index.data(), (S32) bad_index.size()));
+
+        ensure("empty", !restored->unpackDecodedVolumeFaces(NULL, 0));
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("Mesh LOD reload benchmark");
+
+        // Not a pass/fail test.  Reports what a revisit costs with the
+        // asset format (zlib, LLSD, dequantize, tangents, cache optimize)
+        // and with the decoded format.
+        if (! getenv("LL_TEST_BENCHMARKS"))
+        {
+            skip("set LL_TEST_BENCHMARKS to run the benchmark");
+        }
+
+        const S32 reloads(20);
+        std::string lod = make_mesh_lod(4, 64);
+        LLVolumeParams params(mesh_params());
+
+        std::vector<U8> decoded;
+        U64 start(LLTimer::getTotalTime());
+        for (S32 i = 0; i < reloads; ++i)
+        {
+            LLPointer<LLVolume> volume = new LLVolume(params, 1.f);
+            ensure("unpack asset", volume->unpackVolumeFaces((U8*) lod.data(), (S32) lod.size()));
+            if (decoded.empty())
+            {
+                volume->packDecodedVolumeFaces(decoded);
+            }
+        }
+        const U64 asset_time(LLTimer::getTotalTime() - start);
+
+        start = LLTimer::getTotalTime();
+        for (S32 i = 0; i < reloads; ++i)
+        {
+            LLPointer<LLVolume> volume = new LLVolume(params, 1.f);
+            ensure("unpack decoded", volume->unpackDecodedVolumeFaces(decoded.data(), (S32) decoded.size()));
+        }
+        const U64 decoded_time(LLTimer::getTotalTime() - start);
+
+        std::cout << "Mesh LOD reload x" << reloads << ":  asset " << lod.size() << " bytes "
+                  << asset_time << " uS, decoded " << decoded.size() << " bytes "
+                  << decoded_time << " uS" << std::endl;
+    }
+}
@@ -30,6 +30,7 @@
 #include "message.h" // TODO: babbage: Remove...
 #include "llstl.h"
 #include "llindexedvector.h"
+#include "llframeprofiler.h"
 
 #include "nd/ndexceptions.h" // <FS:ND/> For ndxran
 
@@ -365,9 +366,13 @@ public:
 
     bool callHandlerFunc(LLMessageSystem *msgsystem) const
     {
-        LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+        LL_PROFILE_ZONE_NAMED_CATEGORY_NETWORK("Message handler");
         if (mHandlerFunc)
         {
+            // mName comes from the message string table and lives as long as
+            // the viewer, so frame spike reports can name the message
+            LLFrameProfiler::Zone message_zone(mName);
+
 
             // <FS:ND> Handle invalid packets by throwing an exception and a graceful continue
 
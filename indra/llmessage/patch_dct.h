@@ -89,6 +89,9 @@ void get_patch_group_header(LLGroupHeader *gopp);
 void set_group_of_patch_header(LLGroupHeader *gopp);
 void init_patch_decompressor(S32 size);
 void decompress_patch(F32 *patch, S32 *cpatch, LLPatchHeader *ph);
+// With an explicit group header, safe to call from worker threads.  simd
+// false runs the original scalar IDCT, to check the SIMD one against.
+void decompress_patch(F32 *patch, S32 *cpatch, LLPatchHeader *ph, const LLGroupHeader *gopp, bool simd = true);
 void decompress_patchv(LLVector3 *v, S32 *cpatch, LLPatchHeader *ph);
 
 #endif
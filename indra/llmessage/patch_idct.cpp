@@ -52,7 +52,7 @@ void build_patch_dequantize_table(S32 size)
 
 S32 gCurrentDeSize = 0;
 
-F32 gPatchICosines[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE];
+LL_ALIGN_16(F32 gPatchICosines[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE]);
 
 void setup_patch_icosines(S32 size)
 {
@@ -585,16 +585,91 @@ inline void idct_patch_large(F32 *block)
     idct_line_large_slow(temp, block, 31);
 }
 
+// The same sums as idct_patch() and idct_patch_large(), four outputs at a
+// time: the column pass adds up whole rows of coefficients scaled by one
+// cosine, the line pass splats one coefficient over four cosines.  The
+// terms are added in the same order as the scalar code.
+void idct_patch_simd(F32 *block, S32 size)
+{
+    LL_ALIGN_16(F32 temp[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE]);
+    const S32 quads = size/4;
+    const F32 *pcp = gPatchICosines;
+    LLVector4a acc[LARGE_PATCH_SIZE/4];
+    LLVector4a t, c, oo_sqrt2;
+    oo_sqrt2.splat(OO_SQRT2);
+
+    // columns: temp[n][col] = sum over u of block[u][col]*cos[u][n]
+    for (S32 n = 0; n < size; n++)
+    {
+        for (S32 q = 0; q < quads; q++)
+        {
+            acc[q].load4a(block + q*4);
+            acc[q].mul(oo_sqrt2);
+        }
+        for (S32 u = 1; u < size; u++)
+        {
+            c.splat(pcp[u*size + n]);
+            const F32 *row = block + u*size;
+            for (S32 q = 0; q < quads; q++)
+            {
+                t.load4a(row + q*4);
+                t.mul(c);
+                acc[q].add(t);
+            }
+        }
+        for (S32 q = 0; q < quads; q++)
+        {
+            acc[q].store4a(temp + n*size + q*4);
+        }
+    }
+
+    // lines: block[line][n] = sum over u of temp[line][u]*cos[u][n]
+    LLVector4a oosob;
+    oosob.splat(2.f/size);
+    for (S32 line = 0; line < size; line++)
+    {
+        const F32 *linein = temp + line*size;
+        c.splat(OO_SQRT2*linein[0]);
+        for (S32 q = 0; q < quads; q++)
+        {
+            acc[q] = c;
+        }
+        for (S32 u = 1; u < size; u++)
+        {
+            c.splat(linein[u]);
+            const F32 *cosines = pcp + u*size;
+            for (S32 q = 0; q < quads; q++)
+            {
+                t.load4a(cosines + q*4);
+                t.mul(c);
+                acc[q].add(t);
+            }
+        }
+        for (S32 q = 0; q < quads; q++)
+        {
+            acc[q].mul(oosob);
+            acc[q].store4a(block + line*size + q*4);
+        }
+    }
+}
+
 S32 gDitherNoise = 128;
 
 void decompress_patch(F32 *patch, S32 *cpatch, LLPatchHeader *ph)
+{
+    decompress_patch(patch, cpatch, ph, gGOPP);
+}
+
+// Only reads the tables init_patch_decompressor() built: nobody may call it
+// while patches are being decompressed on other threads.
+void decompress_patch(F32 *patch, S32 *cpatch, LLPatchHeader *ph, const LLGroupHeader *gopp, bool simd)
 {
     S32     i, j;
 
-    F32     block[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE], *tblock = block;
+    LL_ALIGN_16(F32 block[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE]);
+    F32     *tblock = block;
     F32     *tpatch;
 
-    LLGroupHeader   *gopp = gGOPP;
     S32     size = gopp->patch_size;
     F32     range = ph->range;
     S32     prequant = (ph->quant_wbits >> 4) + 2;
@@ -614,7 +689,11 @@ void decompress_patch(F32 *patch, S32 *cpatch, LLPatchHeader *ph)
         *(tblock++) = *(cpatch + *(decopy_matrix++))*(*dq++);
     }
 
-    if (size == 16)
+    if (simd)
+    {
+        idct_patch_simd(block, size);
+    }
+    else if (size == 16)
     {
         idct_patch(block);
     }
@@ -639,7 +718,8 @@ void decompress_patchv(LLVector3 *v, S32 *cpatch, LLPatchHeader *ph)
 {
     S32     i, j;
 
-    F32         block[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE], *tblock = block;
+    LL_ALIGN_16(F32 block[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE]);
+    F32         *tblock = block;
     LLVector3   *tvec;
 
     LLGroupHeader   *gopp = gGOPP;
@@ -665,10 +745,7 @@ void decompress_patchv(LLVector3 *v, S32 *cpatch, LLPatchHeader *ph)
         *(tblock++) = *(cpatch + *(decopy_matrix++))*(*dq++);
     }
 
-    if (size == 16)
-        idct_patch(block);
-    else
-        idct_patch_large(block);
+    idct_patch_simd(block, size);
 
     for (j = 0; j < size; j++)
     {
@@ -680,4 +757,3 @@ void decompress_patchv(LLVector3 *v, S32 *cpatch, LLPatchHeader *ph)
         }
     }
 }
-
@@ -0,0 +1,195 @@
+/**
+ * @file   patch_dct_test.cpp
+ * @brief  Test for the terrain patch decompressor in patch_dct.h.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "../patch_dct.h"
+// STL headers
+#include <vector>
+// std headers
+// external library headers
+// other Linden headers
+#include "../patch_code.h"
+#include "llbitpack.h"
+#include "llmath.h"
+#include "lltut.h"
+
+namespace
+{
+    const S32 PATCHES_PER_EDGE = 16;                                // a 256m region
+    const S32 GRIDS_PER_EDGE = PATCHES_PER_EDGE * NORMAL_PATCH_SIZE + 1;
+    const S32 PATCHES_PER_PACKET = 4;
+    const S32 PACKET_BUFFER_SIZE = 64 * 1024;
+
+    // rolling hills with a cliff and some rough ground
+    F32 height(S32 x, S32 y)
+    {
+        F32 z = 20.f + 8.f * sinf(0.05f * x) * cosf(0.07f * y) + 3.f * sinf(0.3f * (x + y));
+        if (x > 180)
+        {
+            z += 15.f;
+        }
+        z += 0.25f * (F32)((x * 7919 + y * 104729) % 17) / 17.f;
+        return z;
+    }
+
+    // The bit stream of a LayerData packet: the region's patches, several
+    // to a packet, packed the way the simulator does.
+    struct LayerDataPacket
+    {
+        std::vector<U8> mData;
+        S32 mSize = 0;
+    };
+
+    void make_layer_data(std::vector<LayerDataPacket>& packets)
+    {
+        std::vector<F32> heights(GRIDS_PER_EDGE * GRIDS_PER_EDGE);
+        for (S32 y = 0; y < GRIDS_PER_EDGE; ++y)
+        {
+            for (S32 x = 0; x < GRIDS_PER_EDGE; ++x)
+            {
+                heights[y * GRIDS_PER_EDGE + x] = height(x, y);
+            }
+        }
+
+        init_patch_compressor(NORMAL_PATCH_SIZE, GRIDS_PER_EDGE, 'L');
+        LLGroupHeader group_header;
+        get_patch_group_header(&group_header);
+
+        S32 cpatch[LARGE_PATCH_SIZE * LARGE_PATCH_SIZE];
+        for (S32 first = 0; first < PATCHES_PER_EDGE * PATCHES_PER_EDGE; first += PATCHES_PER_PACKET)
+        {
+            packets.emplace_back();
+            LayerDataPacket& packet = packets.back();
+            packet.mData.resize(PACKET_BUFFER_SIZE);
+            LLBitPack bitpack(packet.mData.data(), PACKET_BUFFER_SIZE);
+            init_patch_coding(bitpack);
+            code_patch_group_header(bitpack, &group_header);
+            for (S32 n = first; n < first + PATCHES_PER_PACKET; ++n)
+            {
+                const S32 i = n % PATCHES_PER_EDGE, j = n / PATCHES_PER_EDGE;
+                F32* patch = &heights[j * NORMAL_PATCH_SIZE * GRIDS_PER_EDGE + i * NORMAL_PATCH_SIZE];
+                LLPatchHeader ph;
+                F32 zmax, zmin;
+                prescan_patch(patch, &ph, zmax, zmin);
+                ph.patchids = (i << 5) | j;
+                compress_patch(patch, cpatch, &ph, 10);
+                code_patch_header(bitpack, &ph, cpatch);
+                code_patch(bitpack, cpatch, 0);
+            }
+            code_end_of_data(bitpack);
+            end_patch_coding(bitpack);
+            packet.mSize = bitpack.mBufferSize;
+        }
+    }
+
+    // What LLSurface::decompressDCTPatch() does with a packet, into heights
+    void decompress_layer_data(const LayerDataPacket& packet, F32* heights, bool simd)
+    {
+        LLBitPack bitpack(const_cast<U8*>(packet.mData.data()), packet.mSize);
+        init_patch_decoding(bitpack);
+        LLGroupHeader group_header;
+        decode_patch_group_header(bitpack, &group_header);
+        init_patch_decompressor(group_header.patch_size);
+        group_header.stride = GRIDS_PER_EDGE;
+
+        S32 cpatch[LARGE_PATCH_SIZE * LARGE_PATCH_SIZE];
+        while (true)
+        {
+            LLPatchHeader ph;
+            decode_patch_header(bitpack, &ph, false);
+            if (ph.quant_wbits == END_OF_PATCHES)
+            {
+                break;
+            }
+            const S32 i = ph.patchids >> 5, j = ph.patchids & 0x1F;
+            decode_patch(bitpack, cpatch);
+            decompress_patch(heights + j * NORMAL_PATCH_SIZE * GRIDS_PER_EDGE + i * NORMAL_PATCH_SIZE, cpatch, &ph,
+                             &group_header, simd);
+        }
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct patch_dct_data
+    {
+        std::vector<LayerDataPacket> mPackets;
+
+        patch_dct_data()
+        {
+            make_layer_data(mPackets);
+        }
+    };
+    typedef test_group<patch_dct_data> patch_dct_group;
+    typedef patch_dct_group::object object;
+    patch_dct_group patch_dctgrp("patch_dct");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("LayerData heightfield same as with the scalar IDCT");
+
+        std::vector<F32> scalar(GRIDS_PER_EDGE * GRIDS_PER_EDGE, 0.f);
+        std::vector<F32> simd(GRIDS_PER_EDGE * GRIDS_PER_EDGE, 0.f);
+        for (const LayerDataPacket& packet : mPackets)
+        {
+            decompress_layer_data(packet, scalar.data(), false);
+            decompress_layer_data(packet, simd.data(), true);
+        }
+
+        for (S32 y = 0; y < GRIDS_PER_EDGE - 1; ++y)
+        {
+            for (S32 x = 0; x < GRIDS_PER_EDGE - 1; ++x)
+            {
+                const S32 k = y * GRIDS_PER_EDGE + x;
+                ensure_distance(llformat("height at %d, %d", x, y), simd[k], scalar[k], 1.e-3f);
+                // and both are what was sent, give or take the quantization
+                ensure_distance(llformat("decoded at %d, %d", x, y), scalar[k], height(x, y), 1.f);
+            }
+        }
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("32x32 patches same as with the scalar IDCT");
+
+        LLGroupHeader group_header;
+        group_header.patch_size = LARGE_PATCH_SIZE;
+        group_header.stride = LARGE_PATCH_SIZE;
+        group_header.layer_type = 'L';
+        init_patch_decompressor(LARGE_PATCH_SIZE);
+
+        // coefficients as decode_patch() leaves them, mostly in the low
+        // frequencies
+        S32 cpatch[LARGE_PATCH_SIZE * LARGE_PATCH_SIZE];
+        for (S32 i = 0; i < LARGE_PATCH_SIZE * LARGE_PATCH_SIZE; ++i)
+        {
+            cpatch[i] = (i < 160) ? ((i * 37) % 41) - 20 : 0;
+        }
+        LLPatchHeader ph;
+        ph.dc_offset = 12.f;
+        ph.range = 40;
+        ph.quant_wbits = (8 << 4) | 8;
+        ph.patchids = 0;
+
+        F32 scalar[LARGE_PATCH_SIZE * LARGE_PATCH_SIZE], simd[LARGE_PATCH_SIZE * LARGE_PATCH_SIZE];
+        decompress_patch(scalar, cpatch, &ph, &group_header, false);
+        decompress_patch(simd, cpatch, &ph, &group_header, true);
+        for (S32 i = 0; i < LARGE_PATCH_SIZE * LARGE_PATCH_SIZE; ++i)
+        {
+            ensure_distance(llformat("height %d", i), simd[i], scalar[i], 1.e-3f);
+        }
+    }
+} // namespace tut
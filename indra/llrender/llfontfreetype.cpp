@@ -43,6 +43,7 @@
 
 #include "lldir.h"
 #include "llerror.h"
+#include "llfile.h"
 #include "llimage.h"
 #include "llimagepng.h"
 //#include "llimagej2c.h"
@@ -53,6 +54,9 @@
 #include "llgl.h"
 
 #include "llapr.h"
+#include "hbxxh.h"
+#include "lltimer.h"
+#include "lltrace.h"
 
 #define ENABLE_OT_SVG_SUPPORT
 
@@ -60,8 +64,129 @@ FT_Render_Mode gFontRenderMode = FT_RENDER_MODE_NORMAL;
 
 LLFontManager *gFontManagerp = NULL;
 
+std::string LLFontFreetype::sGlyphCacheDir;
+
+static LLTrace::CountStatHandle<> sGlyphsRasterized("fontglyphsrasterized", "Glyphs rasterized by FreeType");
+static LLTrace::CountStatHandle<> sGlyphsCached("fontglyphscached", "Glyphs read from the glyph cache rather than rasterized");
+static LLTrace::EventStatHandle<F64Milliseconds> sGlyphWaitTime("fontglyphwait", "Time text waited for its new glyphs to be rasterized");
+
 FT_Library gFTLibrary = NULL;
 
+namespace
+{
+    // On-disk glyph cache, see LLFontFreetype::saveGlyphCache()
+    const U32 GLYPH_CACHE_MAGIC = 0x48504c47;   // "GLPH"
+    const U32 GLYPH_CACHE_VERSION = 1;
+    // Glyphs saved for one font, those used in the session first
+    const size_t GLYPH_CACHE_MAX_GLYPHS = 4096;
+    // All entries, see LLFontFreetype::trimGlyphCache()
+    const S64 GLYPH_CACHE_MAX_BYTES = 32 * 1024 * 1024;
+
+    struct GlyphCacheHeader
+    {
+        U32 mMagic;
+        U32 mVersion;
+        U64 mKey;
+        U32 mBitmapCount;   // distinct glyph bitmaps, each followed by its pixels
+        U32 mGlyphCount;
+    };
+
+    // A glyph bitmap, rows as they are in the bitmap cache images: alpha
+    // only for grayscale ones, 4 bytes a pixel for color ones
+    struct CachedBitmap
+    {
+        U32 mBitmapType;
+        S32 mWidth;
+        S32 mHeight;
+    };
+
+    struct CachedGlyph
+    {
+        U32 mChar;
+        U32 mGlyphIndex;
+        U32 mGlyphType;
+        U32 mBitmap;        // index of its CachedBitmap
+        S32 mXBearing;
+        S32 mYBearing;
+        F32 mXAdvance;
+        F32 mYAdvance;
+    };
+
+    bool read_bytes(const U8*& cur, const U8* end, void* dst, size_t bytes)
+    {
+        if (size_t(end - cur) < bytes)
+        {
+            return false;
+        }
+        memcpy(dst, cur, bytes);
+        cur += bytes;
+        return true;
+    }
+
+    void append_bytes(std::vector<U8>& out, const void* src, size_t bytes)
+    {
+        const U8* bytes_begin = (const U8*)src;
+        out.insert(out.end(), bytes_begin, bytes_begin + bytes);
+    }
+
+    // bytes of a glyph's pixels in the cache, and in the bitmap images
+    U32 cached_pixel_size(EFontGlyphType bitmap_type)
+    {
+        return (EFontGlyphType::Color == bitmap_type) ? 4 : 1;
+    }
+
+    void copy_glyph_pixels(LLImageRaw* image_raw, EFontGlyphType bitmap_type, S32 x, S32 y, S32 width, S32 height,
+                           U8* cached, bool to_image)
+    {
+        const S32 components = image_raw->getComponents();
+        const U32 pixel_size = cached_pixel_size(bitmap_type);
+        // the alpha of luminance-alpha grayscale bitmaps, see setSubImageLuminanceAlpha()
+        const S32 first_component = (EFontGlyphType::Color == bitmap_type) ? 0 : components - 1;
+        U8* data = image_raw->getData();
+        for (S32 row = 0; row < height; ++row)
+        {
+            U8* image_row = data + ((y + row) * image_raw->getWidth() + x) * components + first_component;
+            U8* cached_row = cached + row * width * pixel_size;
+            for (S32 col = 0; col < width; ++col)
+            {
+                U8* image_pixel = image_row + col * components;
+                U8* cached_pixel = cached_row + col * pixel_size;
+                if (to_image)
+                {
+                    memcpy(image_pixel, cached_pixel, pixel_size);
+                }
+                else
+                {
+                    memcpy(cached_pixel, image_pixel, pixel_size);
+                }
+            }
+        }
+    }
+}
+
+// A glyph cache entry as read: its glyphs go in the bitmap cache when first
+// asked for, the others are saved again with the glyphs used
+struct LLFontFreetype::GlyphCacheEntry
+{
+    struct Bitmap
+    {
+        EFontGlyphType mBitmapType;
+        S32 mWidth;
+        S32 mHeight;
+        size_t mOffset;         // of its pixels in mContents
+        bool mPlaced = false;
+        U32 mBitmapNum = 0;
+        S32 mX = 0;
+        S32 mY = 0;
+    };
+
+    std::string mContents;
+    std::vector<Bitmap> mBitmaps;
+    std::vector<CachedGlyph> mGlyphs;
+    std::vector<bool> mGlyphPlaced;
+    boost::unordered_multimap<llwchar, U32> mGlyphIndices;
+};
+
 //static
 void LLFontManager::initClass()
 {
@@ -149,8 +274,16 @@ LLFontFreetype::LLFontFreetype()
     mIsFallback(false),
     mFTFace(NULL),
     mRenderGlyphCount(0),
+    mGlyphGeneration(0),
+    mGlyphBatchDepth(0),
+    mUseGlyphCache(false),
+    mGlyphCacheRead(false),
     mStyle(0),
-    mPointSize(0)
+    mPointSize(0),
+    mVertDPI(0.f),
+    mHorzDPI(0.f),
+    mFaceIndex(0),
+    mFontHash(0)
 {
     // <FS:ND> Set up kerning cache, size is 256x256, the initial cache lines are all null
     mKerningCache = new F32*[ 256 ];
@@ -301,6 +434,10 @@ bool LLFontFreetype::loadFace(const std::string& filename, F32 point_size, F32 v
 
     mName = filename;
     mPointSize = point_size;
+    mVertDPI = vert_dpi;
+    mHorzDPI = horz_dpi;
+    mFaceIndex = face_n;
+    mFontHash = gFontManagerp->getFontHash(filename);
 
     mStyle = LLFontGL::NORMAL;
     if(mFTFace->style_flags & FT_STYLE_FLAG_BOLD)
@@ -554,6 +691,11 @@ LLFontGlyphInfo* LLFontFreetype::addGlyph(llwchar wch, EFontGlyphType glyph_type
     llassert(glyph_type < EFontGlyphType::Count);
     //LL_DEBUGS() << "Adding new glyph for " << wch << " to font" << LL_ENDL;
 
+    if (LLFontGlyphInfo* gi = addCachedGlyph(wch, glyph_type))
+    {
+        return gi;
+    }
+
     // Initialize char to glyph map
     FT_UInt glyph_index = FT_Get_Char_Index(mFTFace, wch);
     if (glyph_index == 0)
@@ -749,41 +891,105 @@ LLFontGlyphInfo* LLFontFreetype::addGlyphFromFont(const LLFontFreetype *fontp, l
         llassert(false);
     }
 
-    LLImageGL *image_gl = mFontBitmapCachep->getImageGL(bitmap_glyph_type, bitmap_num);
-    LLImageRaw *image_raw = mFontBitmapCachep->getImageRaw(bitmap_glyph_type, bitmap_num);
-    if (image_gl && image_raw)
+    LLTrace::add(sGlyphsRasterized, 1);
+
+    // The whole bitmap goes to GL, so a batch uploads it once at the end
+    const std::pair<EFontGlyphType, U32> bitmap(bitmap_glyph_type, bitmap_num);
+    if (std::find(mDirtyBitmaps.begin(), mDirtyBitmaps.end(), bitmap) == mDirtyBitmaps.end())
     {
-        image_gl->setSubImage(image_raw, 0, 0, image_gl->getWidth(), image_gl->getHeight());
+        mDirtyBitmaps.push_back(bitmap);
     }
-    else
+    if (!mGlyphBatchDepth)
     {
-        llassert(false); //images were just inserted by nextOpenPos, they shouldn't be missing
+        uploadBitmaps();
     }
 
     return gi;
 }
 
-LLFontGlyphInfo* LLFontFreetype::getGlyphInfo(llwchar wch, EFontGlyphType glyph_type) const
+LLFontGlyphInfo* LLFontFreetype::findGlyphInfo(llwchar wch, EFontGlyphType glyph_type) const
 {
     std::pair<char_glyph_info_map_t::iterator, char_glyph_info_map_t::iterator> range_it = mCharGlyphInfoMap.equal_range(wch);
 
     char_glyph_info_map_t::iterator iter = (EFontGlyphType::Unspecified != glyph_type)
         ? std::find_if(range_it.first, range_it.second, [&glyph_type](const char_glyph_info_map_t::value_type& entry) { return entry.second->mGlyphType == glyph_type; })
         : range_it.first;
-    if (iter != range_it.second)
+    return (iter != range_it.second) ? iter->second : NULL;
+}
+
+LLFontGlyphInfo* LLFontFreetype::getGlyphInfo(llwchar wch, EFontGlyphType glyph_type) const
+{
+    LLFontGlyphInfo* gi = findGlyphInfo(wch, glyph_type);
+    if (gi)
     {
-        return iter->second;
+        return gi;
     }
     else
     {
         // this glyph doesn't yet exist, so render it and return the result
-        return addGlyph(wch, (EFontGlyphType::Unspecified != glyph_type) ? glyph_type : EFontGlyphType::Grayscale);
+        LLTimer wait_timer;
+        gi = addGlyph(wch, (EFontGlyphType::Unspecified != glyph_type) ? glyph_type : EFontGlyphType::Grayscale);
+        LLTrace::record(sGlyphWaitTime, F64Milliseconds(wait_timer.getElapsedTimeF64() * 1000.0));
+        return gi;
+    }
+}
+
+void LLFontFreetype::addGlyphs(const llwchar* wchars, S32 count, EFontGlyphType glyph_type) const
+{
+    if (!mFTFace || !wchars)
+    {
+        return;
+    }
+
+    // nothing to do, or time, unless a glyph is missing
+    S32 first = 0;
+    while (first < count && findGlyphInfo(wchars[first], glyph_type))
+    {
+        ++first;
+    }
+    if (first == count)
+    {
+        return;
+    }
+
+    LLTimer wait_timer;
+    ++mGlyphBatchDepth;
+    for (S32 i = first; i < count; ++i)
+    {
+        if (i == first || !findGlyphInfo(wchars[i], glyph_type))
+        {
+            addGlyph(wchars[i], (EFontGlyphType::Unspecified != glyph_type) ? glyph_type : EFontGlyphType::Grayscale);
+        }
+    }
+    --mGlyphBatchDepth;
+
+    LL_PROFILE_ZONE_NAMED("addGlyphs upload");
+    uploadBitmaps();
+    LLTrace::record(sGlyphWaitTime, F64Milliseconds(wait_timer.getElapsedTimeF64() * 1000.0));
+}
+
+void LLFontFreetype::uploadBitmaps() const
+{
+    for (const std::pair<EFontGlyphType, U32>& entry : mDirtyBitmaps)
+    {
+        LLImageGL *image_gl = mFontBitmapCachep->getImageGL(entry.first, entry.second);
+        LLImageRaw *image_raw = mFontBitmapCachep->getImageRaw(entry.first, entry.second);
+        if (image_gl && image_raw)
+        {
+            image_gl->setSubImage(image_raw, 0, 0, image_gl->getWidth(), image_gl->getHeight());
+        }
+        else
+        {
+            llassert(false); //images were inserted by nextOpenPos, they shouldn't be missing
+        }
     }
+    mDirtyBitmaps.clear();
 }
 
 void LLFontFreetype::insertGlyphInfo(llwchar wch, LLFontGlyphInfo* gi) const
 {
     llassert(gi->mGlyphType < EFontGlyphType::Count);
+    ++mGlyphGeneration;
     std::pair<char_glyph_info_map_t::iterator, char_glyph_info_map_t::iterator> range_it = mCharGlyphInfoMap.equal_range(wch);
 
     char_glyph_info_map_t::iterator iter =
@@ -799,6 +1005,377 @@ void LLFontFreetype::insertGlyphInfo(llwchar wch, LLFontGlyphInfo* gi) const
     }
 }
 
+// static
+void LLFontFreetype::setGlyphCacheDir(const std::string& dir)
+{
+    sGlyphCacheDir = dir;
+}
+
+std::string LLFontFreetype::getGlyphCacheFilename(U64& key) const
+{
+    // Everything the bitmaps and metrics depend on: the font files, by
+    // their contents, the size and the render mode.  Glyphs come from the
+    // fallbacks too.
+    std::string key_string = llformat("%016llx %d %.3f %.3f %.3f %d", (unsigned long long)mFontHash, mFaceIndex,
+                                      mPointSize, mVertDPI, mHorzDPI, (S32)gFontRenderMode);
+    for (const fallback_font_t& fallback : mFallbackFonts)
+    {
+        key_string += llformat(" %016llx %d %.3f", (unsigned long long)fallback.first->mFontHash,
+                               fallback.first->mFaceIndex, fallback.first->mPointSize);
+    }
+    key = HBXXH64::digest(key_string);
+    return sGlyphCacheDir + gDirUtilp->getDirDelimiter() + llformat("glyphs_%016llx.bin", (unsigned long long)key);
+}
+
+void LLFontFreetype::useGlyphCache()
+{
+    mUseGlyphCache = true;
+}
+
+void LLFontFreetype::readGlyphCache() const
+{
+    mGlyphCacheRead = true;
+    if (sGlyphCacheDir.empty() || mIsFallback || !mFTFace || !mFontHash)
+    {
+        return;
+    }
+
+    LL_PROFILE_ZONE_SCOPED;
+
+    U64 key;
+    const std::string filename = getGlyphCacheFilename(key);
+    std::unique_ptr<GlyphCacheEntry> entry(new GlyphCacheEntry);
+    entry->mContents = LLFile::getContents(filename);
+    if (entry->mContents.empty())
+    {
+        return;
+    }
+
+    const U8* begin = (const U8*)entry->mContents.data();
+    const U8* cur = begin;
+    const U8* end = cur + entry->mContents.size();
+    GlyphCacheHeader header;
+    if (!read_bytes(cur, end, &header, sizeof(header))
+        || header.mMagic != GLYPH_CACHE_MAGIC
+        || header.mVersion != GLYPH_CACHE_VERSION
+        || header.mKey != key)
+    {
+        LL_DEBUGS("Font") << "Ignoring out of date glyph cache " << filename << LL_ENDL;
+        return;
+    }
+
+    // Only checked here: the pixels are copied out when a glyph is placed
+    bool valid = true;
+    entry->mBitmaps.reserve(header.mBitmapCount);
+    for (U32 i = 0; valid && i < header.mBitmapCount; ++i)
+    {
+        CachedBitmap bitmap;
+        if (!read_bytes(cur, end, &bitmap, sizeof(bitmap))
+            || bitmap.mBitmapType >= (U32)EFontGlyphType::Count
+            || bitmap.mWidth < 0 || bitmap.mHeight < 0)
+        {
+            valid = false;
+            break;
+        }
+        const EFontGlyphType bitmap_type = (EFontGlyphType)bitmap.mBitmapType;
+        const size_t bytes = (size_t)bitmap.mWidth * bitmap.mHeight * cached_pixel_size(bitmap_type);
+        if (size_t(end - cur) < bytes)
+        {
+            valid = false;
+            break;
+        }
+        GlyphCacheEntry::Bitmap entry_bitmap;
+        entry_bitmap.mBitmapType = bitmap_type;
+        entry_bitmap.mWidth = bitmap.mWidth;
+        entry_bitmap.mHeight = bitmap.mHeight;
+        entry_bitmap.mOffset = cur - begin;
+        entry->mBitmaps.push_back(entry_bitmap);
+        cur += bytes;
+    }
+
+    entry->mGlyphs.reserve(header.mGlyphCount);
+    for (U32 i = 0; valid && i < header.mGlyphCount; ++i)
+    {
+        CachedGlyph glyph;
+        if (!read_bytes(cur, end, &glyph, sizeof(glyph))
+            || glyph.mGlyphType >= (U32)EFontGlyphType::Count
+            || glyph.mBitmap >= entry->mBitmaps.size())
+        {
+            valid = false;
+            break;
+        }
+        entry->mGlyphIndices.insert(std::make_pair((llwchar)glyph.mChar, (U32)entry->mGlyphs.size()));
+        entry->mGlyphs.push_back(glyph);
+    }
+
+    if (!valid || cur != end)
+    {
+        LL_WARNS("Font") << "Glyph cache " << filename << " is damaged, removing it" << LL_ENDL;
+        LLFile::remove(filename);
+        return;
+    }
+
+    entry->mGlyphPlaced.resize(entry->mGlyphs.size(), false);
+    LL_DEBUGS("Font") << "Read " << entry->mGlyphs.size() << " glyphs of " << mName << " from " << filename << LL_ENDL;
+    mGlyphCacheEntry = std::move(entry);
+}
+
+LLFontGlyphInfo* LLFontFreetype::addCachedGlyph(llwchar wch, EFontGlyphType glyph_type) const
+{
+    if (!mUseGlyphCache)
+    {
+        return NULL;
+    }
+    if (!mGlyphCacheRead)
+    {
+        readGlyphCache();
+    }
+    if (!mGlyphCacheEntry)
+    {
+        return NULL;
+    }
+
+    GlyphCacheEntry& entry = *mGlyphCacheEntry;
+    auto range_it = entry.mGlyphIndices.equal_range(wch);
+    auto wanted = std::find_if(range_it.first, range_it.second,
+                               [&entry, glyph_type](const std::pair<const llwchar, U32>& index)
+                               {
+                                   return entry.mGlyphs[index.second].mGlyphType == (U32)glyph_type
+                                       && !entry.mGlyphPlaced[index.second];
+                               });
+    if (wanted == range_it.second)
+    {
+        return NULL;
+    }
+
+    // Bitmaps go where new glyphs would, so a bad entry can only leave some
+    // unused space behind
+    const U32 bitmap_index = entry.mGlyphs[wanted->second].mBitmap;
+    GlyphCacheEntry::Bitmap& bitmap = entry.mBitmaps[bitmap_index];
+    if (!bitmap.mPlaced)
+    {
+        if (!mFontBitmapCachep->nextOpenPos(bitmap.mWidth, bitmap.mX, bitmap.mY, bitmap.mBitmapType, bitmap.mBitmapNum))
+        {
+            return NULL;
+        }
+        LLImageRaw* image_raw = mFontBitmapCachep->getImageRaw(bitmap.mBitmapType, bitmap.mBitmapNum);
+        if (!image_raw
+            || bitmap.mX + bitmap.mWidth > image_raw->getWidth()
+            || bitmap.mY + bitmap.mHeight > image_raw->getHeight())
+        {
+            return NULL;
+        }
+        {
+            LLImageDataLock lock(image_raw);
+            copy_glyph_pixels(image_raw, bitmap.mBitmapType, bitmap.mX, bitmap.mY, bitmap.mWidth, bitmap.mHeight,
+                              (U8*)&entry.mContents[bitmap.mOffset], true);
+        }
+        bitmap.mPlaced = true;
+
+        const std::pair<EFontGlyphType, U32> dirty(bitmap.mBitmapType, bitmap.mBitmapNum);
+        if (std::find(mDirtyBitmaps.begin(), mDirtyBitmaps.end(), dirty) == mDirtyBitmaps.end())
+        {
+            mDirtyBitmaps.push_back(dirty);
+        }
+    }
+
+    // All the glyph infos of wch sharing the bitmap, as addGlyphFromFont()
+    // makes them
+    LLFontGlyphInfo* result = NULL;
+    for (auto it = range_it.first; it != range_it.second; ++it)
+    {
+        const CachedGlyph& glyph = entry.mGlyphs[it->second];
+        const EFontGlyphType type = (EFontGlyphType)glyph.mGlyphType;
+        if (glyph.mBitmap != bitmap_index || entry.mGlyphPlaced[it->second] || findGlyphInfo(wch, type))
+        {
+            continue;
+        }
+        LLFontGlyphInfo* gi = new LLFontGlyphInfo(glyph.mGlyphIndex, type);
+        gi->mXBitmapOffset = bitmap.mX;
+        gi->mYBitmapOffset = bitmap.mY;
+        gi->mBitmapEntry = std::make_pair(bitmap.mBitmapType, bitmap.mBitmapNum);
+        gi->mWidth = bitmap.mWidth;
+        gi->mHeight = bitmap.mHeight;
+        gi->mXBearing = glyph.mXBearing;
+        gi->mYBearing = glyph.mYBearing;
+        gi->mXAdvance = glyph.mXAdvance;
+        gi->mYAdvance = glyph.mYAdvance;
+        insertGlyphInfo(wch, gi);
+        entry.mGlyphPlaced[it->second] = true;
+        if (type == glyph_type)
+        {
+            result = gi;
+        }
+    }
+
+    LLTrace::add(sGlyphsCached, 1);
+    if (!mGlyphBatchDepth)
+    {
+        uploadBitmaps();
+    }
+    return result;
+}
+
+void LLFontFreetype::saveGlyphCache() const
+{
+    if (sGlyphCacheDir.empty() || mIsFallback || !mFTFace || !mFontHash)
+    {
+        return;
+    }
+
+    LL_PROFILE_ZONE_SCOPED;
+
+    // One bitmap for all the glyph infos of a character that share it
+    std::map<std::tuple<EFontGlyphType, U32, S32, S32>, U32> bitmap_indices;
+    std::vector<const LLFontGlyphInfo*> bitmaps;
+    std::vector<CachedGlyph> glyphs;
+    for (const char_glyph_info_map_t::value_type& entry : mCharGlyphInfoMap)
+    {
+        if (glyphs.size() >= GLYPH_CACHE_MAX_GLYPHS)
+        {
+            break;
+        }
+        const LLFontGlyphInfo* gi = entry.second;
+        if (!entry.first || gi->mBitmapEntry.first >= EFontGlyphType::Count)
+        {
+            // the empty glyph comes with the font
+            continue;
+        }
+        const std::tuple<EFontGlyphType, U32, S32, S32> location(gi->mBitmapEntry.first, gi->mBitmapEntry.second,
+                                                                  gi->mXBitmapOffset, gi->mYBitmapOffset);
+        auto inserted = bitmap_indices.insert(std::make_pair(location, (U32)bitmaps.size()));
+        if (inserted.second)
+        {
+            bitmaps.push_back(gi);
+        }
+        CachedGlyph glyph = { (U32)entry.first, gi->mGlyphIndex, (U32)gi->mGlyphType, inserted.first->second,
+                              gi->mXBearing, gi->mYBearing, gi->mXAdvance, gi->mYAdvance };
+        glyphs.push_back(glyph);
+    }
+    if (glyphs.empty())
+    {
+        return;
+    }
+
+    // Then, while there is room, the glyphs read but not used this session
+    std::map<U32, U32> cached_indices;
+    std::vector<U32> cached_bitmaps;
+    if (mGlyphCacheEntry)
+    {
+        const GlyphCacheEntry& entry = *mGlyphCacheEntry;
+        for (size_t i = 0; i < entry.mGlyphs.size() && glyphs.size() < GLYPH_CACHE_MAX_GLYPHS; ++i)
+        {
+            CachedGlyph glyph = entry.mGlyphs[i];
+            if (entry.mGlyphPlaced[i] || findGlyphInfo(glyph.mChar, (EFontGlyphType)glyph.mGlyphType))
+            {
+                continue;
+            }
+            auto inserted = cached_indices.insert(std::make_pair(glyph.mBitmap, (U32)cached_bitmaps.size()));
+            if (inserted.second)
+            {
+                cached_bitmaps.push_back(glyph.mBitmap);
+            }
+            glyph.mBitmap = (U32)bitmaps.size() + inserted.first->second;
+            glyphs.push_back(glyph);
+        }
+    }
+
+    U64 key;
+    const std::string filename = getGlyphCacheFilename(key);
+    std::vector<U8> out;
+    GlyphCacheHeader header = { GLYPH_CACHE_MAGIC, GLYPH_CACHE_VERSION, key, (U32)(bitmaps.size() + cached_bitmaps.size()),
+                                (U32)glyphs.size() };
+    append_bytes(out, &header, sizeof(header));
+    std::vector<U8> pixels;
+    for (const LLFontGlyphInfo* gi : bitmaps)
+    {
+        const EFontGlyphType bitmap_type = gi->mBitmapEntry.first;
+        LLImageRaw* image_raw = mFontBitmapCachep->getImageRaw(bitmap_type, gi->mBitmapEntry.second);
+        if (!image_raw)
+        {
+            return;
+        }
+        CachedBitmap bitmap = { (U32)bitmap_type, gi->mWidth, gi->mHeight };
+        append_bytes(out, &bitmap, sizeof(bitmap));
+        pixels.resize((size_t)gi->mWidth * gi->mHeight * cached_pixel_size(bitmap_type));
+        {
+            LLImageDataSharedLock lock(image_raw);
+            copy_glyph_pixels(image_raw, bitmap_type, gi->mXBitmapOffset, gi->mYBitmapOffset, gi->mWidth, gi->mHeight,
+                              pixels.data(), false);
+        }
+        append_bytes(out, pixels.data(), pixels.size());
+    }
+    for (U32 index : cached_bitmaps)
+    {
+        const GlyphCacheEntry::Bitmap& cached = mGlyphCacheEntry->mBitmaps[index];
+        CachedBitmap bitmap = { (U32)cached.mBitmapType, cached.mWidth, cached.mHeight };
+        append_bytes(out, &bitmap, sizeof(bitmap));
+        append_bytes(out, mGlyphCacheEntry->mContents.data() + cached.mOffset,
+                     (size_t)cached.mWidth * cached.mHeight * cached_pixel_size(cached.mBitmapType));
+    }
+    append_bytes(out, glyphs.data(), glyphs.size() * sizeof(CachedGlyph));
+
+    // Written aside and renamed, so another viewer instance never reads
+    // half of it
+    const std::string temp_filename = filename + ".tmp";
+    llofstream file(temp_filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        return;
+    }
+    file.write((const char*)out.data(), out.size());
+    file.close();
+    // rename() won't replace a file on Windows
+    LLFile::remove(filename, ENOENT);
+    if (file.fail() || LLFile::rename(temp_filename, filename) != 0)
+    {
+        LL_WARNS("Font") << "Unable to write the glyphs of " << mName << " to " << filename << LL_ENDL;
+        LLFile::remove(temp_filename);
+    }
+}
+
+// static
+void LLFontFreetype::trimGlyphCache()
+{
+    if (sGlyphCacheDir.empty())
+    {
+        return;
+    }
+
+    // Every session saves the entries of the fonts it used, so the oldest
+    // are those of fonts not used for longest
+    std::vector<std::pair<time_t, std::string> > entries;
+    S64 total_bytes = 0;
+    for (const std::string& name : gDirUtilp->getFilesInDir(sGlyphCacheDir))
+    {
+        const std::string filename = sGlyphCacheDir + gDirUtilp->getDirDelimiter() + name;
+        llstat stat_data;
+        if (LLFile::stat(filename, &stat_data) == 0)
+        {
+            total_bytes += stat_data.st_size;
+            entries.push_back(std::make_pair(stat_data.st_mtime, filename));
+        }
+    }
+    if (total_bytes <= GLYPH_CACHE_MAX_BYTES)
+    {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end());
+    for (const std::pair<time_t, std::string>& entry : entries)
+    {
+        if (total_bytes <= GLYPH_CACHE_MAX_BYTES)
+        {
+            break;
+        }
+        llstat stat_data;
+        if (LLFile::stat(entry.second, &stat_data) == 0 && LLFile::remove(entry.second) == 0)
+        {
+            total_bytes -= stat_data.st_size;
+        }
+    }
+}
+
 void LLFontFreetype::renderGlyph(EFontGlyphType bitmap_type, U32 glyph_index, llwchar wch) const
 {
     if (mFTFace == NULL)
@@ -883,7 +1460,12 @@ void LLFontFreetype::resetBitmapCache()
         delete it->second;
     }
     mCharGlyphInfoMap.clear();
+    ++mGlyphGeneration;
     mFontBitmapCachep->reset();
+    mDirtyBitmaps.clear();
+    // read again for the new size, when first needed
+    mGlyphCacheEntry.reset();
+    mGlyphCacheRead = false;
 
     // Adding default glyph is skipped for fallback fonts here as well as in loadFace().
     // This if was added as fix for EXT-4971.
@@ -1039,12 +1621,14 @@ namespace nd
                 mName = aName;
                 mSize = aSize;
                 mRefs = 1;
+                mHash = HBXXH64::digest( &mAddress[0], mAddress.size() );
             }
 
             std::string mName;
             std::vector<U8> mAddress;
             long mSize;
             U32  mRefs;
+            U64  mHash;
         };
     }
 }
@@ -1081,6 +1665,12 @@ U8 const* LLFontManager::loadFont( std::string const &aFilename, long &a_Size)
     return &itr->second->mAddress[ 0 ];
 }
 
+U64 LLFontManager::getFontHash( std::string const &aFilename ) const
+{
+    std::map< std::string, std::shared_ptr<nd::fonts::LoadedFont> >::const_iterator itr = m_LoadedFonts.find( aFilename );
+    return ( itr != m_LoadedFonts.end() ) ? itr->second->mHash : 0;
+}
+
 void LLFontManager::unloadAllFonts()
 {
     m_LoadedFonts.clear();
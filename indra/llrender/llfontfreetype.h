@@ -28,6 +28,7 @@
 #define LL_LLFONTFREETYPE_H
 
 #include <boost/unordered_map.hpp>
+#include <memory>
 #include "llpointer.h"
 #include "llstl.h"
 
@@ -65,6 +66,7 @@ private:
 // <FS:ND> FIRE-7570. Only load/mmap fonts once.
 public:
     U8 const *loadFont( std::string const &aFilename, long &a_Size );
+    U64 getFontHash( std::string const &aFilename ) const; // of the file's contents, 0 if not loaded
 
 private:
     void unloadAllFonts();
@@ -155,6 +157,22 @@ public:
 
     LLFontGlyphInfo* getGlyphInfo(llwchar wch, EFontGlyphType glyph_type) const;
 
+    // Rasterizes the glyphs of wchars that aren't in the bitmap cache yet,
+    // all in one pass: each bitmap they land in is uploaded once, rather
+    // than once per glyph.
+    void addGlyphs(const llwchar* wchars, S32 count, EFontGlyphType glyph_type) const;
+
+    // Glyphs used in a session are kept in dir when the font is destroyed,
+    // with their metrics, keyed by the font files, fallbacks included, and
+    // the size.  A font created with the same ones later reads them when it
+    // first adds a glyph, and puts each in its bitmap cache only when it is
+    // asked for.  An empty dir, the default, turns this off.
+    static void setGlyphCacheDir(const std::string& dir);
+    void useGlyphCache();
+    void saveGlyphCache() const;
+    // Removes the least recently saved entries over the size limit
+    static void trimGlyphCache();
+
     void reset(F32 vert_dpi, F32 horz_dpi);
 
     void destroyGL();
@@ -164,6 +182,10 @@ public:
     void       dumpFontBitmaps() const;
     const LLFontBitmapCache* getFontBitmapCache() const;
 
+    // Changes whenever a glyph info is added, replaced or deleted, so
+    // pointers to them kept from an earlier generation may be stale
+    S32 getGlyphGeneration() const { return mGlyphGeneration; }
+
     void setStyle(U8 style);
     U8 getStyle() const;
 
@@ -176,12 +198,21 @@ private:
     LLFontGlyphInfo* addGlyphFromFont(const LLFontFreetype *fontp, llwchar wch, U32 glyph_index, EFontGlyphType bitmap_type) const; // Add a glyph from this font to the other (returns the glyph_index, 0 if not found)
     void renderGlyph(EFontGlyphType bitmap_type, U32 glyph_index, llwchar wch) const;
     void insertGlyphInfo(llwchar wch, LLFontGlyphInfo* gi) const;
+    LLFontGlyphInfo* findGlyphInfo(llwchar wch, EFontGlyphType glyph_type) const;
+    void uploadBitmaps() const;
+    std::string getGlyphCacheFilename(U64& key) const;
+    void readGlyphCache() const;
+    LLFontGlyphInfo* addCachedGlyph(llwchar wch, EFontGlyphType glyph_type) const;
 
     std::string mName;
 
     U8 mStyle;
 
     F32 mPointSize;
+    F32 mVertDPI;
+    F32 mHorzDPI;
+    S32 mFaceIndex;
+    U64 mFontHash;
     F32 mAscender;
     F32 mDescender;
     F32 mLineHeight;
@@ -205,6 +236,19 @@ private:
     mutable LLFontBitmapCache* mFontBitmapCachep;
 
     mutable S32 mRenderGlyphCount;
+    mutable S32 mGlyphGeneration;
+
+    // While addGlyphs() runs, the bitmaps it changed, uploaded at the end
+    mutable S32 mGlyphBatchDepth;
+    mutable std::vector<std::pair<EFontGlyphType, U32> > mDirtyBitmaps;
+
+    // This font's glyph cache entry, read when it first adds a glyph
+    struct GlyphCacheEntry;
+    bool mUseGlyphCache;
+    mutable bool mGlyphCacheRead;
+    mutable std::unique_ptr<GlyphCacheEntry> mGlyphCacheEntry;
+
+    static std::string sGlyphCacheDir;
 
     // <FS:ND> Save X-kerning data, so far only for all glyphs with index small than 256 (to not waste too much memory)
     // right now it is 256 slots with 256 glyphs each, maybe consider splitting it into smaller slices to use less memory if we
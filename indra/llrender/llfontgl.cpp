@@ -30,6 +30,7 @@
 
 // Linden library includes
 #include "llfasttimer.h"
+#include "llframetimer.h"
 #include "llfontfreetype.h"
 #include "llfontbitmapcache.h"
 #include "llfontregistry.h"
@@ -41,6 +42,9 @@
 #include "lltexture.h"
 #include "lldir.h"
 #include "llstring.h"
+#include "hbxxh.h"
+#include "llthread.h"
+#include "lltrace.h"
 
 // Third party library includes
 #include <boost/tokenizer.hpp>
@@ -71,6 +75,10 @@ std::vector<std::pair<LLCoordGL, F32> > LLFontGL::sOriginStack;
 
 const F32 PAD_UVY = 0.5f; // half of vertical padding between glyphs in the glyph texture
 const F32 DROP_SHADOW_SOFT_STRENGTH = 0.3f;
+const size_t MAX_GLYPH_RUNS = 512; // per font, see getGlyphRun()
+
+static LLTrace::CountStatHandle<> sGlyphsLaidOut("fontglyphslaidout", "Glyphs render() looked up and kerned");
+static LLTrace::CountStatHandle<> sGlyphsReused("fontglyphsreused", "Glyphs render() drew from a cached run");
 
 LLFontGL::LLFontGL()
 {
@@ -207,6 +215,10 @@ S32 LLFontGL::render(const LLWString &wstr, S32 begin_offset, F32 x, F32 y, cons
         length = llmin((S32)wstr.length() - begin_offset, max_chars );
     }
 
+    const EFontGlyphType glyph_type = (!use_color) ? EFontGlyphType::Grayscale : EFontGlyphType::Color;
+    GlyphRun scratch_run;
+    const GlyphRun& run = getGlyphRun(wstr, begin_offset, length, glyph_type, scratch_run);
+
     F32 cur_x, cur_y, cur_render_x, cur_render_y;
 
     // Not guaranteed to be set correctly
@@ -240,10 +252,10 @@ S32 LLFontGL::render(const LLWString &wstr, S32 begin_offset, F32 x, F32 y, cons
     case LEFT:
         break;
     case RIGHT:
-        cur_x -= llmin(scaled_max_pixels, ll_round(getWidthF32(wstr.c_str(), begin_offset, length) * sScaleX));
+        cur_x -= llmin(scaled_max_pixels, ll_round(run.mWidth * sScaleX));
         break;
     case HCENTER:
-        cur_x -= llmin(scaled_max_pixels, ll_round(getWidthF32(wstr.c_str(), begin_offset, length) * sScaleX)) / 2;
+        cur_x -= llmin(scaled_max_pixels, ll_round(run.mWidth * sScaleX)) / 2;
         break;
     default:
         break;
@@ -263,13 +275,11 @@ S32 LLFontGL::render(const LLWString &wstr, S32 begin_offset, F32 x, F32 y, cons
     F32 inv_width = 1.f / font_bitmap_cache->getBitmapWidth();
     F32 inv_height = 1.f / font_bitmap_cache->getBitmapHeight();
 
-    const S32 LAST_CHARACTER = LLFontFreetype::LAST_CHAR_FULL;
-
     bool draw_ellipses = false;
     if (use_ellipses)
     {
         // check for too long of a string
-        S32 string_width = ll_round(getWidthF32(wstr.c_str(), begin_offset, max_chars) * sScaleX);
+        S32 string_width = ll_round(run.mWidth * sScaleX);
         if (string_width > scaled_max_pixels)
         {
             // use four dots for ellipsis width to generate padding
@@ -279,8 +289,6 @@ S32 LLFontGL::render(const LLWString &wstr, S32 begin_offset, F32 x, F32 y, cons
         }
     }
 
-    const LLFontGlyphInfo* next_glyph = NULL;
-
     // string can have more than one glyph per char (ex: bold or shadow),
     // make sure that GLYPH_BATCH_SIZE won't end up with half a symbol.
     // See drawGlyph.
@@ -302,17 +310,13 @@ S32 LLFontGL::render(const LLWString &wstr, S32 begin_offset, F32 x, F32 y, cons
     {
         llwchar wch = wstr[i];
 
-        const LLFontGlyphInfo* fgi = next_glyph;
-        next_glyph = NULL;
-        if(!fgi)
-        {
-            fgi = mFontFreetype->getGlyphInfo(wch, (!use_color) ? EFontGlyphType::Grayscale : EFontGlyphType::Color);
-        }
-        if (!fgi)
+        if (i - begin_offset >= (S32)run.mGlyphs.size())
         {
             LL_ERRS() << "Missing Glyph Info" << LL_ENDL;
             break;
         }
+        const LayoutGlyph& glyph = run.mGlyphs[i - begin_offset];
+        const LLFontGlyphInfo* fgi = glyph.mInfo;
         // Per-glyph bitmap texture.
         std::pair<EFontGlyphType, S32> next_bitmap_entry = fgi->mBitmapEntry;
         if (next_bitmap_entry != bitmap_entry || last_char != wch)
@@ -378,14 +382,7 @@ S32 LLFontGL::render(const LLWString &wstr, S32 begin_offset, F32 x, F32 y, cons
         chars_drawn++;
         cur_x += fgi->mXAdvance;
         cur_y += fgi->mYAdvance;
-
-        llwchar next_char = wstr[i+1];
-        if (next_char && (next_char < LAST_CHARACTER))
-        {
-            // Kern this puppy.
-            next_glyph = mFontFreetype->getGlyphInfo(next_char, (!use_color) ? EFontGlyphType::Grayscale : EFontGlyphType::Color);
-            cur_x += mFontFreetype->getXKerning(fgi, next_glyph);
-        }
+        cur_x += glyph.mKerning;
 
         // Round after kerning.
         // Must do this to cur_x, not just to cur_render_x, otherwise you
@@ -445,6 +442,121 @@ S32 LLFontGL::render(const LLWString &wstr, S32 begin_offset, F32 x, F32 y, cons
     return chars_drawn;
 }
 
+const LLFontGL::GlyphRun& LLFontGL::getGlyphRun(const LLWString& wstr, S32 begin_offset, S32 length,
+                                                 EFontGlyphType glyph_type, GlyphRun& scratch) const
+{
+    // the character after the run kerns its last glyph
+    const S32 text_length = llmax(0, llmin(length + 1, (S32)wstr.length() - begin_offset));
+    const llwchar* text = wstr.c_str() + (text_length ? begin_offset : 0);
+
+    // mGlyphRuns is the main thread's
+    if (length <= 0 || !on_main_thread())
+    {
+        scratch.mText.assign(text, text_length);
+        scratch.mLength = llmax(0, length);
+        scratch.mGlyphType = glyph_type;
+        layoutGlyphRun(scratch);
+        return scratch;
+    }
+
+    const U64 key = HBXXH64::digest(text, text_length * sizeof(llwchar)) ^ (((U64)length << 32) | (U64)glyph_type);
+    const U32 frame = LLFrameTimer::getFrameCount();
+    glyph_run_map_t::iterator it = mGlyphRuns.find(key);
+    if (it != mGlyphRuns.end())
+    {
+        GlyphRun& run = it->second;
+        if (run.mLength == length
+            && run.mGlyphType == glyph_type
+            && run.mText.compare(0, LLWString::npos, text, text_length) == 0)
+        {
+            run.mLastFrame = frame;
+            if (run.mGlyphGeneration == mFontFreetype->getGlyphGeneration())
+            {
+                LLTrace::add(sGlyphsReused, run.mGlyphs.size());
+                return run;
+            }
+            // glyphs were added since, the pointers may be stale
+            layoutGlyphRun(run);
+            return run;
+        }
+    }
+    else if (mGlyphRuns.size() >= MAX_GLYPH_RUNS)
+    {
+        // drop the runs not drawn this frame; if there are none, this one
+        // isn't cached either
+        if (mGlyphRunsSweptFrame != frame)
+        {
+            mGlyphRunsSweptFrame = frame;
+            for (it = mGlyphRuns.begin(); it != mGlyphRuns.end(); )
+            {
+                it = (it->second.mLastFrame != frame) ? mGlyphRuns.erase(it) : std::next(it);
+            }
+        }
+        if (mGlyphRuns.size() >= MAX_GLYPH_RUNS)
+        {
+            scratch.mText.assign(text, text_length);
+            scratch.mLength = length;
+            scratch.mGlyphType = glyph_type;
+            layoutGlyphRun(scratch);
+            return scratch;
+        }
+    }
+
+    // new, or another string with the same key
+    GlyphRun& run = mGlyphRuns[key];
+    run.mText.assign(text, text_length);
+    run.mLength = length;
+    run.mGlyphType = glyph_type;
+    run.mLastFrame = frame;
+    layoutGlyphRun(run);
+    return run;
+}
+
+void LLFontGL::layoutGlyphRun(GlyphRun& run) const
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_UI;
+    const S32 LAST_CHARACTER = LLFontFreetype::LAST_CHAR_FULL;
+
+    // Rasterize the glyphs the run is missing all at once, before the
+    // lookups below add them one by one
+    if (run.mLength > 0)
+    {
+        mFontFreetype->addGlyphs(run.mText.c_str(), (S32)run.mText.length(), run.mGlyphType);
+    }
+
+    run.mGlyphs.clear();
+    run.mGlyphs.reserve(run.mLength);
+    const LLFontGlyphInfo* next_glyph = NULL;
+    for (S32 i = 0; i < run.mLength; i++)
+    {
+        const LLFontGlyphInfo* fgi = next_glyph;
+        next_glyph = NULL;
+        if (!fgi)
+        {
+            fgi = mFontFreetype->getGlyphInfo(run.mText[i], run.mGlyphType);
+        }
+        if (!fgi)
+        {
+            break;
+        }
+
+        F32 kerning = 0.f;
+        llwchar next_char = run.mText[i + 1];
+        if (next_char && (next_char < LAST_CHARACTER))
+        {
+            // Kern this puppy.
+            next_glyph = mFontFreetype->getGlyphInfo(next_char, run.mGlyphType);
+            kerning = mFontFreetype->getXKerning(fgi, next_glyph);
+        }
+        run.mGlyphs.push_back({ fgi, kerning });
+    }
+
+    run.mWidth = (run.mLength > 0) ? getWidthF32(run.mText.c_str(), 0, run.mLength) : 0.f;
+    // after the lookups, which may have added glyphs
+    run.mGlyphGeneration = mFontFreetype->getGlyphGeneration();
+    LLTrace::add(sGlyphsLaidOut, run.mGlyphs.size());
+}
+
 S32 LLFontGL::render(const LLWString &text, S32 begin_offset, F32 x, F32 y, const LLColor4 &color) const
 {
     return render(text, begin_offset, x, y, color, LEFT, BASELINE, NORMAL, NO_SHADOW);
@@ -582,10 +694,12 @@ F32 LLFontGL::getWidthF32(const llwchar* wchars, S32 begin_offset, S32 max_chars
 void LLFontGL::generateASCIIglyphs()
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_UI;
+    llwchar ascii[127 - 32];
     for (U32 i = 32; (i < 127); i++)
     {
-        mFontFreetype->getGlyphInfo(i, EFontGlyphType::Grayscale);
+        ascii[i - 32] = i;
     }
+    mFontFreetype->addGlyphs(ascii, 127 - 32, EFontGlyphType::Grayscale);
 }
 
 // Returns the max number of complete characters from text (up to max_chars) that can be drawn in max_pixels
@@ -35,10 +35,15 @@
 #include "llrect.h"
 #include "v2math.h"
 
+#include <unordered_map>
+#include <vector>
+
 class LLColor4;
 // Key used to request a font.
 class LLFontDescriptor;
 class LLFontFreetype;
+struct LLFontGlyphInfo;
+enum class EFontGlyphType : U32;
 
 // Structure used to store previously requested fonts.
 class LLFontRegistry;
@@ -251,6 +256,38 @@ private:
     LLFontDescriptor mFontDescriptor;
     LLPointer<LLFontFreetype> mFontFreetype;
 
+    // A string laid out by render(): the glyph of each character, and the
+    // kerning with the next one.  Where it is drawn, how wide it may be,
+    // its style and color don't change it, so render() keeps the runs it
+    // lays out and draws the same string from them in later frames.
+    struct LayoutGlyph
+    {
+        const LLFontGlyphInfo* mInfo;
+        F32 mKerning;
+    };
+    struct GlyphRun
+    {
+        LLWString mText;            // the run and the character after it
+        S32 mLength = 0;
+        EFontGlyphType mGlyphType;
+        S32 mGlyphGeneration = 0;   // of mFontFreetype when laid out
+        U32 mLastFrame = 0;
+        F32 mWidth = 0.f;           // getWidthF32() of the run
+        std::vector<LayoutGlyph> mGlyphs;
+    };
+    typedef std::unordered_map<U64, GlyphRun> glyph_run_map_t;
+    mutable glyph_run_map_t mGlyphRuns;
+    // A sweep leaves only runs drawn in its frame: sweeping again in the
+    // same frame would find nothing to evict.
+    mutable U32 mGlyphRunsSweptFrame = U32_MAX;
+
+    // The run of length characters of wstr from begin_offset, from
+    // mGlyphRuns when it is there and current, else laid out into it, or
+    // into scratch off the main thread or when mGlyphRuns is full.
+    const GlyphRun& getGlyphRun(const LLWString& wstr, S32 begin_offset, S32 length, EFontGlyphType glyph_type,
+                                GlyphRun& scratch) const;
+    void layoutGlyphRun(GlyphRun& run) const;
+
     void renderTriangle(LLVector4a* vertex_out, LLVector2* uv_out, LLColor4U* colors_out, const LLRectf& screen_rect, const LLRectf& uv_rect, const LLColor4U& color, F32 slant_amt) const;
     void drawGlyph(S32& glyph_count, LLVector4a* vertex_out, LLVector2* uv_out, LLColor4U* colors_out, const LLRectf& screen_rect, const LLRectf& uv_rect, const LLColor4U& color, U8 style, ShadowType shadow, F32 drop_shadow_fade) const;
 
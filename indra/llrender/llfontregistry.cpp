@@ -621,6 +621,11 @@ LLFontGL *LLFontRegistry::createFont(const LLFontDescriptor& desc)
     if (result)
     {
         result->mFontDescriptor = desc;
+        if (mCreateGLTextures)
+        {
+            // glyphs rasterized by an earlier session, fallbacks included
+            result->mFontFreetype->useGlyphCache();
+        }
     }
     else
     {
@@ -650,9 +655,17 @@ void LLFontRegistry::clear()
          ++it)
     {
         LLFontGL *fontp = it->second;
+        if (fontp && mCreateGLTextures)
+        {
+            fontp->mFontFreetype->saveGlyphCache();
+        }
         delete fontp;
     }
     mFontMap.clear();
+    if (mCreateGLTextures)
+    {
+        LLFontFreetype::trimGlyphCache();
+    }
 }
 
 void LLFontRegistry::destroyGL()
@@ -184,6 +184,8 @@ void LLFontVertexBuffer::genBuffers(
     // so will need to rerender previous characters
     mLastFontCacheGen = fontp->getCacheGeneration();
 
+    // fontp->render() draws a string it has drawn before from its glyph
+    // run, so rebuilding after a move or a color change skips the layout
     gGL.beginList(&mBufferList);
     mChars = fontp->render(text, begin_offset, x, y, color, halign, valign,
         style, shadow, max_chars, max_pixels, right_x, use_ellipses, use_color);
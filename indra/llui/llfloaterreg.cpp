@@ -32,7 +32,12 @@
 #include "llfloater.h"
 #include "llmultifloater.h"
 #include "llfloaterreglistener.h"
+#include "llframeprofiler.h"
+#include "lltimer.h"
+#include "lluictrlfactory.h"
 #include "lluiusage.h"
+#include "llxmlnode.h"
+#include "workqueue.h"
 #include <string>
 
 //*******************************************************
@@ -44,6 +49,9 @@ LLFloaterReg::build_map_t LLFloaterReg::sBuildMap;
 std::map<std::string, std::string, std::less<>> LLFloaterReg::sGroupMap;
 bool LLFloaterReg::sBlockShowFloaters = false;
 std::set<std::string, std::less<>> LLFloaterReg::sAlwaysShowableList;
+std::set<std::string, std::less<>> LLFloaterReg::sPooledFloaters;
+std::set<std::string, std::less<>> LLFloaterReg::sPrewarmPending;
+std::deque<std::string> LLFloaterReg::sPrewarmReady;
 
 static LLFloaterRegListener sFloaterRegListener;
 
@@ -222,6 +230,12 @@ LLFloater* LLFloaterReg::getInstance(std::string_view name, const LLSD& key)
                         }
                         res->setInstanceName(std::string(name));
 
+                        if ((res->mSingleInstance || key.isUndefined()) && sPooledFloaters.find(name) != sPooledFloaters.end())
+                        {
+                            res->mReuseInstance = true;
+                            res->mIsReuseInitialized = true;
+                        }
+
                         LLFloater* last_floater = (list.empty() ? NULL : list.back());
 
                         res->applyControlsAndPosition(last_floater);
@@ -318,6 +332,8 @@ LLFloater* LLFloaterReg::showInstance(std::string_view name, const LLSD& key, bo
     if ( (sBlockShowFloaters && sAlwaysShowableList.find(name) == sAlwaysShowableList.end()) || (!mValidateSignal(name, key)) )
 // [/RLVa:KB]
         return 0;//
+    LLTimer open_timer;
+    const bool built = (findInstance(name, key) == NULL);
     LLFloater* instance = getInstance(name, key);
     if (instance)
     {
@@ -325,10 +341,123 @@ LLFloater* LLFloaterReg::showInstance(std::string_view name, const LLSD& key, bo
         instance->openFloater(key);
         if (focus)
             instance->setFocus(true);
+        LLUIUsage::instance().logFloaterOpen(std::string(name), open_timer.getElapsedTimeF64(), built);
     }
     return instance;
 }
 
+//static
+void LLFloaterReg::prewarmInstance(std::string_view name)
+{
+    auto it = sBuildMap.find(name);
+    if (it == sBuildMap.end() || findInstance(name) || sPrewarmPending.find(name) != sPrewarmPending.end())
+    {
+        return;
+    }
+    const std::string floater_name(name);
+    sPrewarmPending.insert(floater_name);
+    setPooled(name);
+
+    // Without the XUI cache there is nothing to read ahead: the floater is
+    // built from the XML when its turn comes
+    LL::WorkQueue::ptr_t main_queue = LL::WorkQueue::getInstance("mainloop");
+    LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+    if (LLXMLNode::getLayeredCacheDir().empty() || !main_queue || !general_queue)
+    {
+        sPrewarmReady.push_back(floater_name);
+        return;
+    }
+
+    // Skin directories are looked up here: LLDir caches what it finds
+    const std::vector<std::string> paths = LLUICtrlFactory::getLayeredXMLPaths(it->second.mFile);
+    bool posted = main_queue->postTo(
+        general_queue,
+        [paths]() // Work done on general queue
+        {
+            std::vector<std::string> filenames;
+            LLXMLNode::prefetchLayeredCache(paths, &filenames);
+            return filenames;
+        },
+        [floater_name](std::vector<std::string> filenames) // Callback to main thread
+        {
+            onPrewarmRead(floater_name, filenames);
+        });
+    if (!posted)
+    {
+        sPrewarmReady.push_back(floater_name);
+    }
+}
+
+//static
+void LLFloaterReg::onPrewarmRead(const std::string& name, const std::vector<std::string>& filenames)
+{
+    // The floater has been read, now the panels it includes
+    std::vector<std::vector<std::string> > panel_paths;
+    for (const std::string& filename : filenames)
+    {
+        std::vector<std::string> paths = gDirUtilp->findSkinnedFilenames(LLDir::XUI, filename, LLDir::CURRENT_SKIN);
+        if (!paths.empty())
+        {
+            panel_paths.push_back(std::move(paths));
+        }
+    }
+
+    LL::WorkQueue::ptr_t main_queue = LL::WorkQueue::getInstance("mainloop");
+    LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+    if (panel_paths.empty() || !main_queue || !general_queue
+        || !main_queue->postTo(
+            general_queue,
+            [panel_paths]() // Work done on general queue
+            {
+                for (const std::vector<std::string>& paths : panel_paths)
+                {
+                    LLXMLNode::prefetchLayeredCache(paths);
+                }
+            },
+            [name]() // Callback to main thread
+            {
+                sPrewarmReady.push_back(name);
+            }))
+    {
+        sPrewarmReady.push_back(name);
+    }
+}
+
+//static
+size_t LLFloaterReg::updatePrewarm()
+{
+    while (!sPrewarmReady.empty())
+    {
+        const std::string name = sPrewarmReady.front();
+        sPrewarmReady.pop_front();
+        sPrewarmPending.erase(name);
+        auto it = sBuildMap.find(name);
+        if (it == sBuildMap.end() || findInstance(name))
+        {
+            // opened meanwhile
+            continue;
+        }
+
+        LL_PROFILE_ZONE_NAMED("Prewarm floater");
+        // names the floater in frame spike reports: sBuildMap keys live as
+        // long as the viewer
+        LLFrameProfiler::Zone floater_zone(it->first.c_str());
+        LLTimer build_timer;
+        if (getInstance(name))
+        {
+            LLUIUsage::instance().logFloaterPrebuilt(name, build_timer.getElapsedTimeF64());
+        }
+        break;
+    }
+    return sPrewarmReady.size();
+}
+
+//static
+void LLFloaterReg::setPooled(std::string_view name)
+{
+    sPooledFloaters.emplace(name);
+}
+
 //static
 // returns true if the instance exists
 bool LLFloaterReg::hideInstance(std::string_view name, const LLSD& key)
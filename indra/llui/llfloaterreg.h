@@ -30,6 +30,7 @@
 #include "llrect.h"
 #include "llsd.h"
 
+#include <deque>
 #include <list>
 #include <boost/function.hpp>
 // [RLVa:KB] - Checked: 2011-05-25 (RLVa-1.4.0a)
@@ -82,6 +83,14 @@ private:
      */
     static std::set<std::string, std::less<>> sAlwaysShowableList;
 
+    // Floaters kept once built, and those being built ahead of time: their
+    // XUI being read, then waiting for the main thread to build them
+    static std::set<std::string, std::less<>> sPooledFloaters;
+    static std::set<std::string, std::less<>> sPrewarmPending;
+    static std::deque<std::string> sPrewarmReady;
+
+    static void onPrewarmRead(const std::string& name, const std::vector<std::string>& filenames);
+
 // [RLVa:KB] - Checked: 2010-02-28 (RLVa-1.4.0a) | Modified: RLVa-1.2.0a
     // Used to determine whether a floater can be shown
 public:
@@ -145,6 +154,22 @@ public:
     static bool toggleInstance(std::string_view name, const LLSD& key = LLSD());
     static bool instanceVisible(std::string_view name, const LLSD& key = LLSD());
 
+    // Prebuilding and pooling
+
+    // Builds a floater ahead of its first opening, left hidden, so that
+    // showing it later doesn't stall the UI.  Its XUI, and that of the
+    // panels it includes, is read from the XUI cache on a worker thread;
+    // the floater itself is built on the main thread by updatePrewarm().
+    // Prewarmed floaters are pooled.
+    static void prewarmInstance(std::string_view name);
+    // Builds the first floater whose XUI has been read, if any.  A build
+    // can't be cut short, so the caller spaces these out over frames with
+    // time to spare.  Returns how many are still waiting.
+    static size_t updatePrewarm();
+    // A pooled floater opened without a key is hidden when closed rather
+    // than destroyed, and shown again the next time it is opened.
+    static void setPooled(std::string_view name);
+
     static void showInitialVisibleInstances();
     static void hideVisibleInstances(const std::set<std::string>& exceptions = std::set<std::string>());
     static void restoreVisibleInstances();
@@ -740,7 +740,8 @@ void LLFolderView::draw()
 
     // skip over LLFolderViewFolder::draw since we don't want the folder icon, label,
     // and arrow for the root folder
-    LLView::draw();
+    LLRect visible_rect;
+    drawChildren(getVisibleRectIn(this, visible_rect) ? &visible_rect : NULL);
 
     mDragAndDropThisFrame = false;
 }
@@ -1787,6 +1788,15 @@ LLRect LLFolderView::getVisibleRect()
     return visible_rect;
 }
 
+bool LLFolderView::getVisibleRectIn(const LLView* view, LLRect& rect)
+{
+    if (!mScrollContainer)
+    {
+        return false;
+    }
+    return localRectToOtherView(getVisibleRect(), &rect, view);
+}
+
 bool LLFolderView::getShowSelectionContext()
 {
     if (mShowSelectionContext)
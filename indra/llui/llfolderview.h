@@ -228,6 +228,9 @@ public:
     void setScrollContainer( LLScrollContainer* parent ) { mScrollContainer = parent; }
     LLScrollContainer* getScrollContainer() { return mScrollContainer; }
     LLRect getVisibleRect();
+    // The visible rect in view's local coordinates, false without a scroll
+    // container.  Rows outside it aren't drawn.
+    bool getVisibleRectIn(const LLView* view, LLRect& rect);
 
     bool search(LLFolderViewItem* first_item, const std::string &search_string, bool backward);
     void setShowSelectionContext(bool show) { mShowSelectionContext = show; }
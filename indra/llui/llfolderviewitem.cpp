@@ -2510,7 +2510,10 @@ void LLFolderViewFolder::draw()
     // draw children if root folder, or any other folder that is open or animating to closed state
     if( getRoot() == this || (isOpen() || mCurHeight != mTargetHeight ))
     {
-        LLView::draw();
+        // with thousands of rows open, only look at those scrolled into view
+        LLFolderView* root = getRoot();
+        LLRect visible_rect;
+        drawChildren(root && root->getVisibleRectIn(this, visible_rect) ? &visible_rect : NULL);
     }
 
     mExpanderHighlighted = false;
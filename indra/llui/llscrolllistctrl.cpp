@@ -30,6 +30,8 @@
 #include "llscrolllistctrl.h"
 
 #include <algorithm>
+#include <numeric>
+#include <set>
 
 #include "llstl.h"
 #include "llboost.h"
@@ -45,6 +47,7 @@
 #include "llresmgr.h"
 #include "llscrollbar.h"
 #include "llscrolllistcell.h"
+#include "llscrolllistsortkeys.h"
 #include "llstring.h"
 #include "llui.h"
 #include "lluictrlfactory.h"
@@ -232,6 +235,9 @@ LLScrollListCtrl::LLScrollListCtrl(const LLScrollListCtrl::Params& p)
     // <FS:Ansariel> Fix for FS-specific people list (radar)
     mFilterColumn(-1),
     mIsFiltered(false),
+    mFilteredItemsFrame(0),
+    mFilteredItemsDirty(true),
+    mDataSource(NULL),
     mPersistSortOrder(p.persist_sort_order),
     mPersistedSortOrderLoaded(false),
     mPersistedSortOrderControl(""),
@@ -439,28 +445,25 @@ S32 LLScrollListCtrl::getMaxItemCount() const
 
 S32 LLScrollListCtrl::isEmpty() const
 {
+    if (mDataSource)
+    {
+        return mSourceOrder.empty();
+    }
     return mItemList.empty();
 }
 
 S32 LLScrollListCtrl::getItemCount() const
 {
+    if (mDataSource)
+    {
+        return getDisplayRowCount();
+    }
+
     // <FS:Ansariel> Fix for FS-specific people list (radar)
     if (mIsFiltered)
     {
-        S32 count(0);
-        item_list::const_iterator iter;
-        for(iter = mItemList.begin(); iter != mItemList.end(); iter++)
-        {
-            LLScrollListItem* item  = *iter;
-            std::string filterColumnValue = item->getColumn(mFilterColumn)->getValue().asString();
-            std::transform(filterColumnValue.begin(), filterColumnValue.end(), filterColumnValue.begin(), ::tolower);
-            if (filterColumnValue.find(mFilterString) == std::string::npos)
-            {
-                continue;
-            }
-            count++;
-        }
-        return count;
+        updateFilteredItems();
+        return static_cast<S32>(mFilteredItems.size());
     }
     // </FS:Ansariel> Fix for FS-specific people list (radar)
 
@@ -487,6 +490,9 @@ void LLScrollListCtrl::clearRows()
 {
     std::for_each(mItemList.begin(), mItemList.end(), DeletePointer());
     mItemList.clear();
+    // the rows of a data source are built again as they come into view
+    mSourceItems.clear();
+    mFilteredItemsDirty = true;
     //mItemCount = 0;
 
     // Scroll the bar back up to the top.
@@ -546,6 +552,11 @@ S32 LLScrollListCtrl::getFirstSelectedIndex() const
     // make sure sort is up to date before returning an index
     updateSort();
 
+    if (mDataSource)
+    {
+        return getSelectedSourceLine(false);
+    }
+
     for (LLScrollListItem* item : mItemList)
     {
         // <FS:Ansariel> Fix for FS-specific people list (radar)
@@ -669,6 +680,12 @@ LLRect LLScrollListCtrl::getRequiredRect()
 
 bool LLScrollListCtrl::addItem( LLScrollListItem* item, EAddPosition pos, bool requires_column )
 {
+    if (mDataSource)
+    {
+        LL_WARNS() << "Rows of " << getName() << " come from its data source" << LL_ENDL;
+        return false;
+    }
+
     bool not_too_big = getItemCount() < mMaxItemCount;
     if (not_too_big)
     {
@@ -676,18 +693,21 @@ bool LLScrollListCtrl::addItem( LLScrollListItem* item, EAddPosition pos, bool r
         {
         case ADD_TOP:
             mItemList.push_front(item);
+            mFilteredItemsDirty = true;
             setNeedsSort();
             break;
 
         case ADD_DEFAULT:
         case ADD_BOTTOM:
             mItemList.push_back(item);
+            mFilteredItemsDirty = true;
             setNeedsSort();
             break;
 
         default:
             llassert(0);
             mItemList.push_back(item);
+            mFilteredItemsDirty = true;
             setNeedsSort();
             break;
         }
@@ -929,6 +949,13 @@ void LLScrollListCtrl::setPageLines(S32 new_page_lines)
 
 bool LLScrollListCtrl::selectFirstItem()
 {
+    if (mDataSource)
+    {
+        bool success = selectItemRange(0, 0);
+        mOriginalSelection = 0;
+        return success;
+    }
+
     bool success = false;
 
     // our $%&@#$()^%#$()*^ iterators don't let us check against the first item inside out iteration
@@ -974,14 +1001,14 @@ bool LLScrollListCtrl::selectFirstItem()
 bool LLScrollListCtrl::selectNthItem(S32 target_index)
 {
     // <FS:Ansariel> FIRE-30571: Comboboxes select all items then pressing Page-Up
-    target_index = llclamp(target_index, 0, (S32)mItemList.size() - 1);
+    target_index = llclamp(target_index, 0, getItemCount() - 1);
     return selectItemRange(target_index, target_index);
 }
 
 // virtual
 bool LLScrollListCtrl::selectItemRange(S32 first_index, S32 last_index)
 {
-    if (mItemList.empty())
+    if (isEmpty())
     {
         return false;
     }
@@ -989,11 +1016,46 @@ bool LLScrollListCtrl::selectItemRange(S32 first_index, S32 last_index)
     // make sure sort is up to date
     updateSort();
 
-    S32 bottom = (S32)mItemList.size() - 1;
+    S32 bottom = (mDataSource ? getItemCount() : (S32)mItemList.size()) - 1;
     first_index = llclamp(first_index, 0, bottom);
     last_index = last_index < 0 ? bottom : llclamp(last_index, first_index, bottom);
 
     bool success = false;
+    if (mDataSource)
+    {
+        // only the rows in the range are built
+        std::set<U32> rows;
+        for (S32 line = first_index; line <= last_index; ++line)
+        {
+            rows.insert(getSourceRow(line));
+        }
+        for (const auto& built : mSourceItems)
+        {
+            if (!rows.count(built.first))
+            {
+                deselectItem(built.second);
+            }
+        }
+        for (S32 line = first_index; line <= last_index; ++line)
+        {
+            LLScrollListItem* itemp = getDisplayRow(line);
+            if (itemp->getEnabled())
+            {
+                selectItem(itemp, -1, false);
+                success = true;
+            }
+        }
+
+        if (mCommitOnSelectionChange)
+        {
+            commitIfChanged();
+        }
+
+        mSearchString.clear();
+
+        return success;
+    }
+
     S32 index = 0;
     for (item_list::iterator iter = mItemList.begin(); iter != mItemList.end(); )
     {
@@ -1001,6 +1063,7 @@ bool LLScrollListCtrl::selectItemRange(S32 first_index, S32 last_index)
         if (!itemp)
         {
             iter = mItemList.erase(iter);
+            mFilteredItemsDirty = true;
             continue;
         }
 
@@ -1051,6 +1114,7 @@ void LLScrollListCtrl::swapWithNext(S32 index)
     LLScrollListItem *cur_itemp = mItemList[index];
     mItemList[index] = mItemList[index + 1];
     mItemList[index + 1] = cur_itemp;
+    mFilteredItemsDirty = true;
 }
 
 
@@ -1065,11 +1129,18 @@ void LLScrollListCtrl::swapWithPrevious(S32 index)
     LLScrollListItem *cur_itemp = mItemList[index];
     mItemList[index] = mItemList[index - 1];
     mItemList[index - 1] = cur_itemp;
+    mFilteredItemsDirty = true;
 }
 
 
 void LLScrollListCtrl::deleteSingleItem(S32 target_index)
 {
+    if (mDataSource)
+    {
+        LL_WARNS() << "Rows of " << getName() << " are deleted from its data source" << LL_ENDL;
+        return;
+    }
+
     if (target_index < 0 || target_index >= (S32)mItemList.size())
     {
         return;
@@ -1085,12 +1156,19 @@ void LLScrollListCtrl::deleteSingleItem(S32 target_index)
     }
     delete itemp;
     mItemList.erase(mItemList.begin() + target_index);
+    mFilteredItemsDirty = true;
     dirtyColumns();
 }
 
 //FIXME: refactor item deletion
 void LLScrollListCtrl::deleteItems(const LLSD& sd)
 {
+    if (mDataSource)
+    {
+        LL_WARNS() << "Rows of " << getName() << " are deleted from its data source" << LL_ENDL;
+        return;
+    }
+
     item_list::iterator iter;
     for (iter = mItemList.begin(); iter < mItemList.end(); )
     {
@@ -1103,6 +1181,7 @@ void LLScrollListCtrl::deleteItems(const LLSD& sd)
             }
             delete itemp;
             iter = mItemList.erase(iter);
+            mFilteredItemsDirty = true;
         }
         else
         {
@@ -1115,6 +1194,12 @@ void LLScrollListCtrl::deleteItems(const LLSD& sd)
 
 void LLScrollListCtrl::deleteSelectedItems()
 {
+    if (mDataSource)
+    {
+        LL_WARNS() << "Rows of " << getName() << " are deleted from its data source" << LL_ENDL;
+        return;
+    }
+
     item_list::iterator iter;
     for (iter = mItemList.begin(); iter != mItemList.end(); )
     {
@@ -1123,6 +1208,7 @@ void LLScrollListCtrl::deleteSelectedItems()
         {
             delete itemp;
             iter = mItemList.erase(iter);
+            mFilteredItemsDirty = true;
         }
         else
         {
@@ -1145,9 +1231,9 @@ void LLScrollListCtrl::mouseOverHighlightNthItem(S32 target_index)
 {
     if (mHighlightedItem != target_index)
     {
-        if (mHighlightedItem >= 0 && mHighlightedItem < mItemList.size())
+        if (mHighlightedItem >= 0 && mHighlightedItem < getDisplayRowCount())
         {
-            mItemList[mHighlightedItem]->setHoverCell(-1);
+            getDisplayRow(mHighlightedItem)->setHoverCell(-1);
         }
         mHighlightedItem = target_index;
     }
@@ -1185,6 +1271,11 @@ S32 LLScrollListCtrl::getItemIndex( LLScrollListItem* target_item ) const
 {
     updateSort();
 
+    if (mDataSource)
+    {
+        return getSourceLine(target_item);
+    }
+
     S32 index = 0;
     item_list::const_iterator iter;
     for (iter = mItemList.begin(); iter != mItemList.end(); iter++)
@@ -1209,6 +1300,18 @@ S32 LLScrollListCtrl::getItemIndex( const LLUUID& target_id ) const
 {
     updateSort();
 
+    if (mDataSource)
+    {
+        for (S32 line = 0, count = getDisplayRowCount(); line < count; ++line)
+        {
+            if (mDataSource->getRowValue(getSourceRow(line)).asUUID() == target_id)
+            {
+                return line;
+            }
+        }
+        return -1;
+    }
+
     S32 index = 0;
     item_list::const_iterator iter;
     for (iter = mItemList.begin(); iter != mItemList.end(); iter++)
@@ -1232,6 +1335,28 @@ void LLScrollListCtrl::selectPrevItem( bool extend_selection)
         // select last item
         selectNthItem(getItemCount() - 1);
     }
+    else if (mDataSource)
+    {
+        updateSort();
+
+        S32 line = getSelectedSourceLine(false);
+        LLScrollListItem* cur_item = getDisplayRow(line);
+        while (!prev_item && --line >= 0)
+        {
+            // don't allow navigation to disabled elements
+            LLScrollListItem* item = getDisplayRow(line);
+            prev_item = item->getEnabled() ? item : NULL;
+        }
+
+        if (prev_item)
+        {
+            selectItem(prev_item, cur_item->getSelectedCell(), !extend_selection);
+        }
+        else
+        {
+            reportInvalidInput();
+        }
+    }
     else
     {
         updateSort();
@@ -1275,6 +1400,29 @@ void LLScrollListCtrl::selectNextItem( bool extend_selection)
     {
         selectFirstItem();
     }
+    else if (mDataSource)
+    {
+        updateSort();
+
+        S32 line = getSelectedSourceLine(true);
+        LLScrollListItem* cur_item = getDisplayRow(line);
+        S32 count = getDisplayRowCount();
+        while (!next_item && ++line < count)
+        {
+            // don't allow navigation to disabled items
+            LLScrollListItem* item = getDisplayRow(line);
+            next_item = item->getEnabled() ? item : NULL;
+        }
+
+        if (next_item)
+        {
+            selectItem(next_item, cur_item->getSelectedCell(), !extend_selection);
+        }
+        else
+        {
+            reportInvalidInput();
+        }
+    }
     else
     {
         updateSort();
@@ -1769,43 +1917,27 @@ void LLScrollListCtrl::drawItems()
         static LLUICachedControl<F32> type_ahead_timeout ("TypeAheadTimeout", 0);
         highlight_color.mV[VALPHA] = clamp_rescale(mSearchTimer.getElapsedTimeF32(), type_ahead_timeout * 0.7f, type_ahead_timeout(), 0.4f, 0.f);
 
-        // <FS:Ansariel> Fix for FS-specific people list (radar)
-        //S32 first_line = mScrollLines;
-        //S32 last_line = llmin((S32)mItemList.size() - 1, mScrollLines + getLinesPerPage());
-        S32 first_line;
-        S32 last_line;
-        if (mIsFiltered)
+        // only the rows of the current page, filtered or not
+        S32 row_count = getDisplayRowCount();
+        S32 first_line = mScrollLines;
+        if (mDataSource && first_line < row_count)
         {
-            first_line = 0;
-            last_line = (S32)mItemList.size() - 1;
+            // a page is as many lines as fit, once one is built
+            getDisplayRow(first_line);
         }
-        else
+        S32 last_line = llmin(row_count - 1, mScrollLines + getLinesPerPage());
+
+        if (mDataSource)
         {
-            first_line = mScrollLines;
-            last_line = llmin((S32)mItemList.size() - 1, mScrollLines + getLinesPerPage());
+            trimSourceRows(first_line, last_line);
         }
-        S32 line = first_line;
-        // </FS:Ansariel> Fix for FS-specific people list (radar)
-
-        if (first_line >= mItemList.size())
+        if (first_line >= row_count)
         {
             return;
         }
-        item_list::iterator iter;
-        // <FS:Ansariel> Fix for FS-specific people list (radar)
-        //for (S32 line = first_line; line <= last_line; line++)
-        //{
-        //  LLScrollListItem* item = mItemList[line];
-        for (S32 itline = first_line; itline <= last_line; itline++)
+        for (S32 line = first_line; line <= last_line; line++)
         {
-            LLScrollListItem* item = mItemList[itline];
-
-            // <FS:Ansariel> Fix for FS-specific people list (radar)
-            if (isFiltered(item))
-            {
-                continue;
-            }
-        // </FS:Ansariel> Fix for FS-specific people list (radar)
+            LLScrollListItem* item = getDisplayRow(line);
 
             item_rect.setOriginAndSize(
                 x,
@@ -1869,9 +2001,6 @@ void LLScrollListCtrl::drawItems()
 
                 cur_y -= mLineHeight;
             }
-            // <FS:Ansariel> Fix for FS-specific people list (radar)
-            line++;
-            // </FS:Ansariel> Fix for FS-specific people list (radar)
         }
     }
 }
@@ -1911,7 +2040,7 @@ void LLScrollListCtrl::draw()
 
     updateColumns();
 
-    mCommentText->setVisible(mItemList.empty());
+    mCommentText->setVisible(isEmpty());
 
     drawItems();
 
@@ -2042,6 +2171,29 @@ bool LLScrollListCtrl::selectItemAt(S32 x, S32 y, MASK mask)
                 {
                     selectItem(hit_item, getColumnIndexFromOffset(x));
                 }
+                else if (mDataSource)
+                {
+                    // Select everthing between mLastSelected and hit_item,
+                    // building those rows
+                    S32 first_line = getSourceLine(mLastSelected);
+                    S32 last_line = getSourceLine(hit_item);
+                    if (first_line > last_line)
+                    {
+                        std::swap(first_line, last_line);
+                    }
+                    for (S32 line = llmax(first_line, 0); line <= last_line; ++line)
+                    {
+                        if (mMaxSelectable > 0 && getAllSelected().size() >= mMaxSelectable)
+                        {
+                            if (mOnMaximumSelectCallback)
+                            {
+                                mOnMaximumSelectCallback();
+                            }
+                            break;
+                        }
+                        selectItem(getDisplayRow(line), getColumnIndexFromOffset(x), false);
+                    }
+                }
                 else
                 {
                     // Select everthing between mLastSelected and hit_item
@@ -2453,29 +2605,17 @@ LLScrollListItem* LLScrollListCtrl::hitItem( S32 x, S32 y )
     //S32 num_page_lines = getLinesPerPage();
     S32 num_page_lines = getLinesPerPage() + 1;
 
-    S32 line = 0;
-    item_list::iterator iter;
-    for(iter = mItemList.begin(); iter != mItemList.end(); iter++)
+    S32 last_line = llmin(getDisplayRowCount(), mScrollLines + num_page_lines);
+    for (S32 line = mScrollLines; line < last_line; line++)
     {
-        LLScrollListItem* item  = *iter;
-        // <FS:Ansariel> Fix for FS-specific people list (radar)
-        if (isFiltered(item))
+        LLScrollListItem* item = getDisplayRow(line);
+        if( item->getEnabled() && item_rect.pointInRect( x, y ) )
         {
-            continue;
+            hit_item = item;
+            break;
         }
-        // </FS:Ansariel> Fix for FS-specific people list (radar)
-
-        if( mScrollLines <= line && line < mScrollLines + num_page_lines )
-        {
-            if( item->getEnabled() && item_rect.pointInRect( x, y ) )
-            {
-                hit_item = item;
-                break;
-            }
 
-            item_rect.translate(0, -mLineHeight);
-        }
-        line++;
+        item_rect.translate(0, -mLineHeight);
     }
 
     return hit_item;
@@ -3185,10 +3325,7 @@ void LLScrollListCtrl::updateSort() const
         mLastUpdateFrame=0;
     // </FS:Beq>
         // do stable sort to preserve any previous sorts
-        std::stable_sort(
-            mItemList.begin(),
-            mItemList.end(),
-            SortScrollListItem(mSortColumns,mSortCallback, mAlternateSort));
+        sortItems(mSortColumns);
 
         mSorted = true;
     }
@@ -3201,16 +3338,82 @@ void LLScrollListCtrl::sortOnce(S32 column, bool ascending)
     sort_column.push_back(std::make_pair(column, ascending));
 
     // do stable sort to preserve any previous sorts
-    std::stable_sort(
-        mItemList.begin(),
-        mItemList.end(),
-        SortScrollListItem(sort_column,mSortCallback,mAlternateSort));
+    sortItems(sort_column);
+}
+
+void LLScrollListCtrl::sortItems(const std::vector<std::pair<S32, bool> >& sort_orders) const
+{
+    mFilteredItemsDirty = true;
+
+    if (mDataSource)
+    {
+        // Same order as the items would get, from the source's cell values
+        LLScrollListSortKeys keys(sort_orders, false, mSourceOrder.size());
+        for (size_t i = 0; i < sort_orders.size(); ++i)
+        {
+            S32 column = sort_orders[i].first;
+            if (column < 0 || column >= (S32)mColumnsIndexed.size() || !mColumnsIndexed[column])
+            {
+                continue;
+            }
+            const std::string& name = mColumnsIndexed[column]->mName;
+            for (size_t line = 0; line < mSourceOrder.size(); ++line)
+            {
+                keys.setKey(line, i, mDataSource->getCellValue(mSourceOrder[line], name).asString());
+            }
+        }
+
+        std::vector<U32> order;
+        keys.sort(order);
+        for (U32& line : order)
+        {
+            line = mSourceOrder[line];
+        }
+        mSourceOrder.swap(order);
+        return;
+    }
+
+    if (mSortCallback)
+    {
+        // the callback compares the items themselves
+        std::stable_sort(
+            mItemList.begin(),
+            mItemList.end(),
+            SortScrollListItem(sort_orders, mSortCallback, mAlternateSort));
+        return;
+    }
+
+    // Extract the cells' values once rather than on every comparison
+    LLScrollListSortKeys keys(sort_orders, mAlternateSort, mItemList.size());
+    for (size_t row = 0; row < mItemList.size(); ++row)
+    {
+        const LLScrollListItem* item = mItemList[row];
+        for (size_t i = 0; i < sort_orders.size(); ++i)
+        {
+            if (const LLScrollListCell* cell = item->getColumn(sort_orders[i].first))
+            {
+                keys.setKey(row, i, cell->getValue().asString(),
+                            mAlternateSort ? cell->getAltValue().asString() : std::string());
+            }
+        }
+    }
+
+    std::vector<U32> order;
+    keys.sort(order);
+
+    item_list sorted;
+    for (U32 row : order)
+    {
+        sorted.push_back(mItemList[row]);
+    }
+    mItemList.swap(sorted);
 }
 
 void LLScrollListCtrl::dirtyColumns()
 {
     mColumnsDirty = true;
     mColumnWidthsDirty = true;
+    mFilteredItemsDirty = true;
 
     // need to keep mColumnsIndexed up to date
     // just in case someone indexes into it immediately
@@ -3256,7 +3459,7 @@ void LLScrollListCtrl::scrollToShowSelected()
         return;
     }
 
-    LLScrollListItem* item = mItemList[index];
+    LLScrollListItem* item = getDisplayRow(index);
     if (!item)
     {
         // I don't THINK this should ever happen.
@@ -3321,6 +3524,25 @@ bool LLScrollListCtrl::canCut() const
 // virtual
 void LLScrollListCtrl::selectAll()
 {
+    if (mDataSource)
+    {
+        // builds every row
+        for (S32 line = 0, count = getDisplayRowCount(); line < count; ++line)
+        {
+            LLScrollListItem* itemp = getDisplayRow(line);
+            if (itemp->getEnabled())
+            {
+                selectItem(itemp, -1, false);
+            }
+        }
+
+        if (mCommitOnSelectionChange)
+        {
+            commitIfChanged();
+        }
+        return;
+    }
+
     // Deselects all other items
     item_list::iterator iter;
     for (iter = mItemList.begin(); iter != mItemList.end(); iter++)
@@ -3341,7 +3563,8 @@ void LLScrollListCtrl::selectAll()
 // virtual
 bool LLScrollListCtrl::canSelectAll() const
 {
-    return getCanSelect() && mAllowMultipleSelection && !(mMaxSelectable > 0 && mItemList.size() > mMaxSelectable);
+    size_t rows = mDataSource ? mSourceOrder.size() : mItemList.size();
+    return getCanSelect() && mAllowMultipleSelection && !(mMaxSelectable > 0 && rows > mMaxSelectable);
 }
 
 // virtual
@@ -3626,6 +3849,13 @@ LLScrollListItem* LLScrollListCtrl::addRow(LLScrollListItem *new_item, const LLS
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_UI;
     if (!item_p.validateBlock() || !new_item) return NULL;
+    initItemCells(new_item, item_p);
+    addItem(new_item, pos);
+    return new_item;
+}
+
+void LLScrollListCtrl::initItemCells(LLScrollListItem* new_item, const LLScrollListItem::Params& item_p)
+{
     new_item->setNumColumns(static_cast<S32>(mColumns.size()));
 
     // Add any columns we don't already have
@@ -3725,9 +3955,6 @@ LLScrollListItem* LLScrollListCtrl::addRow(LLScrollListItem *new_item, const LLS
             new_item->setColumn(column_idx, new LLScrollListSpacer(cell_p));
         }
     }
-
-    addItem(new_item, pos);
-    return new_item;
 }
 
 LLScrollListItem* LLScrollListCtrl::addSimpleElement(const std::string& value, EAddPosition pos, const LLSD& id)
@@ -3903,6 +4130,7 @@ void LLScrollListCtrl::setFilterString(const std::string& str)
     mFilterString = str;
     std::transform(mFilterString.begin(), mFilterString.end(), mFilterString.begin(), ::tolower);
     mIsFiltered = (mFilterColumn > -1 && !mFilterString.empty());
+    mFilteredItemsDirty = true;
     updateLayout();
 
     if (mIsFiltered && getNumSelected() > 0 && isFiltered(getFirstSelected()))
@@ -3931,8 +4159,247 @@ bool LLScrollListCtrl::isFiltered(const LLScrollListItem* item) const
     }
     return false;
 }
+
+S32 LLScrollListCtrl::getDisplayRowCount() const
+{
+    if (mDataSource)
+    {
+        updateSourceLines();
+        return static_cast<S32>(mIsFiltered ? mSourceLines.size() : mSourceOrder.size());
+    }
+    if (mIsFiltered)
+    {
+        updateFilteredItems();
+        return static_cast<S32>(mFilteredItems.size());
+    }
+    return static_cast<S32>(mItemList.size());
+}
+
+LLScrollListItem* LLScrollListCtrl::getDisplayRow(S32 line)
+{
+    if (mDataSource)
+    {
+        return buildSourceRow(getSourceRow(line));
+    }
+    if (mIsFiltered)
+    {
+        updateFilteredItems();
+        return mFilteredItems[line];
+    }
+    return mItemList[line];
+}
+
+void LLScrollListCtrl::updateFilteredItems() const
+{
+    U32 frame = LLFrameTimer::getFrameCount();
+    if (!mFilteredItemsDirty && mFilteredItemsFrame == frame)
+    {
+        return;
+    }
+    mFilteredItemsDirty = false;
+    mFilteredItemsFrame = frame;
+
+    mFilteredItems.clear();
+    for (LLScrollListItem* item : mItemList)
+    {
+        if (!isFiltered(item))
+        {
+            mFilteredItems.push_back(item);
+        }
+    }
+}
 // </FS:Ansariel> Fix for FS-specific people list (radar)
 
+void LLScrollListCtrl::setDataSource(LLScrollListDataSource* source)
+{
+    clearRows();
+    mDataSource = source;
+    mSourceOrder.clear();
+    mSourceLines.clear();
+    dataSourceChanged();
+}
+
+void LLScrollListCtrl::dataSourceChanged()
+{
+    if (!mDataSource)
+    {
+        updateLayout();
+        return;
+    }
+
+    // Rows may have moved or changed: the built ones go, and the selected
+    // ones are built again from the rows with the same values
+    std::set<std::string> selected;
+    std::string last_selected = mLastSelected ? mLastSelected->getValue().asString() : std::string();
+    for (LLScrollListItem* item : mItemList)
+    {
+        if (item->getSelected())
+        {
+            selected.insert(item->getValue().asString());
+        }
+    }
+    std::for_each(mItemList.begin(), mItemList.end(), DeletePointer());
+    mItemList.clear();
+    mSourceItems.clear();
+    mLastSelected = NULL;
+
+    U32 rows = (U32)llmax(mDataSource->getRowCount(), 0);
+    mSourceOrder.resize(rows);
+    std::iota(mSourceOrder.begin(), mSourceOrder.end(), 0);
+    if (!mLineHeight && rows > 0)
+    {
+        // the line height comes from the cells, and sizes the pages
+        buildSourceRow(0);
+    }
+    for (U32 row = 0; row < rows && !selected.empty(); ++row)
+    {
+        auto found = selected.find(mDataSource->getRowValue(row).asString());
+        if (found != selected.end())
+        {
+            LLScrollListItem* item = buildSourceRow(row);
+            item->setSelected(true);
+            if (*found == last_selected)
+            {
+                mLastSelected = item;
+            }
+            selected.erase(found);
+        }
+    }
+
+    mFilteredItemsDirty = true;
+    setNeedsSort();
+    updateLayout();
+}
+
+U32 LLScrollListCtrl::getSourceRow(S32 line) const
+{
+    updateSourceLines();
+    return mIsFiltered ? mSourceLines[line] : mSourceOrder[line];
+}
+
+S32 LLScrollListCtrl::getSourceLine(const LLScrollListItem* item) const
+{
+    for (const auto& built : mSourceItems)
+    {
+        if (built.second == item)
+        {
+            // mostly asked about rows in view
+            S32 count = getDisplayRowCount();
+            S32 page_end = llmin(count, mScrollLines + mScrollbar->getPageSize() + 1);
+            for (S32 line = llmin(mScrollLines, count); line < page_end; ++line)
+            {
+                if (getSourceRow(line) == built.first)
+                {
+                    return line;
+                }
+            }
+            for (S32 line = 0; line < count; ++line)
+            {
+                if (getSourceRow(line) == built.first)
+                {
+                    return line;
+                }
+            }
+            break;
+        }
+    }
+    return -1;
+}
+
+S32 LLScrollListCtrl::getSelectedSourceLine(bool last) const
+{
+    S32 found = -1;
+    for (S32 line = 0, count = getDisplayRowCount(); line < count; ++line)
+    {
+        auto built = mSourceItems.find(getSourceRow(line));
+        if (built != mSourceItems.end() && built->second->getSelected())
+        {
+            found = line;
+            if (!last)
+            {
+                break;
+            }
+        }
+    }
+    return found;
+}
+
+void LLScrollListCtrl::updateSourceLines() const
+{
+    // sorting changes the lines
+    updateSort();
+    if (!mIsFiltered || !mFilteredItemsDirty)
+    {
+        return;
+    }
+    mFilteredItemsDirty = false;
+
+    mSourceLines.clear();
+    if (mFilterColumn >= (S32)mColumnsIndexed.size() || !mColumnsIndexed[mFilterColumn])
+    {
+        return;
+    }
+    const std::string& column = mColumnsIndexed[mFilterColumn]->mName;
+    for (U32 row : mSourceOrder)
+    {
+        std::string value = mDataSource->getCellValue(row, column).asString();
+        std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+        if (value.find(mFilterString) != std::string::npos)
+        {
+            mSourceLines.push_back(row);
+        }
+    }
+}
+
+LLScrollListItem* LLScrollListCtrl::buildSourceRow(U32 row)
+{
+    auto built = mSourceItems.find(row);
+    if (built != mSourceItems.end())
+    {
+        return built->second;
+    }
+
+    LLSD element;
+    mDataSource->getRowElement(row, element);
+    LLScrollListItem::Params item_params;
+    LLParamSDParser parser;
+    parser.readSD(element, item_params);
+
+    LLScrollListItem* item = new LLScrollListItem(item_params);
+    initItemCells(item, item_params);
+    mDataSource->onRowBuilt(row, item);
+    updateLineHeightInsert(item);
+    mItemList.push_back(item);
+    mSourceItems[row] = item;
+    return item;
+}
+
+void LLScrollListCtrl::trimSourceRows(S32 first_line, S32 last_line)
+{
+    std::set<U32> rows;
+    for (S32 line = first_line; line <= last_line; ++line)
+    {
+        rows.insert(getSourceRow(line));
+    }
+
+    for (auto built = mSourceItems.begin(); built != mSourceItems.end(); )
+    {
+        LLScrollListItem* item = built->second;
+        if (item->getSelected() || rows.count(built->first))
+        {
+            ++built;
+            continue;
+        }
+        mItemList.erase(std::find(mItemList.begin(), mItemList.end(), item));
+        if (mLastSelected == item)
+        {
+            mLastSelected = NULL;
+        }
+        delete item;
+        built = mSourceItems.erase(built);
+    }
+}
+
 // <FS:Ansariel> Persists sort order of scroll lists
 void LLScrollListCtrl::loadPersistedSortOrder()
 {
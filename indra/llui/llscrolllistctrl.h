@@ -31,6 +31,7 @@
 
 #include <vector>
 #include <deque>
+#include <map>
 
 #include "lluictrl.h"
 #include "llctrlselectioninterface.h"
@@ -50,6 +51,26 @@ class LLScrollListCell;
 class LLTextBox;
 class LLContextMenu;
 
+// Rows of a list in data source mode, see LLScrollListCtrl::setDataSource().
+// Rows are numbered from 0 in the source's own order.
+class LLScrollListDataSource
+{
+public:
+    virtual ~LLScrollListDataSource() {}
+
+    virtual S32 getRowCount() const = 0;
+    // Value of the row's item, which identifies the row across changes
+    virtual LLSD getRowValue(S32 row) const = 0;
+    // Value of the row's cell in the named column, which the list sorts
+    // and filters on without building the row
+    virtual LLSD getCellValue(S32 row, const std::string& column) const = 0;
+    // The row, as taken by LLScrollListCtrl::addElement()
+    virtual void getRowElement(S32 row, LLSD& element) const = 0;
+    // Called on the item built from the row, for what the element can't
+    // say, such as cell colors
+    virtual void onRowBuilt(S32 row, LLScrollListItem* item) const {}
+};
+
 class LLScrollListCtrl : public LLUICtrl, public LLEditMenuHandler,
     public LLCtrlListInterface, public LLCtrlScrollInterface
 {
@@ -189,6 +210,18 @@ public:
     // "columns" => [ "column" => column name, "value" => value, "type" => type, "font" => font, "font-style" => style ], "id" => uuid
     // Creates missing columns automatically.
     virtual LLScrollListItem* addElement(const LLSD& element, EAddPosition pos = ADD_BOTTOM, void* userdata = NULL);
+    // Data source mode, for lists too long to build an item for every
+    // row: the list keeps the order of source's rows in a flat array,
+    // sorted and filtered on their cell values, and builds items only for
+    // the rows in view and the selected ones.  The item functions see just
+    // those, and selecting all the rows builds them all.  Rows are added
+    // and deleted by the source, which calls dataSourceChanged() when its
+    // rows change, and outlives the list or is reset with NULL.  Sort
+    // callbacks compare items and are not used in this mode.
+    void            setDataSource(LLScrollListDataSource* source);
+    LLScrollListDataSource* getDataSource() const { return mDataSource; }
+    // The selected rows are kept, by value
+    void            dataSourceChanged();
     virtual LLScrollListItem* addRow(LLScrollListItem *new_item, const LLScrollListItem::Params& value, EAddPosition pos = ADD_BOTTOM);
     virtual LLScrollListItem* addRow(const LLScrollListItem::Params& value, EAddPosition pos = ADD_BOTTOM);
     // Simple add element. Takes a single array of:
@@ -350,7 +383,7 @@ public:
 
     // <FS:Ansariel> Fix for FS-specific people list (radar)
     void            setFilterString(const std::string& str);
-    void            setFilterColumn(S32 col) { mFilterColumn = col; }
+    void            setFilterColumn(S32 col) { mFilterColumn = col; mFilteredItemsDirty = true; }
     bool            isFiltered(const LLScrollListItem* item) const;
     // </FS:Ansariel> Fix for FS-specific people list (radar)
 
@@ -496,9 +529,27 @@ private:
     void            selectItem(LLScrollListItem* itemp, S32 cell, bool single_select = true);
     void            deselectItem(LLScrollListItem* itemp);
     void            commitIfChanged();
+    void            initItemCells(LLScrollListItem* item, const LLScrollListItem::Params& item_p);
     bool            setSort(S32 column, bool ascending);
+    void            sortItems(const std::vector<std::pair<S32, bool> >& sort_orders) const;
     S32             getLinesPerPage();
 
+    // Rows as displayed: the items passing the filter, or all of them.
+    // Drawing and hit testing only look at the rows of the current page.
+    // getDisplayRow() indexes the rows counted by getDisplayRowCount(),
+    // building the row in data source mode.
+    S32             getDisplayRowCount() const;
+    LLScrollListItem* getDisplayRow(S32 line);
+    void            updateFilteredItems() const;
+
+    // Data source mode
+    U32             getSourceRow(S32 line) const;
+    S32             getSourceLine(const LLScrollListItem* item) const;
+    S32             getSelectedSourceLine(bool last) const;
+    void            updateSourceLines() const;
+    LLScrollListItem* buildSourceRow(U32 row);
+    void            trimSourceRows(S32 first_line, S32 last_line);
+
     // <FS:Ansariel> Persists sort order of scroll lists
     void            loadPersistedSortOrder();
 
@@ -575,6 +626,19 @@ private:
     std::string     mFilterString;
     S32             mFilterColumn;
     bool            mIsFiltered;
+    // items passing the filter, rebuilt when the list changes and once a
+    // frame, as cells may be edited in place
+    mutable std::vector<LLScrollListItem*> mFilteredItems;
+    mutable U32     mFilteredItemsFrame;
+    mutable bool    mFilteredItemsDirty;
+
+    LLScrollListDataSource* mDataSource;
+    // source rows in sort order, and those of them passing the filter,
+    // which mFilteredItemsDirty also stands for
+    mutable std::vector<U32> mSourceOrder;
+    mutable std::vector<U32> mSourceLines;
+    // items built from source rows, in mItemList too
+    std::map<U32, LLScrollListItem*> mSourceItems;
 
     S32             mSearchColumn;
     S32             mNumDynamicWidthColumns;
@@ -0,0 +1,89 @@
+/**
+ * @file llscrolllistsortkeys.cpp
+ * @brief Sort keys of the rows of a scroll list, extracted once per sort.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llscrolllistsortkeys.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "llstring.h"
+
+LLScrollListSortKeys::LLScrollListSortKeys(const sort_order_t& sort_orders, bool alternate_sort, size_t rows)
+:   mSortOrders(sort_orders),
+    mAltSort(alternate_sort),
+    mRows(rows),
+    mKeys(rows * sort_orders.size())
+{
+}
+
+void LLScrollListSortKeys::setKey(size_t row, size_t order, std::string&& value, std::string&& alt_value)
+{
+    Key& key = mKeys[order * mRows + row];
+    key.mValue = std::move(value);
+    key.mAltValue = std::move(alt_value);
+    key.mValid = true;
+}
+
+bool LLScrollListSortKeys::precedes(U32 row1, U32 row2) const
+{
+    // sort over all columns in order specified by mSortOrders
+    S32 sort_result = 0;
+    for (size_t i = mSortOrders.size(); i-- > 0; )
+    {
+        const Key& key1 = mKeys[i * mRows + row1];
+        const Key& key2 = mKeys[i * mRows + row2];
+        if (!key1.mValid || !key2.mValid)
+        {
+            continue;
+        }
+
+        S32 order = mSortOrders[i].second ? 1 : -1; // ascending or descending sort for this column?
+        if (mAltSort && !key1.mAltValue.empty() && !key2.mAltValue.empty())
+        {
+            sort_result = order * LLStringUtil::compareDict(key1.mAltValue, key2.mAltValue);
+        }
+        else
+        {
+            sort_result = order * LLStringUtil::compareDict(key1.mValue, key2.mValue);
+        }
+        if (sort_result != 0)
+        {
+            break; // we have a sort order!
+        }
+    }
+
+    return sort_result < 0;
+}
+
+void LLScrollListSortKeys::sort(std::vector<U32>& rows) const
+{
+    rows.resize(mRows);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::stable_sort(rows.begin(), rows.end(),
+                     [this](U32 row1, U32 row2) { return precedes(row1, row2); });
+}
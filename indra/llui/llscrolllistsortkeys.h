@@ -0,0 +1,77 @@
+/**
+ * @file llscrolllistsortkeys.h
+ * @brief Sort keys of the rows of a scroll list, extracted once per sort.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLSCROLLLISTSORTKEYS_H
+#define LL_LLSCROLLLISTSORTKEYS_H
+
+#include <string>
+#include <vector>
+
+//
+// LLScrollListCtrl sorts by comparing the values of the sort columns'
+// cells, and used to convert them from LLSD to strings on every
+// comparison: sorting a list of 100k rows made millions of string copies.
+// This keeps each row's keys in one flat array, extracted once, and sorts
+// row indices over it.  The order is the one the comparison on cells
+// gives: stable, the last sort column is the primary one, and a column
+// whose cell is missing from either row is skipped.
+//
+class LLScrollListSortKeys
+{
+public:
+    // column, ascending; the last one is the primary sort column
+    typedef std::vector<std::pair<S32, bool> > sort_order_t;
+
+    // With alternate_sort, rows are compared on their alternate values
+    // when both have one.
+    LLScrollListSortKeys(const sort_order_t& sort_orders, bool alternate_sort, size_t rows);
+
+    const sort_order_t& getSortOrders() const { return mSortOrders; }
+
+    // Keys of row for the order-th entry of the sort orders.  Rows that
+    // don't have the column are left without a key.
+    void setKey(size_t row, size_t order, std::string&& value, std::string&& alt_value = std::string());
+
+    // Stable order of the rows, as indices
+    void sort(std::vector<U32>& rows) const;
+
+private:
+    struct Key
+    {
+        std::string mValue;
+        std::string mAltValue;
+        bool mValid = false;
+    };
+
+    bool precedes(U32 row1, U32 row2) const;
+
+    const sort_order_t& mSortOrders;
+    const bool mAltSort;
+    const size_t mRows;
+    std::vector<Key> mKeys;     // mRows per sort order entry, in that order
+};
+
+#endif // LL_LLSCROLLLISTSORTKEYS_H
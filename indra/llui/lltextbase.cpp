@@ -29,6 +29,7 @@
 
 #include "lltextbase.h"
 
+#include "hbxxh.h"
 #include "llemojidictionary.h"
 #include "llemojihelper.h"
 #include "lllocalcliprect.h"
@@ -1976,6 +1977,7 @@ void LLTextBase::reflow()
         const F32 text_available_width = (F32)(mVisibleTextRect.getWidth() - mHPad);  // reserve room for margin
         F32 remaining_pixels = text_available_width;
         S32 line_count = 0;
+        bool paragraph_start = true;
 
         // find and erase line info structs starting at start_index and going to end of document
         if (!mLineInfoList.empty())
@@ -1987,17 +1989,56 @@ void LLTextBase::reflow()
                 line_start_index = iter->mDocIndexStart;
                 line_count = iter->mLineNum;
                 cur_top = iter->mRect.mTop;
+                paragraph_start = (iter == mLineInfoList.begin()) || ((iter - 1)->mLineNum != iter->mLineNum);
                 getSegmentAndOffset(iter->mDocIndexStart, &seg_iter, &seg_offset);
                 mLineInfoList.erase(iter, mLineInfoList.end());
             }
         }
 
+        LLTextLayoutCache::Settings cache_settings;
+        cache_settings.mTextWidth = mVisibleTextRect.getWidth();
+        cache_settings.mHPad = mHPad;
+        cache_settings.mHAlign = mHAlign;
+        cache_settings.mLineSpacingMult = mLineSpacingMult;
+        cache_settings.mLineSpacingPixels = mLineSpacingPixels;
+        cache_settings.mWordWrap = getWordWrap();
+        cache_settings.mFontGeneration = LLFontGL::sResolutionGeneration;
+        mLayoutCache.beginLayout(cache_settings, line_start_index == 0);
+
+        // paragraph being laid out, to cache when it ends with a hard line break
+        segment_set_t::iterator paragraph_seg_iter = seg_iter;
+        S32 paragraph_seg_offset = 0;
+        S32 paragraph_start_index = 0;
+        size_t paragraph_first_line = 0;
+        S32 paragraph_top = 0;
+        S32 paragraph_line_count = 0;
+        bool paragraph_cacheable = false;
+
         S32 line_height = 0;
         S32 seg_line_offset = line_count + 1;
 
         while(seg_iter != mSegments.end())
         {
+            if (paragraph_start)
+            {
+                if (reuseParagraphLayout(seg_iter, seg_offset, line_start_index, cur_top, line_count))
+                {
+                    // still at the start of a paragraph
+                    seg_line_offset = line_count;
+                    continue;
+                }
+                paragraph_start = false;
+                paragraph_seg_iter = seg_iter;
+                paragraph_seg_offset = seg_offset;
+                paragraph_start_index = line_start_index;
+                paragraph_first_line = mLineInfoList.size();
+                paragraph_top = cur_top;
+                paragraph_line_count = line_count;
+                paragraph_cacheable = true;
+            }
+
             LLTextSegmentPtr segment = *seg_iter;
+            paragraph_cacheable = paragraph_cacheable && segment->canCacheLayout();
 
             // track maximum height of any segment on this line
             S32 cur_index = segment->getStart() + seg_offset;
@@ -2029,6 +2070,8 @@ void LLTextBase::reflow()
                             text_left + text_actual_width,
                             cur_top - line_height);
 
+            bool paragraph_end = false;
+
             // if we didn't finish the current segment...
             if (last_segment_char_on_line < segment->getEnd())
             {
@@ -2043,6 +2086,7 @@ void LLTextBase::reflow()
                 cur_top -= ll_round((F32)line_height * mLineSpacingMult) + mLineSpacingPixels;
                 remaining_pixels = text_available_width;
                 line_height = 0;
+                paragraph_end = force_newline;
             }
             // ...just consumed last segment..
             else if (++segment_set_t::iterator(seg_iter) == mSegments.end())
@@ -2070,6 +2114,7 @@ void LLTextBase::reflow()
                     cur_top -= ll_round((F32)line_height * mLineSpacingMult) + mLineSpacingPixels;
                     line_height = 0;
                     remaining_pixels = text_available_width;
+                    paragraph_end = true;
                 }
                 ++seg_iter;
                 seg_offset = 0;
@@ -2079,7 +2124,34 @@ void LLTextBase::reflow()
             {
                 line_count++;
             }
+
+            if (paragraph_end)
+            {
+                LLTextLayoutCache::Paragraph paragraph;
+                paragraph.mLength = line_start_index - paragraph_start_index;
+                if (paragraph_cacheable
+                    && paragraph.mLength > 0
+                    && getParagraphFingerprint(paragraph_seg_iter, paragraph_seg_offset, paragraph.mLength, paragraph.mFingerprint))
+                {
+                    paragraph.mHeight = paragraph_top - cur_top;
+                    paragraph.mLineCount = line_count - paragraph_line_count;
+                    paragraph.mLines.reserve(mLineInfoList.size() - paragraph_first_line);
+                    for (size_t i = paragraph_first_line; i < mLineInfoList.size(); ++i)
+                    {
+                        const line_info& line = mLineInfoList[i];
+                        LLRect rect = line.mRect;
+                        rect.translate(0, -paragraph_top);
+                        paragraph.mLines.push_back({ line.mDocIndexStart - paragraph_start_index,
+                                                     line.mDocIndexEnd - paragraph_start_index,
+                                                     rect,
+                                                     line.mLineNum - paragraph_line_count });
+                    }
+                    mLayoutCache.store(*paragraph_seg_iter, paragraph_seg_offset, std::move(paragraph));
+                }
+                paragraph_start = true;
+            }
         }
+        mLayoutCache.endLayout();
 
         // calculate visible region for diplaying text
         updateRects();
@@ -2130,6 +2202,105 @@ void LLTextBase::reflow()
     updateCursorXPos();
 }
 
+bool LLTextBase::getParagraphFingerprint(segment_set_t::iterator seg_iter, S32 seg_offset, S32 length, U64& fingerprint,
+                                         segment_set_t::iterator* end_iter, S32* end_offset) const
+{
+    const S32 start = (*seg_iter)->getStart() + seg_offset;
+    const S32 end = start + length;
+    const LLWString& text = getWText();
+    if (end > (S32)text.length())
+    {
+        return false;
+    }
+
+    // The segments: which ones, of what kind, with which style, where.  A
+    // segment freed and another allocated at its address in its place is
+    // only a match if it is laid out the same way anyway.
+    U64 hash = 14695981039346656037ULL;
+    auto mix = [&hash](U64 value)
+    {
+        hash = (hash ^ value) * 1099511628211ULL;
+    };
+    for (; seg_iter != mSegments.end() && (*seg_iter)->getStart() < end; ++seg_iter)
+    {
+        const LLTextSegment* segment = *seg_iter;
+        if (!segment->canCacheLayout())
+        {
+            return false;
+        }
+        F32 width;
+        S32 height;
+        segment->getDimensionsF32(0, 0, width, height);
+        mix((U64)(uintptr_t)segment);
+        mix((U64)(uintptr_t)&typeid(*segment));
+        mix((U64)(uintptr_t)segment->getStyle().get());
+        mix((U64)(llmax(segment->getStart(), start) - start));
+        mix((U64)(llmin(segment->getEnd(), end) - start));
+        mix((U64)height);
+        if (segment->getEnd() > end)
+        {
+            break;
+        }
+    }
+
+    fingerprint = hash ^ HBXXH64::digest(text.data() + start, length * sizeof(llwchar));
+
+    if (end_iter && end_offset)
+    {
+        // where the next paragraph starts, as reflow would get there
+        if (seg_iter != mSegments.end() && (*seg_iter)->getEnd() > end)
+        {
+            *end_iter = seg_iter;
+            *end_offset = end - (*seg_iter)->getStart();
+        }
+        else
+        {
+            *end_iter = seg_iter;
+            *end_offset = 0;
+        }
+    }
+    return true;
+}
+
+bool LLTextBase::reuseParagraphLayout(segment_set_t::iterator& seg_iter, S32& seg_offset, S32& line_start_index,
+                                      S32& cur_top, S32& line_count)
+{
+    const LLTextLayoutCache::Paragraph* paragraph = mLayoutCache.find(*seg_iter, seg_offset);
+    if (!paragraph)
+    {
+        return false;
+    }
+
+    U64 fingerprint = 0;
+    segment_set_t::iterator end_iter;
+    S32 end_offset = 0;
+    if (!getParagraphFingerprint(seg_iter, seg_offset, paragraph->mLength, fingerprint, &end_iter, &end_offset)
+        || fingerprint != paragraph->mFingerprint)
+    {
+        mLayoutCache.recordMiss();
+        return false;
+    }
+
+    const S32 start = (*seg_iter)->getStart() + seg_offset;
+    for (const LLTextLayoutCache::Line& line : paragraph->mLines)
+    {
+        LLRect rect = line.mRect;
+        rect.translate(0, cur_top);
+        mLineInfoList.push_back(line_info(start + line.mDocIndexStart,
+                                          start + line.mDocIndexEnd,
+                                          rect,
+                                          line_count + line.mLineNum));
+    }
+    mLayoutCache.recordHit(*paragraph);
+
+    cur_top -= paragraph->mHeight;
+    line_count += paragraph->mLineCount;
+    line_start_index = start + paragraph->mLength;
+    seg_iter = end_iter;
+    seg_offset = end_offset;
+    return true;
+}
+
 LLRect LLTextBase::getTextBoundingRect()
 {
     reflow();
@@ -4211,6 +4382,12 @@ S32 LLNormalTextSegment::getNumChars(S32 num_pixels, S32 segment_offset, S32 lin
     return num_chars;
 }
 
+bool LLNormalTextSegment::canCacheLayout() const
+{
+    // an image can arrive later, and be any size
+    return mStyle->getImage().isNull();
+}
+
 void LLNormalTextSegment::updateLayout(const class LLTextBase& editor)
 {
     LLTextSegment::updateLayout(editor);
@@ -36,6 +36,7 @@
 #include "llkeywords.h"
 #include "llpanel.h"
 #include "llurlmatch.h"
+#include "lltextlayoutcache.h"
 
 #include <string>
 #include <vector>
@@ -85,6 +86,9 @@ public:
     */
     virtual S32                 getNumChars(S32 num_pixels, S32 segment_offset, S32 line_offset, S32 max_chars, S32 line_ind) const;
     virtual void                updateLayout(const class LLTextBase& editor);
+    // true if the segment's size only depends on its text and style, so
+    // the line layout of a paragraph made of such segments can be reused
+    virtual bool                canCacheLayout() const { return false; }
     virtual F32                 draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect);
     virtual bool                canEdit() const;
     virtual void                unlinkFromDocument(class LLTextBase* editor);
@@ -139,6 +143,7 @@ public:
     /*virtual*/ S32                 getOffset(S32 segment_local_x_coord, S32 start_offset, S32 num_chars, bool round) const;
     /*virtual*/ S32                 getNumChars(S32 num_pixels, S32 segment_offset, S32 line_offset, S32 max_chars, S32 line_ind) const;
     /*virtual*/ void                updateLayout(const class LLTextBase& editor);
+    /*virtual*/ bool                canCacheLayout() const;
     /*virtual*/ F32                 draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect);
     /*virtual*/ bool                canEdit() const { return mCanEdit; }
     /*virtual*/ const LLUIColor&     getColor() const                    { return mStyle->getColor(); }
@@ -190,6 +195,7 @@ public:
     LLLabelTextSegment( LLStyleConstSP style, S32 start, S32 end, LLTextBase& editor );
     LLLabelTextSegment( const LLUIColor& color, S32 start, S32 end, LLTextBase& editor, bool is_visible = true);
     /*virtual*/ LLTextSegmentPtr clone(LLTextBase& target) const;
+    /*virtual*/ bool canCacheLayout() const { return false; } // the label isn't part of the document
 
 protected:
 
@@ -218,6 +224,7 @@ public:
     /*virtual*/ LLTextSegmentPtr clone(LLTextBase& target) const;
     /*virtual*/ F32 draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect);
     /*virtual*/ bool handleHover(S32 x, S32 y, MASK mask);
+    /*virtual*/ bool canCacheLayout() const { return false; } // style changes without a reflow
 protected:
     // Style used for text when mouse pointer is over segment
     LLStyleConstSP      mHoveredStyle;
@@ -278,6 +285,7 @@ public:
     /*virtual*/ bool        getDimensionsF32(S32 first_char, S32 num_chars, F32& width, S32& height) const;
     S32         getNumChars(S32 num_pixels, S32 segment_offset, S32 line_offset, S32 max_chars, S32 line_ind) const;
     F32         draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect);
+    /*virtual*/ bool        canCacheLayout() const { return true; }
 
 private:
     S32         mFontHeight;
@@ -701,6 +709,11 @@ protected:
     std::pair<S32, S32>             getVisibleLines(bool fully_visible = false);
     S32                             getLeftOffset(S32 width);
     void                            reflow();
+    // paragraph layout cache, see lltextlayoutcache.h
+    bool                            getParagraphFingerprint(segment_set_t::iterator seg_iter, S32 seg_offset, S32 length, U64& fingerprint,
+                                                            segment_set_t::iterator* end_iter = NULL, S32* end_offset = NULL) const;
+    bool                            reuseParagraphLayout(segment_set_t::iterator& seg_iter, S32& seg_offset, S32& line_start_index,
+                                                         S32& cur_top, S32& line_count);
 
     // cursor
     void                            updateCursorXPos();
@@ -832,6 +845,7 @@ protected:
 
     // transient state
     S32                         mReflowIndex;       // index at which to start reflow.  S32_MAX indicates no reflow needed.
+    LLTextLayoutCache           mLayoutCache;       // line layout of unchanged paragraphs, reused by reflow
     bool                        mScrollNeeded;      // need to change scroll region because of change to cursor position
     S32                         mScrollIndex;       // index of first character to keep visible in scroll region
 
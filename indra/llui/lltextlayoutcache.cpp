@@ -0,0 +1,110 @@
+/**
+ * @file lltextlayoutcache.cpp
+ * @brief Line layout of the paragraphs of a text document, kept across
+ *        reflows.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "lltextlayoutcache.h"
+
+bool LLTextLayoutCache::Settings::operator==(const Settings& other) const
+{
+    return mTextWidth == other.mTextWidth
+        && mHPad == other.mHPad
+        && mHAlign == other.mHAlign
+        && mLineSpacingMult == other.mLineSpacingMult
+        && mLineSpacingPixels == other.mLineSpacingPixels
+        && mWordWrap == other.mWordWrap
+        && mFontGeneration == other.mFontGeneration;
+}
+
+size_t LLTextLayoutCache::KeyHash::operator()(const Key& key) const
+{
+    return std::hash<const void*>()(key.mSegment) ^ ((size_t)key.mOffset * 0x9e3779b97f4a7c15ULL);
+}
+
+void LLTextLayoutCache::beginLayout(const Settings& settings, bool full)
+{
+    if (settings != mSettings)
+    {
+        mParagraphs.clear();
+        mSettings = settings;
+    }
+    ++mLayout;
+    mFullLayout = full;
+}
+
+void LLTextLayoutCache::endLayout()
+{
+    if (!mFullLayout)
+    {
+        return;
+    }
+
+    // Everything still in the document was looked up or stored: the rest
+    // is gone, or changed
+    for (auto it = mParagraphs.begin(); it != mParagraphs.end(); )
+    {
+        if (it->second.mLayout != mLayout)
+        {
+            it = mParagraphs.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    mFullLayout = false;
+}
+
+const LLTextLayoutCache::Paragraph* LLTextLayoutCache::find(const void* segment, S32 offset)
+{
+    auto it = mParagraphs.find(Key{ segment, offset });
+    if (it == mParagraphs.end())
+    {
+        ++mStats.mMisses;
+        return NULL;
+    }
+    it->second.mLayout = mLayout;
+    return &it->second.mParagraph;
+}
+
+void LLTextLayoutCache::recordHit(const Paragraph& paragraph)
+{
+    ++mStats.mHits;
+    mStats.mLinesReused += paragraph.mLines.size();
+}
+
+void LLTextLayoutCache::store(const void* segment, S32 offset, Paragraph&& paragraph)
+{
+    Entry& entry = mParagraphs[Key{ segment, offset }];
+    entry.mParagraph = std::move(paragraph);
+    entry.mLayout = mLayout;
+}
+
+void LLTextLayoutCache::clear()
+{
+    mParagraphs.clear();
+}
@@ -0,0 +1,135 @@
+/**
+ * @file lltextlayoutcache.h
+ * @brief Line layout of the paragraphs of a text document, kept across
+ *        reflows.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLTEXTLAYOUTCACHE_H
+#define LL_LLTEXTLAYOUTCACHE_H
+
+#include "llrect.h"
+
+#include <unordered_map>
+#include <vector>
+
+//
+// LLTextBase lays out its text again from the first changed character to
+// the end of the document, which in a long chat history is most of it: a
+// name resolved near the top, or a line removed from the top, measures
+// every line below again.
+//
+// This cache keeps the line breaks of each paragraph (text between hard
+// line breaks) so the reflow can copy them instead.  A paragraph is
+// cached under the segment it starts in and its offset in that segment,
+// which don't change when text before it is inserted or removed, along
+// with a fingerprint of its text, segments and styles the caller checks
+// before reusing it.  Whatever else the layout depends on goes in the
+// Settings: when they change, the whole cache is dropped.
+//
+class LLTextLayoutCache
+{
+public:
+    struct Line
+    {
+        S32 mDocIndexStart;     // relative to the paragraph's first character
+        S32 mDocIndexEnd;
+        LLRect mRect;           // relative to the paragraph's top
+        S32 mLineNum;           // relative to the paragraph's first line
+    };
+
+    struct Paragraph
+    {
+        U64 mFingerprint = 0;
+        S32 mLength = 0;        // characters, including the line break
+        S32 mHeight = 0;        // from the paragraph's top to the next one's
+        S32 mLineCount = 0;     // hard line breaks, normally 1
+        std::vector<Line> mLines;
+    };
+
+    struct Settings
+    {
+        S32 mTextWidth = 0;
+        S32 mHPad = 0;
+        S32 mHAlign = 0;
+        F32 mLineSpacingMult = 1.f;
+        S32 mLineSpacingPixels = 0;
+        bool mWordWrap = false;
+        S32 mFontGeneration = 0;
+
+        bool operator==(const Settings& other) const;
+        bool operator!=(const Settings& other) const { return !(*this == other); }
+    };
+
+    struct Stats
+    {
+        U64 mHits = 0;
+        U64 mMisses = 0;
+        U64 mLinesReused = 0;
+    };
+
+    // Starts a reflow.  A full one lays out the whole document, so
+    // paragraphs it doesn't look up or store are dropped at endLayout().
+    void beginLayout(const Settings& settings, bool full);
+    void endLayout();
+
+    // The cached paragraph starting at offset in segment, if any.  The
+    // caller compares its fingerprint, then reports the outcome.
+    const Paragraph* find(const void* segment, S32 offset);
+    void recordHit(const Paragraph& paragraph);
+    void recordMiss() { ++mStats.mMisses; }
+
+    void store(const void* segment, S32 offset, Paragraph&& paragraph);
+    void clear();
+
+    size_t size() const { return mParagraphs.size(); }
+    const Stats& getStats() const { return mStats; }
+
+private:
+    struct Key
+    {
+        const void* mSegment;
+        S32 mOffset;
+
+        bool operator==(const Key& other) const { return mSegment == other.mSegment && mOffset == other.mOffset; }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry
+    {
+        Paragraph mParagraph;
+        U32 mLayout;            // last layout that used it
+    };
+
+    std::unordered_map<Key, Entry, KeyHash> mParagraphs;
+    Settings mSettings;
+    U32 mLayout = 0;
+    bool mFullLayout = false;
+    Stats mStats;
+};
+
+#endif // LL_LLTEXTLAYOUTCACHE_H
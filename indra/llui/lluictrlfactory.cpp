@@ -174,6 +174,13 @@ bool LLUICtrlFactory::getLayeredXMLNode(const std::string &xui_filename, LLXMLNo
                                         LLDir::ESkinConstraint constraint)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_UI;
+    return LLXMLNode::getLayeredXMLNode(root, getLayeredXMLPaths(xui_filename, constraint));
+}
+
+//static
+std::vector<std::string> LLUICtrlFactory::getLayeredXMLPaths(const std::string &xui_filename,
+                                                             LLDir::ESkinConstraint constraint)
+{
     std::vector<std::string> paths =
         gDirUtilp->findSkinnedFilenames(LLDir::XUI, xui_filename, constraint);
 
@@ -182,8 +189,7 @@ bool LLUICtrlFactory::getLayeredXMLNode(const std::string &xui_filename, LLXMLNo
         // sometimes whole path is passed in as filename
         paths.push_back(xui_filename);
     }
-
-    return LLXMLNode::getLayeredXMLNode(root, paths);
+    return paths;
 }
 
 
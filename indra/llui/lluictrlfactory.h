@@ -193,6 +193,9 @@ fail:
 
     static bool getLayeredXMLNode(const std::string &filename, LLXMLNodePtr& root,
                                   LLDir::ESkinConstraint constraint=LLDir::CURRENT_SKIN);
+    // The skin and language layers getLayeredXMLNode() merges, base first
+    static std::vector<std::string> getLayeredXMLPaths(const std::string &filename,
+                                                       LLDir::ESkinConstraint constraint=LLDir::CURRENT_SKIN);
 
 private:
     //NOTE: both friend declarations are necessary to keep both gcc and msvc happy
@@ -111,6 +111,27 @@ void LLUIUsage::logPanel(const std::string& p)
     LL_DEBUGS("UIUsage") << "panel " << p << LL_ENDL;
 }
 
+void LLUIUsage::logFloaterOpen(const std::string& floater, F64 seconds, bool built)
+{
+    OpenTimes& times = mFloaterOpenTimes[sanitized(floater)];
+    ++times.mOpens;
+    times.mTotal += seconds;
+    times.mMax = llmax(times.mMax, seconds);
+    if (built)
+    {
+        ++times.mBuilds;
+        times.mBuildTotal += seconds;
+    }
+    LL_DEBUGS("UIUsage") << "floater " << floater << " open in " << seconds * 1000.0 << " ms"
+                         << (built ? ", built" : "") << LL_ENDL;
+}
+
+void LLUIUsage::logFloaterPrebuilt(const std::string& floater, F64 seconds)
+{
+    mFloaterOpenTimes[sanitized(floater)].mPrebuilt += seconds;
+    LL_DEBUGS("UIUsage") << "floater " << floater << " prebuilt in " << seconds * 1000.0 << " ms" << LL_ENDL;
+}
+
 LLSD LLUIUsage::asLLSD() const
 {
     LLSD result;
@@ -130,6 +151,17 @@ LLSD LLUIUsage::asLLSD() const
     {
         result["panels"][it.first] = LLSD::Integer(it.second);
     }
+    for (auto const& it : mFloaterOpenTimes)
+    {
+        const OpenTimes& times = it.second;
+        LLSD& floater = result["floater_open"][it.first];
+        floater["count"] = LLSD::Integer(times.mOpens);
+        floater["mean_ms"] = times.mOpens ? times.mTotal * 1000.0 / times.mOpens : 0.0;
+        floater["max_ms"] = times.mMax * 1000.0;
+        floater["builds"] = LLSD::Integer(times.mBuilds);
+        floater["build_ms"] = times.mBuilds ? times.mBuildTotal * 1000.0 / times.mBuilds : 0.0;
+        floater["prebuilt_ms"] = times.mPrebuilt * 1000.0;
+    }
     return result;
 }
 
@@ -142,5 +174,6 @@ void LLUIUsage::clear()
     mControlCounts.clear();
     mFloaterCounts.clear();
     mPanelCounts.clear();
+    mFloaterOpenTimes.clear();
 }
 
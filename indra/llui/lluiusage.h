@@ -45,13 +45,29 @@ public:
     void logControl(const std::string& control);
     void logFloater(const std::string& floater);
     void logPanel(const std::string& p);
+    // Time from asking for a floater to it being open; built if there was
+    // no instance to show yet
+    void logFloaterOpen(const std::string& floater, F64 seconds, bool built);
+    // Time taken to build a floater ahead of its opening
+    void logFloaterPrebuilt(const std::string& floater, F64 seconds);
     LLSD asLLSD() const;
     void clear();
 private:
+    struct OpenTimes
+    {
+        U32 mOpens = 0;
+        U32 mBuilds = 0;
+        F64 mTotal = 0.0;
+        F64 mMax = 0.0;
+        F64 mBuildTotal = 0.0;
+        F64 mPrebuilt = 0.0;
+    };
+
     std::map<std::string,U32> mCommandCounts;
     std::map<std::string,U32> mControlCounts;
     std::map<std::string,U32> mFloaterCounts;
     std::map<std::string,U32> mPanelCounts;
+    std::map<std::string,OpenTimes> mFloaterOpenTimes;
 };
 
 #endif // LLUIUIUSAGE.h
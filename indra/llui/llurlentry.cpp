@@ -306,6 +306,7 @@ LLUrlEntryHTTP::LLUrlEntryHTTP()
     // </FS:ND>
     // </FS:Ansariel>
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "http://", "https://", "ftp://" };
     mMenuName = "menu_url_http.xml";
     mTooltip = LLTrans::getString("TooltipHttpUrl");
 }
@@ -348,6 +349,7 @@ LLUrlEntryHTTPLabel::LLUrlEntryHTTPLabel()
     mPattern = boost::regex("\\[(https?|ftp)://\\S+[ \t]+[^\\]]+\\]",
     // </FS:Ansariel>
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "[http://", "[https://", "[ftp://" };
     mMenuName = "menu_url_http.xml";
     mTooltip = LLTrans::getString("TooltipHttpUrl");
 }
@@ -377,6 +379,7 @@ LLUrlEntryHTTPNoProtocol::LLUrlEntryHTTPNoProtocol()
 {
     mPattern = boost::regex("\\b(www|ftp)\\.\\S+\\.([^\\s<]*)?\\b", // i.e. www.FOO.BAR
                 boost::regex::perl|boost::regex::icase);
+    mAnchors = { "www.", "ftp." };
     mMenuName = "menu_url_http.xml";
     mTooltip = LLTrans::getString("TooltipHttpUrl");
 }
@@ -412,6 +415,7 @@ LLUrlEntryInvalidSLURL::LLUrlEntryInvalidSLURL()
     // <FS:Beq> remove legacy Inworldz URI support. restore previous with addition of https
     mPattern = boost::regex("(https?://(maps.secondlife.com|slurl.com)/secondlife/|secondlife://(/app/(worldmap|teleport)/)?)[^ /]+(/-?[0-9]+){1,3}(/?(\\?title|\\?img|\\?msg)=\\S*)?/?",
                                     boost::regex::perl|boost::regex::icase);
+    mAnchors = { "secondlife" };
     mMenuName = "menu_url_http.xml";
     mTooltip = LLTrans::getString("TooltipHttpUrl");
 }
@@ -499,6 +503,7 @@ LLUrlEntrySLURL::LLUrlEntrySLURL()
     // see http://slurl.com/about.php for details on the SLURL format
     mPattern = boost::regex("https?://(maps.secondlife.com|slurl.com)/secondlife/[^ /]+(/\\d+){0,3}(/?(\\?title|\\?img|\\?msg)=\\S*)?/?",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/secondlife/" };
     mIcon = "Hand";
     mMenuName = "menu_url_slurl.xml";
     mTooltip = LLTrans::getString("TooltipSLURL");
@@ -589,6 +594,7 @@ LLUrlEntrySecondlifeURL::LLUrlEntrySecondlifeURL()
                             "(https?://([-\\w\\.]*\\.)?secondlife\\.io(:\\d{1,5})?))"
                             "\\/\\S*",
         boost::regex::perl|boost::regex::icase);
+    mAnchors = { "secondlife", "lindenlab", "tilia-inc" };
 
     mIcon = "Hand";
     mMenuName = "menu_url_http.xml";
@@ -632,6 +638,7 @@ LLUrlEntrySimpleSecondlifeURL::LLUrlEntrySimpleSecondlifeURL()
                             "|"
                             "https?://([-\\w\\.]*\\.)?secondlifegrid\\.net(?!\\S)",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "secondlife", "lindenlab", "tilia-inc" };
 
     mIcon = "Hand";
     mMenuName = "menu_url_http.xml";
@@ -646,6 +653,7 @@ LLUrlEntryAgent::LLUrlEntryAgent()
 {
     mPattern = boost::regex(APP_HEADER_REGEX "/agent/[\\da-f-]+/\\w+",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/agent/" };
     mMenuName = "menu_url_agent.xml";
     mIcon = "Generic_Person";
 }
@@ -846,6 +854,7 @@ std::string LLUrlEntryAgent::getIcon(const std::string &url)
 LLUrlEntryAgentMention::LLUrlEntryAgentMention()
 {
     mPattern  = boost::regex(APP_HEADER_REGEX "/agent/[\\da-f-]+/mention", boost::regex::perl | boost::regex::icase);
+    mAnchors = { "/app/agent/" };
     mMenuName = "menu_url_agent.xml";
     mIcon = std::string();
 }
@@ -945,6 +954,7 @@ LLUrlEntryAgentCompleteName::LLUrlEntryAgentCompleteName()
 {
     mPattern = boost::regex(APP_HEADER_REGEX "/agent/[\\da-f-]+/completename",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/agent/" };
 }
 
 std::string LLUrlEntryAgentCompleteName::getName(const LLAvatarName& avatar_name)
@@ -961,6 +971,7 @@ LLUrlEntryAgentLegacyName::LLUrlEntryAgentLegacyName()
 {
     mPattern = boost::regex(APP_HEADER_REGEX "/agent/[\\da-f-]+/legacyname",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/agent/" };
 }
 
 std::string LLUrlEntryAgentLegacyName::getName(const LLAvatarName& avatar_name)
@@ -977,6 +988,7 @@ LLUrlEntryAgentDisplayName::LLUrlEntryAgentDisplayName()
 {
     mPattern = boost::regex(APP_HEADER_REGEX "/agent/[\\da-f-]+/displayname",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/agent/" };
 }
 
 std::string LLUrlEntryAgentDisplayName::getName(const LLAvatarName& avatar_name)
@@ -995,6 +1007,7 @@ LLUrlEntryAgentUserName::LLUrlEntryAgentUserName()
 {
     mPattern = boost::regex(APP_HEADER_REGEX "/agent/[\\da-f-]+/username",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/agent/" };
 }
 
 std::string LLUrlEntryAgentUserName::getName(const LLAvatarName& avatar_name)
@@ -1015,6 +1028,7 @@ extern std::string rlvGetAnonym(const LLAvatarName& avName);
 LLUrlEntryAgentRLVAnonymizedName::LLUrlEntryAgentRLVAnonymizedName()
 {
     mPattern = boost::regex(APP_HEADER_REGEX "/agent/[\\da-f-]+/rlvanonym", boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/agent/" };
 }
 
 std::string LLUrlEntryAgentRLVAnonymizedName::getName(const LLAvatarName& avatar_name)
@@ -1032,6 +1046,7 @@ FSUrlEntryAgentSelf::FSUrlEntryAgentSelf() : LLUrlEntryAgent()
 {
     mPattern = boost::regex(APP_HEADER_REGEX "/agentself/[\\da-f-]+/\\w+",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/agentself/" };
 }
 
 std::string FSUrlEntryAgentSelf::getLabel(const std::string &url, const LLUrlLabelCallback &cb)
@@ -1057,6 +1072,7 @@ LLUrlEntryGroup::LLUrlEntryGroup()
 {
     mPattern = boost::regex(APP_HEADER_REGEX "/group/[\\da-f-]+/\\w+",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/group/" };
     mMenuName = "menu_url_group.xml";
     mIcon = "Generic_Group";
     mTooltip = LLTrans::getString("TooltipGroupUrl");
@@ -1134,6 +1150,7 @@ LLUrlEntryInventory::LLUrlEntryInventory()
     //x-grid-location-info://lincoln.lindenlab.com/app/inventory/0e346d8b-4433-4d66-a6b0-fd37083abc4c/select?name=name with spaces&param2=value
     mPattern = boost::regex(APP_HEADER_REGEX "/inventory/[\\da-f-]+/\\w+\\S*",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/inventory/" };
     mMenuName = "menu_url_inventory.xml";
 }
 
@@ -1154,6 +1171,7 @@ LLUrlEntryObjectIM::LLUrlEntryObjectIM()
     mPattern = boost::regex("(hop|secondlife):///app/objectim/[\\da-f-]+\?[^ \t\r\n\v\f]*",
     // </FS:AW>
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/objectim/" };
     mMenuName = "menu_url_objectim.xml";
 }
 
@@ -1184,6 +1202,7 @@ LLUrlEntryChat::LLUrlEntryChat()
 {
     mPattern = boost::regex("secondlife:///app/chat/\\d+/\\S+",
         boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/chat/" };
     mMenuName = "menu_url_slapp.xml";
     mTooltip = LLTrans::getString("TooltipSLAPP");
 }
@@ -1209,6 +1228,7 @@ LLUrlEntryParcel::LLUrlEntryParcel()
 {
     mPattern = boost::regex(APP_HEADER_REGEX "/parcel/[\\da-f-]+/about",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/parcel/" };
     mMenuName = "menu_url_parcel.xml";
     mTooltip = LLTrans::getString("TooltipParcelUrl");
 
@@ -1314,6 +1334,7 @@ LLUrlEntryPlace::LLUrlEntryPlace()
 {
     mPattern = boost::regex("(((hop://[-\\w\\.\\:\\@]+/)|((x-grid-location-info://[-\\w\\.]+/region/)|(secondlife://)))\\S+/?(\\d+/\\d+/-?\\d+|\\d+/-?\\d+)/?)|(hop://[-\\w\\.\\:\\@]+/[^\\s/]+/?(?![^\\s]))", // <AW: hop:// protocol>
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "hop://", "x-grid-location-info://", "secondlife://" };
     mMenuName = "menu_url_slurl.xml";
     mTooltip = LLTrans::getString("TooltipSLURL");
 }
@@ -1362,6 +1383,7 @@ LLUrlEntryRegion::LLUrlEntryRegion()
 {
     mPattern = boost::regex("secondlife:///app/region/[A-Za-z0-9()_%]+(/\\d+)?(/\\d+)?(/\\d+)?/?",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/region/" };
     mMenuName = "menu_url_slurl.xml";
     mTooltip = LLTrans::getString("TooltipSLURL");
 }
@@ -1426,6 +1448,7 @@ LLUrlEntryTeleport::LLUrlEntryTeleport()
 {
     mPattern = boost::regex(APP_HEADER_REGEX "/teleport/\\S+(/\\d+)?(/\\d+)?(/\\d+)?/?\\S*",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/teleport/" };
     mMenuName = "menu_url_teleport.xml";
     mTooltip = LLTrans::getString("TooltipTeleportUrl");
 }
@@ -1497,6 +1520,7 @@ FSUrlEntryWear::FSUrlEntryWear()
 {
     mPattern = boost::regex("(hop|secondlife):///app/wear_folder/\\S+",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/wear_folder/" };
     mMenuName = "menu_url_slapp.xml";
     mTooltip = LLTrans::getString("TooltipFSUrlEntryWear");
 }
@@ -1515,6 +1539,7 @@ LLUrlEntrySL::LLUrlEntrySL()
 {
     mPattern = boost::regex("(hop|secondlife)://(\\w+)?(:\\d+)?/\\S+", // <AW: hop:// protocol>
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "hop://", "secondlife://" };
     mMenuName = "menu_url_slapp.xml";
     mTooltip = LLTrans::getString("TooltipSLAPP");
 }
@@ -1533,6 +1558,7 @@ FSHelpDebugUrlEntrySL::FSHelpDebugUrlEntrySL()
 {
     mPattern = boost::regex("(hop|secondlife):///app/fshelp/showdebug/\\S+",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/fshelp/showdebug/" };
     mMenuName = "menu_url_slapp.xml";
     mTooltip = LLTrans::getString("TooltipFSHelpDebugSLUrl");
 }
@@ -1552,6 +1578,7 @@ LLUrlEntrySLLabel::LLUrlEntrySLLabel()
 {
     mPattern = boost::regex("\\[(hop|secondlife)://\\S+[ \t]+[^\\]]+\\]", // <AW: hop:// protocol>
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "[hop://", "[secondlife://" };
     mMenuName = "menu_url_slapp.xml";
     mTooltip = LLTrans::getString("TooltipSLAPP");
 }
@@ -1601,6 +1628,7 @@ LLUrlEntryWorldMap::LLUrlEntryWorldMap()
 {
     mPattern = boost::regex(APP_HEADER_REGEX "/worldmap/\\S+/?(\\d+)?/?(\\d+)?/?(\\d+)?/?\\S*",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/worldmap/" };
     mMenuName = "menu_url_map.xml";
     mTooltip = LLTrans::getString("TooltipMapUrl");
 }
@@ -1642,6 +1670,7 @@ LLUrlEntryNoLink::LLUrlEntryNoLink()
 {
     mPattern = boost::regex("<nolink>.*?</nolink>",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "<nolink>" };
 }
 
 std::string LLUrlEntryNoLink::getUrl(const std::string &url) const
@@ -1669,6 +1698,7 @@ LLUrlEntryIcon::LLUrlEntryIcon()
 {
     mPattern = boost::regex("<icon\\s*>\\s*([^<]*)?\\s*</icon\\s*>",
                             boost::regex::perl|boost::regex::icase);
+    mAnchors = { "<icon" };
 }
 
 std::string LLUrlEntryIcon::getUrl(const std::string &url) const
@@ -1703,6 +1733,10 @@ LLUrlEntryJira::LLUrlEntryJira()
                 // <FS:Ansariel> FIRE-917: Match case to reduce number of false positives
                 //boost::regex::perl|boost::regex::icase);
                 boost::regex::perl);
+    // the issue names, as the pattern matches them
+    mAnchors = { "arvd-", "bug-", "chop-", "chuibug-", "cts-", "doc-", "dn-", "ecc-", "exp-", "fire-", "fitmesh-", "leap-",
+                 "llsd-", "matbug-", "misc-", "open-", "pathbug-", "plat-", "pyo-", "scr-", "sh-", "sinv-", "sls-", "snow-",
+                 "social-", "storm-", "sun-", "svc-", "spot-", "sup-", "tpv-", "vwr-", "web-" };
     mMenuName = "menu_url_http.xml";
     mTooltip = LLTrans::getString("TooltipHttpUrl");
 }
@@ -1739,6 +1773,7 @@ LLUrlEntryEmail::LLUrlEntryEmail()
 {
     mPattern = boost::regex("(mailto:)?[\\w\\.\\-]+@[\\w\\.\\-]+\\.[a-z]{2,63}",
                             boost::regex::perl | boost::regex::icase);
+    mAnchors = { "@" };
     mMenuName = "menu_url_email.xml";
     mTooltip = LLTrans::getString("TooltipEmail");
 }
@@ -1769,6 +1804,7 @@ LLUrlEntryExperienceProfile::LLUrlEntryExperienceProfile()
 {
     mPattern = boost::regex(APP_HEADER_REGEX "/experience/[\\da-f-]+/profile",
         boost::regex::perl|boost::regex::icase);
+    mAnchors = { "/app/experience/" };
     mIcon = "Generic_Experience";
     mMenuName = "menu_url_experience.xml";
 }
@@ -1826,6 +1862,7 @@ LLUrlEntryIPv6::LLUrlEntryIPv6()
     mHostPath = "https?://\\[([a-f0-9:]+:+)+[a-f0-9]+]";
     mPattern = boost::regex(mHostPath + "(:\\d{1,5})?(/\\S*)?",
         boost::regex::perl | boost::regex::icase);
+    mAnchors = { "http://[", "https://[" };
     mMenuName = "menu_url_http.xml";
     mTooltip = LLTrans::getString("TooltipHttpUrl");
 }
@@ -1868,6 +1905,7 @@ LLUrlEntryKeybinding::LLUrlEntryKeybinding()
 {
     mPattern = boost::regex(APP_HEADER_REGEX "/keybinding/\\w+(\\?mode=\\w+)?$",
                             boost::regex::perl | boost::regex::icase);
+    mAnchors = { "/app/keybinding/" };
     mMenuName = "menu_url_experience.xml";
 
     initLocalization();
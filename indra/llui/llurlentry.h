@@ -76,7 +76,12 @@ public:
     virtual ~LLUrlEntryBase();
 
     /// Return the regex pattern that matches this Url
-    boost::regex getPattern() const { return mPattern; }
+    const boost::regex& getPattern() const { return mPattern; }
+
+    /// Return literal strings, in lower case, at least one of which is in
+    /// any text the pattern matches, whatever its case. Empty if the
+    /// pattern has none, in which case it is always tried.
+    const std::vector<std::string>& getAnchors() const { return mAnchors; }
 
     /// Return the url from a string that matched the regex
     virtual std::string getUrl(const std::string &string) const;
@@ -136,6 +141,7 @@ protected:
     } LLUrlEntryObserver;
 
     boost::regex                                    mPattern;
+    std::vector<std::string>                        mAnchors;
     std::string                                     mIcon;
     std::string                                     mMenuName;
     std::string                                     mTooltip;
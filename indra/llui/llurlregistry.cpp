@@ -38,6 +38,7 @@ void LLUrlRegistryNullCallback(const std::string &url, const std::string &label,
 }
 
 LLUrlRegistry::LLUrlRegistry()
+:   mUseAnchors(true)
 {
 //  mUrlEntry.reserve(20);
 // [RLVa:KB] - Checked: 2010-11-01 (RLVa-1.2.2a) | Added: RLVa-1.2.2a
@@ -120,14 +121,32 @@ void LLUrlRegistry::registerUrl(LLUrlEntryBase *url, bool force_front)
 {
     if (url)
     {
+        // Url types share anchors, so each is searched for once per text
+        std::vector<U32> anchors;
+        for (const std::string& anchor : url->getAnchors())
+        {
+            std::vector<std::string>::iterator found = std::find(mAnchors.begin(), mAnchors.end(), anchor);
+            anchors.push_back((U32)(found - mAnchors.begin()));
+            if (found == mAnchors.end())
+            {
+                mAnchors.push_back(anchor);
+            }
+        }
+
         if (force_front)  // IDEVO
+        {
             mUrlEntry.insert(mUrlEntry.begin(), url);
+            mUrlEntryAnchors.insert(mUrlEntryAnchors.begin(), anchors);
+        }
         else
-        mUrlEntry.push_back(url);
+        {
+            mUrlEntry.push_back(url);
+            mUrlEntryAnchors.push_back(anchors);
+        }
     }
 }
 
-static bool matchRegex(const char *text, boost::regex regex, U32 &start, U32 &end)
+static bool matchRegex(const char *text, const boost::regex& regex, U32 &start, U32 &end)
 {
     boost::cmatch result;
     bool found;
@@ -183,6 +202,20 @@ static bool stringHasUrl(const std::string &text)
             text.find("@") != std::string::npos);
 }
 
+// ASCII only, like the anchors: other bytes can't be part of one
+static std::string toLowerASCII(const std::string &text)
+{
+    std::string lower(text);
+    for (char& c : lower)
+    {
+        if (c >= 'A' && c <= 'Z')
+        {
+            c += 'a' - 'A';
+        }
+    }
+    return lower;
+}
+
 static bool stringHasJira(const std::string &text)
 {
     // same as above, but for jiras
@@ -233,6 +266,12 @@ bool LLUrlRegistry::findUrl(const std::string &text, LLUrlMatch &match, const LL
     U32 match_start = 0, match_end = 0;
     LLUrlEntryBase *match_entry = NULL;
 
+    // A Url type's regex can't match unless the text has one of its
+    // anchors, whatever their case. Anchors are searched for when a Url
+    // type first needs them: -1 not yet, else whether the text has it.
+    const std::string lower_text = mUseAnchors ? toLowerASCII(text) : std::string();
+    std::vector<S8> has_anchor(mAnchors.size(), -1);
+
     std::vector<LLUrlEntryBase *>::iterator it;
     for (it = mUrlEntry.begin(); it != mUrlEntry.end(); ++it)
     {
@@ -249,6 +288,28 @@ bool LLUrlRegistry::findUrl(const std::string &text, LLUrlMatch &match, const LL
 
         LLUrlEntryBase *url_entry = *it;
 
+        const std::vector<U32>& anchors = mUrlEntryAnchors[it - mUrlEntry.begin()];
+        if (mUseAnchors && !anchors.empty())
+        {
+            bool found = false;
+            for (U32 anchor : anchors)
+            {
+                if (has_anchor[anchor] < 0)
+                {
+                    has_anchor[anchor] = (lower_text.find(mAnchors[anchor]) != std::string::npos) ? 1 : 0;
+                }
+                if (has_anchor[anchor])
+                {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found)
+            {
+                continue;
+            }
+        }
+
         U32 start = 0, end = 0;
         if (matchRegex(text.c_str(), url_entry->getPattern(), start, end))
         {
@@ -94,8 +94,17 @@ public:
 
     bool containsAgentMention(const std::string& text);
 
+    /// For debug purposes and performance testing: try every Url type's
+    /// regex, rather than only those whose anchors are in the text
+    void enableAnchorPrefilter(bool enable) { mUseAnchors = enable; }
+
 private:
     std::vector<LLUrlEntryBase *> mUrlEntry;
+    // the anchors of all the Url types, and for each Url type the indices
+    // of its own, empty if it has none
+    std::vector<std::string> mAnchors;
+    std::vector<std::vector<U32> > mUrlEntryAnchors;
+    bool mUseAnchors;
     LLUrlEntryBase* mUrlEntryTrusted;
     LLUrlEntryBase* mUrlEntryIcon;
     LLUrlEntryBase* mLLUrlEntryInvalidSLURL;
@@ -1290,7 +1290,7 @@ void LLView::draw()
     drawChildren();
 }
 
-void LLView::drawChildren()
+void LLView::drawChildren(const LLRect* cull_rect)
 {
     if (!mChildList.empty())
     {
@@ -1307,6 +1307,11 @@ void LLView::drawChildren()
                 continue;
             }
 
+            if (cull_rect && !cull_rect->overlaps(viewp->getRect()))
+            {
+                continue;
+            }
+
             if (viewp->getVisible() && viewp->getRect().isValid())
             {
                 LLRect screen_rect = viewp->calcScreenRect();
@@ -540,7 +540,8 @@ public:
 protected:
     void            drawDebugRect();
     void            drawChild(LLView* childp, S32 x_offset = 0, S32 y_offset = 0, bool force_draw = false);
-    void            drawChildren();
+    // cull_rect, in local coordinates, skips the children outside it
+    void            drawChildren(const LLRect* cull_rect = NULL);
     bool            visibleAndContains(S32 local_x, S32 local_Y);
     bool            visibleEnabledAndContains(S32 local_x, S32 local_y);
     void            logMouseEvent();
@@ -0,0 +1,261 @@
+/**
+ * @file   llscrolllistsortkeys_test.cpp
+ * @brief  Test for llscrolllistsortkeys.h.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "../llscrolllistsortkeys.h"
+// STL headers
+#include <algorithm>
+#include <iostream>
+#include <vector>
+// std headers
+// external library headers
+// other Linden headers
+#include "llsd.h"
+#include "llstring.h"
+#include "lltimer.h"
+#include "lltut.h"
+
+namespace
+{
+    typedef LLScrollListSortKeys::sort_order_t sort_order_t;
+
+    // A scroll list row: a value and an alternate value per column, an
+    // undefined value standing for a missing cell
+    struct Row
+    {
+        std::vector<LLSD> mValues;
+        std::vector<LLSD> mAltValues;
+    };
+
+    // What LLScrollListCtrl did before: compare the cells' LLSD values,
+    // converted to strings, on every comparison
+    struct CompareCells
+    {
+        const sort_order_t& mSortOrders;
+        bool mAltSort;
+
+        bool operator()(const Row* r1, const Row* r2) const
+        {
+            S32 sort_result = 0;
+            for (sort_order_t::const_reverse_iterator it = mSortOrders.rbegin(); it != mSortOrders.rend(); ++it)
+            {
+                S32 col = it->first;
+                S32 order = it->second ? 1 : -1;
+                if (r1->mValues[col].isDefined() && r2->mValues[col].isDefined())
+                {
+                    if (mAltSort && !r1->mAltValues[col].asString().empty() && !r2->mAltValues[col].asString().empty())
+                    {
+                        sort_result = order * LLStringUtil::compareDict(r1->mAltValues[col].asString(), r2->mAltValues[col].asString());
+                    }
+                    else
+                    {
+                        sort_result = order * LLStringUtil::compareDict(r1->mValues[col].asString(), r2->mValues[col].asString());
+                    }
+                    if (sort_result != 0)
+                    {
+                        break;
+                    }
+                }
+            }
+            return sort_result < 0;
+        }
+    };
+
+    // What LLScrollListCtrl::sortItems() does now
+    void sort_with_keys(const std::vector<Row>& rows, const sort_order_t& sort_orders, bool alt_sort, std::vector<U32>& order)
+    {
+        LLScrollListSortKeys keys(sort_orders, alt_sort, rows.size());
+        for (size_t row = 0; row < rows.size(); ++row)
+        {
+            for (size_t i = 0; i < sort_orders.size(); ++i)
+            {
+                const S32 col = sort_orders[i].first;
+                if (rows[row].mValues[col].isDefined())
+                {
+                    keys.setKey(row, i, rows[row].mValues[col].asString(),
+                                alt_sort ? rows[row].mAltValues[col].asString() : std::string());
+                }
+            }
+        }
+        keys.sort(order);
+    }
+
+    std::vector<U32> sort_with_cells(const std::vector<Row>& rows, const sort_order_t& sort_orders, bool alt_sort)
+    {
+        std::vector<const Row*> items;
+        for (const Row& row : rows)
+        {
+            items.push_back(&row);
+        }
+        std::stable_sort(items.begin(), items.end(), CompareCells{ sort_orders, alt_sort });
+
+        std::vector<U32> order;
+        for (const Row* item : items)
+        {
+            order.push_back((U32)(item - rows.data()));
+        }
+        return order;
+    }
+
+    // Radar-like rows: name, distance, and an age with a sortable
+    // alternate value
+    std::vector<Row> make_rows(S32 count)
+    {
+        static const char* names[] = { "Alice", "bob", "Carol", "dave", "Eve", "mallory", "Trent", "victor" };
+        std::vector<Row> rows(count);
+        for (S32 i = 0; i < count; ++i)
+        {
+            S32 hash = (i * 7919) % 1009;
+            Row& row = rows[i];
+            row.mValues.push_back(llformat("%s Resident%d", names[hash % 8], hash % 97));
+            row.mValues.push_back(LLSD((F64)(hash % 257) / 4.0));
+            row.mValues.push_back(hash % 13 ? LLSD(llformat("%d days", hash % 365)) : LLSD());
+            row.mAltValues.push_back(LLSD());
+            row.mAltValues.push_back(LLSD());
+            row.mAltValues.push_back(hash % 5 ? LLSD(llformat("%05d", hash % 365)) : LLSD());
+        }
+        return rows;
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llscrolllistsortkeys_data
+    {
+    };
+    typedef test_group<llscrolllistsortkeys_data> llscrolllistsortkeys_group;
+    typedef llscrolllistsortkeys_group::object object;
+    llscrolllistsortkeys_group llscrolllistsortkeysgrp("llscrolllistsortkeys");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("same order as comparing cells");
+
+        std::vector<Row> rows = make_rows(500);
+        std::vector<U32> order;
+
+        sort_order_t by_name{ { 0, true } };
+        sort_with_keys(rows, by_name, false, order);
+        ensure("by name", order == sort_with_cells(rows, by_name, false));
+
+        // primary: distance descending, then name
+        sort_order_t by_distance{ { 0, true }, { 1, false } };
+        sort_with_keys(rows, by_distance, false, order);
+        ensure("by distance, name", order == sort_with_cells(rows, by_distance, false));
+
+        // missing cells and alternate values
+        sort_order_t by_age{ { 0, false }, { 2, true } };
+        sort_with_keys(rows, by_age, true, order);
+        ensure("by age, alternate", order == sort_with_cells(rows, by_age, true));
+        sort_with_keys(rows, by_age, false, order);
+        ensure("by age", order == sort_with_cells(rows, by_age, false));
+
+        // stable
+        sort_order_t none;
+        sort_with_keys(rows, none, false, order);
+        for (U32 i = 0; i < order.size(); ++i)
+        {
+            ensure_equals("unsorted", order[i], i);
+        }
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("100k row benchmark");
+
+        // Not a pass/fail test beyond the orders matching.  Populates 100k
+        // radar-like rows, sorts them by distance then name, and pages
+        // through them with a name filter, the way drawing and hit testing
+        // did (scanning every row for each page) and do now (the rows
+        // passing the filter listed once a frame).
+        if (! getenv("LL_TEST_BENCHMARKS"))
+        {
+            skip("set LL_TEST_BENCHMARKS to run the benchmark");
+        }
+
+        const S32 ROWS = 100000;
+        U64 start = LLTimer::getTotalTime();
+        std::vector<Row> rows = make_rows(ROWS);
+        const U64 populate_time = LLTimer::getTotalTime() - start;
+
+        sort_order_t sort_orders{ { 0, true }, { 1, true } };
+        start = LLTimer::getTotalTime();
+        std::vector<U32> cells_order = sort_with_cells(rows, sort_orders, false);
+        const U64 cells_time = LLTimer::getTotalTime() - start;
+
+        start = LLTimer::getTotalTime();
+        std::vector<U32> keys_order;
+        sort_with_keys(rows, sort_orders, false, keys_order);
+        const U64 keys_time = LLTimer::getTotalTime() - start;
+        ensure("same order", keys_order == cells_order);
+
+        const std::string filter = "resident4";
+        auto filtered = [&filter](const Row& row)
+        {
+            std::string value = row.mValues[0].asString();
+            LLStringUtil::toLower(value);
+            return value.find(filter) == std::string::npos;
+        };
+
+        // ten pages, 25 rows each, from 100 rows apart
+        const S32 PAGES = 10, PAGE_LINES = 25;
+        S32 scanned_rows = 0;
+        start = LLTimer::getTotalTime();
+        for (S32 page = 0; page < PAGES; ++page)
+        {
+            S32 line = 0;
+            for (U32 index : keys_order)
+            {
+                if (filtered(rows[index]))
+                {
+                    continue;
+                }
+                if (line >= page * 100 && line < page * 100 + PAGE_LINES)
+                {
+                    ++scanned_rows;
+                }
+                ++line;
+            }
+        }
+        const U64 scan_time = LLTimer::getTotalTime() - start;
+
+        S32 indexed_rows = 0;
+        start = LLTimer::getTotalTime();
+        std::vector<const Row*> passing;
+        for (U32 index : keys_order)
+        {
+            if (!filtered(rows[index]))
+            {
+                passing.push_back(&rows[index]);
+            }
+        }
+        for (S32 page = 0; page < PAGES; ++page)
+        {
+            S32 last_line = llmin((S32)passing.size(), page * 100 + PAGE_LINES);
+            for (S32 line = page * 100; line < last_line; ++line)
+            {
+                indexed_rows += passing[line] ? 1 : 0;
+            }
+        }
+        const U64 index_time = LLTimer::getTotalTime() - start;
+        ensure_equals("same rows shown", indexed_rows, scanned_rows);
+
+        std::cout << std::endl << ROWS << " rows: populate " << populate_time << " uS; sort "
+                  << cells_time << " uS comparing cells, " << keys_time << " uS on keys; "
+                  << PAGES << " filtered pages " << scan_time << " uS scanning, " << index_time
+                  << " uS indexed" << std::endl;
+    }
+} // namespace tut
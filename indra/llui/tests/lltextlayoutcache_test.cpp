@@ -0,0 +1,245 @@
+/**
+ * @file   lltextlayoutcache_test.cpp
+ * @brief  Test for lltextlayoutcache.h.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "../lltextlayoutcache.h"
+// STL headers
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+// std headers
+// external library headers
+// other Linden headers
+#include "lltimer.h"
+#include "lltut.h"
+
+namespace
+{
+    typedef LLTextLayoutCache::Line Line;
+    typedef std::vector<std::unique_ptr<std::string> > document_t;
+
+    const S32 LINE_HEIGHT = 14;
+
+    // Stand-in for LLTextBase::reflow() laying out one paragraph: measures
+    // every character with a made up font and wraps at spaces.
+    LLTextLayoutCache::Paragraph layout_paragraph(const std::string& text, S32 width)
+    {
+        LLTextLayoutCache::Paragraph paragraph;
+        paragraph.mLength = (S32)text.size();
+        paragraph.mLineCount = 1;
+        S32 line_start = 0;
+        S32 last_space = -1;
+        S32 x = 0;
+        S32 top = 0;
+        for (S32 i = 0; i < (S32)text.size(); ++i)
+        {
+            x += 5 + (text[i] % 4);
+            if (text[i] == ' ')
+            {
+                last_space = i;
+            }
+            if (x > width && last_space > line_start)
+            {
+                paragraph.mLines.push_back({ line_start, last_space + 1, LLRect(0, top, width, top - LINE_HEIGHT), 0 });
+                top -= LINE_HEIGHT;
+                line_start = last_space + 1;
+                i = last_space;
+                x = 0;
+            }
+        }
+        paragraph.mLines.push_back({ line_start, (S32)text.size(), LLRect(0, top, width, top - LINE_HEIGHT), 0 });
+        paragraph.mHeight = LINE_HEIGHT - top;
+        return paragraph;
+    }
+
+    // Lays out the whole document, from the cache where the paragraph's
+    // fingerprint allows, into lines.
+    void reflow(const document_t& document, LLTextLayoutCache* cache, S32 width, std::vector<Line>& lines)
+    {
+        LLTextLayoutCache::Settings settings;
+        settings.mTextWidth = width;
+        if (cache)
+        {
+            cache->beginLayout(settings, true);
+        }
+
+        lines.clear();
+        S32 doc_index = 0;
+        S32 top = 0;
+        S32 line_num = 0;
+        for (const auto& text : document)
+        {
+            const U64 fingerprint = std::hash<std::string>()(*text);
+            const LLTextLayoutCache::Paragraph* cached = cache ? cache->find(text.get(), 0) : NULL;
+            LLTextLayoutCache::Paragraph laid_out;
+            if (cached && cached->mFingerprint == fingerprint)
+            {
+                cache->recordHit(*cached);
+            }
+            else
+            {
+                laid_out = layout_paragraph(*text, width);
+                laid_out.mFingerprint = fingerprint;
+                cached = &laid_out;
+            }
+
+            for (const Line& line : cached->mLines)
+            {
+                LLRect rect = line.mRect;
+                rect.translate(0, top);
+                lines.push_back({ doc_index + line.mDocIndexStart, doc_index + line.mDocIndexEnd, rect, line_num + line.mLineNum });
+            }
+            doc_index += cached->mLength;
+            top -= cached->mHeight;
+            line_num += cached->mLineCount;
+
+            if (cache && cached == &laid_out)
+            {
+                cache->store(text.get(), 0, std::move(laid_out));
+            }
+        }
+
+        if (cache)
+        {
+            cache->endLayout();
+        }
+    }
+
+    bool same_lines(const std::vector<Line>& a, const std::vector<Line>& b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].mDocIndexStart != b[i].mDocIndexStart || a[i].mDocIndexEnd != b[i].mDocIndexEnd
+                || a[i].mRect != b[i].mRect || a[i].mLineNum != b[i].mLineNum)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::unique_ptr<std::string> chat_line(S32 i)
+    {
+        return std::make_unique<std::string>(llformat("[12:%02d] Resident %d: message number %d, long enough to wrap "
+                                                      "once or twice in a narrow nearby chat floater\n", i % 60, i % 97, i));
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct lltextlayoutcache_data
+    {
+    };
+    typedef test_group<lltextlayoutcache_data> lltextlayoutcache_group;
+    typedef lltextlayoutcache_group::object object;
+    lltextlayoutcache_group lltextlayoutcachegrp("lltextlayoutcache");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("reuse, settings and sweeping");
+
+        document_t document;
+        for (S32 i = 0; i < 100; ++i)
+        {
+            document.push_back(chat_line(i));
+        }
+
+        LLTextLayoutCache cache;
+        std::vector<Line> expected, lines;
+        reflow(document, NULL, 300, expected);
+        reflow(document, &cache, 300, lines);
+        ensure("same layout", same_lines(expected, lines));
+        ensure_equals("all stored", cache.size(), 100U);
+
+        // a name resolved in the first line: only that one is laid out
+        *document[0] = "[12:00] Someone Else: message number 0\n";
+        reflow(document, NULL, 300, expected);
+        reflow(document, &cache, 300, lines);
+        ensure("same layout after edit", same_lines(expected, lines));
+        ensure_equals("reused", cache.getStats().mHits, 99ULL);
+
+        // first line removed: its entry goes with the next full layout
+        document.erase(document.begin());
+        reflow(document, &cache, 300, lines);
+        ensure_equals("swept", cache.size(), 99U);
+        ensure_equals("reused again", cache.getStats().mHits, 99ULL + 99ULL);
+
+        // another width: nothing can be reused
+        reflow(document, NULL, 250, expected);
+        reflow(document, &cache, 250, lines);
+        ensure("same layout at another width", same_lines(expected, lines));
+        ensure_equals("nothing reused", cache.getStats().mHits, 99ULL + 99ULL);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("50k line chat history benchmark");
+
+        // Not a pass/fail test beyond the layouts matching.  Appends 50k
+        // lines, then times the reflows a long chat history goes through
+        // from the top: a name resolved in the first line, and the first
+        // line removed.
+        if (! getenv("LL_TEST_BENCHMARKS"))
+        {
+            skip("set LL_TEST_BENCHMARKS to run the benchmark");
+        }
+
+        const S32 LINES = 50000;
+        document_t document;
+        LLTextLayoutCache cache;
+        std::vector<Line> uncached, cached;
+
+        U64 start = LLTimer::getTotalTime();
+        for (S32 i = 0; i < LINES; ++i)
+        {
+            document.push_back(chat_line(i));
+            // appending only lays out the new paragraph
+            LLTextLayoutCache::Paragraph paragraph = layout_paragraph(*document.back(), 300);
+            paragraph.mFingerprint = std::hash<std::string>()(*document.back());
+            cache.store(document.back().get(), 0, std::move(paragraph));
+        }
+        const U64 append_time = LLTimer::getTotalTime() - start;
+
+        *document[0] = "[12:00] Someone Else: message number 0\n";
+        start = LLTimer::getTotalTime();
+        reflow(document, NULL, 300, uncached);
+        const U64 edit_uncached = LLTimer::getTotalTime() - start;
+        start = LLTimer::getTotalTime();
+        reflow(document, &cache, 300, cached);
+        const U64 edit_cached = LLTimer::getTotalTime() - start;
+        ensure("same layout after edit", same_lines(uncached, cached));
+
+        document.erase(document.begin());
+        start = LLTimer::getTotalTime();
+        reflow(document, NULL, 300, uncached);
+        const U64 remove_uncached = LLTimer::getTotalTime() - start;
+        start = LLTimer::getTotalTime();
+        reflow(document, &cache, 300, cached);
+        const U64 remove_cached = LLTimer::getTotalTime() - start;
+        ensure("same layout after removal", same_lines(uncached, cached));
+
+        std::cout << std::endl << LINES << " chat lines, " << cached.size() << " wrapped lines: append " << append_time
+                  << " uS; first line edited: " << edit_uncached << " uS laid out, " << edit_cached
+                  << " uS cached; first line removed: " << remove_uncached << " uS laid out, " << remove_cached
+                  << " uS cached" << std::endl;
+    }
+} // namespace tut
@@ -27,6 +27,7 @@
 
 #include "linden_common.h"
 #include "../llurlentry.h"
+#include "../llurlregistry.h"
 #include "../lluictrl.h"
 //#include "llurlentry_stub.cpp"
 #include "lltut.h"
@@ -34,7 +35,10 @@
 #include "../llrender/lluiimage.h"
 #include "../llmessage/llexperiencecache.h"
 
+#include "lltimer.h"
+
 #include <boost/regex.hpp>
+#include <iostream>
 
 #if LL_WINDOWS
 // because something pulls in window and lldxdiag dependencies which in turn need wbemuuid.lib
@@ -145,6 +149,40 @@ namespace tut
         ensure_equals(testname, label, expected);
     }
 
+    // Lines as they come in local chat, IMs and group chat, most without
+    // a Url, for the LLUrlRegistry tests
+    const char* CHAT_LINES[] =
+    {
+        "[10:02] Ahern Resident: hey everyone",
+        "[10:02] Ahern Resident: anyone know where the sandbox went?",
+        "[10:03] Zaphod Beeblebrox: try secondlife:///app/region/Sandbox%20Island/128/128/25",
+        "[10:03] Zaphod Beeblebrox: or http://maps.secondlife.com/secondlife/Sandbox%20Island/128/128/25",
+        "[10:04] Ahern Resident: thanks!! :)",
+        "[10:05] Trillian Astra: lol",
+        "[10:05] Trillian Astra: the new release notes are up at https://www.firestormviewer.org/release-notes/ btw",
+        "[10:06] Ahern Resident: is that the one that fixes FIRE-12345?",
+        "[10:06] Trillian Astra: yes, and BUG-7890 too I think",
+        "[10:07] Zaphod Beeblebrox: brb",
+        "[10:09] Ahern Resident: Who's going to the party tonight at hop://grid.example.org:8002/Party Island/100/100/30 ?",
+        "[10:09] Trillian Astra: me! send me a TP",
+        "[10:10] Zaphod Beeblebrox: back",
+        "[10:10] Zaphod Beeblebrox: mail me at zaphod@example.com if you want the notecard",
+        "[10:11] Ahern Resident: www.example.com has the schedule",
+        "[10:12] Trillian Astra: <nolink>http://not.a.link.example.com</nolink> is what it says on the sign",
+        "[10:12] Ahern Resident: ok",
+        "[10:13] Marvin Android: Life. Don't talk to me about life.",
+        "[10:14] Trillian Astra: the store is on the marketplace https://marketplace.secondlife.com/stores/12345",
+        "[10:14] Ahern Resident: nice, and the wiki? [https://wiki.secondlife.com/wiki/Main_Page the wiki]",
+        "[10:15] Zaphod Beeblebrox: heading to x-grid-location-info://grid.example.org/region/Welcome/128/128/22",
+        "[10:16] Marvin Android: I think you ought to know I'm feeling very depressed.",
+        "[10:16] Ahern Resident: ftp://files.example.net/pub/readme.txt has the old ones",
+        "[10:17] Trillian Astra: see you all later, bye!",
+        "[10:17] Ahern Resident: bye :D",
+        "[10:18] Zaphod Beeblebrox: anyone using the SH-1234 workaround still?",
+        "[10:19] Marvin Android: Here I am, brain the size of a planet...",
+        "[10:20] Ahern Resident: http://[2001:db8::1]:8080/status is down again",
+    };
+
     void testLocation(const std::string &testname, LLUrlEntryBase &entry,
                       const char *text, const std::string &expected)
     {
@@ -932,4 +970,84 @@ namespace tut
             "http://[ 2001:0db8:11a3:09d7:1f34:8a2e:07a0:765d ]",
             "");
     }
+
+    // all the Urls findUrl() finds in text, one after the other, the way
+    // LLTextBase looks for them
+    std::string findUrls(const std::string& text)
+    {
+        std::string found;
+        LLUrlMatch match;
+        size_t offset = 0;
+        while (offset < text.size()
+               && LLUrlRegistry::instance().findUrl(text.substr(offset), match, &dummyCallback, true))
+        {
+            found += llformat("%u-%u %s|", (U32)(offset + match.getStart()), (U32)(offset + match.getEnd()),
+                              match.getUrl().c_str());
+            offset += match.getEnd() + 1;
+        }
+        return found;
+    }
+
+    template<> template<>
+    void object::test<17>()
+    {
+        //
+        // test LLUrlRegistry::findUrl() with and without the anchor prefilter
+        //
+        LLUrlRegistry& registry = LLUrlRegistry::instance();
+        for (const char* line : CHAT_LINES)
+        {
+            registry.enableAnchorPrefilter(false);
+            const std::string expected = findUrls(line);
+            registry.enableAnchorPrefilter(true);
+            ensure_equals(line, findUrls(line), expected);
+        }
+        registry.enableAnchorPrefilter(true);
+
+        // the anchors are matched whatever the case, as the patterns are
+        const char* upper_case = "see HTTP://EXAMPLE.COM/ and WWW.EXAMPLE.COM";
+        ensure("upper case Url found", !findUrls(upper_case).empty());
+        registry.enableAnchorPrefilter(false);
+        const std::string expected = findUrls(upper_case);
+        registry.enableAnchorPrefilter(true);
+        ensure_equals("upper case Urls", findUrls(upper_case), expected);
+    }
+
+    template<> template<>
+    void object::test<18>()
+    {
+        //
+        // LLUrlRegistry::findUrl() benchmark
+        //
+        // Not a pass/fail test.  Times finding the Urls in a chat
+        // transcript with every Url type's regex tried, and with only
+        // those whose anchors are in the line.
+        if (! getenv("LL_TEST_BENCHMARKS"))
+        {
+            skip("set LL_TEST_BENCHMARKS to run the benchmark");
+        }
+
+        const S32 REPEATS = 20;
+        LLUrlRegistry& registry = LLUrlRegistry::instance();
+        U64 times[2] = { 0, 0 };
+        size_t found = 0;
+        for (S32 prefilter = 0; prefilter < 2; ++prefilter)
+        {
+            registry.enableAnchorPrefilter(prefilter != 0);
+            U64 start = LLTimer::getTotalTime();
+            for (S32 r = 0; r < REPEATS; ++r)
+            {
+                for (const char* line : CHAT_LINES)
+                {
+                    found += findUrls(line).size();
+                }
+            }
+            times[prefilter] = LLTimer::getTotalTime() - start;
+        }
+        registry.enableAnchorPrefilter(true);
+
+        std::cout << std::endl << LL_ARRAY_SIZE(CHAT_LINES) << " chat lines: " << times[0] / REPEATS
+                  << " uS with every regex, " << times[1] / REPEATS << " uS with the anchor prefilter ("
+                  << found << ")" << std::endl;
+    }
 }
@@ -46,7 +46,10 @@
 #include "llsdserialize.h"
 #include "llfile.h"
 #include "lltimer.h"
+#include "llframetimer.h"
 #include "lldir.h"
+#include "hbxxh.h"
+#include "llmemorystream.h"
 
 #if LL_RELEASE_WITH_DEBUG_INFO || LL_DEBUG
 #define CONTROL_ERRS LL_ERRS("ControlErrors")
@@ -96,14 +99,42 @@ const S32 CURRENT_VERSION = 101;
 
 // If you define the environment variable LL_SETTINGS_PROFILE to any value this will activate
 // the gSavedSettings profiling code.  This code tracks the calls to get a saved (debug) setting.
-// When the viewer exits the results are written to the log directory to the file specified
-// by SETTINGS_PROFILE below.  Only settings with an average access rate >= 2/second are output.
-typedef std::pair<std::string, U32> settings_pair_t;
-typedef std::vector<settings_pair_t> settings_vec_t;
-LLSD getCount;
-settings_vec_t getCount_v;
-F64 start_time = 0;
-std::string SETTINGS_PROFILE = "settings_profile.log";
+// When the viewer exits the results are written to the log directory, to a file per control
+// group named after SETTINGS_PROFILE below.  Only settings looked up every other frame or
+// more, or many times in one frame, are output.
+std::string SETTINGS_PROFILE = "settings_profile";
+
+namespace
+{
+    // Lookups of one setting in a single frame that suggest a loop
+    const U32 HOT_LOOP_LOOKUPS = 8;
+
+    // Defaults snapshot header, followed by the file's settings in the LLSD
+    // binary format.  Only used if made from a file of the same size and
+    // hash, by the same snapshot format version.
+    const char SNAPSHOT_MAGIC[8] = { 'L', 'L', 'S', 'E', 'T', 'S', 'N', 'P' };
+    const U32 SNAPSHOT_VERSION = 1;
+
+    struct SnapshotHeader
+    {
+        char mMagic[8];
+        U32 mVersion;
+        U32 mPad;
+        U64 mSourceSize;
+        U64 mSourceHash;
+    };
+
+    // FNV-1a
+    constexpr U64 hash_control_name(std::string_view name)
+    {
+        U64 hash = 14695981039346656037ULL;
+        for (char c : name)
+        {
+            hash = (hash ^ (U8)c) * 1099511628211ULL;
+        }
+        return hash;
+    }
+}
 
 bool LLControlVariable::llsd_compare(const LLSD& a, const LLSD & b)
 {
@@ -161,7 +192,8 @@ LLControlVariable::LLControlVariable(const std::string& name, eControlType type,
       mCanBackup(can_backup),       // <FS:Zi> Backup Settings
       mHideFromSettingsEditor(hidefromsettingseditor),
       mSanityType(sanityType),
-      mSanityComment(sanityComment)
+      mSanityComment(sanityComment),
+      mSlot(0)
 {
     if ((persist != PERSIST_NO) && mComment.empty())
     {
@@ -172,6 +204,7 @@ LLControlVariable::LLControlVariable(const std::string& name, eControlType type,
     }
     //Push back versus setValue'ing here, since we don't want to call a signal yet
     mValues.push_back(initial);
+    updateTypedValue();
 
     mSanityValues.push_back(sanityValues[0]);
     mSanityValues.push_back(sanityValues[1]);
@@ -265,6 +298,7 @@ void LLControlVariable::setValue(const LLSD& new_value, bool saved_value)
             mValues.push_back(storable_value);
         }
     }
+    updateTypedValue();
 
     if(value_changed)
     {
@@ -285,6 +319,7 @@ void LLControlVariable::setDefaultValue(const LLSD& value)
     bool value_changed = !llsd_compare(original_value, comparable_value);
     resetToDefault(false);
     mValues[0] = comparable_value;
+    updateTypedValue();
     if (value_changed)
     {
         mSanitySignal(this,isSane());
@@ -324,6 +359,7 @@ void LLControlVariable::resetToDefault(bool fire_signal)
     {
         mValues.pop_back();
     }
+    updateTypedValue();
 
     if(fire_signal)
     {
@@ -407,6 +443,30 @@ bool LLControlVariable::shouldSave(bool nondefault_only)
     return ! llsd_compare(getSaveValue(), getDefault());
 }
 
+void LLControlVariable::updateTypedValue()
+{
+    // same conversions as convert_from_llsd()
+    const LLSD& value = mValues.back();
+    switch (mType)
+    {
+    case TYPE_U32:
+        mTypedValue.mU32 = (U32)value.asInteger();
+        break;
+    case TYPE_S32:
+        mTypedValue.mS32 = value.asInteger();
+        break;
+    case TYPE_F32:
+        mTypedValue.mF32 = (F32)value.asReal();
+        break;
+    case TYPE_BOOLEAN:
+        mTypedValue.mBool = value.asBoolean();
+        break;
+    default:
+        mTypedValue.mU32 = 0;
+        break;
+    }
+}
+
 LLSD LLControlVariable::getSaveValue() const
 {
     //The first level of the stack is default
@@ -417,13 +477,148 @@ LLSD LLControlVariable::getSaveValue() const
 
 LLPointer<LLControlVariable> LLControlGroup::getControl(std::string_view name)
 {
+    return findControl(name);
+}
+
+LLControlVariable* LLControlGroup::findControl(std::string_view name)
+{
+    const U64 hash = hash_control_name(name);
+    if (!mIndex.empty())
+    {
+        const size_t mask = mIndex.size() - 1;
+        for (size_t i = hash & mask; mIndex[i].mControl; i = (i + 1) & mask)
+        {
+            const IndexEntry& entry = mIndex[i];
+            if (entry.mHash == hash && entry.mControl->getName() == name)
+            {
+                if (mSettingsProfile)
+                {
+                    traceLookup(mLookupTraces[entry.mControl->mSlot]);
+                }
+                return entry.mControl;
+            }
+        }
+    }
+
     if (mSettingsProfile)
     {
-        incrCount(name);
+        auto it = mMissingLookups.find(name);
+        if (it == mMissingLookups.end())
+        {
+            it = mMissingLookups.emplace(std::string(name), LookupTrace()).first;
+        }
+        traceLookup(it->second);
+    }
+    return NULL;
+}
+
+void LLControlGroup::indexControl(LLControlVariable* control)
+{
+    control->mSlot = (U32)mControls.size();
+    mControls.push_back(control);
+    mLookupTraces.resize(mControls.size());
+
+    if (mControls.size() * 2 > mIndex.size())
+    {
+        // grow and rehash everything, including this one
+        rehashIndex(mControls.size());
+        return;
+    }
+
+    const U64 hash = hash_control_name(control->getName());
+    const size_t mask = mIndex.size() - 1;
+    size_t i = hash & mask;
+    while (mIndex[i].mControl)
+    {
+        i = (i + 1) & mask;
+    }
+    mIndex[i] = IndexEntry{ hash, control };
+}
+
+void LLControlGroup::rehashIndex(size_t capacity)
+{
+    size_t size = llmax(mIndex.size(), (size_t)1024);
+    while (size < capacity * 2)
+    {
+        size *= 2;
+    }
+    if (size == mIndex.size())
+    {
+        return;
+    }
+
+    mIndex.assign(size, IndexEntry{ 0, NULL });
+    const size_t mask = size - 1;
+    for (LLControlVariable* indexed : mControls)
+    {
+        const U64 hash = hash_control_name(indexed->getName());
+        size_t i = hash & mask;
+        while (mIndex[i].mControl)
+        {
+            i = (i + 1) & mask;
+        }
+        mIndex[i] = IndexEntry{ hash, indexed };
+    }
+}
+
+void LLControlGroup::traceLookup(LookupTrace& trace)
+{
+    const U32 frame = LLFrameTimer::getFrameCount();
+    ++trace.mCount;
+    if (trace.mFrame != frame)
+    {
+        trace.mFrame = frame;
+        trace.mFrameCount = 0;
+    }
+    trace.mPeakFrameCount = llmax(trace.mPeakFrameCount, ++trace.mFrameCount);
+}
+
+void LLControlGroup::setLookupTracing(bool enable)
+{
+    if (enable && !mSettingsProfile)
+    {
+        // start over
+        mLookupTraces.assign(mControls.size(), LookupTrace());
+        mMissingLookups.clear();
+        mTraceStartFrame = LLFrameTimer::getFrameCount();
+        mTraceStartTime = LLTimer::getTotalSeconds();
+    }
+    mSettingsProfile = enable;
+}
+
+U32 LLControlGroup::writeLookupTrace(std::ostream& out, F32 min_per_frame)
+{
+    const U32 frames = llmax(LLFrameTimer::getFrameCount() - mTraceStartFrame, 1U);
+    const F64 seconds = LLTimer::getTotalSeconds() - mTraceStartTime;
+
+    typedef std::pair<std::string, const LookupTrace*> entry_t;
+    std::vector<entry_t> entries;
+    for (size_t slot = 0; slot < mControls.size(); ++slot)
+    {
+        entries.emplace_back(mControls[slot]->getName(), &mLookupTraces[slot]);
+    }
+    for (const auto& missing : mMissingLookups)
+    {
+        entries.emplace_back(missing.first + " (missing)", &missing.second);
     }
+    std::sort(entries.begin(), entries.end(),
+              [](const entry_t& lhs, const entry_t& rhs){ return lhs.second->mCount > rhs.second->mCount; });
 
-    ctrl_name_table_t::iterator iter = mNameTable.find(name);
-    return iter == mNameTable.end() ? LLPointer<LLControlVariable>() : iter->second;
+    out << llformat("Settings lookups by name over %u frames (%.0f seconds)\n\n", frames, seconds)
+        << "     Lookups  Per frame  Peak in a frame  Name\n";
+    U32 written = 0;
+    for (const entry_t& entry : entries)
+    {
+        const LookupTrace& trace = *entry.second;
+        const F32 per_frame = (F32)trace.mCount / (F32)frames;
+        if (trace.mCount && (per_frame >= min_per_frame || trace.mPeakFrameCount >= HOT_LOOP_LOOKUPS))
+        {
+            out << llformat("%12llu  %9.2f  %15u  %s\n", (unsigned long long)trace.mCount, per_frame,
+                            trace.mPeakFrameCount, entry.first.c_str());
+            ++written;
+        }
+    }
+    return written;
 }
 
 
@@ -457,12 +652,14 @@ const std::string LLControlGroup::mSanityTypeString[SANITY_TYPE_COUNT] = { "None
 
 LLControlGroup::LLControlGroup(const std::string& name)
 :   LLInstanceTracker<LLControlGroup, std::string>(name),
+    mTraceStartFrame(0),
+    mTraceStartTime(0.0),
     mSettingsProfile(false)
 {
 
     if (NULL != getenv("LL_SETTINGS_PROFILE"))
     {
-        mSettingsProfile = true;
+        setLookupTracing(true);
     }
 }
 
@@ -471,66 +668,27 @@ LLControlGroup::~LLControlGroup()
     cleanup();
 }
 
-static bool compareRoutine(settings_pair_t lhs, settings_pair_t rhs)
-{
-    return lhs.second > rhs.second;
-};
-
 void LLControlGroup::cleanup()
 {
-    if(mSettingsProfile && getCount.size() != 0)
+    if (mSettingsProfile && !mControls.empty())
     {
-        std::string file = gDirUtilp->getExpandedFilename(LL_PATH_LOGS, SETTINGS_PROFILE);
-        LLFILE* out = LLFile::fopen(file, "w"); /* Flawfinder: ignore */
-        if(!out)
+        const std::string filename = SETTINGS_PROFILE + "_" + getKey() + ".log";
+        llofstream out(gDirUtilp->getExpandedFilename(LL_PATH_LOGS, filename).c_str());
+        if (!out.is_open())
         {
-            LL_WARNS("SettingsProfile") << "Error opening " << SETTINGS_PROFILE << LL_ENDL;
+            LL_WARNS("SettingsProfile") << "Error opening " << filename << LL_ENDL;
         }
         else
         {
-            F64 end_time = LLTimer::getTotalSeconds();
-            U32 total_seconds = (U32)(end_time - start_time);
-
-            std::string msg = llformat("Runtime (seconds): %d\n\n No. accesses   Avg. accesses/sec  Name\n", total_seconds);
-            std::ostringstream data_msg;
-
-            data_msg << msg;
-            size_t data_size = data_msg.str().size();
-            if (fwrite(data_msg.str().c_str(), 1, data_size, out) != data_size)
-            {
-                LL_WARNS("SettingsProfile") << "Failed to write settings profile header" << LL_ENDL;
-            }
-
-            for (LLSD::map_const_iterator iter = getCount.beginMap(); iter != getCount.endMap(); ++iter)
-            {
-                getCount_v.push_back(settings_pair_t(iter->first, iter->second.asInteger()));
-            }
-            sort(getCount_v.begin(), getCount_v.end(), compareRoutine);
-
-            for (settings_vec_t::iterator iter = getCount_v.begin(); iter != getCount_v.end(); ++iter)
-            {
-                U32 access_rate = 0;
-                if (total_seconds != 0)
-                {
-                    access_rate = iter->second / total_seconds;
-                }
-                if (access_rate >= 2)
-                {
-                    std::ostringstream data_msg;
-                    msg = llformat("%13d        %7d       %s", iter->second, access_rate, iter->first.c_str());
-                    data_msg << msg << "\n";
-                    size_t data_size = data_msg.str().size();
-                    if (fwrite(data_msg.str().c_str(), 1, data_size, out) != data_size)
-                    {
-                        LL_WARNS("SettingsProfile") << "Failed to write settings profile" << LL_ENDL;
-                    }
-                }
-            }
-            getCount = LLSD::emptyMap();
-            fclose(out);
+            writeLookupTrace(out);
         }
+        mSettingsProfile = false;
     }
 
+    mIndex.clear();
+    mControls.clear();
+    mLookupTraces.clear();
+    mMissingLookups.clear();
     mNameTable.clear();
 }
 
@@ -593,6 +751,7 @@ LLControlVariable* LLControlGroup::declareControl(const std::string& name, eCont
     LLControlVariable* control = new LLControlVariable(name, type, initial_val, comment, sanity_type, sanity_value, sanity_comment, persist, can_backup, hidefromsettingseditor);
     // </FS:Zi>
     mNameTable[name] = control;
+    indexControl(control);
     return control;
 }
 
@@ -656,32 +815,46 @@ LLControlVariable* LLControlGroup::declareLLSD(const std::string& name, const LL
     return declareControl(name, TYPE_LLSD, initial_val, comment, SANITY_TYPE_NONE, LLSD(), std::string(""), persist);
 }
 
-void LLControlGroup::incrCount(std::string_view name)
-{
-    if (0.0 == start_time)
-    {
-        start_time = LLTimer::getTotalSeconds();
-    }
-    getCount[name.data()] = getCount[name.data()].asInteger() + 1;
-}
+// The scalar getters read the typed copy of the value, and only go through
+// get<T>() and LLSD to report a missing control or a type mismatch.
 
 bool LLControlGroup::getBOOL(std::string_view name)
 {
+    LLControlVariable* control = findControl(name);
+    if (control && control->isType(TYPE_BOOLEAN))
+    {
+        return control->mTypedValue.mBool;
+    }
     return get<bool>(name);
 }
 
 S32 LLControlGroup::getS32(std::string_view name)
 {
+    LLControlVariable* control = findControl(name);
+    if (control && control->isType(TYPE_S32))
+    {
+        return control->mTypedValue.mS32;
+    }
     return get<S32>(name);
 }
 
 U32 LLControlGroup::getU32(std::string_view name)
 {
+    LLControlVariable* control = findControl(name);
+    if (control && control->isType(TYPE_U32))
+    {
+        return control->mTypedValue.mU32;
+    }
     return get<U32>(name);
 }
 
 F32 LLControlGroup::getF32(std::string_view name)
 {
+    LLControlVariable* control = findControl(name);
+    if (control && control->isType(TYPE_F32))
+    {
+        return control->mTypedValue.mF32;
+    }
     return get<F32>(name);
 }
 
@@ -764,8 +937,7 @@ LLSD LLControlGroup::asLLSD(bool diffs_only)
 
 bool LLControlGroup::controlExists(std::string_view name)
 {
-    ctrl_name_table_t::iterator iter = mNameTable.find(name);
-    return iter != mNameTable.end();
+    return findControl(name) != NULL;
 }
 
 
@@ -1111,9 +1283,106 @@ U32 LLControlGroup::loadFromFile(const std::string& filename, bool set_default_v
         return loadFromFileLegacy(filename, true, TYPE_STRING);
     }
 
+    return loadFromLLSD(settings, filename, set_default_values, save_values);
+}
+
+U32 LLControlGroup::loadDefaultsFromFile(const std::string& filename, const std::string& snapshot_filename, bool* from_snapshot)
+{
+    if (from_snapshot)
+    {
+        *from_snapshot = false;
+    }
+
+    const std::string source = LLFile::getContents(filename);
+    if (source.empty())
+    {
+        LL_WARNS("Settings") << "Cannot find file " << filename << " to load." << LL_ENDL;
+        return 0;
+    }
+    const U64 source_hash = HBXXH64::digest(source);
+
+    LLSD settings;
+    if (!snapshot_filename.empty())
+    {
+        const std::string snapshot = LLFile::getContents(snapshot_filename);
+        SnapshotHeader header;
+        if (snapshot.size() > sizeof(header))
+        {
+            memcpy(&header, snapshot.data(), sizeof(header));
+            if (!memcmp(header.mMagic, SNAPSHOT_MAGIC, sizeof(header.mMagic))
+                && header.mVersion == SNAPSHOT_VERSION
+                && header.mSourceSize == source.size()
+                && header.mSourceHash == source_hash)
+            {
+                const S32 length = (S32)(snapshot.size() - sizeof(header));
+                LLMemoryStream stream((const U8*)snapshot.data() + sizeof(header), length);
+                if (LLSDParser::PARSE_FAILURE != LLSDSerialize::fromBinary(settings, stream, length)
+                    && settings.isMap())
+                {
+                    if (from_snapshot)
+                    {
+                        *from_snapshot = true;
+                    }
+                    return loadFromLLSD(settings, filename, true, true);
+                }
+                LL_WARNS("Settings") << "Unable to parse settings snapshot " << snapshot_filename << LL_ENDL;
+                settings.clear();
+            }
+            else
+            {
+                LL_INFOS("Settings") << "Settings snapshot " << snapshot_filename << " is out of date" << LL_ENDL;
+            }
+        }
+    }
+
+    LLMemoryStream stream((const U8*)source.data(), (S32)source.size());
+    if (LLSDParser::PARSE_FAILURE == LLSDSerialize::fromXML(settings, stream))
+    {
+        // not worth a snapshot
+        return loadFromFile(filename, true);
+    }
+
+    const U32 validitems = loadFromLLSD(settings, filename, true, true);
+    if (!snapshot_filename.empty())
+    {
+        // Written aside and renamed, so another viewer instance starting
+        // at the same time never reads half of it
+        const std::string temp_filename = snapshot_filename + ".tmp";
+        llofstream out(temp_filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (out.is_open())
+        {
+            SnapshotHeader header;
+            memcpy(header.mMagic, SNAPSHOT_MAGIC, sizeof(header.mMagic));
+            header.mVersion = SNAPSHOT_VERSION;
+            header.mPad = 0;
+            header.mSourceSize = source.size();
+            header.mSourceHash = source_hash;
+            out.write((const char*)&header, sizeof(header));
+            LLSDSerialize::toBinary(settings, out);
+            out.close();
+            // rename() won't replace a file on Windows
+            LLFile::remove(snapshot_filename, ENOENT);
+            if (out.fail() || LLFile::rename(temp_filename, snapshot_filename) != 0)
+            {
+                LL_WARNS("Settings") << "Unable to write settings snapshot " << snapshot_filename << LL_ENDL;
+                LLFile::remove(temp_filename);
+            }
+        }
+    }
+    return validitems;
+}
+
+U32 LLControlGroup::loadFromLLSD(const LLSD& settings, const std::string& filename, bool set_default_values, bool save_values)
+{
     U32 validitems = 0;
     bool hidefromsettingseditor = false;
 
+    if (set_default_values)
+    {
+        // most of them are new: size the index once
+        rehashIndex(mControls.size() + settings.size());
+    }
+
     for(LLSD::map_const_iterator itr = settings.beginMap(); itr != settings.endMap(); ++itr)
     {
         LLControlVariable::ePersist persist = LLControlVariable::PERSIST_NONDFT;
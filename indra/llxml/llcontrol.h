@@ -34,6 +34,7 @@
 #include "llrefcount.h"
 #include "llinstancetracker.h"
 
+#include <iosfwd>
 #include <vector>
 
 #include <boost/bind.hpp>
@@ -106,6 +107,16 @@ private:
     bool            mHideFromSettingsEditor;
     std::vector<LLSD> mValues;
     std::vector<LLSD> mSanityValues;
+    U32             mSlot;          // dense index in the owning LLControlGroup
+
+    // mValues.back() for the scalar types, so typed reads skip LLSD
+    union
+    {
+        U32 mU32;
+        S32 mS32;
+        F32 mF32;
+        bool mBool;
+    } mTypedValue;
 
     commit_signal_t mCommitSignal;
     validate_signal_t mValidateSignal;
@@ -170,6 +181,7 @@ private:
     }
     LLSD getComparableValue(const LLSD& value);
     bool llsd_compare(const LLSD& a, const LLSD & b);
+    void updateTypedValue();
 };
 
 typedef LLPointer<LLControlVariable> LLControlVariablePtr;
@@ -207,6 +219,35 @@ protected:
     static const std::string mTypeString[TYPE_COUNT];
     static const std::string mSanityTypeString[SANITY_TYPE_COUNT];
 
+    // Lookups by name go through an open addressing hash index instead of
+    // mNameTable, which is kept for ordered iteration.  Controls also get a
+    // dense slot at declaration, used to keep lookup traces.
+    struct IndexEntry
+    {
+        U64 mHash;
+        LLControlVariable* mControl;    // owned by mNameTable
+    };
+    std::vector<IndexEntry> mIndex;     // power of 2 size, at most half full
+    std::vector<LLControlVariable*> mControls;
+
+    struct LookupTrace
+    {
+        U64 mCount = 0;
+        U32 mFrame = 0;         // frame of the latest lookup
+        U32 mFrameCount = 0;    // lookups in that frame
+        U32 mPeakFrameCount = 0;
+    };
+    std::vector<LookupTrace> mLookupTraces;         // by slot
+    std::map<std::string, LookupTrace, std::less<> > mMissingLookups;
+    U32 mTraceStartFrame;
+    F64 mTraceStartTime;
+
+    LLControlVariable* findControl(std::string_view name);
+    void indexControl(LLControlVariable* control);
+    void rehashIndex(size_t capacity);
+    U32 loadFromLLSD(const LLSD& settings, const std::string& filename, bool set_default_values, bool save_values);
+    void traceLookup(LookupTrace& trace);
+
 public:
     static eControlType typeStringToEnum(const std::string& typestr);
     static eSanityType sanityTypeStringToEnum(const std::string& sanitystr);
@@ -219,6 +260,17 @@ public:
 
     LLControlVariablePtr getControl(std::string_view name);
 
+    // Lookup tracing counts every lookup by name, to find code that looks
+    // settings up by string every frame instead of using LLCachedControl.
+    // It is on from the start with the LL_SETTINGS_PROFILE environment
+    // variable, and the report is then written to the log folder at exit.
+    void setLookupTracing(bool enable);
+    bool isLookupTracing() const { return mSettingsProfile; }
+    // Writes the settings looked up at least min_per_frame times per frame
+    // on average, or many times in a single frame, since tracing started,
+    // busiest first.  Returns the number of settings written.
+    U32 writeLookupTrace(std::ostream& out, F32 min_per_frame = 0.5f);
+
     struct ApplyFunctor
     {
         virtual ~ApplyFunctor() {};
@@ -323,8 +375,12 @@ public:
     U32 loadFromFileLegacy(const std::string& filename, bool require_declaration = true, eControlType declare_as = TYPE_STRING);
     U32 saveToFile(const std::string& filename, bool nondefault_only);
     U32 loadFromFile(const std::string& filename, bool default_values = false, bool save_values = true);
+    // Same as loadFromFile(filename, true), but from a binary snapshot of
+    // the file's settings when there is one made from the same file
+    // contents, which saves parsing the XML.  Otherwise the file is parsed
+    // and the snapshot written for next time.
+    U32 loadDefaultsFromFile(const std::string& filename, const std::string& snapshot_filename, bool* from_snapshot = NULL);
     void    resetToDefaults();
-    void    incrCount(std::string_view name);
 
     bool    mSettingsProfile;
 };
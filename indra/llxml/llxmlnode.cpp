@@ -44,10 +44,15 @@
 #include "llstring.h"
 #include "lluuid.h"
 #include "lldir.h"
+#include "llmutex.h"
+#include "hbxxh.h"
 
 // static
 bool LLXMLNode::sStripEscapedStrings = true;
 bool LLXMLNode::sStripWhitespaceValues = false;
+std::string LLXMLNode::sLayeredCacheDir;
+std::atomic<U32> LLXMLNode::sLayeredCacheHits(0);
+std::atomic<U32> LLXMLNode::sLayeredCacheMisses(0);
 
 LLXMLNode::LLXMLNode() :
     mID(""),
@@ -851,6 +856,16 @@ bool LLXMLNode::getLayeredXMLNode(LLXMLNodePtr& root,
         return false;
     }
 
+    if (!sLayeredCacheDir.empty())
+    {
+        if (loadLayeredCache(paths, root))
+        {
+            ++sLayeredCacheHits;
+            return true;
+        }
+        ++sLayeredCacheMisses;
+    }
+
     if (!LLXMLNode::parseFile(filename, root, NULL))
     {
         LL_WARNS() << "Problem reading UI description file: " << filename << " " << errno << LL_ENDL;
@@ -889,9 +904,543 @@ bool LLXMLNode::getLayeredXMLNode(LLXMLNodePtr& root,
         }
     }
 
+    if (!sLayeredCacheDir.empty())
+    {
+        saveLayeredCache(paths, root);
+    }
+    return true;
+}
+
+namespace
+{
+    const U32 LAYERED_CACHE_MAGIC = 0x43495558; // "XUIC"
+    const U32 LAYERED_CACHE_VERSION = 1;
+
+    // deeper than any XUI file
+    const U32 PACKED_TREE_MAX_DEPTH = 256;
+
+    enum
+    {
+        LAYERED_CACHE_STRIP_ESCAPED = 0x1,
+        LAYERED_CACHE_STRIP_WHITESPACE = 0x2
+    };
+
+    struct LayeredCacheHeader
+    {
+        U32 mMagic;
+        U32 mVersion;
+        U32 mLayerCount;
+        U32 mFlags;         // parser options the layers were read with
+    };
+
+    // One of the layers the tree was merged from, followed by its path
+    struct LayeredCacheLayer
+    {
+        U64 mSize;
+        S64 mModified;
+        U32 mPathLength;
+        U32 mReserved;
+    };
+
+    struct PackedTreeHeader
+    {
+        U32 mStringCount;
+        U32 mNodeCount;
+    };
+
+    // Strings are indices into the tree's string table
+    struct PackedNode
+    {
+        U32 mName;
+        U32 mValue;
+        U32 mID;
+        S32 mLineNumber;
+        U32 mVersionMajor;
+        U32 mVersionMinor;
+        U32 mLength;
+        U32 mPrecision;
+        U32 mType;
+        U32 mEncoding;
+        U32 mAttributeCount;
+        U32 mChildCount;
+    };
+
+    struct PackedAttribute
+    {
+        U32 mName;
+        U32 mValue;
+        S32 mLineNumber;
+    };
+
+    void append_bytes(std::vector<U8>& out, const void* src, size_t bytes)
+    {
+        if (bytes)
+        {
+            const U8* p = (const U8*) src;
+            out.insert(out.end(), p, p + bytes);
+        }
+    }
+
+    bool read_bytes(const U8*& cur, const U8* end, void* dst, size_t bytes)
+    {
+        if (size_t(end - cur) < bytes)
+        {
+            return false;
+        }
+        if (bytes)
+        {
+            memcpy(dst, cur, bytes);
+            cur += bytes;
+        }
+        return true;
+    }
+
+    U32 layered_cache_flags()
+    {
+        return (LLXMLNode::sStripEscapedStrings ? LAYERED_CACHE_STRIP_ESCAPED : 0)
+            | (LLXMLNode::sStripWhitespaceValues ? LAYERED_CACHE_STRIP_WHITESPACE : 0);
+    }
+
+    // Size and modification time of a layer, both 0 for the empty paths
+    // getLayeredXMLNode() skips
+    bool get_layer_stamp(const std::string& path, U64& size, S64& modified)
+    {
+        size = 0;
+        modified = 0;
+        if (path.empty())
+        {
+            return true;
+        }
+        llstat status;
+        if (LLFile::stat(path, &status) != 0)
+        {
+            return false;
+        }
+        size = (U64)status.st_size;
+        modified = (S64)status.st_mtime;
+        return true;
+    }
+
+    std::string layered_cache_filename(const std::string& dir, const std::vector<std::string>& paths)
+    {
+        std::string key;
+        for (const std::string& path : paths)
+        {
+            key += path;
+            key += '\n';
+        }
+        return dir + gDirUtilp->getDirDelimiter() + gDirUtilp->getBaseFileName(paths.front(), true)
+            + llformat("_%016llx.bin", (unsigned long long)HBXXH64::digest(key));
+    }
+
+    // Checks a cache entry against the layers as they are now.  On success
+    // tree_offset is where the packed tree starts.
+    bool check_layered_cache(const std::string& cached, const std::vector<std::string>& paths, size_t& tree_offset)
+    {
+        const U8* start = (const U8*)cached.data();
+        const U8* cur = start;
+        const U8* end = cur + cached.size();
+        LayeredCacheHeader header;
+        if (!read_bytes(cur, end, &header, sizeof(header))
+            || header.mMagic != LAYERED_CACHE_MAGIC
+            || header.mVersion != LAYERED_CACHE_VERSION
+            || header.mLayerCount != paths.size()
+            || header.mFlags != layered_cache_flags())
+        {
+            return false;
+        }
+
+        for (const std::string& path : paths)
+        {
+            LayeredCacheLayer layer;
+            U64 size;
+            S64 modified;
+            if (!read_bytes(cur, end, &layer, sizeof(layer))
+                || layer.mPathLength != path.size()
+                || size_t(end - cur) < layer.mPathLength
+                || path.compare(0, path.size(), (const char*)cur, layer.mPathLength) != 0)
+            {
+                return false;
+            }
+            cur += layer.mPathLength;
+
+            if (!get_layer_stamp(path, size, modified) || size != layer.mSize || modified != layer.mModified)
+            {
+                LL_DEBUGS("XMLNode") << "Cached " << paths.front() << " is out of date" << LL_ENDL;
+                return false;
+            }
+        }
+
+        tree_offset = cur - start;
+        return true;
+    }
+
+    // Entries read ahead by prefetchLayeredCache(), by cache file name,
+    // until getLayeredXMLNode() asks for them
+    const size_t MAX_PREFETCHED_TREES = 64;
+    LLMutex sPrefetchedMutex;
+    std::map<std::string, std::string> sPrefetched;
+
+    bool take_prefetched(const std::string& filename, std::string& cached)
+    {
+        LLMutexLock lock(&sPrefetchedMutex);
+        auto it = sPrefetched.find(filename);
+        if (it == sPrefetched.end())
+        {
+            return false;
+        }
+        cached.swap(it->second);
+        sPrefetched.erase(it);
+        return true;
+    }
+
+    class TreePacker
+    {
+    public:
+        U32 addString(const std::string& str)
+        {
+            auto inserted = mIndices.emplace(str, (U32)mStrings.size());
+            if (inserted.second)
+            {
+                mStrings.push_back(&inserted.first->first);
+            }
+            return inserted.first->second;
+        }
+
+        std::map<std::string, U32> mIndices;
+        std::vector<const std::string*> mStrings;
+        std::vector<U8> mNodes;
+        U32 mNodeCount = 0;
+    };
+
+    class TreeUnpacker
+    {
+    public:
+        TreeUnpacker(const U8* cur, const U8* end)
+        :   mCur(cur),
+            mEnd(end)
+        {
+        }
+
+        bool readStrings(U32 count)
+        {
+            // each one takes at least its length
+            if (count > size_t(mEnd - mCur) / sizeof(U32))
+            {
+                return false;
+            }
+            mStrings.resize(count);
+            mEntries.resize(count, NULL);
+            for (std::string& str : mStrings)
+            {
+                U32 length = 0;
+                if (!read_bytes(mCur, mEnd, &length, sizeof(length)) || length > size_t(mEnd - mCur))
+                {
+                    return false;
+                }
+                str.assign((const char*)mCur, length);
+                mCur += length;
+            }
+            return true;
+        }
+
+        bool getString(U32 index, std::string& str) const
+        {
+            if (index >= mStrings.size())
+            {
+                return false;
+            }
+            str = mStrings[index];
+            return true;
+        }
+
+        const std::vector<std::string>& getStrings() const { return mStrings; }
+
+        // Names are interned the first time they come up
+        LLStringTableEntry* getName(U32 index)
+        {
+            if (index >= mStrings.size() || mStrings[index].empty())
+            {
+                return NULL;
+            }
+            if (!mEntries[index])
+            {
+                mEntries[index] = gStringTable.addStringEntry(mStrings[index]);
+            }
+            return mEntries[index];
+        }
+
+        const U8* mCur;
+        const U8* mEnd;
+        U32 mNodesLeft = 0;
+
+    private:
+        std::vector<std::string> mStrings;
+        std::vector<LLStringTableEntry*> mEntries;
+    };
+
+    void pack_node(LLXMLNode* node, TreePacker& packer)
+    {
+        U32 child_count = 0;
+        for (LLXMLNodePtr child = node->getFirstChild(); child.notNull(); child = child->getNextSibling())
+        {
+            ++child_count;
+        }
+
+        PackedNode packed;
+        packed.mName = packer.addString(node->getName()->mString);
+        packed.mValue = packer.addString(node->getValue());
+        packed.mID = packer.addString(node->mID);
+        packed.mLineNumber = node->mLineNumber;
+        packed.mVersionMajor = node->mVersionMajor;
+        packed.mVersionMinor = node->mVersionMinor;
+        packed.mLength = node->mLength;
+        packed.mPrecision = node->mPrecision;
+        packed.mType = (U32)node->mType;
+        packed.mEncoding = (U32)node->mEncoding;
+        packed.mAttributeCount = (U32)node->mAttributes.size();
+        packed.mChildCount = child_count;
+        append_bytes(packer.mNodes, &packed, sizeof(packed));
+        ++packer.mNodeCount;
+
+        for (LLXMLAttribList::const_iterator it = node->mAttributes.begin(); it != node->mAttributes.end(); ++it)
+        {
+            PackedAttribute attribute;
+            attribute.mName = packer.addString(it->first->mString);
+            attribute.mValue = packer.addString(it->second->getValue());
+            attribute.mLineNumber = it->second->mLineNumber;
+            append_bytes(packer.mNodes, &attribute, sizeof(attribute));
+        }
+
+        for (LLXMLNodePtr child = node->getFirstChild(); child.notNull(); child = child->getNextSibling())
+        {
+            pack_node(child, packer);
+        }
+    }
+
+    LLXMLNodePtr unpack_node(TreeUnpacker& unpacker, U32 depth)
+    {
+        PackedNode packed;
+        if (depth > PACKED_TREE_MAX_DEPTH || !unpacker.mNodesLeft
+            || !read_bytes(unpacker.mCur, unpacker.mEnd, &packed, sizeof(packed)))
+        {
+            return NULL;
+        }
+        --unpacker.mNodesLeft;
+
+        LLStringTableEntry* name = unpacker.getName(packed.mName);
+        std::string value, id;
+        if (!name || !unpacker.getString(packed.mValue, value) || !unpacker.getString(packed.mID, id)
+            || packed.mType > LLXMLNode::TYPE_NODEREF || packed.mEncoding > LLXMLNode::ENCODING_HEX)
+        {
+            return NULL;
+        }
+
+        LLXMLNodePtr node = new LLXMLNode(name, false);
+        node->setValue(value);
+        node->mID = id;
+        node->mLineNumber = packed.mLineNumber;
+        node->mVersionMajor = packed.mVersionMajor;
+        node->mVersionMinor = packed.mVersionMinor;
+        node->mLength = packed.mLength;
+        node->mPrecision = packed.mPrecision;
+        node->mType = (LLXMLNode::ValueType)packed.mType;
+        node->mEncoding = (LLXMLNode::Encoding)packed.mEncoding;
+
+        for (U32 i = 0; i < packed.mAttributeCount; ++i)
+        {
+            PackedAttribute attribute;
+            if (!read_bytes(unpacker.mCur, unpacker.mEnd, &attribute, sizeof(attribute)))
+            {
+                return NULL;
+            }
+            LLStringTableEntry* attribute_name = unpacker.getName(attribute.mName);
+            if (!attribute_name || !unpacker.getString(attribute.mValue, value))
+            {
+                return NULL;
+            }
+            LLXMLNodePtr attribute_node = new LLXMLNode(attribute_name, true);
+            attribute_node->setValue(value);
+            attribute_node->mLineNumber = attribute.mLineNumber;
+            node->addChild(attribute_node);
+        }
+
+        for (U32 i = 0; i < packed.mChildCount; ++i)
+        {
+            LLXMLNodePtr child = unpack_node(unpacker, depth + 1);
+            if (child.isNull())
+            {
+                return NULL;
+            }
+            node->addChild(child);
+        }
+        return node;
+    }
+}
+
+// static
+void LLXMLNode::setLayeredCacheDir(const std::string& dir)
+{
+    sLayeredCacheDir = dir;
+    LLMutexLock lock(&sPrefetchedMutex);
+    sPrefetched.clear();
+}
+
+// static
+void LLXMLNode::packTree(LLXMLNode* root, std::vector<U8>& out)
+{
+    TreePacker packer;
+    pack_node(root, packer);
+
+    PackedTreeHeader header = { (U32)packer.mStrings.size(), packer.mNodeCount };
+    append_bytes(out, &header, sizeof(header));
+    for (const std::string* str : packer.mStrings)
+    {
+        const U32 length = (U32)str->size();
+        append_bytes(out, &length, sizeof(length));
+        append_bytes(out, str->data(), length);
+    }
+    append_bytes(out, packer.mNodes.data(), packer.mNodes.size());
+}
+
+// static
+bool LLXMLNode::unpackTree(const U8* data, size_t size, LLXMLNodePtr& root)
+{
+    TreeUnpacker unpacker(data, data + size);
+    PackedTreeHeader header;
+    if (!read_bytes(unpacker.mCur, unpacker.mEnd, &header, sizeof(header))
+        || !unpacker.readStrings(header.mStringCount))
+    {
+        return false;
+    }
+
+    unpacker.mNodesLeft = header.mNodeCount;
+    LLXMLNodePtr node = unpack_node(unpacker, 0);
+    if (node.isNull() || unpacker.mNodesLeft || unpacker.mCur != unpacker.mEnd)
+    {
+        return false;
+    }
+    root = node;
+    return true;
+}
+
+// static
+bool LLXMLNode::prefetchLayeredCache(const std::vector<std::string>& paths, std::vector<std::string>* filenames)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    if (paths.empty() || paths.front().empty() || sLayeredCacheDir.empty())
+    {
+        return false;
+    }
+
+    const std::string filename = layered_cache_filename(sLayeredCacheDir, paths);
+    std::string cached = LLFile::getContents(filename);
+    size_t tree_offset = 0;
+    if (cached.empty() || !check_layered_cache(cached, paths, tree_offset))
+    {
+        return false;
+    }
+
+    if (filenames)
+    {
+        // The string table holds every value in the tree, no need to
+        // unpack the nodes (nor to touch the string table, which this
+        // thread may not)
+        const U8* tree = (const U8*)cached.data() + tree_offset;
+        TreeUnpacker unpacker(tree, (const U8*)cached.data() + cached.size());
+        PackedTreeHeader header;
+        if (read_bytes(unpacker.mCur, unpacker.mEnd, &header, sizeof(header))
+            && unpacker.readStrings(header.mStringCount))
+        {
+            for (const std::string& str : unpacker.getStrings())
+            {
+                if (str.size() > 4 && str.find_first_of("/\\") == std::string::npos
+                    && LLStringUtil::endsWith(str, ".xml"))
+                {
+                    filenames->push_back(str);
+                }
+            }
+        }
+    }
+
+    LLMutexLock lock(&sPrefetchedMutex);
+    if (sPrefetched.size() >= MAX_PREFETCHED_TREES)
+    {
+        return false;
+    }
+    sPrefetched[filename].swap(cached);
     return true;
 }
 
+// static
+bool LLXMLNode::loadLayeredCache(const std::vector<std::string>& paths, LLXMLNodePtr& root)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    const std::string filename = layered_cache_filename(sLayeredCacheDir, paths);
+    std::string cached;
+    if (!take_prefetched(filename, cached))
+    {
+        cached = LLFile::getContents(filename);
+    }
+    size_t tree_offset = 0;
+    if (cached.empty() || !check_layered_cache(cached, paths, tree_offset))
+    {
+        return false;
+    }
+
+    if (!unpackTree((const U8*)cached.data() + tree_offset, cached.size() - tree_offset, root))
+    {
+        LL_WARNS("XMLNode") << "Unable to read cached " << paths.front() << " from " << filename << LL_ENDL;
+        LLFile::remove(filename);
+        return false;
+    }
+    return true;
+}
+
+// static
+void LLXMLNode::saveLayeredCache(const std::vector<std::string>& paths, LLXMLNode* root)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    std::vector<U8> out;
+    LayeredCacheHeader header = { LAYERED_CACHE_MAGIC, LAYERED_CACHE_VERSION, (U32)paths.size(), layered_cache_flags() };
+    append_bytes(out, &header, sizeof(header));
+    for (const std::string& path : paths)
+    {
+        LayeredCacheLayer layer;
+        if (!get_layer_stamp(path, layer.mSize, layer.mModified))
+        {
+            return;
+        }
+        layer.mPathLength = (U32)path.size();
+        layer.mReserved = 0;
+        append_bytes(out, &layer, sizeof(layer));
+        append_bytes(out, path.data(), path.size());
+    }
+    packTree(root, out);
+
+    // Written aside and renamed, so another viewer instance never reads
+    // half of it
+    const std::string filename = layered_cache_filename(sLayeredCacheDir, paths);
+    const std::string temp_filename = filename + ".tmp";
+    llofstream file(temp_filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        return;
+    }
+    file.write((const char*)out.data(), out.size());
+    file.close();
+    // rename() won't replace a file on Windows
+    LLFile::remove(filename, ENOENT);
+    if (file.fail() || LLFile::rename(temp_filename, filename) != 0)
+    {
+        LL_WARNS("XMLNode") << "Unable to write cached " << paths.front() << " to " << filename << LL_ENDL;
+        LLFile::remove(temp_filename);
+    }
+}
+
 // static
 void LLXMLNode::writeHeaderToFile(LLFILE *out_file)
 {
@@ -35,7 +35,9 @@
 #else
 #include "expat/expat.h"
 #endif
+#include <atomic>
 #include <map>
+#include <vector>
 
 #include "indra_constants.h"
 #include "llrefcount.h"
@@ -150,6 +152,30 @@ public:
 
     static bool getLayeredXMLNode(LLXMLNodePtr& root, const std::vector<std::string>& paths);
 
+    // Binary cache of getLayeredXMLNode() trees.  The tree merged from a
+    // file's skin and language layers is kept in dir, keyed by the layer
+    // paths along with the size and modification time of each layer, and
+    // read back instead of parsing the XML as long as none of them changes.
+    // An empty dir, the default, turns the cache off.
+    static void setLayeredCacheDir(const std::string& dir);
+    static const std::string& getLayeredCacheDir() { return sLayeredCacheDir; }
+
+    // Reads the cache entry of a tree ahead of getLayeredXMLNode(), which
+    // then takes it from memory rather than from the disk.  Safe to call
+    // from any thread.  filenames, if not NULL, gets the .xml files the
+    // tree names (the panels of a floater), so they can be read ahead as
+    // well.  Returns false if there is no usable entry.
+    static bool prefetchLayeredCache(const std::vector<std::string>& paths,
+                                     std::vector<std::string>* filenames = NULL);
+
+    // A tree to and from the cache's format: a table of the distinct names
+    // and values in it, then the nodes depth first, referring to the table.
+    static void packTree(LLXMLNode* root, std::vector<U8>& out);
+    static bool unpackTree(const U8* data, size_t size, LLXMLNodePtr& root);
+
+    static std::atomic<U32> sLayeredCacheHits;      // trees read from the cache
+    static std::atomic<U32> sLayeredCacheMisses;    // trees parsed while the cache is on
+
 
     // Write standard XML file header:
     // <?xml version="1.0" encoding="utf-8" standalone="yes" ?>
@@ -322,6 +348,12 @@ public:
     static bool sStripEscapedStrings;
     static bool sStripWhitespaceValues;
 
+private:
+    static bool loadLayeredCache(const std::vector<std::string>& paths, LLXMLNodePtr& root);
+    static void saveLayeredCache(const std::vector<std::string>& paths, LLXMLNode* root);
+
+    static std::string sLayeredCacheDir;
+
 protected:
     LLStringTableEntry *mName;      // The name of this node
 
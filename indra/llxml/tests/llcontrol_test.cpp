@@ -34,6 +34,7 @@
 
 #include "../test/lltut.h"
 #include <memory>
+#include <sstream>
 #include <vector>
 
 namespace tut
@@ -151,4 +152,74 @@ namespace tut
         ensure("listener fired on changed setting", mListenerFired);
     }
 
+    //lookups by name and typed reads
+    template<> template<>
+    void control_group_t::test<5>()
+    {
+        // enough to grow the index a couple of times
+        for (U32 i = 0; i < 3000; ++i)
+        {
+            mCG->declareU32(STRINGIZE("Setting" << i), i, "numbered setting");
+        }
+        mCG->declareF32("FloatSetting", 0.5f, "float setting");
+        mCG->declareBOOL("BoolSetting", false, "bool setting");
+        for (U32 i = 0; i < 3000; i += 97)
+        {
+            ensure_equals("numbered setting", mCG->getU32(STRINGIZE("Setting" << i)), i);
+        }
+        ensure("missing setting", ! mCG->controlExists("Setting3000"));
+        ensure("no control", mCG->getControl("NoSuchSetting").isNull());
+
+        // typed values follow changes, whichever way they are made
+        mCG->setF32("FloatSetting", 2.f);
+        ensure_equals("set float", mCG->getF32("FloatSetting"), 2.f);
+        mCG->getControl("BoolSetting")->setValue(true);
+        ensure("set bool", mCG->getBOOL("BoolSetting"));
+        mCG->getControl("FloatSetting")->resetToDefault();
+        ensure_equals("reset float", mCG->getF32("FloatSetting"), 0.5f);
+
+        // tracing counts lookups, including those of missing settings
+        mCG->setLookupTracing(true);
+        for (S32 i = 0; i < 10; ++i)
+        {
+            mCG->getF32("FloatSetting");
+            mCG->controlExists("NoSuchSetting");
+        }
+        std::ostringstream out;
+        ensure_equals("traced settings", mCG->writeLookupTrace(out), 2U);
+        ensure("float traced", out.str().find("FloatSetting") != std::string::npos);
+        ensure("missing traced", out.str().find("NoSuchSetting (missing)") != std::string::npos);
+        mCG->setLookupTracing(false);
+    }
+
+    //defaults snapshot
+    template<> template<>
+    void control_group_t::test<6>()
+    {
+        std::string snapshot_file = mTestConfigDir + "settings.bin";
+        mCleanups.push_back(snapshot_file);
+        bool from_snapshot = true;
+        ensure_equals("loaded from XML", mCG->loadDefaultsFromFile(mTestConfigFile, snapshot_file, &from_snapshot), 1U);
+        ensure("no snapshot yet", ! from_snapshot);
+        ensure("snapshot written", LLFile::isfile(snapshot_file));
+
+        LLControlGroup test_cg("foo4");
+        ensure_equals("loaded from snapshot", test_cg.loadDefaultsFromFile(mTestConfigFile, snapshot_file, &from_snapshot), 1U);
+        ensure("snapshot used", from_snapshot);
+        ensure_equals("value from snapshot", test_cg.getU32("TestSetting"), 12);
+        ensure("persisted from snapshot", test_cg.getControl("TestSetting")->isPersisted());
+
+        // a changed file makes the snapshot stale
+        LLSD config;
+        config["TestSetting"]["Comment"] = "Dummy setting used for testing";
+        config["TestSetting"]["Persist"] = 1;
+        config["TestSetting"]["Type"] = "U32";
+        config["TestSetting"]["Value"] = 14;
+        writeSettingsFile(config);
+        LLControlGroup stale_cg("foo5");
+        ensure_equals("loaded from changed XML", stale_cg.loadDefaultsFromFile(mTestConfigFile, snapshot_file, &from_snapshot), 1U);
+        ensure("stale snapshot ignored", ! from_snapshot);
+        ensure_equals("value from changed XML", stale_cg.getU32("TestSetting"), 14);
+    }
+
 }
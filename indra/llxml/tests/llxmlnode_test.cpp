@@ -0,0 +1,315 @@
+/**
+ * @file   llxmlnode_test.cpp
+ * @brief  Test for the LLXMLNode layered XUI cache.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Copyright (c) 2026, Linden Research, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "../llxmlnode.h"
+// STL headers
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+// std headers
+// external library headers
+// other Linden headers
+#include "lldiriterator.h"
+#include "llfile.h"
+#include "lltimer.h"
+#include "stringize.h"
+#include "../test/lltut.h"
+
+namespace
+{
+    const char* BASE_XML =
+        "<?xml version=\"1.0\" encoding=\"utf-8\" standalone=\"yes\" ?>\n"
+        "<floater name=\"test\" title=\"Test\" width=\"300\" height=\"200\">\n"
+        "  <button name=\"ok\" label=\"OK\" left=\"10\" top=\"20\"/>\n"
+        "  <text name=\"hint\" font=\"SansSerifSmall\">Some help\n   text</text>\n"
+        "  <combo_box name=\"choice\">\n"
+        "    <combo_box.item label=\"One\" value=\"1\"/>\n"
+        "    <combo_box.item label=\"Two\" value=\"2\"/>\n"
+        "  </combo_box>\n"
+        "  <string name=\"escaped\">\"quoted \\\"string\\\"\"</string>\n"
+        "  <panel name=\"tab\" filename=\"panel_test.xml\"/>\n"
+        "  <data id=\"counter\" type=\"integer\" length=\"2\" precision=\"16\" encoding=\"decimal\">31 32</data>\n"
+        "</floater>\n";
+
+    // a translation, the way a language's layer overrides the base file
+    const char* LAYER_XML =
+        "<?xml version=\"1.0\" encoding=\"utf-8\" standalone=\"yes\" ?>\n"
+        "<floater name=\"test\" title=\"Essai\">\n"
+        "  <button name=\"ok\" label=\"D'accord\"/>\n"
+        "  <combo_box name=\"choice\">\n"
+        "    <combo_box.item label=\"Deux\" value=\"2\"/>\n"
+        "  </combo_box>\n"
+        "</floater>\n";
+
+    void write_file(const std::string& filename, const std::string& contents)
+    {
+        llofstream file(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        file << contents;
+        file.close();
+    }
+
+    std::string to_xml(LLXMLNodePtr node)
+    {
+        std::ostringstream out;
+        node->writeToOstream(out);
+        return out.str();
+    }
+
+    // what writeToOstream() leaves out
+    void ensure_same_details(LLXMLNodePtr expected, LLXMLNodePtr actual)
+    {
+        tut::ensure_equals("line", actual->getLineNumber(), expected->getLineNumber());
+        tut::ensure_equals("id", actual->getID(), expected->getID());
+        tut::ensure_equals("type", actual->getType(), expected->getType());
+        tut::ensure_equals("length", actual->getLength(), expected->getLength());
+        tut::ensure_equals("precision", actual->getPrecision(), expected->getPrecision());
+        tut::ensure_equals("encoding", actual->mEncoding, expected->mEncoding);
+        tut::ensure_equals("attributes", actual->mAttributes.size(), expected->mAttributes.size());
+        LLXMLNodePtr expected_child = expected->getFirstChild();
+        LLXMLNodePtr actual_child = actual->getFirstChild();
+        for (; expected_child.notNull(); expected_child = expected_child->getNextSibling(),
+                                         actual_child = actual_child->getNextSibling())
+        {
+            tut::ensure("child", actual_child.notNull());
+            tut::ensure("same name", actual_child->getName() == expected_child->getName());
+            ensure_same_details(expected_child, actual_child);
+        }
+        tut::ensure("no extra child", actual_child.isNull());
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llxmlnode_data
+    {
+        std::string mDir;
+        std::string mCacheDir;
+        std::vector<std::string> mPaths;
+
+        llxmlnode_data()
+        {
+            LLUUID random;
+            random.generate();
+            mDir = STRINGIZE(LLFile::tmpdir() << "llxmlnode-test-" << random << "/");
+            mCacheDir = mDir + "cache";
+            LLFile::mkdir(mDir);
+            LLFile::mkdir(mCacheDir);
+            mPaths.push_back(mDir + "floater_test.xml");
+            mPaths.push_back(mDir + "floater_test_fr.xml");
+            write_file(mPaths[0], BASE_XML);
+            write_file(mPaths[1], LAYER_XML);
+        }
+
+        ~llxmlnode_data()
+        {
+            LLXMLNode::setLayeredCacheDir("");
+            std::string filename;
+            LLDirIterator iter(mCacheDir, "*");
+            while (iter.next(filename))
+            {
+                LLFile::remove(mCacheDir + "/" + filename);
+            }
+            LLFile::rmdir(mCacheDir);
+            for (const std::string& path : mPaths)
+            {
+                LLFile::remove(path);
+            }
+            LLFile::rmdir(mDir);
+        }
+    };
+    typedef test_group<llxmlnode_data> llxmlnode_group;
+    typedef llxmlnode_group::object object;
+    llxmlnode_group llxmlnodegrp("llxmlnode");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("packed tree reads back the same");
+
+        LLXMLNodePtr parsed;
+        ensure("parsed", LLXMLNode::parseBuffer(BASE_XML, strlen(BASE_XML), parsed));
+        std::vector<U8> packed;
+        LLXMLNode::packTree(parsed, packed);
+
+        LLXMLNodePtr unpacked;
+        ensure("unpacked", LLXMLNode::unpackTree(packed.data(), packed.size(), unpacked));
+        ensure_equals("same XML", to_xml(unpacked), to_xml(parsed));
+        ensure_same_details(parsed, unpacked);
+        LLXMLNodePtr data;
+        ensure("data found", unpacked->getChild("data", data, false));
+        S32 values[2] = { 0, 0 };
+        ensure_equals("data values", data->getIntValue(2, values), 2U);
+        ensure_equals("data value", values[1], 32);
+
+        // damaged or cut short
+        for (size_t size = 0; size < packed.size(); size += 7)
+        {
+            LLXMLNodePtr truncated;
+            ensure(STRINGIZE("truncated to " << size), !LLXMLNode::unpackTree(packed.data(), size, truncated));
+        }
+        std::vector<U8> damaged(packed);
+        memset(&damaged[sizeof(U32)], 0xff, sizeof(U32)); // node count
+        LLXMLNodePtr rejected;
+        ensure("bad node count", !LLXMLNode::unpackTree(damaged.data(), damaged.size(), rejected));
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("layered tree from the cache while the layers are unchanged");
+
+        LLXMLNodePtr uncached;
+        ensure("layered", LLXMLNode::getLayeredXMLNode(uncached, mPaths));
+
+        LLXMLNode::setLayeredCacheDir(mCacheDir);
+        const U32 hits = LLXMLNode::sLayeredCacheHits;
+        const U32 misses = LLXMLNode::sLayeredCacheMisses;
+        LLXMLNodePtr first;
+        ensure("first", LLXMLNode::getLayeredXMLNode(first, mPaths));
+        ensure_equals("missed", LLXMLNode::sLayeredCacheMisses - misses, 1U);
+        LLXMLNodePtr cached;
+        ensure("cached", LLXMLNode::getLayeredXMLNode(cached, mPaths));
+        ensure_equals("hit", LLXMLNode::sLayeredCacheHits - hits, 1U);
+        ensure_equals("same as parsed", to_xml(cached), to_xml(uncached));
+        ensure_same_details(uncached, cached);
+        std::string title;
+        ensure("title", cached->getAttributeString("title", title));
+        ensure_equals("translated", title, std::string("Essai"));
+
+        // A layer changed: parsed again, and cached again
+        std::string changed(LAYER_XML);
+        LLStringUtil::replaceString(changed, "Essai", "Un essai");
+        write_file(mPaths[1], changed);
+        LLXMLNodePtr updated;
+        ensure("updated", LLXMLNode::getLayeredXMLNode(updated, mPaths));
+        ensure_equals("missed again", LLXMLNode::sLayeredCacheMisses - misses, 2U);
+        ensure("new title", updated->getAttributeString("title", title));
+        ensure_equals("new translation", title, std::string("Un essai"));
+        LLXMLNodePtr recached;
+        ensure("recached", LLXMLNode::getLayeredXMLNode(recached, mPaths));
+        ensure_equals("hit again", LLXMLNode::sLayeredCacheHits - hits, 2U);
+        ensure_equals("new tree cached", to_xml(recached), to_xml(updated));
+
+        // Other layers, another entry
+        std::vector<std::string> base_only(1, mPaths[0]);
+        LLXMLNodePtr base;
+        ensure("base", LLXMLNode::getLayeredXMLNode(base, base_only));
+        ensure("base title", base->getAttributeString("title", title));
+        ensure_equals("untranslated", title, std::string("Test"));
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("tree read ahead on another thread");
+
+        LLXMLNode::setLayeredCacheDir(mCacheDir);
+        ensure("nothing to read ahead yet", !LLXMLNode::prefetchLayeredCache(mPaths));
+        LLXMLNodePtr parsed;
+        ensure("parsed", LLXMLNode::getLayeredXMLNode(parsed, mPaths));
+
+        bool prefetched = false;
+        std::vector<std::string> filenames;
+        std::thread reader([&]() { prefetched = LLXMLNode::prefetchLayeredCache(mPaths, &filenames); });
+        reader.join();
+        ensure("prefetched", prefetched);
+        ensure_equals("panel named", filenames.size(), 1U);
+        ensure_equals("panel file", filenames[0], std::string("panel_test.xml"));
+
+        // taken from memory, not from the disk
+        std::string filename;
+        LLDirIterator iter(mCacheDir, "*");
+        while (iter.next(filename))
+        {
+            LLFile::remove(mCacheDir + "/" + filename);
+        }
+        const U32 hits = LLXMLNode::sLayeredCacheHits;
+        LLXMLNodePtr cached;
+        ensure("cached", LLXMLNode::getLayeredXMLNode(cached, mPaths));
+        ensure_equals("hit", LLXMLNode::sLayeredCacheHits - hits, 1U);
+        ensure_equals("same as parsed", to_xml(cached), to_xml(parsed));
+
+        // and only once
+        const U32 misses = LLXMLNode::sLayeredCacheMisses;
+        LLXMLNodePtr again;
+        ensure("parsed again", LLXMLNode::getLayeredXMLNode(again, mPaths));
+        ensure_equals("missed", LLXMLNode::sLayeredCacheMisses - misses, 1U);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("preferences floater XUI benchmark");
+
+        // Not a pass/fail test.  Times reading the files the preferences
+        // floater is built from, the floater and its panels in the default
+        // skin, by parsing them (a cold start) and from the cache.
+        if (! getenv("LL_TEST_BENCHMARKS"))
+        {
+            skip("set LL_TEST_BENCHMARKS to run the benchmark");
+        }
+
+        const std::string here(__FILE__);
+        const std::string skin_dir = here.substr(0, here.find_last_of("/\\") + 1) + "../../newview/skins/default/xui/en/";
+        std::vector<std::string> files;
+        files.push_back("floater_preferences.xml");
+        static const char* panels[] = { "UI", "advanced", "alerts", "backup", "chat", "colors", "controls",
+                                        "crashreports", "firestorm", "general", "graphics1", "move", "opensim",
+                                        "privacy", "setup", "skins", "sound", "uploads" };
+        for (const char* panel : panels)
+        {
+            files.push_back(STRINGIZE("panel_preferences_" << panel << ".xml"));
+        }
+        for (const std::string& file : files)
+        {
+            if (!LLFile::isfile(skin_dir + file))
+            {
+                skip("no " + skin_dir + file);
+            }
+        }
+
+        const S32 REPEATS = 10;
+        U64 times[2] = { 0, 0 };
+        U32 nodes = 0;
+        for (S32 cached = 0; cached < 2; ++cached)
+        {
+            LLXMLNode::setLayeredCacheDir(cached ? mCacheDir : "");
+            if (cached)
+            {
+                // fill the cache
+                for (const std::string& file : files)
+                {
+                    LLXMLNodePtr root;
+                    LLXMLNode::getLayeredXMLNode(root, std::vector<std::string>(1, skin_dir + file));
+                }
+            }
+            U64 start = LLTimer::getTotalTime();
+            for (S32 r = 0; r < REPEATS; ++r)
+            {
+                for (const std::string& file : files)
+                {
+                    LLXMLNodePtr root;
+                    ensure(file, LLXMLNode::getLayeredXMLNode(root, std::vector<std::string>(1, skin_dir + file)));
+                    nodes += root->getChildCount();
+                }
+            }
+            times[cached] = LLTimer::getTotalTime() - start;
+        }
+
+        std::cout << std::endl << files.size() << " preferences floater files: " << times[0] / REPEATS
+                  << " uS parsed, " << times[1] / REPEATS << " uS from the cache (" << nodes << ")" << std::endl;
+    }
+} // namespace tut
@@ -230,14 +230,11 @@ void FSAreaSearch::draw()
 
     if (mBeacons)
     {
-        std::vector<LLScrollListItem*> items = mPanelList->getResultList()->getAllData();
-
-        for (const auto* item : items)
+        for (const auto& listed : mPanelList->getListedObjects())
         {
-            if (LLViewerObject* objectp = gObjectList.findObject(item->getUUID()); objectp)
+            if (LLViewerObject* objectp = gObjectList.findObject(listed.id); objectp)
             {
-                const std::string& objectName = mObjectDetails[item->getUUID()].description;
-                gObjectList.addDebugBeacon(objectp->getPositionAgent(), objectName, mBeaconColor, mBeaconTextColor, beacon_line_width);
+                gObjectList.addDebugBeacon(objectp->getPositionAgent(), listed.description, mBeaconColor, mBeaconTextColor, beacon_line_width);
             }
         }
     }
@@ -323,7 +320,7 @@ void FSAreaSearch::checkRegion()
             mObjectDetails.clear();
             mRegionRequests.clear();
             mLastPropertiesReceivedTimer.start();
-            mPanelList->getResultList()->deleteAllItems();
+            mPanelList->clearListedObjects();
             mPanelList->setCounterText();
             mPanelList->setAgentLastPosition(gAgent.getPositionGlobal());
             mRefresh = true;
@@ -349,7 +346,7 @@ void FSAreaSearch::refreshList(bool cache_clear)
              object_it.second.listed = false;
         }
     }
-    mPanelList->getResultList()->deleteAllItems();
+    mPanelList->clearListedObjects();
     mPanelList->setCounterText();
     mPanelList->setAgentLastPosition(gAgent.getPositionGlobal());
     mNamesRequested.clear();
@@ -990,92 +987,48 @@ void FSAreaSearch::matchObject(FSObjectProperties& details, LLViewerObject* obje
 
     details.listed = true;
 
-    LLScrollListCell::Params cell_params;
-    cell_params.font = LLFontGL::getFontSansSerif();
-
-    LLScrollListItem::Params row_params;
-    row_params.value = object_id.asString();
-
-    cell_params.column = "distance";
-    cell_params.value = llformat("%1.0f m", calculateObjectDistance(mPanelList->getAgentLastPosition(), objectp)); // used mAgentLastPosition instead of gAgent->getPositionGlobal for performace
-    row_params.columns.add(cell_params);
-
-    cell_params.column = "name";
-    cell_params.value = details.name;
-    row_params.columns.add(cell_params);
+    FSPanelAreaSearchList::ListedObject listed;
+    listed.id = object_id;
+    listed.distance = llformat("%1.0f m", calculateObjectDistance(mPanelList->getAgentLastPosition(), objectp)); // used mAgentLastPosition instead of gAgent->getPositionGlobal for performace
+    listed.name = details.name;
+    listed.description = details.description;
 
-    cell_params.column = "description";
-    cell_params.value = details.description;
-    row_params.columns.add(cell_params);
-
-    cell_params.column = "price";
     if (details.sale_info.isForSale())
     {
         LLStringUtil::format_map_t args;
         args["COST"] = llformat("%d", details.sale_info.getSalePrice());
-        std::string cost_label = LLTrans::getString("FSAreaSearch_Cost_Label", args);
-        cell_params.value = cost_label;
+        listed.price = LLTrans::getString("FSAreaSearch_Cost_Label", args);
     }
     else
     {
-        cell_params.value = " ";
+        listed.price = " ";
     }
-    row_params.columns.add(cell_params);
 
-    cell_params.column = "land_impact";
     if (F32 cost = objectp->getLinksetCost(); cost > F_ALMOST_ZERO)
     {
-        cell_params.value = cost;
+        listed.land_impact = cost;
     }
     else
     {
-        cell_params.value = "...";
+        listed.land_impact = "...";
     }
-    row_params.columns.add(cell_params);
-
-    cell_params.column = "prim_count";
-    cell_params.value = objectp->numChildren() + 1;
-    row_params.columns.add(cell_params);
-
-    cell_params.column = "owner";
-    cell_params.value = owner_name;
-    row_params.columns.add(cell_params);
 
-    cell_params.column = "group";
-    cell_params.value = group_name;
-    row_params.columns.add(cell_params);
+    listed.prim_count = objectp->numChildren() + 1;
+    listed.owner = owner_name;
+    listed.group = group_name;
+    listed.creator = creator_name;
+    listed.last_owner = last_owner_name;
 
-    cell_params.column = "creator";
-    cell_params.value = creator_name;
-    row_params.columns.add(cell_params);
-
-    cell_params.column = "last_owner";
-    cell_params.value = last_owner_name;
-    row_params.columns.add(cell_params);
-
-    LLScrollListItem* list_row = mPanelList->getResultList()->addRow(row_params);
-
-    if (objectp->flagTemporaryOnRez() || objectp->flagUsePhysics())
+    if (objectp->flagTemporaryOnRez())
     {
-        U8 font_style = LLFontGL::NORMAL;
-        if (objectp->flagTemporaryOnRez())
-        {
-            font_style |= LLFontGL::ITALIC;
-        }
-        if (objectp->flagUsePhysics())
-        {
-            font_style |= LLFontGL::BOLD;
-        }
-
-        S32 num_colums = list_row->getNumColumns();
-        for (S32 i = 0; i < num_colums; i++)
-        {
-            LLScrollListText* list_cell = (LLScrollListText*)list_row->getColumn(i);
-            list_cell->setFontStyle(font_style);
-        }
+        listed.font_style |= LLFontGL::ITALIC;
+    }
+    if (objectp->flagUsePhysics())
+    {
+        listed.font_style |= LLFontGL::BOLD;
     }
 
-    mPanelList->getResultList()->refreshLineHeight();
+    mPanelList->addListedObject(std::move(listed));
 }
 
 void FSAreaSearch::updateObjectCosts(const LLUUID& object_id, F32 object_cost, F32 link_cost, F32 physics_cost, F32 link_physics_cost)
@@ -1085,18 +1038,7 @@ void FSAreaSearch::updateObjectCosts(const LLUUID& object_id, F32 object_cost, F
         return;
     }
 
-    if (FSScrollListCtrl* result_list = mPanelList->getResultList(); result_list)
-    {
-        if (LLScrollListItem* list_row = result_list->getItem(LLSD(object_id)); list_row)
-        {
-            if (LLScrollListColumn* list_column = result_list->getColumn("land_impact"); list_column)
-            {
-                LLScrollListCell* linkset_cost_cell = list_row->getColumn(list_column->mIndex);
-                linkset_cost_cell->setValue(LLSD(link_cost));
-                result_list->setNeedsSort(); // re-sort if needed.
-            }
-        }
-    }
+    mPanelList->updateLandImpact(object_id, link_cost);
 }
 
 void FSAreaSearch::getNameFromUUID(const LLUUID& id, std::string& name, bool group, bool& name_requested)
@@ -1173,7 +1115,7 @@ void FSAreaSearch::callbackLoadFullName(const LLUUID& id, const std::string& ful
 void FSAreaSearch::updateCounterText()
 {
     LLStringUtil::format_map_t args;
-    args["[LISTED]"] = llformat("%d", mPanelList->getResultList()->getItemCount());
+    args["[LISTED]"] = llformat("%d", mPanelList->getListedCount());
     args["[PENDING]"] = llformat("%d", mRequested);
     args["[TOTAL]"] = llformat("%d", mSearchableObjects);
     mPanelList->setCounterText(args);
@@ -1368,6 +1310,7 @@ bool FSPanelAreaSearchList::postBuild()
     mResultList->setDoubleClickCallback(boost::bind(&FSPanelAreaSearchList::onDoubleClick, this));
     mResultList->sortByColumn("name", true);
     mResultList->setContextMenu(&gFSAreaSearchMenu);
+    mResultList->setDataSource(this);
 
     mCounterText = getChild<LLTextBox>("counter");
 
@@ -1392,6 +1335,146 @@ FSPanelAreaSearchList::~FSPanelAreaSearchList()
     {
         mFSAreaSearchColumnConfigConnection.disconnect();
     }
+
+    if (mResultList)
+    {
+        mResultList->setDataSource(nullptr);
+    }
+}
+
+void FSPanelAreaSearchList::draw()
+{
+    flushListedObjects();
+    LLPanel::draw();
+}
+
+void FSPanelAreaSearchList::addListedObject(ListedObject&& object)
+{
+    mListedObjectIndex[object.id] = mListedObjects.size();
+    mListedObjects.emplace_back(std::move(object));
+    mListedObjectsChanged = true;
+}
+
+void FSPanelAreaSearchList::clearListedObjects()
+{
+    mListedObjects.clear();
+    mListedObjectIndex.clear();
+    mListedObjectsChanged = false;
+    mResultList->dataSourceChanged();
+}
+
+void FSPanelAreaSearchList::updateLandImpact(const LLUUID& id, F32 link_cost)
+{
+    if (auto found = mListedObjectIndex.find(id); found != mListedObjectIndex.end())
+    {
+        mListedObjects[found->second].land_impact = link_cost;
+        mListedObjectsChanged = true; // re-sort if needed.
+    }
+}
+
+// Rows are only rebuilt once for all the changes since the last draw,
+// rather than once per object found.
+void FSPanelAreaSearchList::flushListedObjects()
+{
+    if (mListedObjectsChanged)
+    {
+        mListedObjectsChanged = false;
+        mResultList->dataSourceChanged();
+    }
+}
+
+void FSPanelAreaSearchList::indexListedObjects()
+{
+    mListedObjectIndex.clear();
+    for (size_t i = 0; i < mListedObjects.size(); ++i)
+    {
+        mListedObjectIndex[mListedObjects[i].id] = i;
+    }
+}
+
+S32 FSPanelAreaSearchList::getRowCount() const
+{
+    return static_cast<S32>(mListedObjects.size());
+}
+
+LLSD FSPanelAreaSearchList::getRowValue(S32 row) const
+{
+    return mListedObjects[row].id.asString();
+}
+
+LLSD FSPanelAreaSearchList::getCellValue(S32 row, const std::string& column) const
+{
+    const ListedObject& listed = mListedObjects[row];
+    if (column == "distance")
+    {
+        return listed.distance;
+    }
+    if (column == "name")
+    {
+        return listed.name;
+    }
+    if (column == "description")
+    {
+        return listed.description;
+    }
+    if (column == "price")
+    {
+        return listed.price;
+    }
+    if (column == "land_impact")
+    {
+        return listed.land_impact;
+    }
+    if (column == "prim_count")
+    {
+        return listed.prim_count;
+    }
+    if (column == "owner")
+    {
+        return listed.owner;
+    }
+    if (column == "group")
+    {
+        return listed.group;
+    }
+    if (column == "creator")
+    {
+        return listed.creator;
+    }
+    if (column == "last_owner")
+    {
+        return listed.last_owner;
+    }
+    return LLSD();
+}
+
+void FSPanelAreaSearchList::getRowElement(S32 row, LLSD& element) const
+{
+    static const std::string columns[] = { "distance", "name", "description", "price", "land_impact", "prim_count", "owner", "group", "creator", "last_owner" };
+
+    element["value"] = getRowValue(row);
+    for (const auto& column : columns)
+    {
+        LLSD cell;
+        cell["column"] = column;
+        cell["value"] = getCellValue(row, column);
+        cell["font"] = "SANSSERIF";
+        element["columns"].append(cell);
+    }
+}
+
+void FSPanelAreaSearchList::onRowBuilt(S32 row, LLScrollListItem* item) const
+{
+    U8 font_style = mListedObjects[row].font_style;
+    if (font_style != LLFontGL::NORMAL)
+    {
+        S32 num_colums = item->getNumColumns();
+        for (S32 i = 0; i < num_colums; i++)
+        {
+            LLScrollListText* list_cell = (LLScrollListText*)item->getColumn(i);
+            list_cell->setFontStyle(font_style);
+        }
+    }
 }
 
 void FSPanelAreaSearchList::onClickRefresh()
@@ -1456,40 +1539,40 @@ void FSPanelAreaSearchList::updateScrollList()
         mAgentLastPosition = current_agent_position;
     }
 
-    bool deleted = false;
-    LLScrollListColumn* distance_column = mResultList->getColumn("distance");
     LLViewerRegion* our_region = gAgent.getRegion();
 
-    // Iterate over the rows in the list, deleting ones whose object has gone away.
-    std::vector<LLScrollListItem*> items = mResultList->getAllData();
-    for (const auto* item : items)
-    {
-        const LLUUID& row_id = item->getUUID();
-        LLViewerObject* objectp = gObjectList.findObject(row_id);
-
-        if (!objectp || !mFSAreaSearch->isSearchableObject(objectp, our_region))
+    // Drop the listed objects that have gone away.
+    auto gone = std::erase_if(mListedObjects, [this, our_region](const ListedObject& listed)
         {
-            // This item's object has been deleted -- remove the row.
-            // Removing the row won't throw off our iteration, since we have a local copy of the array.
-            // We just need to make sure we don't access this item after the delete.
-            mResultList->deleteSingleItem(mResultList->getItemIndex(row_id));
+            LLViewerObject* objectp = gObjectList.findObject(listed.id);
+            if (!objectp || !mFSAreaSearch->isSearchableObject(objectp, our_region))
+            {
+                mFSAreaSearch->mObjectDetails[listed.id].listed = false;
+                return true;
+            }
+            return false;
+        });
+    if (gone > 0)
+    {
+        indexListedObjects();
+    }
 
-            mFSAreaSearch->mObjectDetails[row_id].listed = false ;
-            deleted = true;
-        }
-        else
+    if (agent_moved)
+    {
+        for (auto& listed : mListedObjects)
         {
-            if (agent_moved && distance_column)
+            if (LLViewerObject* objectp = gObjectList.findObject(listed.id); objectp)
             {
-                item->getColumn(distance_column->mIndex)->setValue(LLSD(llformat("%1.0f m", calculateObjectDistance(current_agent_position, objectp))));
+                listed.distance = llformat("%1.0f m", calculateObjectDistance(current_agent_position, objectp));
             }
         }
     }
 
-    if (deleted || agent_moved)
+    if (gone > 0 || agent_moved)
     {
-        mResultList->updateLayout();
+        mListedObjectsChanged = true;
     }
+    flushListedObjects();
 }
 
 void FSPanelAreaSearchList::updateResultListColumns()
@@ -1560,45 +1643,33 @@ bool FSPanelAreaSearchList::onEnableColumnVisibilityChecked(const LLSD& userdata
 
 void FSPanelAreaSearchList::updateName(const LLUUID& id, const std::string& name)
 {
-    LLScrollListColumn* creator_column = mResultList->getColumn("creator");
-    LLScrollListColumn* owner_column = mResultList->getColumn("owner");
-    LLScrollListColumn* group_column = mResultList->getColumn("group");
-    LLScrollListColumn* last_owner_column = mResultList->getColumn("last_owner");
-
-    // Iterate over the rows in the list, updating the ones with matching id.
-    std::vector<LLScrollListItem*> items = mResultList->getAllData();
-
-    for (const auto* item : items)
+    // Iterate over the listed objects, updating the ones with matching id.
+    for (auto& listed : mListedObjects)
     {
-        const LLUUID& row_id = item->getUUID();
-        FSObjectProperties& details = mFSAreaSearch->mObjectDetails[row_id];
+        FSObjectProperties& details = mFSAreaSearch->mObjectDetails[listed.id];
 
-        if (creator_column && (id == details.creator_id))
+        if (id == details.creator_id)
         {
-            LLScrollListText* creator_text = (LLScrollListText*)item->getColumn(creator_column->mIndex);
-            creator_text->setText(name);
-            mResultList->setNeedsSort();
+            listed.creator = name;
+            mListedObjectsChanged = true;
         }
 
-        if (owner_column && (id == details.owner_id))
+        if (id == details.owner_id)
         {
-            LLScrollListText* owner_text = (LLScrollListText*)item->getColumn(owner_column->mIndex);
-            owner_text->setText(RLVa_hideNameIfRestricted(name));
-            mResultList->setNeedsSort();
+            listed.owner = RLVa_hideNameIfRestricted(name);
+            mListedObjectsChanged = true;
         }
 
-        if (group_column && (id == details.group_id))
+        if (id == details.group_id)
         {
-            LLScrollListText* group_text = (LLScrollListText*)item->getColumn(group_column->mIndex);
-            group_text->setText(name);
-            mResultList->setNeedsSort();
+            listed.group = name;
+            mListedObjectsChanged = true;
         }
 
-        if (last_owner_column && (id == details.last_owner_id))
+        if (id == details.last_owner_id)
         {
-            LLScrollListText* last_owner_text = (LLScrollListText*)item->getColumn(last_owner_column->mIndex);
-            last_owner_text->setText(RLVa_hideNameIfRestricted(name));
-            mResultList->setNeedsSort();
+            listed.last_owner = RLVa_hideNameIfRestricted(name);
+            mListedObjectsChanged = true;
         }
     }
 }
@@ -1717,14 +1788,12 @@ bool FSPanelAreaSearchList::onContextMenuItemClick(const LLSD& userdata)
 
     if (action == "select_all")
     {
-        std::vector<LLScrollListItem*> result_items = mResultList->getAllData();
-        std::for_each(result_items.begin(), result_items.end(), [](LLScrollListItem* item) { item->setSelected(true); });
+        mResultList->selectAll();
         return true;
     }
     if (action == "clear_selection")
     {
-        std::vector<LLScrollListItem*> selected_items = mResultList->getAllSelected();
-        std::for_each(selected_items.begin(), selected_items.end(), [](LLScrollListItem* item) { item->setSelected(false); });
+        mResultList->deselectAllItems(true);
         return true;
     }
     if (action == "filter_my_objects")
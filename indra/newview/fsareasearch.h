@@ -30,10 +30,12 @@
 
 #include "llcategory.h"
 #include "llfloater.h"
+#include "llfontgl.h"
 #include "llframetimer.h"
 #include "llpermissions.h"
 #include "llsaleinfo.h"
 #include "llscrolllistcolumn.h"
+#include "llscrolllistctrl.h"
 #include "llviewerobject.h"
 #include "rlvdefines.h"
 #include <boost/regex.hpp>
@@ -273,7 +275,7 @@ protected:
 // displays the found objects
 //------------------------------------------------------------
 class FSPanelAreaSearchList
-:   public LLPanel
+:   public LLPanel, public LLScrollListDataSource
 {
     LOG_CLASS(FSPanelAreaSearchList);
     friend class FSAreaSearchMenu;
@@ -284,6 +286,38 @@ public:
     virtual ~FSPanelAreaSearchList();
 
     bool postBuild() override;
+    void draw() override;
+
+    // An object as shown on a row of the result list
+    struct ListedObject
+    {
+        LLUUID id;
+        std::string distance;
+        std::string name;
+        std::string description;
+        std::string price;
+        LLSD land_impact;
+        S32 prim_count{ 0 };
+        std::string owner;
+        std::string group;
+        std::string creator;
+        std::string last_owner;
+        U8 font_style{ LLFontGL::NORMAL };
+    };
+
+    // The result list shows the listed objects on the next draw
+    void addListedObject(ListedObject&& object);
+    void clearListedObjects();
+    void updateLandImpact(const LLUUID& id, F32 link_cost);
+    const std::vector<ListedObject>& getListedObjects() const { return mListedObjects; }
+    S32 getListedCount() const { return static_cast<S32>(mListedObjects.size()); }
+
+    // LLScrollListDataSource: the result list only builds the rows in view
+    S32 getRowCount() const override;
+    LLSD getRowValue(S32 row) const override;
+    LLSD getCellValue(S32 row, const std::string& column) const override;
+    void getRowElement(S32 row, LLSD& element) const override;
+    void onRowBuilt(S32 row, LLScrollListItem* item) const override;
 
     void setCounterText();
     void setCounterText(LLStringUtil::format_map_t args);
@@ -311,8 +345,15 @@ private:
     void onColumnVisibilityChecked(const LLSD& userdata);
     bool onEnableColumnVisibilityChecked(const LLSD& userdata);
 
+    void flushListedObjects();
+    void indexListedObjects();
+
     LLVector3d mAgentLastPosition;
 
+    std::vector<ListedObject> mListedObjects;
+    std::map<LLUUID, size_t> mListedObjectIndex;
+    bool mListedObjectsChanged{ false };
+
     FSAreaSearch* mFSAreaSearch{ nullptr };
     LLButton* mRefreshButton{ nullptr };
     FSScrollListCtrl* mResultList{ nullptr };
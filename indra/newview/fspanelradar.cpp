@@ -119,6 +119,11 @@ FSPanelRadar::~FSPanelRadar()
 
     if (mOptionsMenuHandle.get())
         mOptionsMenuHandle.get()->die();
+
+    if (mRadarList)
+    {
+        mRadarList->setDataSource(nullptr);
+    }
 }
 
 bool FSPanelRadar::postBuild()
@@ -128,6 +133,7 @@ bool FSPanelRadar::postBuild()
     mRadarList->setContextMenu(&FSFloaterRadarMenu::gFSRadarMenu);
     mRadarList->setDoubleClickCallback(boost::bind(&FSPanelRadar::onRadarListDoubleClicked, this));
     mRadarList->setCommitCallback(boost::bind(&FSPanelRadar::onRadarListCommitted, this));
+    mRadarList->setDataSource(this);
 
     mMiniMap = getChild<LLNetMap>("Net Map");
     mAddFriendButton = getChild<LLButton>("add_friend_btn");
@@ -303,164 +309,176 @@ void FSPanelRadar::updateList(const std::vector<LLSD>& entries, const LLSD& stat
         return;
     }
 
-    static const std::string flagsColumnType = getString("FlagsColumnType");
+    // The list keeps its selection, and builds the rows in view from these
+    mRadarList->setCommentText(RlvActions::canShowNearbyAgents() ? LLStringUtil::null : RlvStrings::getString("blocked_nearby"));
+    mRadarEntries = entries;
+    mRadarList->dataSourceChanged();
+
+    LLStringUtil::format_map_t name_count_args;
+    name_count_args["[TOTAL]"] = stats["total"].asString();
+    name_count_args["[IN_REGION]"] = stats["region"].asString();
+    name_count_args["[IN_CHAT_RANGE]"] = stats["chatrange"].asString();
+    LLScrollListColumn* column = mRadarList->getColumn("name");
+    column->mHeader->setLabel(getString("avatar_name_count", name_count_args));
+    column->mHeader->setToolTipArgs(name_count_args);
+
+    mRadarList->refreshLineHeight();
+
+    updateButtons();
+    mChangeSignal();
+}
+
+S32 FSPanelRadar::getRowCount() const
+{
+    return static_cast<S32>(mRadarEntries.size());
+}
+
+LLSD FSPanelRadar::getRowValue(S32 row) const
+{
+    return mRadarEntries[row]["entry"]["id"];
+}
+
+LLSD FSPanelRadar::getCellValue(S32 row, const std::string& column) const
+{
     static const std::string flagsColumnValues [3] = { getString("FlagsColumnValue_0"), getString("FlagsColumnValue_1"), getString("FlagsColumnValue_2") };
     static const std::string notesColumnIcon = getString("NotesColumnIcon");
     static const std::string sittingColumnIcon = getString("SittingColumnIcon");
     static const std::string typingColumnIcon = getString("TypingColumnIcon");
 
-    // Store current selection and scroll position
-    LLUUID last_selected_id;
-    if (mRadarList->getLastSelectedItem())
+    const LLSD& entry = mRadarEntries[row]["entry"];
+    if (column == "name" || column == "age" || column == "seen" || column == "range")
     {
-        last_selected_id = mRadarList->getLastSelectedItem()->getUUID();
+        return entry[column];
     }
-    uuid_vec_t selected_ids;
-    for (auto selected_item : mRadarList->getAllSelected())
+    if (column == "seen_sort")
     {
-        selected_ids.emplace_back(selected_item->getUUID());
+        return entry["seen"].asString() + "_" + entry["name"].asString();
     }
-    S32 lastScroll = mRadarList->getScrollPos();
-
-    // Update list
-    mRadarList->setCommentText(RlvActions::canShowNearbyAgents() ? LLStringUtil::null : RlvStrings::getString("blocked_nearby"));
-
-    bool needs_sort = mRadarList->isSorted();
-    mRadarList->setNeedsSort(false);
-
-    mRadarList->clearRows();
-    for (const auto& avdata : entries)
+    if (column == "voice_level")
+    {
+        return entry.has("voice_level_icon") ? entry["voice_level_icon"].asString() : "";
+    }
+    if (column == "in_region")
     {
-        constexpr char font_name[] = "SANSSERIF_SMALL";
-
-        LLSD entry = avdata["entry"];
-        LLSD options = avdata["options"];
-
-        LLSD row_data;
-        row_data["value"] = entry["id"];
-        row_data["columns"][0]["column"] = "name";
-        row_data["columns"][0]["value"] = entry["name"];
-        row_data["columns"][0]["font"] = font_name;
-
-        row_data["columns"][1]["column"] = "voice_level";
-        row_data["columns"][1]["type"] = "icon";
-        row_data["columns"][1]["value"] = ""; // Need to set it after the row has been created because it's to big for the row
-        row_data["columns"][1]["font"] = font_name;
-
-        row_data["columns"][2]["column"] = "in_region";
-        row_data["columns"][2]["type"] = "icon";
         if (entry["on_parcel"].asBoolean())
         {
-            row_data["columns"][2]["value"] = "avatar_on_parcel";
-        }
-        else if (entry["in_region"].asBoolean())
-        {
-            row_data["columns"][2]["value"] = "avatar_in_region";
-        }
-        else
-        {
-            row_data["columns"][2]["value"] = "";
+            return "avatar_on_parcel";
         }
+        return entry["in_region"].asBoolean() ? "avatar_in_region" : "";
+    }
+    if (column == "typing_status")
+    {
+        return entry["typing"].asBoolean() ? typingColumnIcon : "";
+    }
+    if (column == "sitting_status")
+    {
+        return entry["sitting"].asBoolean() ? sittingColumnIcon : "";
+    }
+    if (column == "flags")
+    {
+        return entry.has("flags") ? flagsColumnValues[entry["flags"].asInteger()] : "";
+    }
+    if (column == "has_notes")
+    {
+        return entry["notes"].asBoolean() ? notesColumnIcon : "";
+    }
+    return LLSD();
+}
 
-        row_data["columns"][3]["column"] = "typing_status";
-        row_data["columns"][3]["type"] = "icon";
-        row_data["columns"][3]["value"] = (entry["typing"].asBoolean() ? typingColumnIcon : "");
-
-        row_data["columns"][4]["column"] = "sitting_status";
-        row_data["columns"][4]["type"] = "icon";
-        row_data["columns"][4]["value"] = (entry["sitting"].asBoolean() ? sittingColumnIcon : "");
+void FSPanelRadar::getRowElement(S32 row, LLSD& row_data) const
+{
+    static const std::string flagsColumnType = getString("FlagsColumnType");
+    constexpr char font_name[] = "SANSSERIF_SMALL";
 
-        row_data["columns"][5]["column"] = "flags";
-        row_data["columns"][5]["type"] = flagsColumnType;
+    const LLSD& entry = mRadarEntries[row]["entry"];
 
-        row_data["columns"][6]["column"] = "has_notes";
-        row_data["columns"][6]["type"] = "icon";
-        row_data["columns"][6]["value"] = (entry["notes"].asBoolean() ? notesColumnIcon : "");
-        row_data["columns"][6]["tool_tip"] = entry["notes"].asString();
+    row_data["value"] = entry["id"];
+    row_data["columns"][0]["column"] = "name";
+    row_data["columns"][0]["value"] = entry["name"];
+    row_data["columns"][0]["font"] = font_name;
 
-        row_data["columns"][7]["column"] = "age";
-        row_data["columns"][7]["value"] = entry["age"];
-        row_data["columns"][7]["halign"] = "right";
-        row_data["columns"][7]["font"] = font_name;
+    row_data["columns"][1]["column"] = "voice_level";
+    row_data["columns"][1]["type"] = "icon";
+    row_data["columns"][1]["value"] = ""; // Need to set it after the row has been created because it's to big for the row
+    row_data["columns"][1]["font"] = font_name;
 
-        row_data["columns"][8]["column"] = "seen";
-        row_data["columns"][8]["value"] = entry["seen"];
-        row_data["columns"][8]["halign"] = "right";
-        row_data["columns"][8]["font"] = font_name;
+    row_data["columns"][2]["column"] = "in_region";
+    row_data["columns"][2]["type"] = "icon";
+    row_data["columns"][2]["value"] = getCellValue(row, "in_region");
 
-        row_data["columns"][9]["column"] = "range";
-        row_data["columns"][9]["value"] = entry["range"];
-        row_data["columns"][9]["font"] = font_name;
+    row_data["columns"][3]["column"] = "typing_status";
+    row_data["columns"][3]["type"] = "icon";
+    row_data["columns"][3]["value"] = getCellValue(row, "typing_status");
 
-        row_data["columns"][10]["column"] = "seen_sort";
-        row_data["columns"][10]["value"] = entry["seen"].asString() + "_" + entry["name"].asString();
+    row_data["columns"][4]["column"] = "sitting_status";
+    row_data["columns"][4]["type"] = "icon";
+    row_data["columns"][4]["value"] = getCellValue(row, "sitting_status");
 
-        LLScrollListItem* row = mRadarList->addElement(row_data);
+    row_data["columns"][5]["column"] = "flags";
+    row_data["columns"][5]["type"] = flagsColumnType;
 
-        static S32 rangeColumnIndex = mRadarList->getColumn("range")->mIndex;
-        static S32 nameColumnIndex = mRadarList->getColumn("name")->mIndex;
-        static S32 voiceLevelColumnIndex = mRadarList->getColumn("voice_level")->mIndex;
-        static S32 flagsColumnIndex = mRadarList->getColumn("flags")->mIndex;
-        static S32 ageColumnIndex = mRadarList->getColumn("age")->mIndex;
+    row_data["columns"][6]["column"] = "has_notes";
+    row_data["columns"][6]["type"] = "icon";
+    row_data["columns"][6]["value"] = getCellValue(row, "has_notes");
+    row_data["columns"][6]["tool_tip"] = entry["notes"].asString();
 
-        LLScrollListText* radarRangeCell = (LLScrollListText*)row->getColumn(rangeColumnIndex);
-        radarRangeCell->setColor(LLColor4(options["range_color"]));
-        radarRangeCell->setFontStyle(options["range_style"].asInteger());
+    row_data["columns"][7]["column"] = "age";
+    row_data["columns"][7]["value"] = entry["age"];
+    row_data["columns"][7]["halign"] = "right";
+    row_data["columns"][7]["font"] = font_name;
 
-        LLScrollListText* radarNameCell = (LLScrollListText*)row->getColumn(nameColumnIndex);
-        radarNameCell->setFontStyle(options["name_style"].asInteger());
-        if (options.has("name_color"))
-        {
-            radarNameCell->setColor(LLColor4(options["name_color"]));
-        }
+    row_data["columns"][8]["column"] = "seen";
+    row_data["columns"][8]["value"] = entry["seen"];
+    row_data["columns"][8]["halign"] = "right";
+    row_data["columns"][8]["font"] = font_name;
 
-        if (entry.has("voice_level_icon"))
-        {
-            LLScrollListText* voiceLevelCell = (LLScrollListText*)row->getColumn(voiceLevelColumnIndex);
-            voiceLevelCell->setValue(entry["voice_level_icon"].asString());
-        }
+    row_data["columns"][9]["column"] = "range";
+    row_data["columns"][9]["value"] = entry["range"];
+    row_data["columns"][9]["font"] = font_name;
 
-        if (entry.has("flags"))
-        {
-            LLScrollListText* flagsCell = (LLScrollListText*)row->getColumn(flagsColumnIndex);
-            flagsCell->setValue(flagsColumnValues[entry["flags"].asInteger()]);
-        }
+    row_data["columns"][10]["column"] = "seen_sort";
+    row_data["columns"][10]["value"] = getCellValue(row, "seen_sort");
+}
 
-        if (options.has("age_color"))
-        {
-            LLScrollListText* ageCell = (LLScrollListText*)row->getColumn(ageColumnIndex);
-            ageCell->setColor(LLColor4(options["age_color"]));
-        }
+void FSPanelRadar::onRowBuilt(S32 row, LLScrollListItem* item) const
+{
+    const LLSD& entry = mRadarEntries[row]["entry"];
+    const LLSD& options = mRadarEntries[row]["options"];
+
+    static S32 rangeColumnIndex = mRadarList->getColumn("range")->mIndex;
+    static S32 nameColumnIndex = mRadarList->getColumn("name")->mIndex;
+    static S32 voiceLevelColumnIndex = mRadarList->getColumn("voice_level")->mIndex;
+    static S32 flagsColumnIndex = mRadarList->getColumn("flags")->mIndex;
+    static S32 ageColumnIndex = mRadarList->getColumn("age")->mIndex;
+
+    LLScrollListText* radarRangeCell = (LLScrollListText*)item->getColumn(rangeColumnIndex);
+    radarRangeCell->setColor(LLColor4(options["range_color"]));
+    radarRangeCell->setFontStyle(options["range_style"].asInteger());
+
+    LLScrollListText* radarNameCell = (LLScrollListText*)item->getColumn(nameColumnIndex);
+    radarNameCell->setFontStyle(options["name_style"].asInteger());
+    if (options.has("name_color"))
+    {
+        radarNameCell->setColor(LLColor4(options["name_color"]));
     }
 
-    mRadarList->setNeedsSort(needs_sort);
-    mRadarList->updateSort();
-
-    LLStringUtil::format_map_t name_count_args;
-    name_count_args["[TOTAL]"] = stats["total"].asString();
-    name_count_args["[IN_REGION]"] = stats["region"].asString();
-    name_count_args["[IN_CHAT_RANGE]"] = stats["chatrange"].asString();
-    LLScrollListColumn* column = mRadarList->getColumn("name");
-    column->mHeader->setLabel(getString("avatar_name_count", name_count_args));
-    column->mHeader->setToolTipArgs(name_count_args);
-
-    mRadarList->refreshLineHeight();
-
-    // Restore scroll position
-    mRadarList->setScrollPos(lastScroll);
+    if (entry.has("voice_level_icon"))
+    {
+        LLScrollListText* voiceLevelCell = (LLScrollListText*)item->getColumn(voiceLevelColumnIndex);
+        voiceLevelCell->setValue(entry["voice_level_icon"].asString());
+    }
 
-    // Restore selection list
-    if (!selected_ids.empty())
+    if (entry.has("flags"))
     {
-        mRadarList->selectMultiple(selected_ids);
-        if (last_selected_id.notNull())
-        {
-            mRadarList->setLastSelectedItem(last_selected_id);
-        }
+        LLScrollListText* flagsCell = (LLScrollListText*)item->getColumn(flagsColumnIndex);
+        flagsCell->setValue(getCellValue(row, "flags"));
     }
 
-    updateButtons();
-    mChangeSignal();
+    if (options.has("age_color"))
+    {
+        LLScrollListText* ageCell = (LLScrollListText*)item->getColumn(ageColumnIndex);
+        ageCell->setColor(LLColor4(options["age_color"]));
+    }
 }
 
 void FSPanelRadar::onColumnDisplayModeChanged()
@@ -39,7 +39,7 @@ class LLMenuButton;
 class LLNetMap;
 
 class FSPanelRadar
-    : public LLPanel
+    : public LLPanel, public LLScrollListDataSource
 {
     LOG_CLASS(FSPanelRadar);
     friend class LLPanelPeople;
@@ -68,6 +68,13 @@ public:
         mVisibleCheckFunction = func;
     }
 
+    // LLScrollListDataSource: the radar list only builds the rows in view
+    S32                     getRowCount() const override;
+    LLSD                    getRowValue(S32 row) const override;
+    LLSD                    getCellValue(S32 row, const std::string& column) const override;
+    void                    getRowElement(S32 row, LLSD& element) const override;
+    void                    onRowBuilt(S32 row, LLScrollListItem* item) const override;
+
 private:
     void                    updateButtons();
     void                    updateList(const std::vector<LLSD>& entries, const LLSD& stats);
@@ -84,6 +91,8 @@ private:
     bool                    onEnableColumnVisibilityChecked(const LLSD& userdata);
 
     FSRadarListCtrl*        mRadarList;
+    // rows of mRadarList, as given by FSRadar::getCurrentData()
+    std::vector<LLSD>       mRadarEntries;
     LLNetMap*               mMiniMap;
     LLButton*               mRadarGearButton;
     LLButton*               mAddFriendButton;
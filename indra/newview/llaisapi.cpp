@@ -33,6 +33,7 @@
 #include "llcallbacklist.h"
 #include "llinventorymodel.h"
 #include "llinventoryobserver.h"
+#include "llmainthreadscheduler.h"
 #include "llnotificationsutil.h"
 #include "llsdutil.h"
 #include "llviewerregion.h"
@@ -1089,6 +1090,13 @@ void AISUpdate::checkTimeout()
         LLCoros::checkStop();
         mTimer.setTimerExpirySec(AIS_EXPIRY_SECONDS);
     }
+    // Large fetches after login or a teleport would otherwise take all of
+    // the frame's main thread time.
+    if (LLMainThreadScheduler::yieldForBudget())
+    {
+        LLCoros::checkStop();
+        mTimer.setTimerExpirySec(AIS_EXPIRY_SECONDS);
+    }
 }
 
 void AISUpdate::parseUpdate(const LLSD& update)
@@ -48,6 +48,8 @@
 #include "llfloaterimcontainer.h"
 #include "llimprocessing.h"
 #include "llwindow.h"
+#include "llxmlnode.h"
+#include "llfontfreetype.h"
 #include "llviewerstats.h"
 #include "llviewerstatsrecorder.h"
 #include "llkeyconflict.h" // for legacy keybinding support, remove later
@@ -232,6 +234,7 @@
 #include "llcommandlineparser.h"
 #include "llfloatermemleak.h"
 #include "llfloaterreg.h"
+#include "lluiusage.h"
 #include "llfloatersimplesnapshot.h"
 #include "llfloatersnapshot.h"
 #include "llfloaterflickr.h"
@@ -261,6 +264,10 @@
 #include "gltfscenemanager.h"
 
 #include "workqueue.h"
+#include "workstealingqueue.h"
+#include "llframeprofiler.h"
+#include "llmainthreadscheduler.h"
+#include "llframespikemonitor.h"
 using namespace LL;
 
 // Include for security api initialization
@@ -725,6 +732,7 @@ LLAppViewer::LLAppViewer()
     mReportedCrash(false),
     mNumSessions(0),
     mGeneralThreadPool(nullptr),
+    mAvatarThreadPool(nullptr),
     mPurgeCache(false),
     mPurgeCacheOnExit(false),
     mPurgeUserDataOnExit(false),
@@ -741,6 +749,10 @@ LLAppViewer::LLAppViewer()
     mPeriodicSlowFrame(LLCachedControl<bool>(gSavedSettings,"Periodic Slow Frame", false)),
     mFastTimerLogThread(NULL),
     mSettingsLocationList(NULL),
+    mLaunchSeconds(LLTimer::getTotalSeconds()),
+    mDefaultSettingsSeconds(0.0),
+    mDefaultSettingsFiles(0),
+    mDefaultSettingsSnapshots(0),
     mIsFirstRun(false),
     mSaveSettingsOnExit(true),      // <FS:Zi> Backup Settings
     mPurgeTextures(false) // <FS:Ansariel> FIRE-13066
@@ -1474,6 +1486,7 @@ bool LLAppViewer::init()
     LLViewerStatsRecorder::createInstance();
     LLSelectMgr::createInstance();
     LLViewerCamera::createInstance();
+    LLMainThreadScheduler::createInstance();
     LL::GLTFSceneManager::createInstance();
 
 
@@ -1686,6 +1699,8 @@ bool LLAppViewer::doFrame()
                 }
             }
 
+            beginMainThreadBudget();
+
             {
                 LL_PROFILE_ZONE_NAMED_CATEGORY_APP("df mainloop");
                 // canonical per-frame event
@@ -1693,6 +1708,7 @@ bool LLAppViewer::doFrame()
             }
             {
                 LL_PROFILE_ZONE_NAMED_CATEGORY_APP("df suspend");
+                LLMainThreadScheduler::Slice slice(LLMainThreadScheduler::COROUTINES);
                 // give listeners a chance to run
                 llcoro::suspend();
                 // if one of our coroutines threw an uncaught exception, rethrow it now
@@ -1948,11 +1964,118 @@ bool LLAppViewer::doFrame()
         LL_INFOS() << "Exiting main_loop" << LL_ENDL;
     }
     }LLPerfStats::StatsRecorder::endFrame();
+    updateFrameProfiler();
     LL_PROFILER_FRAME_END;
 
     return ! LLApp::isRunning();
 }
 
+void LLAppViewer::beginMainThreadBudget()
+{
+    static LLCachedControl<bool> budget_enabled(gSavedSettings, "MainThreadBudgetEnabled", true);
+    static LLCachedControl<F32> budget_fraction(gSavedSettings, "MainThreadBudgetFraction", 0.25f);
+    static LLCachedControl<U32> budget_fps(gSavedSettings, "MainThreadBudgetTargetFPS", 60);
+    static LLCachedControl<F32> main_work_time(gSavedSettings, "MainWorkTime", 1.f);
+    static LLCachedControl<U32> max_fps(gSavedSettings, "FramePerSecondLimit");
+    static LLCachedControl<bool> limit_framerate(gSavedSettings, "FSLimitFramerate");
+    static F32 applied_work_time = -1.f;
+
+    LLMainThreadScheduler& scheduler = LLMainThreadScheduler::instance();
+    if (main_work_time != applied_work_time)
+    {
+        // MainWorkTime, in fractional milliseconds, used to be the whole
+        // WorkQueue time slice and is now its minimum.
+        applied_work_time = main_work_time;
+        scheduler.setMinSlice(LLMainThreadScheduler::WORK,
+                              std::chrono::nanoseconds(std::chrono::nanoseconds::rep(applied_work_time * 1000000.f)));
+    }
+
+    // Aim for the frame limiter's rate when it is on
+    const U32 target_fps = (limit_framerate && max_fps > 0) ? (U32)max_fps : (U32)budget_fps;
+    scheduler.beginFrame((F32)target_fps, budget_fraction, budget_enabled);
+}
+
+void LLAppViewer::updateFrameProfiler()
+{
+    static LLCachedControl<bool> profiler_enabled(gSavedSettings, "FrameProfilerEnabled", false);
+    static LLCachedControl<bool> main_thread(gSavedSettings, "FrameProfilerMainThread", true);
+    static LLCachedControl<U32> main_thread_depth(gSavedSettings, "FrameProfilerMainThreadDepth", 12);
+    static LLCachedControl<U32> buffer_events(gSavedSettings, "FrameProfilerBufferEvents", 32768);
+    static LLCachedControl<F32> min_zone_us(gSavedSettings, "FrameProfilerMinZoneMicroseconds", 20.f);
+    static LLCachedControl<F32> spike_threshold(gSavedSettings, "FrameProfilerSpikeThreshold", 0.f);
+    static LLCachedControl<F32> dump_cooldown(gSavedSettings, "FrameProfilerDumpCooldown", 60.f);
+    static U32 applied_buffer_events = 0;
+    static F32 applied_min_zone_us = -1.f;
+    static bool first_frame = true;
+    static LLFrameTimer dump_timer;
+    static bool dumped = false;
+
+    if (first_frame)
+    {
+        LLFrameProfiler::setThreadName("Main");
+        first_frame = false;
+    }
+    if (buffer_events != applied_buffer_events)
+    {
+        applied_buffer_events = buffer_events;
+        LLFrameProfiler::setBufferEvents(applied_buffer_events);
+    }
+    if (min_zone_us != applied_min_zone_us)
+    {
+        applied_min_zone_us = min_zone_us;
+        LLFrameProfiler::setMinZoneMicroseconds(applied_min_zone_us);
+    }
+    LLFrameProfiler::setMainThreadDepth(main_thread_depth);
+    LLFrameProfiler::setMode(profiler_enabled ? LLFrameProfiler::MODE_ALL_THREADS
+                             : main_thread ? LLFrameProfiler::MODE_MAIN_THREAD
+                             : LLFrameProfiler::MODE_OFF);
+
+    const F64 frame_seconds = LLFrameProfiler::endFrame();
+    LLFrameSpikeMonitor::instance().endFrame(frame_seconds);
+
+    const F64 frame_ms = frame_seconds * 1000.0;
+    if (profiler_enabled && spike_threshold > 0.f && frame_ms > spike_threshold
+        && STATE_STARTED == LLStartUp::getStartupState()
+        && (!dumped || dump_timer.getElapsedTimeF32() > dump_cooldown))
+    {
+        dumped = true;
+        dump_timer.reset();
+        dumpFrameProfile(llformat("%.1f ms frame", frame_ms));
+    }
+}
+
+void LLAppViewer::dumpFrameProfile(const std::string& reason)
+{
+    static LLCachedControl<F32> dump_seconds(gSavedSettings, "FrameProfilerDumpSeconds", 5.f);
+    if (!LLFrameProfiler::isEnabled())
+    {
+        LL_WARNS("FrameProfiler") << "Not saving a frame profile, FrameProfilerEnabled and FrameProfilerMainThread are off" << LL_ENDL;
+        return;
+    }
+
+    // Copy the ring buffers now, format and write them off the main thread
+    auto capture = std::make_shared<LLFrameProfiler::Capture>(LLFrameProfiler::capture(dump_seconds));
+    const std::string filename = gDirUtilp->getExpandedFilename(LL_PATH_LOGS,
+        llformat("frame_profile_%u.json", (U32)LLDate::now().secondsSinceEpoch()));
+    auto write = [capture, filename, reason]()
+    {
+        llofstream out(filename);
+        if (!out.is_open())
+        {
+            LL_WARNS("FrameProfiler") << "Unable to write " << filename << LL_ENDL;
+            return;
+        }
+        size_t events = LLFrameProfiler::writeChromeTrace(out, *capture);
+        LL_INFOS("FrameProfiler") << "Saved " << events << " profiler zones (" << reason << ") to " << filename << LL_ENDL;
+    };
+
+    LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+    if (!general_queue || !general_queue->post(write))
+    {
+        write();
+    }
+}
+
 S32 LLAppViewer::updateTextureThreads(F32 max_time)
 {
     size_t work_pending = 0;
@@ -2014,6 +2137,12 @@ bool LLAppViewer::cleanup()
         LLSceneMonitor::deleteSingleton();
     }
 
+    // how long floaters took to open this session
+    if (LLUIUsage::instanceExists())
+    {
+        LL_INFOS("UIUsage") << "Floater open times: " << LLUIUsage::instance().asLLSD()["floater_open"] << LL_ENDL;
+    }
+
     // There used to be an 'if (LLFastTimerView::sAnalyzePerformance)' block
     // here, completely redundant with the one that occurs later in this same
     // function. Presumably the duplication was due to an automated merge gone
@@ -2411,6 +2540,10 @@ bool LLAppViewer::cleanup()
     {
         mGeneralThreadPool->close();
     }
+    if (mAvatarThreadPool)
+    {
+        mAvatarThreadPool->close();
+    }
 
     sTextureFetch->shutDownTextureCacheThread() ;
     LLLFSThread::sLocal->shutdown();
@@ -2472,6 +2605,8 @@ bool LLAppViewer::cleanup()
     sPurgeDiskCacheThread = NULL;
     delete mGeneralThreadPool;
     mGeneralThreadPool = NULL;
+    delete mAvatarThreadPool;
+    mAvatarThreadPool = NULL;
 
     if (LLFastTimerView::sAnalyzePerformance)
     {
@@ -2537,6 +2672,7 @@ bool LLAppViewer::cleanup()
     LLEnvironment::deleteSingleton();
     LLSelectMgr::deleteSingleton();
     LLViewerStatsRecorder::deleteSingleton();
+    LLMainThreadScheduler::deleteSingleton();
     LLViewerEventRecorder::deleteSingleton();
     LLWorld::deleteSingleton();
     LLVoiceClient::deleteSingleton();
@@ -2623,6 +2759,11 @@ bool LLAppViewer::initThreads()
     // general task background thread (LLPerfStats, etc)
     LLAppViewer::instance()->initGeneralThread();
 
+    // avatar pose evaluation, terrain patch decompression and normals; the
+    // main thread joins in while it waits
+    mAvatarThreadPool = new LL::WorkStealingThreadPool("AvatarUpdate", llclamp(cores / 2 - 1, 1, 4));
+    mAvatarThreadPool->start();
+
     LLAppViewer::sPurgeDiskCacheThread = new LLPurgeDiskCacheThread();
 
     if (LLTrace::BlockTimer::sLog || LLTrace::BlockTimer::sMetricLog)
@@ -2885,7 +3026,27 @@ bool LLAppViewer::loadSettingsFromDirectory(const std::string& location_key,
                 full_settings_path = gDirUtilp->getExpandedFilename((ELLPath)path_index, file.file_name());
             }
 
-            if(settings_group->loadFromFile(full_settings_path, set_defaults, file.persistent))
+            U32 loaded = 0;
+            if (set_defaults)
+            {
+                // Defaults only change with an update: load them from a
+                // binary snapshot when the file hasn't changed since the
+                // last run, which is much faster than parsing the XML
+                const F64 start_seconds = LLTimer::getTotalSeconds();
+                bool from_snapshot = false;
+                loaded = settings_group->loadDefaultsFromFile(full_settings_path,
+                                                              getSettingsSnapshotFilename(file.name(), full_settings_path),
+                                                              &from_snapshot);
+                mDefaultSettingsSeconds += LLTimer::getTotalSeconds() - start_seconds;
+                ++mDefaultSettingsFiles;
+                mDefaultSettingsSnapshots += from_snapshot ? 1 : 0;
+            }
+            else
+            {
+                loaded = settings_group->loadFromFile(full_settings_path, set_defaults, file.persistent);
+            }
+
+            if (loaded)
             {   // success!
                 LL_INFOS("Settings") << "Loaded settings file " << full_settings_path << LL_ENDL;
             }
@@ -2912,6 +3073,87 @@ bool LLAppViewer::loadSettingsFromDirectory(const std::string& location_key,
     return true;
 }
 
+std::string LLAppViewer::getSettingsSnapshotFilename(const std::string& group_name,
+                                                     const std::string& settings_path)
+{
+    const std::string snapshot_dir = gDirUtilp->getExpandedFilename(LL_PATH_USER_SETTINGS, "settings_snapshots");
+    if (!LLFile::isdir(snapshot_dir))
+    {
+        // On a first run, the defaults are loaded before anything else has
+        // created user_settings
+        LLFile::mkdir(gDirUtilp->getOSUserAppDir());
+        LLFile::mkdir(gDirUtilp->getExpandedFilename(LL_PATH_USER_SETTINGS, ""));
+        LLFile::mkdir(snapshot_dir);
+    }
+    return snapshot_dir + gDirUtilp->getDirDelimiter() + group_name + "_" + gDirUtilp->getBaseFileName(settings_path, true) + ".bin";
+}
+
+void LLAppViewer::reportLoginScreenShown()
+{
+    static bool reported = false;
+    if (reported)
+    {
+        return;
+    }
+    reported = true;
+
+    const F64 login_seconds = LLTimer::getTotalSeconds() - mLaunchSeconds;
+    const F64 defaults_ms = mDefaultSettingsSeconds * 1000.0;
+    LL_INFOS("AppInit") << "Login screen shown " << llformat("%.2f", login_seconds)
+                        << " seconds after launch.  Default settings took " << llformat("%.1f", defaults_ms)
+                        << " ms to load, " << mDefaultSettingsSnapshots << " of " << mDefaultSettingsFiles
+                        << " files from snapshots" << LL_ENDL;
+
+    // The first run after an update parses the XML, the next ones read the
+    // snapshots: keep the latest timings of each kind of run, and compare
+    // this one with the last run of the other kind.  Runs that mixed both
+    // aren't kept.
+    std::string mode, other_mode;
+    if (mDefaultSettingsFiles && mDefaultSettingsSnapshots == mDefaultSettingsFiles)
+    {
+        mode = "snapshots";
+        other_mode = "xml";
+    }
+    else if (mDefaultSettingsFiles && !mDefaultSettingsSnapshots)
+    {
+        mode = "xml";
+        other_mode = "snapshots";
+    }
+    if (mode.empty())
+    {
+        return;
+    }
+
+    const std::string timings_file = gDirUtilp->getExpandedFilename(LL_PATH_USER_SETTINGS, "settings_snapshots", "startup_times.xml");
+    LLSD timings;
+    llifstream in_file(timings_file.c_str());
+    if (in_file.is_open())
+    {
+        LLSDSerialize::fromXML(timings, in_file);
+        in_file.close();
+    }
+
+    if (timings.has(other_mode))
+    {
+        const F64 other_login_seconds = timings[other_mode]["login_seconds"].asReal();
+        const F64 other_defaults_ms = timings[other_mode]["defaults_ms"].asReal();
+        LL_INFOS("AppInit") << "Last run loading default settings from " << other_mode << ": login screen shown "
+                            << llformat("%.2f", other_login_seconds) << " seconds after launch, default settings took "
+                            << llformat("%.1f", other_defaults_ms) << " ms.  This run from " << mode << ": "
+                            << llformat("%+.2f", login_seconds - other_login_seconds) << " seconds, "
+                            << llformat("%+.1f", defaults_ms - other_defaults_ms) << " ms" << LL_ENDL;
+    }
+
+    timings[mode]["login_seconds"] = login_seconds;
+    timings[mode]["defaults_ms"] = defaults_ms;
+    timings[mode]["files"] = LLSD::Integer(mDefaultSettingsFiles);
+    llofstream out_file(timings_file.c_str());
+    if (out_file.is_open())
+    {
+        LLSDSerialize::toPrettyXML(timings, out_file);
+    }
+}
+
 std::string LLAppViewer::getSettingsFilename(const std::string& location_key,
                                              const std::string& file)
 {
@@ -3046,9 +3288,17 @@ bool LLAppViewer::initConfiguration()
     std::string fsdata_defaults = gDirUtilp->getExpandedFilename(LL_PATH_USER_SETTINGS, llformat("fsdata_defaults.%s.xml", LLVersionInfo::getInstance()->getShortVersion().c_str()));
     std::string fsdata_global = "Global";
     std::shared_ptr<LLControlGroup> settings_group = LLControlGroup::getInstance(fsdata_global);
-    if(settings_group && settings_group->loadFromFile(fsdata_defaults, set_defaults))
+    if (settings_group && gDirUtilp->fileExists(fsdata_defaults))
     {
-        LL_INFOS() << "Loaded settings file " << fsdata_defaults << LL_ENDL;
+        const F64 start_seconds = LLTimer::getTotalSeconds();
+        bool from_snapshot = false;
+        if (settings_group->loadDefaultsFromFile(fsdata_defaults, getSettingsSnapshotFilename(fsdata_global, fsdata_defaults), &from_snapshot))
+        {
+            LL_INFOS() << "Loaded settings file " << fsdata_defaults << LL_ENDL;
+        }
+        mDefaultSettingsSeconds += LLTimer::getTotalSeconds() - start_seconds;
+        ++mDefaultSettingsFiles;
+        mDefaultSettingsSnapshots += from_snapshot ? 1 : 0;
     }
     //</FS:Techwolf Lupindo>
 
@@ -5284,6 +5534,22 @@ bool LLAppViewer::initCache()
     const U32 CACHE_NUMBER_OF_REGIONS_FOR_OBJECTS = 128;
     LLVOCache::getInstance()->initCache(LL_PATH_CACHE, CACHE_NUMBER_OF_REGIONS_FOR_OBJECTS, getObjectCacheVersion());
 
+    // Merged floater and panel XUI, read back instead of parsed again
+    if (gSavedSettings.getBOOL("XUILayoutCache") && !read_only)
+    {
+        const std::string xui_cache = gDirUtilp->getExpandedFilename(LL_PATH_CACHE, "xui_cache");
+        LLFile::mkdir(xui_cache);
+        LLXMLNode::setLayeredCacheDir(xui_cache);
+    }
+
+    // Rasterized glyphs, read back by the fonts initWindow() creates
+    if (gSavedSettings.getBOOL("FontGlyphCache") && !read_only)
+    {
+        const std::string glyph_cache = gDirUtilp->getExpandedFilename(LL_PATH_CACHE, "glyph_cache");
+        LLFile::mkdir(glyph_cache);
+        LLFontFreetype::setGlyphCacheDir(glyph_cache);
+    }
+
     return true;
 }
 
@@ -5320,6 +5586,8 @@ void LLAppViewer::purgeCache()
         // cef does not support clear_cache and clear_cookies, so clear what we can manually.
         gDirUtilp->deleteDirAndContents(browser_cache);
     }
+    gDirUtilp->deleteFilesInDir(gDirUtilp->getExpandedFilename(LL_PATH_CACHE, "xui_cache"), "*");
+    gDirUtilp->deleteFilesInDir(gDirUtilp->getExpandedFilename(LL_PATH_CACHE, "glyph_cache"), "*");
     gDirUtilp->deleteFilesInDir(gDirUtilp->getExpandedFilename(LL_PATH_CACHE, ""), "*");
 }
 
@@ -5608,7 +5876,11 @@ void LLAppViewer::idle()
 
     LLFrameTimer::updateFrameTime();
     LLFrameTimer::updateFrameCount();
-    LLEventTimer::updateClass();
+    {
+        // also runs LLMainThreadTask
+        LLMainThreadScheduler::Slice slice(LLMainThreadScheduler::TIMERS);
+        LLEventTimer::updateClass();
+    }
     LLPerfStats::updateClass();
 
     // LLApp::stepFrame() performs the above three calls plus mRunner.run().
@@ -5627,19 +5899,14 @@ void LLAppViewer::idle()
     gGLManager.mDownScaleMethod = downscale_method;
     LLImageGL::updateClass();
 
-    // Service the WorkQueue we use for replies from worker threads.
-    // Use function statics for the timeslice setting so we only have to fetch
-    // and convert MainWorkTime once.
-    static F32 MainWorkTimeRaw = gSavedSettings.getF32("MainWorkTime");
-    static F32Milliseconds MainWorkTimeMs(MainWorkTimeRaw);
-    // MainWorkTime is specified in fractional milliseconds, but std::chrono
-    // uses integer representations. What if we want less than a microsecond?
-    // Use nanoseconds. We're very sure we will never need to specify a
-    // MainWorkTime that would be larger than we could express in
-    // std::chrono::nanoseconds.
-    static std::chrono::nanoseconds MainWorkTimeNanoSec{
-        std::chrono::nanoseconds::rep(MainWorkTimeMs.value() * 1000000)};
-    gMainloopWork.runFor(MainWorkTimeNanoSec);
+    // Service the WorkQueue we use for replies from worker threads, for as
+    // long as the main thread budget allows (see beginMainThreadBudget()).
+    {
+        LL_PROFILE_ZONE_NAMED_CATEGORY_APP("Main WorkQueue");
+        LLMainThreadScheduler::Slice slice(LLMainThreadScheduler::WORK);
+        gMainloopWork.runUntil(slice.getDeadline());
+        slice.setBacklog(gMainloopWork.size());
+    }
 
     // Cap out-of-control frame times
     // Too low because in menus, swapping, debugger, etc.
@@ -5814,7 +6081,22 @@ void LLAppViewer::idle()
         // Do event notifications if necessary.  Yes, we may want to move this elsewhere.
         gEventNotifier.update();
 
-        gIdleCallbacks.callFunctions();
+        {
+            LL_PROFILE_ZONE_NAMED_CATEGORY_APP("Idle callbacks");
+            LLMainThreadScheduler::Slice slice(LLMainThreadScheduler::IDLE);
+            size_t backlog = gIdleCallbacks.callFunctionsUntil(slice.getDeadline());
+            // Then one floater built ahead of its opening, once the main
+            // thread has had time to spare for a while: a build can't be
+            // cut short.  Its time is charged to this slice, so the frame
+            // goes over budget and the next build waits as long again.
+            // Floaters waiting their turn are not backlog.
+            static LLCachedControl<U32> prewarm_headroom(gSavedSettings, "PrewarmFloatersHeadroomFrames", 30);
+            if (LLMainThreadScheduler::instance().getHeadroomFrames() >= prewarm_headroom)
+            {
+                LLFloaterReg::updatePrewarm();
+            }
+            slice.setBacklog(backlog);
+        }
         gInventory.idleNotifyObservers();
         LLAvatarTracker::instance().idleNotifyObservers();
     }
@@ -161,6 +161,11 @@ public:
     void recordSessionToMarker();
 
     void removeDumpDir();
+
+    // Save the last FrameProfilerDumpSeconds of profiler zones as a Chrome
+    // trace in the logs folder. The file is written on the General thread
+    // pool.
+    void dumpFrameProfile(const std::string& reason);
     // LLAppViewer testing helpers.
     // *NOTE: These will potentially crash the viewer. Only for debugging.
     virtual void forceErrorLLError();
@@ -194,6 +199,9 @@ public:
 
     std::string getSettingsFilename(const std::string& location_key,
                     const std::string& file);
+    // Binary snapshot of a defaults file, see LLControlGroup::loadDefaultsFromFile()
+    std::string getSettingsSnapshotFilename(const std::string& group_name,
+                                            const std::string& settings_path);
     void loadColorSettings();
 
     // For thread debugging.
@@ -205,6 +213,12 @@ public:
     void resumeMainloopTimeout(std::string_view state = "", F32 secs = -1.0f);
     void pingMainloopTimeout(std::string_view state, F32 secs = -1.0f);
 
+    // Logs the time from launch to the login screen, and how long loading
+    // the default settings took, compared with the last run that loaded
+    // them the other way, from the XML or from snapshots.  Only the first
+    // call logs.
+    void reportLoginScreenShown();
+
     // Handle the 'login completed' event.
     // *NOTE:Mani Fix this for login abstraction!!
     void handleLoginComplete();
@@ -282,6 +296,8 @@ protected:
 private:
 
     bool doFrame();
+    void updateFrameProfiler(); // Apply FrameProfiler* settings, end the profiled frame, report and dump spikes
+    void beginMainThreadBudget(); // Apply MainThreadBudget* settings and start the frame's main thread budget
 
     void initMaxHeapSize();
     bool initThreads(); // Initialize viewer threads, return false on failure.
@@ -344,6 +360,7 @@ private:
     static LLTextureFetch* sTextureFetch;
     static LLPurgeDiskCacheThread* sPurgeDiskCacheThread;
     LL::ThreadPool* mGeneralThreadPool;
+    LL::WorkStealingThreadPool* mAvatarThreadPool; // LLVOAvatar::endPoseBatch()
 
     S32 mNumSessions;
 
@@ -365,6 +382,12 @@ private:
     bool mLogoutRequestSent;            // Disconnect message sent to simulator, no longer safe to send messages to the sim.
     struct SettingsFiles* mSettingsLocationList;
 
+    // Startup timing, see reportLoginScreenShown()
+    F64 mLaunchSeconds;
+    F64 mDefaultSettingsSeconds;
+    U32 mDefaultSettingsFiles;
+    U32 mDefaultSettingsSnapshots;
+
     LLWatchdogTimeout* mMainloopTimeout;
 
     // For performance and metric gathering
@@ -0,0 +1,126 @@
+/**
+ * @file llfloaterframespikes.cpp
+ * @brief Debug floater listing the frame time spikes of LLFrameSpikeMonitor
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llfloaterframespikes.h"
+
+#include "llframespikemonitor.h"
+#include "llscrolllistctrl.h"
+#include "lltexteditor.h"
+
+LLFloaterFrameSpikes::LLFloaterFrameSpikes(const LLSD& key)
+:   LLFloater(key),
+    mSpikeList(NULL),
+    mDetails(NULL),
+    mShownChangeCount(0)
+{
+}
+
+bool LLFloaterFrameSpikes::postBuild()
+{
+    mSpikeList = getChild<LLScrollListCtrl>("spike_list");
+    mSpikeList->setCommitCallback(boost::bind(&LLFloaterFrameSpikes::onSelectSpike, this));
+    mDetails = getChild<LLTextEditor>("spike_details");
+    getChild<LLUICtrl>("clear_btn")->setCommitCallback(boost::bind(&LLFloaterFrameSpikes::onClickClear, this));
+
+    // force a refresh on the first draw
+    mShownChangeCount = LLFrameSpikeMonitor::instance().getChangeCount() - 1;
+    return true;
+}
+
+void LLFloaterFrameSpikes::draw()
+{
+    if (mShownChangeCount != LLFrameSpikeMonitor::instance().getChangeCount())
+    {
+        refreshList();
+    }
+    LLFloater::draw();
+}
+
+void LLFloaterFrameSpikes::refreshList()
+{
+    const LLFrameSpikeMonitor& monitor = LLFrameSpikeMonitor::instance();
+    mShownChangeCount = monitor.getChangeCount();
+
+    const LLSD selected = mSpikeList->getSelectedValue();
+    mSpikeList->deleteAllItems();
+
+    // newest first
+    const LLFrameSpikeMonitor::reports_t& reports = monitor.getReports();
+    for (auto it = reports.rbegin(); it != reports.rend(); ++it)
+    {
+        const LLFrameSpikeMonitor::Report& report = *it;
+        std::string cause;
+        if (!report.mSubsystems.empty())
+        {
+            cause = report.mSubsystems.front().mName;
+        }
+        else if (!report.mFastTimers.empty())
+        {
+            cause = report.mFastTimers.front().mName;
+        }
+
+        LLSD row;
+        row["value"] = (LLSD::Integer)report.mSerial;
+        row["columns"][0]["column"] = "time";
+        row["columns"][0]["value"] = report.mTime.toHTTPDateString("%H:%M:%S");
+        row["columns"][1]["column"] = "frame_ms";
+        row["columns"][1]["value"] = llformat("%.1f", report.mFrameMs);
+        row["columns"][2]["column"] = "cause";
+        row["columns"][2]["value"] = cause;
+        mSpikeList->addElement(row);
+    }
+
+    if (selected.isDefined())
+    {
+        mSpikeList->selectByValue(selected);
+    }
+    if (!mSpikeList->getFirstSelected() && !reports.empty())
+    {
+        mSpikeList->selectFirstItem();
+    }
+    onSelectSpike();
+}
+
+void LLFloaterFrameSpikes::onSelectSpike()
+{
+    const LLSD selected = mSpikeList->getSelectedValue();
+    for (const LLFrameSpikeMonitor::Report& report : LLFrameSpikeMonitor::instance().getReports())
+    {
+        if (selected.isDefined() && (U32)selected.asInteger() == report.mSerial)
+        {
+            mDetails->setText(report.asText());
+            return;
+        }
+    }
+    mDetails->setText(getString("no_spike"));
+}
+
+void LLFloaterFrameSpikes::onClickClear()
+{
+    LLFrameSpikeMonitor::instance().clear();
+}
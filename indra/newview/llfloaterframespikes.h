@@ -0,0 +1,55 @@
+/**
+ * @file llfloaterframespikes.h
+ * @brief Debug floater listing the frame time spikes of LLFrameSpikeMonitor
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLFLOATERFRAMESPIKES_H
+#define LL_LLFLOATERFRAMESPIKES_H
+
+#include "llfloater.h"
+
+class LLScrollListCtrl;
+class LLTextEditor;
+
+class LLFloaterFrameSpikes : public LLFloater
+{
+    friend class LLFloaterReg;
+
+public:
+    bool postBuild() override;
+    void draw() override;
+
+private:
+    LLFloaterFrameSpikes(const LLSD& key);
+
+    void refreshList();
+    void onSelectSpike();
+    void onClickClear();
+
+    LLScrollListCtrl*   mSpikeList;
+    LLTextEditor*       mDetails;
+    U32                 mShownChangeCount;
+};
+
+#endif // LL_LLFLOATERFRAMESPIKES_H
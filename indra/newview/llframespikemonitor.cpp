@@ -0,0 +1,386 @@
+/**
+ * @file llframespikemonitor.cpp
+ * @brief Detects main loop frame time spikes and reports where the time went
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llframespikemonitor.h"
+
+#include "llappviewer.h"
+#include "lldir.h"
+#include "llfasttimer.h"
+#include "llframeprofiler.h"
+#include "llsdjson.h"
+#include "llstartup.h"
+#include "lltracerecording.h"
+#include "llviewercontrol.h"
+
+namespace
+{
+    // Entries kept per list in a report
+    constexpr size_t MAX_ENTRIES = 10;
+
+    // Fast timers below this are left out of reports
+    constexpr F64 MIN_FAST_TIMER_MS = 0.5;
+
+    // Zone written by LLFrameProfiler::endFrame()
+    const char* const FRAME_ZONE = "Frame";
+
+    // Zone around every message handler, see LLMessageTemplate::callHandlerFunc()
+    const char* const MESSAGE_HANDLER_ZONE = "Message handler";
+
+    const char* const OTHER_SUBSYSTEM = "Other";
+    const char* const UNTRACKED_SUBSYSTEM = "Untracked";
+
+    // Main loop zones and the subsystem they stand for.  A zone's time goes
+    // to its nearest enclosing zone listed here.
+    const struct
+    {
+        const char* mZone;
+        const char* mSubsystem;
+    } SUBSYSTEM_ZONES[] =
+    {
+        { "df Display",                 "Render" },
+        { "df Snapshot",                "Render" },
+        { "df gatherInput",             "Input" },
+        { "df processMiscNativeEvents", "Input" },
+        { "System Messages",            "Input" },
+        { "df JoystickKeyboard",        "Input" },
+        { "df mainloop",                "Event listeners" },
+        { "df suspend",                 "Coroutines" },
+        { "Network",                    "Network and messages" },
+        { "Main WorkQueue",             "Main WorkQueue callbacks" },
+        { "Prewarm floater",            "Floater prewarming" },
+        { "Idle callbacks",             "Idle callbacks" },
+        { "df idle",                    "Idle" },
+        { "df LLTrace",                 "Statistics" },
+        { "updateTextureThreads",       "Worker thread updates" },
+        { "LFS Thread",                 "Worker thread updates" },
+        { "df gMeshRepo",               "Worker thread updates" },
+        { "df getTextureCache",         "Worker thread updates" },
+        { "df LLVFSThread",             "Worker thread updates" },
+        { "Yield",                      "Sleep" },
+        { "sleep2",                     "Sleep" },
+    };
+
+    const char* find_subsystem(const char* zone)
+    {
+        for (const auto& entry : SUBSYSTEM_ZONES)
+        {
+            if (!strcmp(entry.mZone, zone))
+            {
+                return entry.mSubsystem;
+            }
+        }
+        return nullptr;
+    }
+
+    typedef std::map<std::string, LLFrameSpikeMonitor::Entry> totals_t;
+
+    void add_time(totals_t& totals, const std::string& name, F64 ms)
+    {
+        LLFrameSpikeMonitor::Entry& entry = totals[name];
+        entry.mName = name;
+        entry.mMilliseconds += (F32)ms;
+        ++entry.mCount;
+    }
+
+    // Longest first, at most max_entries of them
+    LLFrameSpikeMonitor::entries_t sorted_entries(const totals_t& totals, size_t max_entries)
+    {
+        LLFrameSpikeMonitor::entries_t entries;
+        entries.reserve(totals.size());
+        for (const auto& pair : totals)
+        {
+            entries.push_back(pair.second);
+        }
+        std::sort(entries.begin(), entries.end(),
+                  [](const LLFrameSpikeMonitor::Entry& a, const LLFrameSpikeMonitor::Entry& b)
+                  { return a.mMilliseconds > b.mMilliseconds; });
+        if (entries.size() > max_entries)
+        {
+            entries.resize(max_entries);
+        }
+        return entries;
+    }
+
+    LLSD entries_as_llsd(const LLFrameSpikeMonitor::entries_t& entries)
+    {
+        LLSD result = LLSD::emptyArray();
+        for (const LLFrameSpikeMonitor::Entry& entry : entries)
+        {
+            LLSD item;
+            item["name"] = entry.mName;
+            item["ms"] = (LLSD::Real)entry.mMilliseconds;
+            item["count"] = (LLSD::Integer)entry.mCount;
+            result.append(item);
+        }
+        return result;
+    }
+
+    void entries_as_text(std::ostringstream& out, const char* title, const LLFrameSpikeMonitor::entries_t& entries)
+    {
+        if (entries.empty())
+        {
+            return;
+        }
+        out << "\n" << title << "\n";
+        for (const LLFrameSpikeMonitor::Entry& entry : entries)
+        {
+            out << llformat("%9.2f ms %6u  ", entry.mMilliseconds, entry.mCount) << entry.mName << "\n";
+        }
+    }
+}
+
+LLFrameSpikeMonitor::LLFrameSpikeMonitor()
+:   mNextSerial(1),
+    mChangeCount(0)
+{
+}
+
+void LLFrameSpikeMonitor::endFrame(F64 frame_seconds)
+{
+    static LLCachedControl<F32> spike_threshold(gSavedSettings, "FrameSpikeThreshold", 150.f);
+    static LLCachedControl<U32> history_size(gSavedSettings, "FrameSpikeHistory", 50);
+
+    const F32 frame_ms = (F32)(frame_seconds * 1000.0);
+    if (spike_threshold <= 0.f || frame_ms <= spike_threshold
+        || STATE_STARTED != LLStartUp::getStartupState())
+    {
+        return;
+    }
+    LL_PROFILE_ZONE_SCOPED;
+
+    Report report;
+    report.mSerial = mNextSerial++;
+    report.mTime = LLDate::now();
+    report.mFrame = gFrameCount;
+    report.mFrameMs = frame_ms;
+    report.mThresholdMs = spike_threshold;
+    attributeZones(report, frame_seconds);
+    attributeFastTimers(report);
+
+    writeLog(report);
+
+    mReports.push_back(std::move(report));
+    while (mReports.size() > llmax(history_size(), 1U))
+    {
+        mReports.pop_front();
+    }
+    ++mChangeCount;
+}
+
+void LLFrameSpikeMonitor::clear()
+{
+    mReports.clear();
+    ++mChangeCount;
+}
+
+void LLFrameSpikeMonitor::attributeZones(Report& report, F64 frame_seconds)
+{
+    if (!LLFrameProfiler::isEnabled())
+    {
+        return;
+    }
+
+    LLFrameProfiler::Capture capture = LLFrameProfiler::capture(frame_seconds + 0.01, true);
+    if (capture.mThreads.empty())
+    {
+        return;
+    }
+    const std::vector<LLFrameProfiler::Event>& events = capture.mThreads.front().mEvents;
+
+    // The frame that just ended is the newest frame zone
+    const LLFrameProfiler::Event* frame = nullptr;
+    for (auto it = events.rbegin(); it != events.rend(); ++it)
+    {
+        if (it->mName && !strcmp(it->mName, FRAME_ZONE))
+        {
+            frame = &*it;
+            break;
+        }
+    }
+    if (!frame)
+    {
+        return;
+    }
+
+    std::vector<const LLFrameProfiler::Event*> zones;
+    for (const LLFrameProfiler::Event& event : events)
+    {
+        if (&event != frame && event.mName
+            && event.mBegin >= frame->mBegin && event.mEnd <= frame->mEnd)
+        {
+            zones.push_back(&event);
+        }
+    }
+    // Parents before their children
+    std::sort(zones.begin(), zones.end(),
+              [](const LLFrameProfiler::Event* a, const LLFrameProfiler::Event* b)
+              { return a->mBegin < b->mBegin || (a->mBegin == b->mBegin && a->mEnd > b->mEnd); });
+
+    const F64 ms_per_count = 1.0 / (capture.mCountsPerMicrosecond * 1000.0);
+    totals_t subsystems;
+    totals_t hot_zones;
+    totals_t messages;
+
+    struct Open
+    {
+        const LLFrameProfiler::Event* mEvent;
+        U64 mChildren;
+        const char* mSubsystem;
+        bool mMessageHandler;
+    };
+    std::vector<Open> stack;
+    U64 top_level = 0;
+
+    auto close = [&](const Open& open)
+    {
+        const U64 length = open.mEvent->mEnd - open.mEvent->mBegin;
+        // Zones of a coroutine that yielded may overlap instead of nest
+        const F64 self_ms = (F64)(length > open.mChildren ? length - open.mChildren : 0) * ms_per_count;
+        add_time(subsystems, open.mSubsystem, self_ms);
+        add_time(hot_zones, open.mEvent->mName, self_ms);
+    };
+
+    for (const LLFrameProfiler::Event* event : zones)
+    {
+        while (!stack.empty() && stack.back().mEvent->mEnd <= event->mBegin)
+        {
+            close(stack.back());
+            stack.pop_back();
+        }
+
+        const U64 length = event->mEnd - event->mBegin;
+        const char* subsystem = find_subsystem(event->mName);
+        if (stack.empty())
+        {
+            top_level += length;
+            if (!subsystem)
+            {
+                subsystem = OTHER_SUBSYSTEM;
+            }
+        }
+        else
+        {
+            Open& parent = stack.back();
+            parent.mChildren += length;
+            if (!subsystem)
+            {
+                subsystem = parent.mSubsystem;
+            }
+            if (parent.mMessageHandler)
+            {
+                add_time(messages, event->mName, (F64)length * ms_per_count);
+            }
+        }
+        stack.push_back({ event, 0, subsystem, !strcmp(event->mName, MESSAGE_HANDLER_ZONE) });
+    }
+    while (!stack.empty())
+    {
+        close(stack.back());
+        stack.pop_back();
+    }
+
+    const U64 frame_length = frame->mEnd - frame->mBegin;
+    if (frame_length > top_level)
+    {
+        add_time(subsystems, UNTRACKED_SUBSYSTEM, (F64)(frame_length - top_level) * ms_per_count);
+    }
+
+    report.mSubsystems = sorted_entries(subsystems, subsystems.size());
+    report.mZones = sorted_entries(hot_zones, MAX_ENTRIES);
+    report.mMessages = sorted_entries(messages, MAX_ENTRIES);
+}
+
+void LLFrameSpikeMonitor::attributeFastTimers(Report& report)
+{
+    // The frame recording only moves on at the start of the next frame, so
+    // the current recording holds the frame that just ended.
+    LLTrace::Recording& recording = LLTrace::get_frame_recording().getCurRecording();
+    totals_t timers;
+    for (auto& base : LLTrace::BlockTimerStatHandle::instance_snapshot())
+    {
+        // because of indirect derivation from LLInstanceTracker, have to downcast
+        LLTrace::BlockTimerStatHandle& timer = static_cast<LLTrace::BlockTimerStatHandle&>(base);
+        const F64 self_ms = recording.getSum(timer.selfTime()).valueInUnits<LLUnits::Milliseconds>();
+        if (self_ms >= MIN_FAST_TIMER_MS)
+        {
+            Entry& entry = timers[timer.getName()];
+            entry.mName = timer.getName();
+            entry.mMilliseconds = (F32)self_ms;
+            entry.mCount = recording.getSum(timer.callCount());
+        }
+    }
+    report.mFastTimers = sorted_entries(timers, MAX_ENTRIES);
+}
+
+void LLFrameSpikeMonitor::writeLog(const Report& report)
+{
+    static LLCachedControl<bool> log_spikes(gSavedSettings, "FrameSpikeLog", true);
+    if (!log_spikes)
+    {
+        return;
+    }
+
+    const std::string filename = gDirUtilp->getExpandedFilename(LL_PATH_LOGS, "frame_spikes.log");
+    llofstream out(filename, std::ios_base::out | std::ios_base::app);
+    if (!out.is_open())
+    {
+        LL_WARNS_ONCE("FrameSpike") << "Unable to write " << filename << LL_ENDL;
+        return;
+    }
+    out << boost::json::serialize(LlsdToJson(report.asLLSD())) << "\n";
+}
+
+LLSD LLFrameSpikeMonitor::Report::asLLSD() const
+{
+    LLSD result;
+    result["time"] = mTime;
+    result["frame"] = (LLSD::Integer)mFrame;
+    result["frame_ms"] = (LLSD::Real)mFrameMs;
+    result["threshold_ms"] = (LLSD::Real)mThresholdMs;
+    result["subsystems"] = entries_as_llsd(mSubsystems);
+    result["zones"] = entries_as_llsd(mZones);
+    result["messages"] = entries_as_llsd(mMessages);
+    result["fast_timers"] = entries_as_llsd(mFastTimers);
+    return result;
+}
+
+std::string LLFrameSpikeMonitor::Report::asText() const
+{
+    std::ostringstream out;
+    out << mTime.asString() << "  frame " << mFrame
+        << llformat(": %.1f ms (threshold %.0f ms)\n", mFrameMs, mThresholdMs);
+    entries_as_text(out, "Subsystems", mSubsystems);
+    entries_as_text(out, "Zones (self time)", mZones);
+    entries_as_text(out, "Message handlers", mMessages);
+    entries_as_text(out, "Fast timers (self time)", mFastTimers);
+    if (mSubsystems.empty())
+    {
+        out << "\nTurn on FrameProfilerMainThread or FrameProfilerEnabled to see subsystems and zones.\n";
+    }
+    return out.str();
+}
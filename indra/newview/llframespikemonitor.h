@@ -0,0 +1,108 @@
+/**
+ * @file llframespikemonitor.h
+ * @brief Detects main loop frame time spikes and reports where the time went
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLFRAMESPIKEMONITOR_H
+#define LL_LLFRAMESPIKEMONITOR_H
+
+#include "llsingleton.h"
+#include "lldate.h"
+#include "llsd.h"
+
+#include <deque>
+
+//
+// Averages hide the single long frames users perceive as stutter.  When a
+// frame takes longer than FrameSpikeThreshold milliseconds, this class
+// writes a report of where the main thread spent that frame:
+//
+// * subsystems: main loop sections (rendering, network, coroutines, main
+//   WorkQueue callbacks, idle callbacks, ...) found in the frame's profiler
+//   zones, see LLFrameProfiler;
+// * the profiler zones and message handlers that took the most time;
+// * the fast timers that took the most self time.
+//
+// The last FrameSpikeHistory reports are kept for the frame_spikes floater,
+// and each report is appended as one line of JSON to frame_spikes.log in
+// the logs folder when FrameSpikeLog is set.
+//
+// Zone attribution needs the frame profiler recording the main thread:
+// FrameProfilerMainThread (on by default) or FrameProfilerEnabled.  With
+// neither, reports only carry fast timers.
+//
+// Threads:  main thread only
+//
+class LLFrameSpikeMonitor : public LLSingleton<LLFrameSpikeMonitor>
+{
+    LLSINGLETON(LLFrameSpikeMonitor);
+
+public:
+    struct Entry
+    {
+        std::string mName;
+        F32 mMilliseconds = 0.f;
+        U32 mCount = 0;     // zones or calls
+    };
+    typedef std::vector<Entry> entries_t;
+
+    struct Report
+    {
+        U32 mSerial;
+        LLDate mTime;
+        U32 mFrame;
+        F32 mFrameMs;
+        F32 mThresholdMs;
+        entries_t mSubsystems;  // main thread time by main loop section
+        entries_t mZones;       // profiler zones, self time
+        entries_t mMessages;    // message handlers
+        entries_t mFastTimers;  // fast timers, self time
+
+        LLSD asLLSD() const;
+        std::string asText() const;
+    };
+    typedef std::deque<Report> reports_t;
+
+    // Called by LLAppViewer at the end of every frame, with the length of
+    // that frame as returned by LLFrameProfiler::endFrame().
+    void endFrame(F64 frame_seconds);
+
+    const reports_t& getReports() const { return mReports; }
+
+    // Changes whenever a report is added or the history is cleared
+    U32 getChangeCount() const { return mChangeCount; }
+
+    void clear();
+
+private:
+    void attributeZones(Report& report, F64 frame_seconds);
+    void attributeFastTimers(Report& report);
+    void writeLog(const Report& report);
+
+    reports_t mReports;
+    U32 mNextSerial;
+    U32 mChangeCount;
+};
+
+#endif // LL_LLFRAMESPIKEMONITOR_H
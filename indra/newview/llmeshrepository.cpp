@@ -70,6 +70,7 @@
 #include "lluploadfloaterobservers.h"
 #include "bufferarray.h"
 #include "bufferstream.h"
+#include "httpstats.h"
 #include "llfasttimer.h"
 #include "llcorehttputil.h"
 #include "lltrans.h"
@@ -234,6 +235,8 @@
 //     sCacheBytesWritten              "
 //     sCacheReads                     "
 //     sCacheWrites                    "
+//     sDecodedCacheHits               "
+//     sDecodedCacheWrites             "
 //     mLoadingMeshes                  mMeshMutex [4]  rw.main.none, rw.any.mMeshMutex
 //     mSkinMap                        none            rw.main.none
 //     mDecompositionMap               none            rw.main.none
@@ -402,6 +405,10 @@ U32 LLMeshRepository::sHTTPRetryCount = 0;
 U32 LLMeshRepository::sHTTPErrorCount = 0;
 U32 LLMeshRepository::sLODProcessing = 0;
 U32 LLMeshRepository::sLODPending = 0;
+std::atomic<U32> LLMeshRepository::sDecodeQueueDepth = 0;
+std::atomic<U32> LLMeshRepository::sDecodeCount = 0;
+std::atomic<U64> LLMeshRepository::sDecodeLatencyTotal = 0;
+std::atomic<U64> LLMeshRepository::sDecodeLatencyMax = 0;
 
 U32 LLMeshRepository::sCacheBytesRead = 0;
 std::atomic<U32> LLMeshRepository::sCacheBytesWritten = 0;
@@ -410,6 +417,8 @@ U32 LLMeshRepository::sCacheBytesSkins = 0;
 U32 LLMeshRepository::sCacheBytesDecomps = 0;
 U32 LLMeshRepository::sCacheReads = 0;
 std::atomic<U32> LLMeshRepository::sCacheWrites = 0;
+std::atomic<U32> LLMeshRepository::sDecodedCacheHits = 0;
+std::atomic<U32> LLMeshRepository::sDecodedCacheWrites = 0;
 U32 LLMeshRepository::sMaxLockHoldoffs = 0;
 
 LLDeadmanTimer LLMeshRepository::sQuiescentTimer(15.0, false);  // true -> gather cpu metrics
@@ -689,7 +698,21 @@ public:
     U32 mRequestedBytes;
 
 protected:
+    // When processData() hands 'data' to another thread, the
+    // returned reference keeps the response body alive if the
+    // data points into it.  Empty when the handler owns a copy.
+    LLCore::BufferArray::ptr_t holdBody(LLCore::BufferArray * body) const
+    {
+        if (! mDataInBody || ! body)
+        {
+            return LLCore::BufferArray::ptr_t();
+        }
+        body->addRef();
+        return LLCore::BufferArray::ptr_t(body);
+    }
+
     bool mHasDataOwnership = true;
+    bool mDataInBody = false;       // 'data' points into the response body, not ours to delete
 };
 
 
@@ -800,6 +823,7 @@ protected:
 public:
     virtual void processData(LLCore::BufferArray * body, S32 body_offset, U8 * data, S32 data_size);
     virtual void processFailure(LLCore::HttpStatus status);
+    void processDecomposition(U8* data, S32 data_size);
 
 public:
     LLUUID mMeshID;
@@ -826,6 +850,7 @@ protected:
 public:
     virtual void processData(LLCore::BufferArray * body, S32 body_offset, U8 * data, S32 data_size);
     virtual void processFailure(LLCore::HttpStatus status);
+    void processPhysicsShape(U8* data, S32 data_size);
 
 public:
     LLUUID mMeshID;
@@ -950,6 +975,38 @@ void write_preamble(LLFileSystem &file, S32 header_bytes, S32 flags)
     file.write((U8*)&flags, sizeof(U32));
 }
 
+// Decoded LODs live in the disk cache next to the raw asset under an id
+// derived from the mesh id, LOD and the sculpt flags (mirror and invert
+// are baked into the decoded faces).
+LLUUID decoded_lod_cache_id(const LLVolumeParams& mesh_params, S32 lod)
+{
+    LLUUID salt;
+    salt.generate(llformat("decoded mesh lod %d %d", lod, (S32) mesh_params.getSculptType()));
+    return mesh_params.getSculptID().combine(salt);
+}
+
+// Entry layout: U32 size of the raw LOD block it was decoded from,
+// followed by LLVolume::packDecodedVolumeFaces() output.
+void store_decoded_lod(const LLVolumeParams& mesh_params, S32 lod, S32 lod_size, const LLVolume* volume)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    std::vector<U8> entry;
+    if (!volume->packDecodedVolumeFaces(entry))
+    {
+        return;
+    }
+    const U32 size_tag(lod_size);
+    entry.insert(entry.begin(), (const U8*) &size_tag, (const U8*) &size_tag + sizeof(U32));
+
+    LLFileSystem file(decoded_lod_cache_id(mesh_params, lod), LLAssetType::AT_MESH, LLFileSystem::WRITE);
+    if (file.write(entry.data(), (S32) entry.size()))
+    {
+        LLMeshRepository::sCacheBytesWritten += (U32) entry.size();
+        ++LLMeshRepository::sDecodedCacheWrites;
+    }
+}
+
 LLMeshRepoThread::LLMeshRepoThread()
 : LLThread("mesh repo"),
   mHttpRequest(NULL),
@@ -985,6 +1042,8 @@ LLMeshRepoThread::LLMeshRepoThread()
     mHttpLegacyPolicyClass = app_core_http.getPolicy(LLAppCoreHttp::AP_MESH1); // <FS:Ansariel> [UDP Assets]
     mHttpLargePolicyClass = app_core_http.getPolicy(LLAppCoreHttp::AP_LARGE_MESH);
 
+    mUseDecodedLODCache = gSavedSettings.getBOOL("MeshDecodedLODCache");
+
     // Lod processing is expensive due to the number of requests
     // and a need to do expensive cacheOptimize().
     mMeshThreadPool.reset(new LL::ThreadPool("MeshLodProcessing", 2));
@@ -1645,7 +1704,7 @@ bool LLMeshRepoThread::fetchMeshSkinInfo(const LLUUID& mesh_id)
                 if (!zero)
                 {
                     //attempt to parse
-                    bool posted = mMeshThreadPool->getQueue().post(
+                    bool posted = postDecode(
                         [mesh_id, buffer, size]
                         ()
                     {
@@ -2102,6 +2161,68 @@ bool LLMeshRepoThread::fetchMeshHeader(const LLVolumeParams& mesh_params)
 }
 
 //return false if failed to get mesh lod.
+bool LLMeshRepoThread::loadDecodedMeshLOD(const LLVolumeParams& mesh_params, S32 lod, S32 lod_size)
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    const LLUUID entry_id(decoded_lod_cache_id(mesh_params, lod));
+    LLFileSystem file(entry_id, LLAssetType::AT_MESH);
+    const S32 entry_size = file.getSize();
+    if (entry_size <= (S32) sizeof(U32))
+    {
+        return false;
+    }
+
+    U8* buffer = new(std::nothrow) U8[entry_size];
+    if (!buffer)
+    {
+        return false;
+    }
+    if (!file.read(buffer, entry_size) || file.getLastBytesRead() != entry_size)
+    {
+        delete[] buffer;
+        return false;
+    }
+    LLMeshRepository::sCacheBytesRead += entry_size;
+    ++LLMeshRepository::sCacheReads;
+
+    const LLVolumeParams params(mesh_params);
+    bool posted = postDecode(
+        [params, lod, lod_size, entry_id, buffer, entry_size]
+        ()
+    {
+        if (!gMeshRepo.mThread->isShuttingDown()
+            && gMeshRepo.mThread->decodedLodReceived(params, lod, lod_size, buffer, entry_size) != MESH_OK)
+        {
+            LL_DEBUGS(LOG_MESH) << "Decoded LOD cache entry for " << params.getSculptID() << " LOD " << lod
+                                << " rejected, loading asset instead." << LL_ENDL;
+
+            // drop the entry so the retry goes through the asset
+            LLFileSystem::removeFile(entry_id, LLAssetType::AT_MESH);
+
+            LLMutexLock lock(gMeshRepo.mThread->mMutex);
+            LODRequest req(params, lod);
+            gMeshRepo.mThread->mLODReqQ.push(req);
+            LLMeshRepository::sLODProcessing++;
+        }
+        delete[] buffer;
+    });
+
+    if (posted)
+    {
+        // now lambda owns buffer
+        return true;
+    }
+
+    bool restored = decodedLodReceived(mesh_params, lod, lod_size, buffer, entry_size) == MESH_OK;
+    delete[] buffer;
+    if (!restored)
+    {
+        LLFileSystem::removeFile(entry_id, LLAssetType::AT_MESH);
+    }
+    return restored;
+}
+
 bool LLMeshRepoThread::fetchMeshLOD(const LLVolumeParams& mesh_params, S32 lod)
 {
     LL_PROFILE_ZONE_SCOPED;
@@ -2134,6 +2255,11 @@ bool LLMeshRepoThread::fetchMeshLOD(const LLVolumeParams& mesh_params, S32 lod)
 
         if (version <= MAX_MESH_VERSION && offset >= 0 && size > 0)
         {
+            if (mUseDecodedLODCache && loadDecodedMeshLOD(mesh_params, lod, size))
+            {
+                return true;
+            }
+
             S32 disk_ofset = offset + CACHE_PREAMBLE_SIZE;
             //check cache for mesh asset
             LLFileSystem file(mesh_id, LLAssetType::AT_MESH);
@@ -2172,7 +2298,7 @@ bool LLMeshRepoThread::fetchMeshLOD(const LLVolumeParams& mesh_params, S32 lod)
                 {
                     //attempt to parse
                     const LLVolumeParams params(mesh_params);
-                    bool posted = mMeshThreadPool->getQueue().post(
+                    bool posted = postDecode(
                         [params, mesh_id, lod, buffer, size]
                         ()
                     {
@@ -2488,52 +2614,88 @@ EMeshProcessingResult LLMeshRepoThread::lodReceived(const LLVolumeParams& mesh_p
     LLPointer<LLVolume> volume = new LLVolume(mesh_params, LLVolumeLODGroup::getVolumeScaleFromDetail(lod));
     if (volume->unpackVolumeFaces(data, data_size))
     {
-        // Use LLVolume::getNumVolumeFaces() here and not LLVolume::getNumFaces(),
-        // because setMeshAssetLoaded() has not yet been called for this volume
-        // (it is set later in LLMeshRepository::notifyMeshLoaded()), and
-        // getNumFaces() would return the number of faces in the LLProfile
-        // instead. HB
-        S32 num_faces = volume->getNumVolumeFaces();
-        if (num_faces > 0)
+        if (mUseDecodedLODCache)
         {
-            // if we have a valid SkinInfo, cache per-joint bounding boxes for this LOD
-            LLPointer<LLMeshSkinInfo> skin_info = nullptr;
-            {
-                LLMutexLock lock(mSkinMapMutex);
-                skin_map::iterator iter = mSkinMap.find(mesh_params.getSculptID());
-                if (iter != mSkinMap.end())
-                {
-                    skin_info = iter->second;
-                }
-            }
-            if (skin_info.notNull() && isAgentAvatarValid())
-            {
-                for (S32 i = 0; i < num_faces; ++i)
-                {
-                    // NOTE: no need to lock gAgentAvatarp as the state being checked is not changed after initialization
-                    LLVolumeFace& face = volume->getVolumeFace(i);
-                    LLSkinningUtil::updateRiggingInfo(skin_info, gAgentAvatarp, face);
-                }
-            }
+            store_decoded_lod(mesh_params, lod, data_size, volume);
+        }
+        return volumeReceived(mesh_params, lod, volume);
+    }
+
+    return MESH_UNKNOWN;
+}
+
+EMeshProcessingResult LLMeshRepoThread::decodedLodReceived(const LLVolumeParams& mesh_params, S32 lod, S32 lod_size, U8* data, S32 data_size)
+{
+    if (data == NULL || data_size <= (S32) sizeof(U32))
+    {
+        return MESH_NO_DATA;
+    }
+
+    U32 stored_lod_size(0);
+    memcpy(&stored_lod_size, data, sizeof(U32));
+    if (stored_lod_size != (U32) lod_size)
+    {
+        // entry was made from a different asset body, ignore it
+        return MESH_INVALID;
+    }
 
-            LoadedMesh mesh(volume, mesh_params, lod);
+    LLPointer<LLVolume> volume = new LLVolume(mesh_params, LLVolumeLODGroup::getVolumeScaleFromDetail(lod));
+    if (volume->unpackDecodedVolumeFaces(data + sizeof(U32), data_size - (S32) sizeof(U32)))
+    {
+        ++LLMeshRepository::sDecodedCacheHits;
+        return volumeReceived(mesh_params, lod, volume);
+    }
+
+    return MESH_UNKNOWN;
+}
+
+EMeshProcessingResult LLMeshRepoThread::volumeReceived(const LLVolumeParams& mesh_params, S32 lod, LLPointer<LLVolume>& volume)
+{
+    // Use LLVolume::getNumVolumeFaces() here and not LLVolume::getNumFaces(),
+    // because setMeshAssetLoaded() has not yet been called for this volume
+    // (it is set later in LLMeshRepository::notifyMeshLoaded()), and
+    // getNumFaces() would return the number of faces in the LLProfile
+    // instead. HB
+    S32 num_faces = volume->getNumVolumeFaces();
+    if (num_faces > 0)
+    {
+        // if we have a valid SkinInfo, cache per-joint bounding boxes for this LOD
+        LLPointer<LLMeshSkinInfo> skin_info = nullptr;
+        {
+            LLMutexLock lock(mSkinMapMutex);
+            skin_map::iterator iter = mSkinMap.find(mesh_params.getSculptID());
+            if (iter != mSkinMap.end())
             {
-                LLMutexLock lock(mLoadedMutex);
-                mLoadedQ.push_back(mesh);
-                // LLPointer is not thread safe, since we added this pointer into
-                // threaded list, make sure counter gets decreased inside mutex lock
-                // and won't affect mLoadedQ processing
-                volume = NULL;
-                // might be good idea to turn mesh into pointer to avoid making a copy
-                mesh.mVolume = NULL;
+                skin_info = iter->second;
             }
+        }
+        if (skin_info.notNull() && isAgentAvatarValid())
+        {
+            for (S32 i = 0; i < num_faces; ++i)
             {
-                // make sure skin info is not removed from list while we are decreasing reference count
-                LLMutexLock lock(mSkinMapMutex);
-                skin_info = nullptr;
+                // NOTE: no need to lock gAgentAvatarp as the state being checked is not changed after initialization
+                LLVolumeFace& face = volume->getVolumeFace(i);
+                LLSkinningUtil::updateRiggingInfo(skin_info, gAgentAvatarp, face);
             }
-            return MESH_OK;
         }
+
+        LoadedMesh mesh(volume, mesh_params, lod);
+        {
+            LLMutexLock lock(mLoadedMutex);
+            mLoadedQ.push_back(mesh);
+            // LLPointer is not thread safe, since we added this pointer into
+            // threaded list, make sure counter gets decreased inside mutex lock
+            // and won't affect mLoadedQ processing
+            volume = NULL;
+            // might be good idea to turn mesh into pointer to avoid making a copy
+            mesh.mVolume = NULL;
+        }
+        {
+            // make sure skin info is not removed from list while we are decreasing reference count
+            LLMutexLock lock(mSkinMapMutex);
+            skin_info = nullptr;
+        }
+        return MESH_OK;
     }
 
     return MESH_UNKNOWN;
@@ -3759,15 +3921,23 @@ void LLMeshHandlerBase::onCompleted(LLCore::HttpHandle handle, LLCore::HttpRespo
                 goto common_exit;
             }
 
-            // *TODO: Try to get rid of data copying and add interfaces
-            // that support BufferArray directly.  Introduce a two-phase
-            // handler, optional first that takes a body, fallback second
-            // that requires a temporary allocation and data copy.
+            // Bodies with a Content-Length arrive in a single block
+            // so the data can usually be used in place.  Only fall
+            // back to a temporary allocation and copy when the body
+            // is fragmented.
             body_offset = mOffset - offset;
-            data = new(std::nothrow) U8[data_size - body_offset];
+            const size_t body_len(data_size - body_offset);
+            data = (U8 *) body->contiguousData(body_offset, body_len);
             if (data)
             {
-                body->read(body_offset, (char *) data, data_size - body_offset);
+                mDataInBody = true;
+                LLCore::HTTPStats::instance().recordBodyBytesInPlace(body_len);
+                LLMeshRepository::sBytesReceived += static_cast<U32>(data_size);
+            }
+            else if ((data = new(std::nothrow) U8[body_len]))
+            {
+                body->read(body_offset, (char *) data, body_len);
+                LLCore::HTTPStats::instance().recordBodyBytesCopied(body_len);
                 LLMeshRepository::sBytesReceived += static_cast<U32>(data_size);
             }
             else
@@ -3779,7 +3949,7 @@ void LLMeshHandlerBase::onCompleted(LLCore::HttpHandle handle, LLCore::HttpRespo
 
         processData(body, body_offset, data, static_cast<S32>(data_size) - body_offset);
 
-        if (mHasDataOwnership)
+        if (mHasDataOwnership && ! mDataInBody)
         {
             delete [] data;
         }
@@ -4015,7 +4185,7 @@ void LLMeshLODHandler::processLod(U8* data, S32 data_size)
     }
 }
 
-void LLMeshLODHandler::processData(LLCore::BufferArray * /* body */, S32 /* body_offset */,
+void LLMeshLODHandler::processData(LLCore::BufferArray * body, S32 /* body_offset */,
                                    U8 * data, S32 data_size)
 {
     LL_PROFILE_ZONE_SCOPED;
@@ -4023,18 +4193,25 @@ void LLMeshLODHandler::processData(LLCore::BufferArray * /* body */, S32 /* body
         && ((data != NULL) == (data_size > 0))) // if we have data but no size or have size but no data, something is wrong
     {
         LLMeshHandlerBase::ptr_t shrd_handler = shared_from_this();
-        bool posted = gMeshRepo.mThread->mMeshThreadPool->getQueue().post(
-            [shrd_handler, data, data_size]
+        LLCore::BufferArray::ptr_t body_ref(holdBody(body));
+        bool posted = gMeshRepo.mThread->postDecode(
+            [shrd_handler, data, data_size, body_ref]
             ()
         {
             if (gMeshRepo.mThread->isShuttingDown())
             {
-                delete[] data;
+                if (! body_ref)
+                {
+                    delete[] data;
+                }
                 return;
             }
             LLMeshLODHandler* handler = (LLMeshLODHandler * )shrd_handler.get();
             handler->processLod(data, data_size);
-            delete[] data;
+            if (! body_ref)
+            {
+                delete[] data;
+            }
         });
 
         if (posted)
@@ -4045,7 +4222,7 @@ void LLMeshLODHandler::processData(LLCore::BufferArray * /* body */, S32 /* body
         else
         {
             // mesh thread dies later than event queue, so this is normal
-            LL_INFOS_ONCE(LOG_MESH) << "Failed to post work into mMeshThreadPool" << LL_ENDL;
+            LL_INFOS_ONCE(LOG_MESH) << "Failed to post work into decode pool" << LL_ENDL;
             processLod(data, data_size);
         }
     }
@@ -4133,7 +4310,7 @@ void LLMeshSkinInfoHandler::processSkin(U8* data, S32 data_size)
     }
 }
 
-void LLMeshSkinInfoHandler::processData(LLCore::BufferArray * /* body */, S32 /* body_offset */,
+void LLMeshSkinInfoHandler::processData(LLCore::BufferArray * body, S32 /* body_offset */,
                                         U8 * data, S32 data_size)
 {
     LL_PROFILE_ZONE_SCOPED;
@@ -4141,18 +4318,25 @@ void LLMeshSkinInfoHandler::processData(LLCore::BufferArray * /* body */, S32 /*
         && ((data != NULL) == (data_size > 0))) // if we have data but no size or have size but no data, something is wrong
     {
         LLMeshHandlerBase::ptr_t shrd_handler = shared_from_this();
-        bool posted = gMeshRepo.mThread->mMeshThreadPool->getQueue().post(
-            [shrd_handler, data, data_size]
+        LLCore::BufferArray::ptr_t body_ref(holdBody(body));
+        bool posted = gMeshRepo.mThread->postDecode(
+            [shrd_handler, data, data_size, body_ref]
             ()
         {
             if (gMeshRepo.mThread->isShuttingDown())
             {
-                delete[] data;
+                if (! body_ref)
+                {
+                    delete[] data;
+                }
                 return;
             }
             LLMeshSkinInfoHandler* handler = (LLMeshSkinInfoHandler*)shrd_handler.get();
             handler->processSkin(data, data_size);
-            delete[] data;
+            if (! body_ref)
+            {
+                delete[] data;
+            }
         });
 
         if (posted)
@@ -4163,7 +4347,7 @@ void LLMeshSkinInfoHandler::processData(LLCore::BufferArray * /* body */, S32 /*
         else
         {
             // mesh thread dies later than event queue, so this is normal
-            LL_INFOS_ONCE(LOG_MESH) << "Failed to post work into mMeshThreadPool" << LL_ENDL;
+            LL_INFOS_ONCE(LOG_MESH) << "Failed to post work into decode pool" << LL_ENDL;
             processSkin(data, data_size);
         }
     }
@@ -4195,13 +4379,54 @@ void LLMeshDecompositionHandler::processFailure(LLCore::HttpStatus status)
     // request unfulfilled rather than retry forever.
 }
 
-void LLMeshDecompositionHandler::processData(LLCore::BufferArray * /* body */, S32 /* body_offset */,
+void LLMeshDecompositionHandler::processData(LLCore::BufferArray * body, S32 /* body_offset */,
                                              U8 * data, S32 data_size)
 {
     LL_PROFILE_ZONE_SCOPED;
     if ((!MESH_DECOMP_PROCESS_FAILED)
-        && ((data != NULL) == (data_size > 0)) // if we have data but no size or have size but no data, something is wrong
-        && gMeshRepo.mThread->decompositionReceived(mMeshID, data, data_size))
+        && ((data != NULL) == (data_size > 0))) // if we have data but no size or have size but no data, something is wrong
+    {
+        LLMeshHandlerBase::ptr_t shrd_handler = shared_from_this();
+        LLCore::BufferArray::ptr_t body_ref(holdBody(body));
+        bool posted = gMeshRepo.mThread->postDecode(
+            [shrd_handler, data, data_size, body_ref]
+            ()
+        {
+            if (!gMeshRepo.mThread->isShuttingDown())
+            {
+                LLMeshDecompositionHandler* handler = (LLMeshDecompositionHandler*)shrd_handler.get();
+                handler->processDecomposition(data, data_size);
+            }
+            if (! body_ref)
+            {
+                delete[] data;
+            }
+        });
+
+        if (posted)
+        {
+            // ownership of data was passed to the lambda
+            mHasDataOwnership = false;
+        }
+        else
+        {
+            LL_INFOS_ONCE(LOG_MESH) << "Failed to post work into decode pool" << LL_ENDL;
+            processDecomposition(data, data_size);
+        }
+    }
+    else
+    {
+        LL_WARNS(LOG_MESH) << "Error during mesh decomposition processing.  ID:  " << mMeshID
+                           << ", Unknown reason.  Not retrying."
+                           << LL_ENDL;
+        // *TODO:  Mark mesh unavailable on error
+    }
+}
+
+void LLMeshDecompositionHandler::processDecomposition(U8* data, S32 data_size)
+{
+    LL_PROFILE_ZONE_SCOPED;
+    if (gMeshRepo.mThread->decompositionReceived(mMeshID, data, data_size))
     {
         // good fetch from sim, write to cache
         LLFileSystem file(mMeshID, LLAssetType::AT_MESH, LLFileSystem::READ_WRITE);
@@ -4268,13 +4493,54 @@ void LLMeshPhysicsShapeHandler::processFailure(LLCore::HttpStatus status)
     // *TODO:  Mark mesh unavailable on error
 }
 
-void LLMeshPhysicsShapeHandler::processData(LLCore::BufferArray * /* body */, S32 /* body_offset */,
+void LLMeshPhysicsShapeHandler::processData(LLCore::BufferArray * body, S32 /* body_offset */,
                                             U8 * data, S32 data_size)
 {
     LL_PROFILE_ZONE_SCOPED;
     if ((!MESH_PHYS_SHAPE_PROCESS_FAILED)
-        && ((data != NULL) == (data_size > 0)) // if we have data but no size or have size but no data, something is wrong
-        && gMeshRepo.mThread->physicsShapeReceived(mMeshID, data, data_size) == MESH_OK)
+        && ((data != NULL) == (data_size > 0))) // if we have data but no size or have size but no data, something is wrong
+    {
+        LLMeshHandlerBase::ptr_t shrd_handler = shared_from_this();
+        LLCore::BufferArray::ptr_t body_ref(holdBody(body));
+        bool posted = gMeshRepo.mThread->postDecode(
+            [shrd_handler, data, data_size, body_ref]
+            ()
+        {
+            if (!gMeshRepo.mThread->isShuttingDown())
+            {
+                LLMeshPhysicsShapeHandler* handler = (LLMeshPhysicsShapeHandler*)shrd_handler.get();
+                handler->processPhysicsShape(data, data_size);
+            }
+            if (! body_ref)
+            {
+                delete[] data;
+            }
+        });
+
+        if (posted)
+        {
+            // ownership of data was passed to the lambda
+            mHasDataOwnership = false;
+        }
+        else
+        {
+            LL_INFOS_ONCE(LOG_MESH) << "Failed to post work into decode pool" << LL_ENDL;
+            processPhysicsShape(data, data_size);
+        }
+    }
+    else
+    {
+        LL_WARNS(LOG_MESH) << "Error during mesh physics shape processing.  ID:  " << mMeshID
+                           << ", Unknown reason.  Not retrying."
+                           << LL_ENDL;
+        // *TODO:  Mark mesh unavailable on error
+    }
+}
+
+void LLMeshPhysicsShapeHandler::processPhysicsShape(U8* data, S32 data_size)
+{
+    LL_PROFILE_ZONE_SCOPED;
+    if (gMeshRepo.mThread->physicsShapeReceived(mMeshID, data, data_size) == MESH_OK)
     {
         // good fetch from sim, write to cache for caching
         LLFileSystem file(mMeshID, LLAssetType::AT_MESH, LLFileSystem::READ_WRITE);
@@ -4536,6 +4802,26 @@ S32 LLMeshRepository::loadMesh(LLVOVolume* vobj, const LLVolumeParams& mesh_para
     return new_lod;
 }
 
+void LLMeshRepository::prefetchMesh(const LLVolumeParams& mesh_params, S32 lod)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+
+    if (lod < 0 || lod >= LLVolumeLODGroup::NUM_LODS)
+    {
+        return;
+    }
+
+    LLMutexLock lock(mMeshMutex);
+    const auto& mesh_id = mesh_params.getSculptID();
+    if (mLoadingMeshes[lod].find(mesh_id) == mLoadingMeshes[lod].end())
+    {
+        std::shared_ptr<PendingRequestBase> request(new PendingRequestLOD(mesh_params, lod));
+        mPendingRequests.emplace_back(request);
+        mLoadingMeshes[lod][mesh_id].initData(nullptr, request);
+        LLMeshRepository::sLODPending++;
+    }
+}
+
 void LLMeshRepository::notifyLoadedMeshes()
 { //called from main thread
     LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK; //LL_RECORD_BLOCK_TIME(FTM_MESH_FETCH);
@@ -6338,10 +6624,35 @@ void LLMeshRepository::metricsUpdate()
         metrics["teleports"] = LLSD::Integer(metrics_teleport_start_count);
         metrics["user_cpu"] = double(user_cpu) / 1.0e6;
         metrics["sys_cpu"] = double(sys_cpu) / 1.0e6;
+        metrics["decodes"] = LLSD::Integer(sDecodeCount.load());
+        metrics["decode_latency_avg_ms"] = getDecodeLatencyAvgMs();
+        metrics["decode_latency_max_ms"] = double(sDecodeLatencyMax.load()) / 1.0e3;
+        metrics["decoded_cache_hits"] = LLSD::Integer(sDecodedCacheHits.load());
+        metrics["decoded_cache_writes"] = LLSD::Integer(sDecodedCacheWrites.load());
         LL_INFOS(LOG_MESH) << "EventMarker " << metrics << LL_ENDL;
     }
 }
 
+// Threading:  any thread
+// static
+void LLMeshRepository::recordDecodeLatency(U64 usec)
+{
+    ++sDecodeCount;
+    sDecodeLatencyTotal += usec;
+    U64 prev_max(sDecodeLatencyMax.load());
+    while (usec > prev_max && !sDecodeLatencyMax.compare_exchange_weak(prev_max, usec))
+    {
+    }
+}
+
+// Threading:  any thread
+// static
+F32 LLMeshRepository::getDecodeLatencyAvgMs()
+{
+    const U32 count(sDecodeCount.load());
+    return count ? F32(sDecodeLatencyTotal.load()) / (1000.f * count) : 0.f;
+}
+
 // Threading:  main thread only
 // static
 void teleport_started()
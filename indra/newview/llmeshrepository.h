@@ -41,6 +41,7 @@
 #include "httpheaders.h"
 #include "httphandler.h"
 #include "llthread.h"
+#include "threadpool.h"
 
 #define LLCONVEXDECOMPINTER_STATIC 1
 
@@ -300,7 +301,10 @@ public:
     }
     void initData(LLVOVolume* vol, std::shared_ptr<PendingRequestBase>& request)
     {
-        mVolumes.push_back(vol);
+        if (vol)
+        {
+            mVolumes.push_back(vol);
+        }
         request->trackData(this);
         mRequest = request;
     }
@@ -554,9 +558,18 @@ public:
 
     // workqueue for processing generic requests
     LL::WorkQueue mWorkQueue;
-    // lods have their own thread due to costly cacheOptimize() calls
+    // Asset decode (inflate, LLSD parse, face unpack and cacheOptimize())
+    // runs on this pool so the repo thread only schedules.  Width comes
+    // from the "MeshLodProcessing" entry of ThreadPoolSizes.
     std::unique_ptr<LL::ThreadPool> mMeshThreadPool;
 
+    // Post decode work to mMeshThreadPool, tracking queue depth and
+    // post-to-completion latency for the mesh stats.  Returns false
+    // if the pool no longer accepts work; caller then keeps ownership
+    // of anything the callable would have consumed.
+    template <typename CALLABLE>
+    bool postDecode(CALLABLE&& callable);
+
     // llcorehttp library interface objects.
     LLCore::HttpStatus                  mHttpStatus;
     LLCore::HttpRequest *               mHttpRequest;
@@ -591,6 +604,7 @@ public:
     bool fetchMeshLOD(const LLVolumeParams& mesh_params, S32 lod);
     EMeshProcessingResult headerReceived(const LLVolumeParams& mesh_params, U8* data, S32 data_size, U32 flags = 0);
     EMeshProcessingResult lodReceived(const LLVolumeParams& mesh_params, S32 lod, U8* data, S32 data_size);
+    EMeshProcessingResult decodedLodReceived(const LLVolumeParams& mesh_params, S32 lod, S32 lod_size, U8* data, S32 data_size);
     bool skinInfoReceived(const LLUUID& mesh_id, U8* data, S32 data_size);
     bool decompositionReceived(const LLUUID& mesh_id, U8* data, S32 data_size);
     EMeshProcessingResult physicsShapeReceived(const LLUUID& mesh_id, U8* data, S32 data_size);
@@ -659,11 +673,23 @@ private:
     // Mutex: acquires mPendingMutex, mMutex and mHeaderMutex as needed
     void loadMeshLOD(const LLUUID &mesh_id, const LLVolumeParams& mesh_params, S32 lod);
 
+    // Try the decoded LOD cache first, posting a restore to the decode
+    // pool on a hit.  Returns false if the LOD must be loaded the usual way.
+    //
+    // Threads:  Repo thread only
+    bool loadDecodedMeshLOD(const LLVolumeParams& mesh_params, S32 lod, S32 lod_size);
+
+    // Hand a freshly unpacked LOD over to the main thread.
+    //
+    // Threads:  any thread
+    EMeshProcessingResult volumeReceived(const LLVolumeParams& mesh_params, S32 lod, LLPointer<LLVolume>& volume);
+
     // Threads:  Repo thread only
     U8* getDiskCacheBuffer(S32 size);
     S32 mDiskCacheBufferSize = 0;
     U8* mDiskCacheBuffer = nullptr;
     bool mShuttingDown = false;
+    bool mUseDecodedLODCache = false;
 };
 
 
@@ -849,6 +875,10 @@ public:
     static U32 sHTTPErrorCount;                 // Requests ending in error
     static U32 sLODPending;
     static U32 sLODProcessing;
+    static std::atomic<U32> sDecodeQueueDepth;  // Decode jobs waiting for or running on a worker
+    static std::atomic<U32> sDecodeCount;       // Decode jobs completed
+    static std::atomic<U64> sDecodeLatencyTotal; // Post-to-completion time of all decodes (usec)
+    static std::atomic<U64> sDecodeLatencyMax;
     static U32 sCacheBytesRead;
     static std::atomic<U32> sCacheBytesWritten;
     static U32 sCacheBytesHeaders;
@@ -856,10 +886,15 @@ public:
     static U32 sCacheBytesDecomps;
     static U32 sCacheReads;
     static std::atomic<U32> sCacheWrites;
+    static std::atomic<U32> sDecodedCacheHits;  // LODs restored from the decoded LOD cache
+    static std::atomic<U32> sDecodedCacheWrites;
     static U32 sMaxLockHoldoffs;                // Maximum sequential locking failures
 
     static LLDeadmanTimer sQuiescentTimer;      // Time-to-complete-mesh-downloads after significant events
 
+    static void recordDecodeLatency(U64 usec);
+    static F32 getDecodeLatencyAvgMs();
+
     // Estimated triangle count of the largest LOD
     F32 getEstTrianglesMax(LLUUID mesh_id);
     F32 getEstTrianglesStreamingCost(LLUUID mesh_id);
@@ -880,6 +915,9 @@ public:
     void unregisterMesh(LLVOVolume* volume);
     //mesh management functions
     S32 loadMesh(LLVOVolume* volume, const LLVolumeParams& mesh_params, S32 new_lod = 0, S32 last_lod = -1);
+    // Request a LOD no object is waiting on yet (see LLVOCachePrefetcher).
+    // With no volumes attached it scores below every visible request.
+    void prefetchMesh(const LLVolumeParams& mesh_params, S32 lod);
 
     void notifyLoadedMeshes();
     void notifyMeshLoaded(const LLVolumeParams& mesh_params, LLVolume* volume, S32 lod);
@@ -988,6 +1026,26 @@ public:
 
 extern LLMeshRepository gMeshRepo;
 
+template <typename CALLABLE>
+bool LLMeshRepoThread::postDecode(CALLABLE&& callable)
+{
+    const U64 queued_at(LLTimer::getTotalTime());
+    ++LLMeshRepository::sDecodeQueueDepth;
+    bool posted = mMeshThreadPool->getQueue().post(
+        [queued_at, work = std::forward<CALLABLE>(callable)]
+        () mutable
+    {
+        work();
+        --LLMeshRepository::sDecodeQueueDepth;
+        LLMeshRepository::recordDecodeLatency(LLTimer::getTotalTime() - queued_at);
+    });
+    if (!posted)
+    {
+        --LLMeshRepository::sDecodeQueueDepth;
+    }
+    return posted;
+}
+
 const F32 ANIMATED_OBJECT_BASE_COST = 15.0f;
 const F32 ANIMATED_OBJECT_COST_PER_KTRI = 1.5f;
 
@@ -143,9 +143,19 @@ void LLSkinningUtil::initSkinningMatrixPalette(
 
     LLMatrix4a world[LL_CHARACTER_MAX_ANIMATED_JOINTS];
 
+    // joints that haven't moved since updateCharacterPose() are read from
+    // the flattened skeleton rather than asked one at a time
+    const LLFlatSkeleton& skeleton = avatar->getFlatSkeleton();
+
     for (S32 j = 0; j < count; ++j)
     {
         S32 joint_num = skin->mJointNums[j];
+        if (const LLMatrix4a* flat_world = skeleton.findWorldMatrix(joint_num))
+        {
+            world[j] = *flat_world;
+            continue;
+        }
+
         LLJoint *joint = avatar->getJoint(joint_num);
 
         if (joint)
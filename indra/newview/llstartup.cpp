@@ -1302,6 +1302,7 @@ bool idle_startup()
                 }
             }
             do_startup_frame();
+            LLAppViewer::instance()->reportLoginScreenShown();
             LLStartUp::setStartupState( STATE_LOGIN_WAIT );     // Wait for user input
         }
         else
@@ -3345,6 +3346,19 @@ bool idle_startup()
 
         LLUIUsage::instance().clear();
 
+        // Floaters slow to open the first time are built ahead, in the
+        // background
+        const LLSD pooled = gSavedSettings.getLLSD("PooledFloaters");
+        for (LLSD::array_const_iterator it = pooled.beginArray(); it != pooled.endArray(); ++it)
+        {
+            LLFloaterReg::setPooled(it->asString());
+        }
+        const LLSD prewarm = gSavedSettings.getLLSD("PrewarmFloaters");
+        for (LLSD::array_const_iterator it = prewarm.beginArray(); it != prewarm.endArray(); ++it)
+        {
+            LLFloaterReg::prewarmInstance(it->asString());
+        }
+
         LLPerfStats::StatsRecorder::setAutotuneInit();
 
         // Display Avatar Welcome Pack the first time a user logs in
@@ -55,6 +55,7 @@
 #include "lldrawpoolterrain.h"
 #include "lldrawable.h"
 #include "llworldmipmap.h"
+#include "workstealingqueue.h"
 
 extern LLPipeline gPipeline;
 extern bool gShiftFrame;
@@ -796,6 +797,39 @@ bool LLSurface::idleUpdate(F32 max_update_time)
         getRegion()->dirtyHeights();
     }
 
+    // The middle normals of a patch only need its own heights: work them out
+    // for all the dirty patches at once on the worker threads.  The edges
+    // and corners reach into the neighbors and are done by updateNormals().
+    std::vector<LLSurfacePatch*> middle_normals;
+    for (LLSurfacePatch* patchp : mDirtyPatchList)
+    {
+        if (patchp->hasInvalidMiddleNormals())
+        {
+            middle_normals.push_back(patchp);
+        }
+    }
+    if (!middle_normals.empty())
+    {
+        LL_PROFILE_ZONE_NAMED("surface middle normals");
+        auto update_middle_normals = [&middle_normals](size_t first, size_t last)
+        {
+            for (size_t i = first; i < last; ++i)
+            {
+                middle_normals[i]->updateMiddleNormals<PBR>();
+            }
+        };
+
+        LL::WorkQueue::ptr_t queue = LL::WorkQueue::getInstance("AvatarUpdate");
+        if (queue && middle_normals.size() > 1)
+        {
+            LL::parallel_for(*queue, 0, middle_normals.size(), 1, update_middle_normals);
+        }
+        else
+        {
+            update_middle_normals(0, middle_normals.size());
+        }
+    }
+
     // Always call updateNormals() / updateVerticalStats()
     //  every frame to avoid artifacts
     for(std::set<LLSurfacePatch *>::iterator iter = mDirtyPatchList.begin();
@@ -827,10 +861,22 @@ template bool LLSurface::idleUpdate</*PBR=*/true>(F32 max_update_time);
 
 void LLSurface::decompressDCTPatch(LLBitPack &bitpack, LLGroupHeader *gopp, bool b_large_patch)
 {
+    LL_PROFILE_ZONE_SCOPED;
+
+    // The bit stream has to be decoded in order, but each patch's IDCT only
+    // writes that patch's heights: decode all of them first, run the IDCTs
+    // on the worker threads, then update edges and stats here in order.
+    struct DecodedPatch
+    {
+        LLSurfacePatch* mPatchp;
+        LLPatchHeader   mHeader;
+        S32             mCoefficients[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE];
+    };
+    static std::vector<DecodedPatch> decoded;   // main thread only
+    decoded.clear();
 
     LLPatchHeader  ph;
     S32 j, i;
-    S32 patch[LARGE_PATCH_SIZE*LARGE_PATCH_SIZE];
     LLSurfacePatch *patchp;
 
     init_patch_decompressor(gopp->patch_size);
@@ -874,14 +920,56 @@ void LLSurface::decompressDCTPatch(LLBitPack &bitpack, LLGroupHeader *gopp, bool
                 << " quant_wbits " << (S32)ph.quant_wbits
                 << " patchids " << (S32)ph.patchids
                 << LL_ENDL;
-            return;
+            // the patches before it are still good
+            break;
         }
 
         patchp = &mPatchList[j*mPatchesPerEdge + i];
 
+        // a patch sent twice ends up with the last heights, as when they
+        // were decompressed one after the other
+        DecodedPatch* patch = NULL;
+        for (DecodedPatch& earlier : decoded)
+        {
+            if (earlier.mPatchp == patchp)
+            {
+                patch = &earlier;
+                break;
+            }
+        }
+        if (!patch)
+        {
+            decoded.emplace_back();
+            patch = &decoded.back();
+            patch->mPatchp = patchp;
+        }
+        patch->mHeader = ph;
+
+        decode_patch(bitpack, patch->mCoefficients);
+    }
 
-        decode_patch(bitpack, patch);
-        decompress_patch(patchp->getDataZ(), patch, &ph);
+    auto decompress = [gopp](size_t first, size_t last)
+    {
+        for (size_t k = first; k < last; ++k)
+        {
+            DecodedPatch& patch = decoded[k];
+            decompress_patch(patch.mPatchp->getDataZ(), patch.mCoefficients, &patch.mHeader, gopp);
+        }
+    };
+
+    LL::WorkQueue::ptr_t queue = LL::WorkQueue::getInstance("AvatarUpdate");
+    if (queue && decoded.size() > 1)
+    {
+        LL::parallel_for(*queue, 0, decoded.size(), 1, decompress);
+    }
+    else
+    {
+        decompress(0, decoded.size());
+    }
+
+    for (DecodedPatch& patch : decoded)
+    {
+        patchp = patch.mPatchp;
 
         // Update edges for neighbors.  Need to guarantee that this gets done before we generate vertical stats.
         patchp->updateNorthEdge();
@@ -53,6 +53,7 @@ LLSurfacePatch::LLSurfacePatch()
     mDirty(false),
     mDirtyZStats(true),
     mHeightsGenerated(false),
+    mMiddleNormalsUpdated(false),
     mDataOffset(0),
     mDataZ(NULL),
     mDataNorm(NULL),
@@ -96,6 +97,7 @@ void LLSurfacePatch::dirty()
     // texture being updated...
     if (mVObjp)
     {
+        mVObjp->clearGeomCache();
         mVObjp->dirtyGeom();
     }
     else
@@ -674,6 +676,16 @@ void LLSurfacePatch::updateVerticalStats()
     {
         mVObjp->dirtyPatch();
     }
+    // The neighbors' edges, and the strips stitching them to this patch,
+    // reach into its heights and normals.
+    for (U32 i = 0; i < 8; i++)
+    {
+        LLSurfacePatch* neighbor = getNeighborPatch(i);
+        if (neighbor && neighbor->mVObjp.notNull())
+        {
+            neighbor->mVObjp->clearGeomCache();
+        }
+    }
     mDirtyZStats = false;
 }
 
@@ -873,16 +885,11 @@ void LLSurfacePatch::updateNormals()
         dirty_patch = true;
     }
 
-    // update the middle normals
-    if (mNormalsInvalid[MIDDLE])
+    // update the middle normals, unless LLSurface::idleUpdate() already has
+    updateMiddleNormals<PBR>();
+    if (mMiddleNormalsUpdated)
     {
-        for (j=2; j < grids_per_patch_edge - 2; j++)
-        {
-            for (i=2; i < grids_per_patch_edge - 2; i++)
-            {
-                calcNormal<PBR>(i, j, 2);
-            }
-        }
+        mMiddleNormalsUpdated = false;
         dirty_patch = true;
     }
 
@@ -900,6 +907,94 @@ void LLSurfacePatch::updateNormals()
 template void LLSurfacePatch::updateNormals</*PBR=*/false>();
 template void LLSurfacePatch::updateNormals</*PBR=*/true>();
 
+// Normals at (x, y), ... (x + 3, y) with a stride of 2, as calcNormal<false>()
+// computes them, for points at least 2 away from the patch edges: the four
+// heights around each point are in the patch, no neighbors involved.
+static void calc_middle_normals4(const F32* data_z, LLVector3* data_norm, U32 x, U32 y, U32 surface_stride, F32 mpg)
+{
+    const F32* south = data_z + (y - 2) * surface_stride + x;
+    const F32* north = data_z + (y + 2) * surface_stride + x;
+
+    LLVector4a z00, z01, z10, z11;
+    z00.loadua(south - 2);
+    z10.loadua(south + 2);
+    z01.loadua(north - 2);
+    z11.loadua(north + 2);
+
+    // c1 = p11 - p00 = (2mpg, 2mpg, a), c2 = p01 - p10 = (-2mpg, 2mpg, b)
+    LLVector4a a, b;
+    a.setSub(z11, z00);
+    b.setSub(z01, z10);
+    LLVector4a two_mpg;
+    two_mpg.splat(2.f * mpg);
+
+    // normal = c1 % c2, a lane per point
+    LLVector4a nx, ny, nz, t;
+    nx.setMul(two_mpg, b);
+    t.setMul(a, two_mpg);
+    nx.sub(t);
+    ny.setMul(a, two_mpg);
+    ny.mul(-1.f);
+    t.setMul(two_mpg, b);
+    ny.sub(t);
+    nz.splat(8.f * mpg * mpg);
+
+    LLVector4a len;
+    len.setMul(nx, nx);
+    t.setMul(ny, ny);
+    len.add(t);
+    t.setMul(nz, nz);
+    len.add(t);
+    len = _mm_sqrt_ps(len);
+
+    // the z term alone keeps the length above FP_MAG_THRESHOLD
+    LLVector4a oolen;
+    oolen.splat(1.f);
+    oolen.div(len);
+    nx.mul(oolen);
+    ny.mul(oolen);
+    nz.mul(oolen);
+
+    LLVector3* normal = data_norm + y * surface_stride + x;
+    for (U32 i = 0; i < 4; ++i)
+    {
+        normal[i].set(nx[i], ny[i], nz[i]);
+    }
+}
+
+template<bool PBR>
+void LLSurfacePatch::updateMiddleNormals()
+{
+    if (!mNormalsInvalid[MIDDLE] || mSurfacep->mType == 'w')
+    {
+        return;
+    }
+    const U32 grids_per_patch_edge = mSurfacep->getGridsPerPatchEdge();
+    const U32 surface_stride = mSurfacep->getGridsPerEdge();
+    const F32 mpg = mSurfacep->getMetersPerGrid() * 2;
+
+    for (U32 j = 2; j < grids_per_patch_edge - 2; j++)
+    {
+        U32 i = 2;
+        if (!PBR)
+        {
+            for (; i + 4 <= grids_per_patch_edge - 2; i += 4)
+            {
+                calc_middle_normals4(mDataZ, mDataNorm, i, j, surface_stride, mpg);
+            }
+        }
+        for (; i < grids_per_patch_edge - 2; i++)
+        {
+            calcNormal<PBR>(i, j, 2);
+        }
+    }
+    mNormalsInvalid[MIDDLE] = false;
+    mMiddleNormalsUpdated = true;
+}
+
+template void LLSurfacePatch::updateMiddleNormals</*PBR=*/false>();
+template void LLSurfacePatch::updateMiddleNormals</*PBR=*/true>();
+
 void LLSurfacePatch::updateEastEdge()
 {
     U32 grids_per_patch_edge = mSurfacep->getGridsPerPatchEdge();
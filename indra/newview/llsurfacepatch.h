@@ -79,6 +79,12 @@ public:
     void updateCompositionStats();
     template<bool PBR>
     void updateNormals();
+    // The normals that only depend on this patch's heights, if they need
+    // updating.  Touches nothing outside the patch, so patches may do this
+    // on different threads; updateNormals() does the rest.
+    template<bool PBR>
+    void updateMiddleNormals();
+    bool hasInvalidMiddleNormals() const { return mNormalsInvalid[MIDDLE]; }
 
     void updateEastEdge();
     void updateNorthEdge();
@@ -161,6 +167,7 @@ protected:
     bool mDirty;
     bool mDirtyZStats;
     bool mHeightsGenerated;
+    bool mMiddleNormalsUpdated; // by updateMiddleNormals() since updateNormals()
 
     U32 mDataOffset;
     F32 *mDataZ;
@@ -195,6 +202,8 @@ protected:
 
 extern template void LLSurfacePatch::updateNormals</*PBR=*/false>();
 extern template void LLSurfacePatch::updateNormals</*PBR=*/true>();
+extern template void LLSurfacePatch::updateMiddleNormals</*PBR=*/false>();
+extern template void LLSurfacePatch::updateMiddleNormals</*PBR=*/true>();
 
 
 #endif // LL_LLSURFACEPATCH_H
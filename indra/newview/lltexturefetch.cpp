@@ -60,6 +60,7 @@
 #include "httpresponse.h"
 #include "bufferarray.h"
 #include "bufferstream.h"
+#include "httpstats.h"
 #include "llcorehttputil.h"
 #include "llhttpretrypolicy.h"
 #include "fsassetblacklist.h" //For Asset blacklist
@@ -247,6 +248,11 @@ static const S32 HTTP_REQUESTS_RANGE_END_MAX = 20000000;
 static const S32 MAX_CAP_MISSING_RETRIES = 720;
 static const S32 CAP_MISSING_EXPIRATION_DELAY = 1; // seconds
 
+// An HTTP request still waiting for a connection is moved in llcorehttp's
+// ready queue once its texture's priority (its virtual size) changes by more
+// than this factor, e.g. when the camera turns towards or away from it.
+static const F32 HTTP_REPRIORITIZE_FACTOR = 2.f;
+
 //////////////////////////////////////////////////////////////////////////////
 namespace
 {
@@ -261,6 +267,12 @@ namespace
     // "delete" derives from Latin "deletus"
     void NoOpDeletor(LLCore::HttpHandler *)
     { /*NoOp*/ }
+
+    // llcorehttp priority of a texture fetch, its virtual size in pixels
+    LLCore::HttpRequest::priority_t http_priority(F32 image_priority)
+    {
+        return (LLCore::HttpRequest::priority_t) llclamp(image_priority, 0.f, 1.e9f);
+    }
 }
 
 static const char* e_state_name[] =
@@ -470,6 +482,12 @@ private:
     // Locks:  Mw
     void setImagePriority(F32 priority);
 
+    // Moves a waiting HTTP request in llcorehttp's ready queue if the
+    // image priority changed enough since it was issued.
+    // Locks:  Mw
+    // Threads:  Ttf
+    void updateHttpPriority();
+
     // Locks:  Mw (ctor invokes without lock)
     void setDesiredDiscard(S32 discard, S32 size);
 
@@ -634,6 +652,7 @@ private:
     LLCore::BufferArray *   mHttpBufferArray;           // Refcounted pointer to response data
     S32                     mHttpPolicyClass;
     bool                    mHttpActive;                // Active request to http library
+    F32                     mHttpPriority;              // mImagePriority the active request was queued with
     U32                     mHttpReplySize,             // Actual received data size
                             mHttpReplyOffset;           // Actual received data offset
     bool                    mHttpHasResource;           // Counts against Fetcher's mHttpSemaphore
@@ -953,6 +972,7 @@ LLTextureFetchWorker::LLTextureFetchWorker(LLTextureFetch* fetcher,
       mHttpBufferArray(NULL),
       mHttpPolicyClass(mFetcher->mHttpPolicyClass),
       mHttpActive(false),
+      mHttpPriority(0.f),
       mHttpReplySize(0U),
       mHttpReplyOffset(0U),
       mHttpHasResource(false),
@@ -1100,6 +1120,24 @@ void LLTextureFetchWorker::setImagePriority(F32 priority)
     mImagePriority = priority; //should map to max virtual size, abort if zero
 }
 
+// Locks:  Mw
+// Threads:  Ttf
+void LLTextureFetchWorker::updateHttpPriority()
+{
+    if (!mHttpActive || mState != WAIT_HTTP_REQ || LLCORE_HTTP_HANDLE_INVALID == mHttpHandle)
+    {
+        return;
+    }
+    if (mImagePriority > mHttpPriority * HTTP_REPRIORITIZE_FACTOR
+        || mImagePriority * HTTP_REPRIORITIZE_FACTOR < mHttpPriority)
+    {
+        // Only reorders the request if it hasn't got a connection yet
+        mHttpPriority = mImagePriority;
+        mFetcher->mHttpRequest->requestSetPriority(mHttpHandle, http_priority(mHttpPriority),
+                                                   LLCore::HttpHandler::ptr_t());
+    }
+}
+
 // Locks:  Mw
 void LLTextureFetchWorker::resetFormattedData()
 {
@@ -1677,6 +1715,12 @@ bool LLTextureFetchWorker::doWork(S32 param)
             return true; // failed
         }
 
+        // The shared options can't carry a per request priority:  queue it
+        // right behind the request, before the policy thread gets to it.
+        mHttpPriority = mImagePriority;
+        mFetcher->mHttpRequest->requestSetPriority(mHttpHandle, http_priority(mHttpPriority),
+                                                   LLCore::HttpHandler::ptr_t());
+
         mHttpActive = true;
         mFetcher->addToHTTPQueue(mID);
         recordTextureStart(true);
@@ -1886,7 +1930,10 @@ bool LLTextureFetchWorker::doWork(S32 param)
                 // Copy previously collected data into buffer
                 memcpy(buffer, mFormattedImage->getData(), cur_size);
             }
+            // Image data must live in an aligned buffer owned by the
+            // formatted image so this is the one copy out of the body.
             mHttpBufferArray->read(src_offset, (char *) buffer + cur_size, append_size);
+            LLCore::HTTPStats::instance().recordBodyBytesCopied(append_size);
 
             // NOTE: setData releases current data and owns new data (buffer)
             mFormattedImage->setData(buffer, total_size);
@@ -3177,6 +3224,7 @@ bool LLTextureFetch::updateRequestPriority(const LLUUID& id, F32 priority)
             {
                 worker->lockWorkMutex();                                        // +Mw
                 worker->setImagePriority(priority);
+                worker->updateHttpPriority();
                 worker->unlockWorkMutex();                                      // -Mw
             }
         });
@@ -77,6 +77,7 @@
 #include "llfloaterfixedenvironment.h"
 #include "llfloaterfonttest.h"
 #include "llfloaterforgetuser.h"
+#include "llfloaterframespikes.h"
 #include "llfloatergesture.h"
 #include "llfloatergltfasseteditor.h"
 #include "llfloatergodtools.h"
@@ -460,6 +461,7 @@ void LLViewerFloaterReg::registerFloaters()
 
     LLFloaterReg::add("font_test", "floater_font_test.xml", (LLFloaterBuildFunc)&LLFloaterReg::build<LLFloaterFontTest>);
     //LLFloaterReg::add("forget_username", "floater_forget_user.xml", (LLFloaterBuildFunc)&LLFloaterReg::build<LLFloaterForgetUser>);
+    LLFloaterReg::add("frame_spikes", "floater_frame_spikes.xml", (LLFloaterBuildFunc)&LLFloaterReg::build<LLFloaterFrameSpikes>);
 
     LLFloaterReg::add("gestures", "floater_gesture.xml", (LLFloaterBuildFunc)&LLFloaterReg::build<LLFloaterGesture>);
     LLFloaterReg::add("gltf_asset_editor", "floater_gltf_asset_editor.xml", (LLFloaterBuildFunc)&LLFloaterReg::build<LLFloaterGLTFAssetEditor>);
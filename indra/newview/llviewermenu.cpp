@@ -2379,6 +2379,9 @@ class LLAdvancedToggleDebugJointUpdates : public view_listener_t
     bool handleEvent(const LLSD& userdata)
     {
         LLVOAvatar::sJointDebug = !(LLVOAvatar::sJointDebug);
+        LLJoint::sCountUpdates = LLVOAvatar::sJointDebug;
+        LLJoint::sNumUpdates = 0;
+        LLJoint::sNumTouches = 0;
         return true;
     }
 };
@@ -11039,6 +11042,11 @@ void handle_dump_timers()
     LLTrace::BlockTimer::dumpCurTimes();
 }
 
+void handle_dump_frame_profile()
+{
+    LLAppViewer::instance()->dumpFrameProfile("requested from the menu");
+}
+
 void handle_debug_avatar_textures()
 {
     LLViewerObject* objectp = LLSelectMgr::getInstance()->getSelection()->getPrimaryObject();
@@ -12868,6 +12876,7 @@ void initialize_menus()
     view_listener_t::addMenu(new LLAdvancedDumpSelectMgr(), "Advanced.DumpSelectMgr");
     view_listener_t::addMenu(new LLAdvancedDumpInventory(), "Advanced.DumpInventory");
     commit.add("Advanced.DumpTimers", boost::bind(&handle_dump_timers) );
+    commit.add("Advanced.DumpFrameProfile", boost::bind(&handle_dump_frame_profile) );
     commit.add("Advanced.DumpFocusHolder", boost::bind(&handle_dump_focus) );
     view_listener_t::addMenu(new LLAdvancedPrintSelectedObjectInfo(), "Advanced.PrintSelectedObjectInfo");
     view_listener_t::addMenu(new LLAdvancedPrintAgentInfo(), "Advanced.PrintAgentInfo");
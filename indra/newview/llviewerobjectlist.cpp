@@ -1028,7 +1028,8 @@ void LLViewerObjectList::update(LLAgent &agent)
     if (freezeTime)
     // </FS:Ansariel> Speed up debug settings
     {
-
+        // avatars evaluate their poses together at the end
+        LLVOAvatar::beginPoseBatch();
         for (std::vector<LLViewerObject*>::iterator iter = idle_list.begin();
             iter != idle_end; iter++)
         {
@@ -1038,9 +1039,11 @@ void LLViewerObjectList::update(LLAgent &agent)
                 objectp->idleUpdate(agent, frame_time);
             }
         }
+        LLVOAvatar::endPoseBatch();
     }
     else
     {
+        LLVOAvatar::beginPoseBatch();
         for (std::vector<LLViewerObject*>::iterator idle_iter = idle_list.begin();
             idle_iter != idle_end; idle_iter++)
         {
@@ -1048,6 +1051,8 @@ void LLViewerObjectList::update(LLAgent &agent)
             llassert(objectp->isActive());
                 objectp->idleUpdate(agent, frame_time);
         }
+        // before the flexible objects, which follow the attachment points
+        LLVOAvatar::endPoseBatch();
 
         //update flexible objects
         LLVolumeImplFlexible::updateClass();
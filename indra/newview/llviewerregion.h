@@ -407,6 +407,8 @@ public:
 
     LLVOCacheEntry* getCacheEntryForOctree(U32 local_id);
     LLVOCacheEntry* getCacheEntry(U32 local_id, bool valid = true);
+    // All cached entries, for read only walks (see LLVOCachePrefetcher).
+    const std::map<U32, LLPointer<LLVOCacheEntry> >& getCacheEntries() const;
     bool probeCache(U32 local_id, U32 crc, U32 flags, U8 &cache_miss_type);
     U64 getRegionCacheHitCount() { return mRegionCacheHitCount; }
     U64 getRegionCacheMissCount() { return mRegionCacheMissCount; }
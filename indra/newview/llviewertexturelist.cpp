@@ -98,6 +98,7 @@ LLTextureKey::LLTextureKey(LLUUID id, ETexListType tex_type)
 
 LLViewerTextureList::LLViewerTextureList()
     : mForceResetTextureStats(false),
+    mLastUpdateSlot(0),
     mInitialized(false)
 {
 }
@@ -367,6 +368,7 @@ void LLViewerTextureList::shutdown()
     mFastCacheList.clear();
 
     mUUIDMap.clear();
+    mLastUpdateSlot = 0;
 
     mImageList.clear();
 
@@ -683,12 +685,13 @@ LLViewerFetchedTexture* LLViewerTextureList::createImage(const LLUUID &image_id,
 void LLViewerTextureList::findTexturesByID(const LLUUID &image_id, std::vector<LLViewerFetchedTexture*> &output)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_TEXTURE;
-    LLTextureKey search_key(image_id, TEX_LIST_STANDARD);
-    uuid_map_t::iterator iter = mUUIDMap.lower_bound(search_key);
-    while (iter != mUUIDMap.end() && iter->first.textureId == image_id)
+    for (ETexListType tex_type : { TEX_LIST_STANDARD, TEX_LIST_SCALE })
     {
-        output.push_back(iter->second);
-        iter++;
+        uuid_map_t::iterator iter = mUUIDMap.find(LLTextureKey(image_id, tex_type));
+        if (iter != mUUIDMap.end())
+        {
+            output.push_back(iter->second);
+        }
     }
 }
 
@@ -1239,6 +1242,7 @@ F32 LLViewerTextureList::updateImagesFetchTextures(F32 max_time)
 
     typedef std::vector<LLPointer<LLViewerFetchedTexture> > entries_list_t;
     entries_list_t entries;
+    std::vector<size_t> entry_slots;
 
     // update N textures at beginning of mImageList
     U32 update_count = 0;
@@ -1268,7 +1272,8 @@ F32 LLViewerTextureList::updateImagesFetchTextures(F32 max_time)
 
         // copy entries out of UUID map for updating
         entries.reserve(update_count);
-        uuid_map_t::iterator iter = mUUIDMap.upper_bound(mLastUpdateKey);
+        entry_slots.reserve(update_count);
+        uuid_map_t::iterator iter = mUUIDMap.iterAt(mLastUpdateSlot + 1);
         while (update_count-- > 0)
         {
             if (iter == mUUIDMap.end())
@@ -1279,6 +1284,7 @@ F32 LLViewerTextureList::updateImagesFetchTextures(F32 max_time)
             if (iter->second->getGLTexture())
             {
                 entries.push_back(iter->second);
+                entry_slots.push_back(iter.getSlot());
             }
             ++iter;
         }
@@ -1286,9 +1292,11 @@ F32 LLViewerTextureList::updateImagesFetchTextures(F32 max_time)
 
     LLTimer timer;
 
-    for (auto& imagep : entries)
+    for (size_t i = 0; i < entries.size(); ++i)
     {
-        mLastUpdateKey = LLTextureKey(imagep->getID(), (ETexListType)imagep->getTextureListType());
+        // slots move when the map grows, which only costs some fairness
+        mLastUpdateSlot = entry_slots[i];
+        LLViewerFetchedTexture* imagep = entries[i];
 
         if (imagep->getNumRefs() > 1) // make sure this image hasn't been deleted before attempting to update (may happen as a side effect of some other image updating)
         {
@@ -28,6 +28,7 @@
 #define LL_LLVIEWERTEXTURELIST_H
 
 #include "lluuid.h"
+#include "lluuidflatmap.h"
 //#include "message.h"
 #include "llgl.h"
 #include "llviewertexture.h"
@@ -83,8 +84,25 @@ struct LLTextureKey
             return key1.textureType < key2.textureType;
         }
     }
+
+    friend bool operator==(const LLTextureKey& key1, const LLTextureKey& key2)
+    {
+        return key1.textureId == key2.textureId && key1.textureType == key2.textureType;
+    }
 };
 
+namespace std
+{
+    template<> struct hash<LLTextureKey>
+    {
+        size_t operator()(const LLTextureKey& key) const noexcept
+        {
+            // both list types of an id land next to each other
+            return std::hash<LLUUID>()(key.textureId) + key.textureType;
+        }
+    };
+}
+
 class LLViewerTextureList
 {
     friend class LLTextureView;
@@ -236,9 +254,9 @@ public:
     static U32 sNumFastCacheReads;
 
 private:
-    typedef std::map< LLTextureKey, LLPointer<LLViewerFetchedTexture> > uuid_map_t;
+    typedef LLUUIDFlatMap<LLPointer<LLViewerFetchedTexture>, LLTextureKey> uuid_map_t;
     uuid_map_t mUUIDMap;
-    LLTextureKey mLastUpdateKey;
+    size_t mLastUpdateSlot; // round robin position in mUUIDMap for updateImagesFetchTextures()
 
     image_list_t mImageList;
 
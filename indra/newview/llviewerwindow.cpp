@@ -185,6 +185,7 @@
 #include "llviewershadermgr.h"
 #include "llviewerstats.h"
 #include "llvoavatarself.h"
+#include "llvocacheprefetch.h"
 #include "llvopartgroup.h"
 #include "llvovolume.h"
 #include "llworld.h"
@@ -766,6 +767,15 @@ public:
                 addText(xpos, ypos, llformat("%d/%d Mesh LOD Pending/Processing", LLMeshRepository::sLODPending, LLMeshRepository::sLODProcessing));
                 ypos += y_inc;
 
+                addText(xpos, ypos, llformat("%d/%.1f/%.1f Mesh Decode Queued/Avg ms/Max ms", LLMeshRepository::sDecodeQueueDepth.load(),
+                    LLMeshRepository::getDecodeLatencyAvgMs(), LLMeshRepository::sDecodeLatencyMax.load() / 1000.f));
+                ypos += y_inc;
+
+                LLVOCachePrefetcher* prefetcher = LLVOCachePrefetcher::getInstance();
+                addText(xpos, ypos, llformat("%d/%d/%.0f%% Cache Prefetch Pending/Issued/Hit", prefetcher->getPendingCount(),
+                    prefetcher->getIssuedCount(), prefetcher->getHitRate() * 100.f));
+                ypos += y_inc;
+
                 // <FS:Ansariel> Mesh debugging
                 addText(xpos, ypos, llformat("%d Mesh Active LOD Requests", LLMeshRepoThread::sActiveLODRequests.load()));
                 ypos += y_inc;
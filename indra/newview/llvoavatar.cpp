@@ -53,6 +53,7 @@
 #include "llcallingcard.h"      // IDEVO for LLAvatarTracker
 #include "lldrawpoolavatar.h"
 #include "lldriverparam.h"
+#include "llpolymesh.h"
 #include "llpolyskeletaldistortion.h"
 #include "lleditingmotion.h"
 #include "llemote.h"
@@ -95,6 +96,7 @@
 #include "llvoavatarself.h"
 #include "llvovolume.h"
 #include "llworld.h"
+#include "workstealingqueue.h"
 #include "pipeline.h"
 #include "llviewershadermgr.h"
 #include "llsky.h"
@@ -649,6 +651,8 @@ bool LLVOAvatar::sVisibleInFirstPerson = false;
 F32 LLVOAvatar::sLODFactor = 1.f;
 F32 LLVOAvatar::sPhysicsLODFactor = 1.f;
 bool LLVOAvatar::sJointDebug            = false;
+bool LLVOAvatar::sPoseBatching = false;
+std::vector<LLPointer<LLVOAvatar> > LLVOAvatar::sPoseBatch;
 F32 LLVOAvatar::sUnbakedTime = 0.f;
 F32 LLVOAvatar::sUnbakedUpdateTime = 0.f;
 F32 LLVOAvatar::sGreyTime = 0.f;
@@ -714,6 +718,8 @@ LLVOAvatar::LLVOAvatar(const LLUUID& id,
     mCulled( false ),
     mVisibilityRank(0),
     mNeedsSkin(false),
+    mEvaluatingPose(false),
+    mVisualParamsPending(false),
     mLastSkinTime(0.f),
     mUpdatePeriod(1),
     mOverallAppearance(AOA_INVISIBLE),
@@ -3207,7 +3213,30 @@ void LLVOAvatar::idleUpdate(LLAgent &agent, const F64 &time)
     // animate the character
     // store off last frame's root position to be consistent with camera position
     mLastRootPos = mRoot->getWorldPosition();
+    if (sPoseBatching && isPoseBatchable())
+    {
+        if (prepareCharacterUpdate(agent))
+        {
+            // the pose is evaluated with the others' and the rest done in endPoseBatch()
+            sPoseBatch.push_back(this);
+            return;
+        }
+        idleUpdateCommit(finishCharacterUpdate());
+        return;
+    }
+
     bool detailed_update = updateCharacter(agent);
+    idleUpdateCommit(detailed_update);
+}
+
+//------------------------------------------------------------------------
+// idleUpdateCommit()
+// Everything idleUpdate() does once the character is updated: whatever
+// has side effects outside this avatar, always on the main thread.
+//------------------------------------------------------------------------
+void LLVOAvatar::idleUpdateCommit(bool detailed_update)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
 
     static LLUICachedControl<bool> visualizers_in_calls("ShowVoiceVisualizersInCalls", false);
     bool voice_enabled = (visualizers_in_calls || LLVoiceClient::getInstance()->inProximalChannel()) &&
@@ -3385,12 +3414,13 @@ void LLVOAvatar::idleUpdateMisc(bool detailed_update)
     LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
     if (LLVOAvatar::sJointDebug)
     {
+        // a batched avatar's pose was counted with the batch, see
+        // endPoseBatch(): this is what it touched on the main thread
         LL_INFOS() << getDebugName() << ": joint touches: " << LLJoint::sNumTouches << " updates: " << LLJoint::sNumUpdates << LL_ENDL;
+        LLJoint::sNumUpdates = 0;
+        LLJoint::sNumTouches = 0;
     }
 
-    LLJoint::sNumUpdates = 0;
-    LLJoint::sNumTouches = 0;
-
     bool visible = isVisible() || mNeedsAnimUpdate;
 
     // update attachments positions
@@ -5659,6 +5689,23 @@ bool LLVOAvatar::computeNeedsUpdate()
 //------------------------------------------------------------------------
 bool LLVOAvatar::updateCharacter(LLAgent &agent)
 {
+    if (prepareCharacterUpdate(agent))
+    {
+        updateCharacterPose();
+    }
+    return finishCharacterUpdate();
+}
+
+//------------------------------------------------------------------------
+// prepareCharacterUpdate()
+// Everything updateCharacter() does before evaluating the motions.
+// Returns true if there is a pose to evaluate, and finishCharacterUpdate()
+// to call after it.
+//------------------------------------------------------------------------
+bool LLVOAvatar::prepareCharacterUpdate(LLAgent &agent)
+{
+    mPoseUpdate.mActive = false;
+
     updateDebugText();
 
     if (!mIsBuilt)
@@ -5760,20 +5807,40 @@ bool LLVOAvatar::updateCharacter(LLAgent &agent)
     // update animations
     if (!visible && !isSelf()) // NOTE: never do a "hidden update" for self avatar as it interrupts controller processing
     {
-        updateMotions(LLCharacter::HIDDEN_UPDATE);
+        mPoseUpdate.mUpdateType = LLCharacter::HIDDEN_UPDATE;
     }
     else if (mSpecialRenderMode == 1) // Animation Preview
     {
-        updateMotions(LLCharacter::FORCE_UPDATE);
+        mPoseUpdate.mUpdateType = LLCharacter::FORCE_UPDATE;
     }
     else
     {
         // Might be better to do HIDDEN_UPDATE if cloud
-        updateMotions(LLCharacter::NORMAL_UPDATE);
+        mPoseUpdate.mUpdateType = LLCharacter::NORMAL_UPDATE;
+    }
+    mPoseUpdate.mEvaluate = prepareMotions(mPoseUpdate.mUpdateType);
+    mPoseUpdate.mVisible = visible;
+    mPoseUpdate.mWasSitGroundConstrained = was_sit_ground_constrained;
+    mPoseUpdate.mActive = true;
+    return true;
+}
+
+//------------------------------------------------------------------------
+// updateCharacterPose()
+// Evaluates the motions and updates the skeleton.  In a pose batch this
+// runs on the AvatarUpdate thread pool: it must not touch anything but
+// this avatar's motions and joints.
+//------------------------------------------------------------------------
+void LLVOAvatar::updateCharacterPose()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    if (mPoseUpdate.mEvaluate)
+    {
+        evaluateMotions(mPoseUpdate.mUpdateType);
     }
 
     // Special handling for sitting on ground.
-    if (!getParent() && (isSitting() || was_sit_ground_constrained))
+    if (!getParent() && (isSitting() || mPoseUpdate.mWasSitGroundConstrained))
     {
 
         F32 off_z = (F32)LLVector3d(getHoverOffset()).mdV[VZ];
@@ -5787,22 +5854,133 @@ bool LLVOAvatar::updateCharacter(LLAgent &agent)
         }
     }
 
+    // Update child joints as needed, in one pass over the flattened
+    // skeleton.
+    mFlatSkeleton.update(mRoot);
+}
+
+//------------------------------------------------------------------------
+// finishCharacterUpdate()
+// Everything updateCharacter() does after evaluating the motions.
+// Returns true if the avatar is visible.
+//------------------------------------------------------------------------
+bool LLVOAvatar::finishCharacterUpdate()
+{
+    if (!mPoseUpdate.mActive)
+    {
+        return false;
+    }
+    mPoseUpdate.mActive = false;
+
+    // what the motions asked for while evaluated in a batch
+    if (mVisualParamsPending)
+    {
+        mVisualParamsPending = false;
+        updateVisualParams();
+    }
+    if (!mPendingMotions.empty())
+    {
+        std::vector<std::pair<LLUUID, F32> > motions;
+        motions.swap(mPendingMotions);
+        for (const auto& motion : motions)
+        {
+            startMotion(motion.first, motion.second);
+        }
+    }
+
     // update head position
     updateHeadOffset();
 
     // Generate footstep sounds when feet hit the ground
     updateFootstepSounds();
 
-    // Update child joints as needed.
-    mRoot->updateWorldMatrixChildren();
-
-    if (visible)
+    if (mPoseUpdate.mVisible)
     {
         // System avatar mesh vertices need to be reskinned.
         mNeedsSkin = true;
     }
 
-    return visible;
+    return mPoseUpdate.mVisible;
+}
+
+//------------------------------------------------------------------------
+// isPoseBatchable()
+// Whether this avatar's pose can be evaluated along with the others': not
+// our own, whose motions talk to the agent, nor a UI avatar, nor animesh
+// attached to an avatar, which follows its attachment point.
+//------------------------------------------------------------------------
+bool LLVOAvatar::isPoseBatchable()
+{
+    return !isSelf() && !isUIAvatar() && !getAttachedAvatar();
+}
+
+//------------------------------------------------------------------------
+// beginPoseBatch()
+// From here to endPoseBatch(), idleUpdate() only prepares the avatars it
+// can batch.
+//------------------------------------------------------------------------
+//static
+void LLVOAvatar::beginPoseBatch()
+{
+    static LLCachedControl<bool> parallel_update(gSavedSettings, "AvatarParallelUpdate", true);
+    sPoseBatching = parallel_update;
+}
+
+//------------------------------------------------------------------------
+// endPoseBatch()
+// Evaluates the poses of the avatars prepared since beginPoseBatch() on
+// the AvatarUpdate thread pool, then finishes their idleUpdate() here.
+//------------------------------------------------------------------------
+//static
+void LLVOAvatar::endPoseBatch()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    sPoseBatching = false;
+    if (sPoseBatch.empty())
+    {
+        return;
+    }
+
+    auto update_poses = [](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            LLVOAvatar* avatar = sPoseBatch[i];
+            if (!avatar->isDead())
+            {
+                avatar->mEvaluatingPose = true;
+                avatar->updateCharacterPose();
+                avatar->mEvaluatingPose = false;
+            }
+        }
+    };
+
+    LL::WorkQueue::ptr_t queue = LL::WorkQueue::getInstance("AvatarUpdate");
+    if (queue && sPoseBatch.size() > 1)
+    {
+        LL::parallel_for(*queue, 0, sPoseBatch.size(), 1, update_poses);
+    }
+    else
+    {
+        update_poses(0, sPoseBatch.size());
+    }
+
+    if (sJointDebug)
+    {
+        LL_INFOS() << "pose batch of " << sPoseBatch.size() << " avatars: joint touches: " << LLJoint::sNumTouches
+                   << " updates: " << LLJoint::sNumUpdates << LL_ENDL;
+        LLJoint::sNumUpdates = 0;
+        LLJoint::sNumTouches = 0;
+    }
+
+    for (LLVOAvatar* avatar : sPoseBatch)
+    {
+        if (!avatar->isDead())
+        {
+            avatar->idleUpdateCommit(avatar->finishCharacterUpdate());
+        }
+    }
+    sPoseBatch.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -7194,6 +7372,13 @@ LLUUID LLVOAvatar::remapMotionID(const LLUUID& id)
 // virtual
 bool LLVOAvatar::startMotion(const LLUUID& id, F32 time_offset)
 {
+    if (mEvaluatingPose)
+    {
+        // loading the motion waits for finishCharacterUpdate(), on the main thread
+        mPendingMotions.emplace_back(id, time_offset);
+        return true;
+    }
+
     LL_DEBUGS("Motion") << "motion requested " << id.asString() << " " << gAnimLibrary.animationName(id) << LL_ENDL;
 
     // <FS:Zi> Animation Overrider
@@ -8034,6 +8219,15 @@ void LLVOAvatar::getGround(const LLVector3 &in_pos_agent, LLVector3 &out_pos_age
         return;
     }
 
+    // the ray casts may build octrees of the objects they hit: poses
+    // evaluated in a batch cast them one at a time
+    static std::mutex sGroundMutex;
+    std::unique_lock<std::mutex> lock(sGroundMutex, std::defer_lock);
+    if (mEvaluatingPose)
+    {
+        lock.lock();
+    }
+
     p0_global = gAgent.getPosGlobalFromAgent(in_pos_agent) + z_vec;
     p1_global = gAgent.getPosGlobalFromAgent(in_pos_agent) - z_vec;
     LLViewerObject *obj;
@@ -8200,6 +8394,13 @@ void LLVOAvatar::initAttachmentPoints(bool ignore_hud_joints)
 //-----------------------------------------------------------------------------
 void LLVOAvatar::updateVisualParams()
 {
+    if (mEvaluatingPose)
+    {
+        // may start motions and dirty the mesh: wait for finishCharacterUpdate()
+        mVisualParamsPending = true;
+        return;
+    }
+
     ESex avatar_sex = (getVisualParamWeight("male") > 0.5f) ? SEX_MALE : SEX_FEMALE;
     if (getSex() != avatar_sex)
     {
@@ -8221,7 +8422,11 @@ void LLVOAvatar::updateVisualParams()
         }
     }
 
+    // the morphs add up on each mesh, which is then renormalized once, and
+    // the meshes are morphed in parallel
+    LLPolyMesh::beginMorphBatch();
     LLCharacter::updateVisualParams();
+    LLPolyMesh::endMorphBatch(LL::WorkQueue::getInstance("AvatarUpdate").get());
 
     if (mLastSkeletonSerialNum != mSkeletonSerialNum)
     {
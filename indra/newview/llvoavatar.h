@@ -41,6 +41,7 @@
 #include "llviewerobject.h"
 #include "llcharacter.h"
 #include "llcontrol.h"
+#include "llflatskeleton.h"
 #include "llviewerjointmesh.h"
 #include "llviewerjointattachment.h"
 #include "llrendertarget.h"
@@ -277,12 +278,27 @@ public:
     virtual void    updateDebugText();
     virtual bool    computeNeedsUpdate();
     virtual bool    updateCharacter(LLAgent &agent);
+
+    // updateCharacter() in three phases, so the poses of the avatars
+    // updated between beginPoseBatch() and endPoseBatch() can be evaluated
+    // together on the "AvatarUpdate" thread pool.  prepareCharacterUpdate()
+    // and finishCharacterUpdate() run on the main thread; in a batch,
+    // updateCharacterPose() runs on any thread and only touches this
+    // avatar's motions and joints, leaving motion starts and visual param
+    // updates to finishCharacterUpdate().
+    bool            prepareCharacterUpdate(LLAgent &agent);
+    void            updateCharacterPose();
+    bool            finishCharacterUpdate();
+    static void     beginPoseBatch();
+    static void     endPoseBatch();
+
     void            updateFootstepSounds();
     void            computeUpdatePeriod();
     void            updateOrientation(LLAgent &agent, F32 speed, F32 delta_time);
     void            updateTimeStep();
     void            updateRootPositionAndRotation(LLAgent &agent, F32 speed, bool was_sit_ground_constrained);
 
+    void            idleUpdateCommit(bool detailed_update);
     void            idleUpdateVoiceVisualizer(bool voice_enabled, const LLVector3 &position);
     void            idleUpdateMisc(bool detailed_update);
     virtual void    idleUpdateAppearanceAnimation();
@@ -381,7 +397,30 @@ public:
     static bool     sShowAttachmentPoints;
     static F32      sLODFactor; // user-settable LOD factor
     static F32      sPhysicsLODFactor; // user-settable physics LOD factor
-    static bool     sJointDebug; // output total number of joints being touched for each avatar
+    static bool     sJointDebug; // output total number of joints being touched for each avatar and pose batch
+
+private:
+    bool            isPoseBatchable();
+
+    // state of an updateCharacter() split by a pose batch
+    struct PoseUpdate
+    {
+        bool mActive = false;   // prepared, not finished yet
+        bool mEvaluate = false; // the motion controller has a pose to evaluate
+        bool mVisible = false;
+        bool mWasSitGroundConstrained = false;
+        LLCharacter::e_update_t mUpdateType = LLCharacter::NORMAL_UPDATE;
+    };
+    PoseUpdate      mPoseUpdate;
+    bool            mEvaluatingPose;            // in a batch, updateCharacterPose() is running
+    bool            mVisualParamsPending;       // updateVisualParams() called meanwhile
+    std::vector<std::pair<LLUUID, F32> > mPendingMotions; // startMotion() called meanwhile
+    LLFlatSkeleton  mFlatSkeleton;              // mRoot and below, updated by updateCharacterPose()
+
+    static bool     sPoseBatching;
+    static std::vector<LLPointer<LLVOAvatar> > sPoseBatch;
+
+public:
 
     static LLPartSysData sCloud;
 
@@ -883,6 +922,10 @@ public:
     typedef std::unordered_map<U64, MatrixPaletteCache> matrix_palette_cache_t;
     matrix_palette_cache_t mMatrixPaletteCache;
 
+    // World matrices of the skeleton as of the last updateCharacterPose(),
+    // in one array for building the matrix palettes
+    const LLFlatSkeleton& getFlatSkeleton() const { return mFlatSkeleton; }
+
 protected:
     void            releaseMeshData();
     virtual void restoreMeshData();
@@ -35,6 +35,8 @@
 #include "llsdserialize.h"
 #include "llagent.h" // <FS:Beq/> For gAgent
 #include "llworld.h" // For LLWorld::getInstance()
+#include "llpartdata.h"
+#include "llvolumemessage.h"
 
 //static variables
 U32 LLVOCacheEntry::sMinFrameRange = 0;
@@ -416,6 +418,211 @@ LLDataPackerBinaryBuffer *LLVOCacheEntry::getDP()
     return &mDP;
 }
 
+namespace
+{
+    // Bounded read of a size prefixed block from the cached update.
+    // LLDataPackerBinaryBuffer::unpackBinaryData() trusts the destination
+    // to be large enough, which a scan of arbitrary cache entries cannot.
+    bool read_cached_block(LLDataPackerBinaryBuffer& dp, std::vector<U8>* out)
+    {
+        const S32 pos = dp.getCurrentSize();
+        const S32 remaining = dp.getBufferSize() - pos;
+        if (remaining < 4)
+        {
+            return false;
+        }
+        S32 size = 0;
+        memcpy(&size, dp.getBuffer() + pos, 4);
+        if (size < 0 || size > remaining - 4)
+        {
+            return false;
+        }
+        if (out)
+        {
+            out->assign(dp.getBuffer() + pos + 4, dp.getBuffer() + pos + 4 + size);
+        }
+        dp.shift(pos + 4 + size);
+        return true;
+    }
+}
+
+bool LLVOCacheEntry::getPrefetchAssets(LLVolumeParams& volume_params, uuid_vec_t& texture_ids) const
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+
+    texture_ids.clear();
+    if (mDP.getBufferSize() == 0)
+    {
+        return false;
+    }
+
+    // Walks the same layout LLViewerObject::processUpdateMessage() and
+    // LLVOVolume::processUpdateMessage() consume for OUT_FULL_CACHED,
+    // keeping only what names an asset.
+    LLDataPackerBinaryBuffer dp(const_cast<U8*>(mDP.getBuffer()), mDP.getBufferSize());
+
+    LLUUID id;
+    U32 local_id;
+    LLPCode pcode = 0;
+    U8 state, material, click_action;
+    U32 crc;
+    LLVector3 vec;
+    U32 value;
+    if (!dp.unpackUUID(id, "ID")
+        || !dp.unpackU32(local_id, "LocalID")
+        || !dp.unpackU8(pcode, "PCode")
+        || pcode != LL_PCODE_VOLUME
+        || !dp.unpackU8(state, "State")
+        || !dp.unpackU32(crc, "CRC")
+        || !dp.unpackU8(material, "Material")
+        || !dp.unpackU8(click_action, "ClickAction")
+        || !dp.unpackVector3(vec, "Scale")
+        || !dp.unpackVector3(vec, "Pos")
+        || !dp.unpackVector3(vec, "Rot")
+        || !dp.unpackU32(value, "SpecialCode")
+        || !dp.unpackUUID(id, "Owner"))
+    {
+        return false;
+    }
+
+    if (value & 0x80)
+    {
+        dp.unpackVector3(vec, "Omega");
+    }
+    if (value & 0x20)
+    {
+        U32 parent_id;
+        dp.unpackU32(parent_id, "ParentID");
+    }
+    if (value & 0x2)
+    {
+        U8 tree_data;
+        dp.unpackU8(tree_data, "TreeData");
+    }
+    else if (value & 0x1)
+    {
+        U32 size;
+        if (!dp.unpackU32(size, "ScratchPadSize") || !read_cached_block(dp, NULL))
+        {
+            return false;
+        }
+    }
+    if (value & 0x4)
+    {
+        std::string text;
+        U8 color[4];
+        dp.unpackString(text, "Text");
+        dp.unpackBinaryDataFixed(color, 4, "Color");
+    }
+    if (value & 0x200)
+    {
+        std::string media_url;
+        dp.unpackString(media_url, "MediaURL");
+    }
+    if (value & 0x8)
+    {
+        LLPartSysData part_sys;
+        part_sys.unpackLegacy(dp);
+    }
+
+    LLUUID sculpt_id;
+    U8 sculpt_type = 0;
+    U8 num_parameters = 0;
+    if (!dp.unpackU8(num_parameters, "num_params"))
+    {
+        return false;
+    }
+    std::vector<U8> param_block;
+    for (U8 param = 0; param < num_parameters; ++param)
+    {
+        U16 param_type;
+        if (!dp.unpackU16(param_type, "param_type") || !read_cached_block(dp, &param_block))
+        {
+            return false;
+        }
+        if (param_type == LLNetworkData::PARAMS_SCULPT && !param_block.empty())
+        {
+            LLSculptParams sculpt;
+            LLDataPackerBinaryBuffer dp2(param_block.data(), (S32) param_block.size());
+            if (sculpt.unpack(dp2))
+            {
+                sculpt_id = sculpt.getSculptTexture();
+                sculpt_type = sculpt.getSculptType();
+            }
+        }
+    }
+
+    if (value & 0x10)
+    {
+        F32 gain, cutoff;
+        U8 sound_flags;
+        dp.unpackUUID(id, "SoundUUID");
+        dp.unpackF32(gain, "SoundGain");
+        dp.unpackU8(sound_flags, "SoundFlags");
+        dp.unpackF32(cutoff, "SoundRadius");
+    }
+    if (value & 0x100)
+    {
+        std::string name_value_list;
+        dp.unpackString(name_value_list, "NV");
+    }
+
+    if (!LLVolumeMessage::unpackVolumeParams(&volume_params, dp))
+    {
+        return false;
+    }
+    volume_params.setSculptID(sculpt_id, sculpt_type);
+    if (sculpt_id.notNull() && !volume_params.isMeshSculpt())
+    {
+        texture_ids.push_back(sculpt_id);
+    }
+
+    // Only the image field of the texture entry is needed:  a default id
+    // followed by (face bitfield, id) exceptions up to a zero bitfield.
+    std::vector<U8> te;
+    if (!read_cached_block(dp, &te))
+    {
+        return false;
+    }
+    const U8* cur = te.data();
+    const U8* end = cur + te.size();
+    const size_t id_size = sizeof(LLUUID);
+    if (size_t(end - cur) >= id_size)
+    {
+        memcpy(id.mData, cur, id_size);
+        cur += id_size;
+        texture_ids.push_back(id);
+
+        while (cur < end)
+        {
+            U64 index_flags = 0;
+            U8 sbit = 0;
+            do
+            {
+                if (cur >= end)
+                {
+                    return true;
+                }
+                sbit = *cur++;
+                index_flags = (index_flags << 7) | (sbit & 0x7F);
+            } while (sbit & 0x80);
+
+            if (!index_flags || size_t(end - cur) < id_size)
+            {
+                break;
+            }
+            memcpy(id.mData, cur, id_size);
+            cur += id_size;
+            if (std::find(texture_ids.begin(), texture_ids.end(), id) == texture_ids.end())
+            {
+                texture_ids.push_back(id);
+            }
+        }
+    }
+
+    return true;
+}
+
 void LLVOCacheEntry::recordHit()
 {
     mHitCount++;
@@ -39,6 +39,7 @@
 //---------------------------------------------------------------------------
 // Cache entries
 class LLCamera;
+class LLVolumeParams;
 
 class LLGLTFOverrideCacheEntry
 {
@@ -134,6 +135,9 @@ public:
     void dump() const;
     S32 writeToBuffer(U8 *data_buffer) const;
     LLDataPackerBinaryBuffer *getDP();
+    // Volume params (with mesh or sculpt id) and texture ids the cached
+    // update will need once the object is created.  Does not touch mDP.
+    bool getPrefetchAssets(LLVolumeParams& volume_params, uuid_vec_t& texture_ids) const;
     void recordHit();
     void recordDupe() { mDupeCount++; }
 
@@ -156,6 +160,9 @@ public:
     void setValid(bool valid = true) {mValid = valid;}
     bool isValid() const {return mValid;}
 
+    void setPrefetchExpiry(F64 expiry) {mPrefetchExpiry = expiry;}
+    bool isPrefetched(F64 now) const {return now < mPrefetchExpiry;}
+
     void setUpdateFlags(U32 flags) {mUpdateFlags = flags;}
     U32  getUpdateFlags() const    {return mUpdateFlags;}
 
@@ -189,6 +196,7 @@ protected:
     vocache_entry_set_t         mChildrenList; //children entries in a linked set.
 
     bool                        mValid; //if set, this entry is valid, otherwise it is invalid and will be removed.
+    F64                         mPrefetchExpiry = 0.0; //assets were requested ahead of the object becoming visible, not again until then.
 
     LLVector4a                  mBSphereCenter; //bounding sphere center
     F32                         mBSphereRadius; //bounding sphere radius
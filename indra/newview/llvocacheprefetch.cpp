@@ -0,0 +1,336 @@
+/**
+ * @file llvocacheprefetch.cpp
+ * @brief Requests mesh and texture assets of cached objects ahead of the camera.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llvocacheprefetch.h"
+
+#include "llagent.h"
+#include "llfilesystem.h"
+#include "llmeshrepository.h"
+#include "llviewercamera.h"
+#include "llviewercontrol.h"
+#include "llviewerregion.h"
+#include "llviewertexture.h"
+#include "llvocache.h"
+#include "llvolumemgr.h"
+#include "llvovolume.h"
+#include "llworld.h"
+
+namespace
+{
+    // Scan at most this often, and only after the camera moved at least
+    // MIN_SCAN_MOVE meters or changed region.
+    constexpr F32 SCAN_INTERVAL = 0.5f;
+    constexpr F32 MIN_SCAN_MOVE = 4.f;
+
+    // Prefetched entries that are not instantiated within this time are
+    // counted as misses and their textures released.
+    constexpr F64 PREFETCH_EXPIRY = 30.0;
+
+    // Virtual size given to prefetched textures, enough for a 64x64 mip.
+    constexpr F32 PREFETCH_TEXTURE_PIXELS = 64.f * 64.f;
+}
+
+LLVOCachePrefetcher::LLVOCachePrefetcher()
+:   mLastScanRegion(NULL),
+    mScanning(false),
+    mScanDrawDistance(0.f),
+    mScanRegionIndex(0),
+    mScanNextLocalID(0),
+    mIssuedCount(0),
+    mMeshRequestCount(0),
+    mTextureRequestCount(0),
+    mHitCount(0),
+    mMissCount(0)
+{
+}
+
+LLVOCachePrefetcher::~LLVOCachePrefetcher()
+{
+    if (mIssuedCount)
+    {
+        LL_INFOS("ObjectCache") << "Prefetch summary:  entries " << mIssuedCount
+                                << ", mesh requests " << mMeshRequestCount
+                                << ", texture requests " << mTextureRequestCount
+                                << ", hits " << mHitCount
+                                << ", misses " << mMissCount
+                                << ", hit rate " << getHitRate() * 100.f << "%" << LL_ENDL;
+    }
+}
+
+F32 LLVOCachePrefetcher::getHitRate() const
+{
+    const U32 resolved = mHitCount + mMissCount;
+    return resolved ? (F32)mHitCount / (F32)resolved : 0.f;
+}
+
+void LLVOCachePrefetcher::idle()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+
+    static LLCachedControl<bool> prefetch_enabled(gSavedSettings, "ObjectCachePrefetch", true);
+
+    resolvePending();
+
+    if (!prefetch_enabled || !LLViewerRegion::sVOCacheCullingEnabled)
+    {
+        mScanning = false;
+        mCandidates.clear();
+        return;
+    }
+
+    if (mScanning)
+    {
+        continueScan();
+    }
+    else if (mScanTimer.getElapsedTimeF32() > SCAN_INTERVAL)
+    {
+        const LLVector3 origin = LLViewerCamera::getInstance()->getOrigin();
+        if (gAgent.getRegion() != mLastScanRegion
+            || (origin - mLastScanOrigin).lengthSquared() > MIN_SCAN_MOVE * MIN_SCAN_MOVE)
+        {
+            mLastScanRegion = gAgent.getRegion();
+            mLastScanOrigin = origin;
+            beginScan();
+            continueScan();
+        }
+        mScanTimer.reset();
+    }
+}
+
+void LLVOCachePrefetcher::resolvePending()
+{
+    const F64 now = LLFrameTimer::getTotalSeconds();
+    for (std::deque<Pending>::iterator iter = mPending.begin(); iter != mPending.end();)
+    {
+        LLVOCacheEntry* entry = iter->mEntry;
+        if (!entry->isValid())
+        {
+            // killed or replaced by the simulator, says nothing about the prediction
+            iter = mPending.erase(iter);
+        }
+        else if (entry->getState() != LLVOCacheEntry::INACTIVE)
+        {
+            ++mHitCount;
+            iter = mPending.erase(iter);
+        }
+        else if (now > iter->mExpires)
+        {
+            ++mMissCount;
+            iter = mPending.erase(iter);
+        }
+        else
+        {
+            // virtual sizes are reset every frame
+            for (LLViewerFetchedTexture* tex : iter->mTextures)
+            {
+                tex->addTextureStats(PREFETCH_TEXTURE_PIXELS);
+            }
+            ++iter;
+        }
+    }
+}
+
+void LLVOCachePrefetcher::beginScan()
+{
+    static LLCachedControl<F32> lookahead(gSavedSettings, "ObjectCachePrefetchLookahead", 2.f);
+
+    // Where the camera will be after 'lookahead' seconds at its current
+    // speed, never further out than the draw distance.  Kept in global
+    // coordinates, the agent's region may change before the scan is done.
+    LLViewerCamera* camera = LLViewerCamera::getInstance();
+    mScanDrawDistance = camera->getFar();
+    const F32 travel = llmin(camera->getAverageSpeed() * (F32)lookahead, mScanDrawDistance);
+    mScanPredicted = gAgent.getPosGlobalFromAgent(camera->getOrigin() + camera->getVelocityDir() * travel);
+
+    mScanRegions.clear();
+    for (LLViewerRegion* regionp : LLWorld::getInstance()->getRegionList())
+    {
+        const F32 region_width = regionp->getWidth();
+        LLVector3 local(mScanPredicted - regionp->getOriginGlobal());
+        LLVector3 clamped(llclamp(local.mV[VX], 0.f, region_width),
+                          llclamp(local.mV[VY], 0.f, region_width),
+                          local.mV[VZ]);
+        if (dist_vec(local, clamped) <= mScanDrawDistance)
+        {
+            mScanRegions.push_back(regionp->getHandle());
+        }
+    }
+
+    mScanRegionIndex = 0;
+    mScanNextLocalID = 0;
+    mCandidates.clear();
+    mScanning = true;
+}
+
+void LLVOCachePrefetcher::continueScan()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+
+    static LLCachedControl<U32> entries_per_frame(gSavedSettings, "ObjectCachePrefetchEntriesPerFrame", 2000);
+
+    const F64 now = LLFrameTimer::getTotalSeconds();
+    const U32 max_visits = llmax((U32)entries_per_frame, 1U);
+    U32 visits = 0;
+    for (; mScanRegionIndex < mScanRegions.size(); ++mScanRegionIndex, mScanNextLocalID = 0)
+    {
+        // the region may have gone away since the scan began
+        LLViewerRegion* regionp = LLWorld::getInstance()->getRegionFromHandle(mScanRegions[mScanRegionIndex]);
+        if (!regionp)
+        {
+            continue;
+        }
+
+        LLVector3 local(mScanPredicted - regionp->getOriginGlobal());
+        LLVector4a local_predicted;
+        local_predicted.load3(local.mV);
+
+        const std::map<U32, LLPointer<LLVOCacheEntry> >& entries = regionp->getCacheEntries();
+        for (auto iter = entries.lower_bound(mScanNextLocalID); iter != entries.end(); ++iter)
+        {
+            if (visits == max_visits)
+            {
+                // resume from here on the next frame
+                mScanNextLocalID = iter->first;
+                return;
+            }
+            ++visits;
+
+            LLVOCacheEntry* entry = iter->second;
+            if (!isCandidate(entry, now))
+            {
+                continue;
+            }
+
+            LLVector4a delta;
+            delta.setSub(entry->getPositionGroup(), local_predicted);
+            const F32 radius = entry->getBinRadius();
+            const F32 distance = llmax(delta.getLength3().getF32() - radius, 1.f);
+            if (distance > mScanDrawDistance)
+            {
+                continue;
+            }
+            mCandidates.emplace_back(radius / distance, entry);
+        }
+    }
+
+    finishScan();
+}
+
+void LLVOCachePrefetcher::finishScan()
+{
+    static LLCachedControl<U32> max_per_scan(gSavedSettings, "ObjectCachePrefetchMaxPerScan", 32);
+    static LLCachedControl<U32> max_pending(gSavedSettings, "ObjectCachePrefetchMaxPending", 512);
+
+    mScanning = false;
+
+    const U32 budget = mPending.size() < max_pending ? llmin((U32)max_per_scan, (U32)(max_pending - mPending.size())) : 0;
+    if (mCandidates.size() > budget)
+    {
+        std::partial_sort(mCandidates.begin(), mCandidates.begin() + budget, mCandidates.end(),
+                          [](const candidate_t& lhs, const candidate_t& rhs) { return lhs.first > rhs.first; });
+        mCandidates.resize(budget);
+    }
+
+    // entries found in earlier frames may have changed since
+    const F64 now = LLFrameTimer::getTotalSeconds();
+    for (const candidate_t& candidate : mCandidates)
+    {
+        LLVOCacheEntry* entry = candidate.second;
+        if (isCandidate(entry, now))
+        {
+            prefetch(entry, entry->getBinRadius() / candidate.first);
+        }
+    }
+    mCandidates.clear();
+}
+
+bool LLVOCachePrefetcher::isCandidate(LLVOCacheEntry* entry, F64 now) const
+{
+    return entry->isValid()
+        && !entry->isPrefetched(now)
+        && entry->isState(LLVOCacheEntry::INACTIVE)
+        && entry->hasState(LLVOCacheEntry::IN_VO_TREE)
+        && entry->getEntry();
+}
+
+bool LLVOCachePrefetcher::prefetch(LLVOCacheEntry* entry, F32 distance)
+{
+    // Whatever happens, look at each entry once per expiry period.
+    const F64 expires = LLFrameTimer::getTotalSeconds() + PREFETCH_EXPIRY;
+    entry->setPrefetchExpiry(expires);
+
+    LLVolumeParams volume_params;
+    uuid_vec_t texture_ids;
+    if (!entry->getPrefetchAssets(volume_params, texture_ids))
+    {
+        return false;
+    }
+
+    Pending pending;
+    pending.mEntry = entry;
+    pending.mExpires = expires;
+
+    if (volume_params.isMeshSculpt() && gMeshRepo.meshRezEnabled())
+    {
+        // Only reach for the network.  A mesh already in the disk cache
+        // loads quickly enough once the object asks for it.
+        const LLUUID& mesh_id = volume_params.getSculptID();
+        if (!gMeshRepo.hasHeader(mesh_id) && !LLFileSystem::getExists(mesh_id, LLAssetType::AT_MESH))
+        {
+            // Same estimate as LLVOVolume::calcLOD() minus the per object tweaks.
+            const F32 tan_angle = LLVOVolume::sLODFactor * entry->getBinRadius() / (distance * F_PI / 3.f);
+            gMeshRepo.prefetchMesh(volume_params, LLVolumeLODGroup::getDetailFromTan(ll_round(tan_angle, 0.01f)));
+            ++mMeshRequestCount;
+        }
+    }
+
+    for (const LLUUID& id : texture_ids)
+    {
+        if (id.isNull() || id == IMG_DEFAULT)
+        {
+            continue;
+        }
+        LLViewerFetchedTexture* tex = LLViewerTextureManager::getFetchedTexture(id, FTT_DEFAULT, true,
+                                                                               LLGLTexture::BOOST_NONE,
+                                                                               LLViewerTexture::LOD_TEXTURE);
+        if (!tex || tex->isMissingAsset())
+        {
+            continue;
+        }
+        if (tex->getDiscardLevel() < 0)
+        {
+            ++mTextureRequestCount;
+        }
+        tex->addTextureStats(PREFETCH_TEXTURE_PIXELS);
+        pending.mTextures.push_back(tex);
+    }
+
+    ++mIssuedCount;
+    mPending.push_back(std::move(pending));
+    return true;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file llvocacheprefetch.h
+ * @brief Requests mesh and texture assets of cached objects ahead of the camera.
+ *
+ * $LicenseInfo:firstyear=2026&license=viewerlgpl$
+ * Second Life Viewer Source Code
+ * Copyright (C) 2026, Linden Research, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * Linden Research, Inc., 945 Battery Street, San Francisco, CA  94111  USA
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLVOCACHEPREFETCH_H
+#define LL_LLVOCACHEPREFETCH_H
+
+#include "llsingleton.h"
+#include "llframetimer.h"
+#include "llpointer.h"
+#include "v3dmath.h"
+#include "v3math.h"
+
+#include <deque>
+#include <vector>
+
+class LLVOCacheEntry;
+class LLViewerFetchedTexture;
+class LLViewerRegion;
+
+//
+// Objects restored from the object cache are only instantiated once they
+// pass LLViewerRegion's visibility tests, and their mesh and textures are
+// requested after that.  This class looks along the camera path for cached
+// entries that are not instantiated yet and requests their mesh LOD (which
+// brings in the header) and a low resolution mip of their textures, so the
+// data is on disk or in memory by the time the object shows up.
+//
+// Requests are low priority:  prefetched mesh LODs have no volume attached
+// and score below every visible request, prefetched textures only carry a
+// small virtual size.
+//
+// An entry counts as a hit if it leaves the INACTIVE state before its
+// prefetch expires, and as a miss otherwise.  Either way it is not looked
+// at again until then.
+//
+// A scan may span several frames:  it looks at no more than
+// ObjectCachePrefetchEntriesPerFrame cache entries a frame and picks up
+// where it left off on the next one.
+//
+// Threads:  main thread only
+//
+class LLVOCachePrefetcher : public LLSingleton<LLVOCachePrefetcher>
+{
+    LLSINGLETON(LLVOCachePrefetcher);
+    ~LLVOCachePrefetcher();
+
+public:
+    // Called once per frame from LLWorld::updateRegions().
+    void idle();
+
+    U32 getPendingCount() const         { return (U32)mPending.size(); }
+    U32 getIssuedCount() const          { return mIssuedCount; }
+    U32 getMeshRequestCount() const     { return mMeshRequestCount; }
+    U32 getTextureRequestCount() const  { return mTextureRequestCount; }
+    U32 getHitCount() const             { return mHitCount; }
+    U32 getMissCount() const            { return mMissCount; }
+    F32 getHitRate() const;
+
+private:
+    void resolvePending();
+    void beginScan();
+    void continueScan();
+    void finishScan();
+    bool isCandidate(LLVOCacheEntry* entry, F64 now) const;
+    bool prefetch(LLVOCacheEntry* entry, F32 distance);
+
+    struct Pending
+    {
+        LLPointer<LLVOCacheEntry> mEntry;
+        std::vector<LLPointer<LLViewerFetchedTexture> > mTextures;
+        F64 mExpires;
+    };
+    std::deque<Pending> mPending;
+
+    LLFrameTimer    mScanTimer;
+    LLVector3       mLastScanOrigin;
+    LLViewerRegion* mLastScanRegion;
+
+    // scan in progress:  where the camera is predicted to be, the regions
+    // left to look at, the next local id in the current one and the
+    // entries found so far, scored by size over distance
+    bool                mScanning;
+    LLVector3d          mScanPredicted;
+    F32                 mScanDrawDistance;
+    std::vector<U64>    mScanRegions;
+    size_t              mScanRegionIndex;
+    U32                 mScanNextLocalID;
+    typedef std::pair<F32, LLPointer<LLVOCacheEntry> > candidate_t;
+    std::vector<candidate_t> mCandidates;
+
+    U32 mIssuedCount;
+    U32 mMeshRequestCount;
+    U32 mTextureRequestCount;
+    U32 mHitCount;
+    U32 mMissCount;
+};
+
+#endif // LL_LLVOCACHEPREFETCH_H
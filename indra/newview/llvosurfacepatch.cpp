@@ -38,6 +38,7 @@
 #include "llsurface.h"
 #include "llviewerobjectlist.h"
 #include "llviewerregion.h"
+#include "llviewerstats.h"
 #include "llvlcomposition.h"
 #include "llvolume.h"
 #include "llvovolume.h"
@@ -46,6 +47,71 @@
 
 F32 LLVOSurfacePatch::sLODFactor = 1.f;
 
+namespace
+{
+    // Writes the vertices of one section of a patch's geometry.  They come
+    // from the patch's cache when it was built at the same strides before,
+    // since its heights last changed; otherwise they are evaluated, and kept
+    // in the cache for when the camera brings the patch back to this LOD.
+    class LLTerrainGeomWriter
+    {
+    public:
+        LLTerrainGeomWriter(const LLSurfacePatch* patchp, LLVOSurfacePatch::CachedGeom& cached,
+                            LLStrider<LLVector3>& verticesp, LLStrider<LLVector3>& normalsp,
+                            LLStrider<LLVector2>& texCoords0p, LLStrider<LLVector2>& texCoords1p)
+        :   mPatchp(patchp),
+            mCached(cached),
+            mReuse(!cached.mVertices.empty()),
+            mNext(0),
+            mVerticesp(verticesp),
+            mNormalsp(normalsp),
+            mTexCoords0p(texCoords0p),
+            mTexCoords1p(texCoords1p)
+        {
+            LLTrace::add(mReuse ? LLStatViewer::TERRAIN_GEOM_REUSED : LLStatViewer::TERRAIN_GEOM_BUILT, 1);
+        }
+
+        void addVertex(U32 x, U32 y, U32 stride)
+        {
+            if (mReuse && mNext < mCached.mVertices.size())
+            {
+                *(mVerticesp++) = mCached.mVertices[mNext];
+                *(mNormalsp++) = mCached.mNormals[mNext];
+                *(mTexCoords0p++) = mCached.mTexCoords0[mNext];
+                *(mTexCoords1p++) = mCached.mTexCoords1[mNext];
+                ++mNext;
+                return;
+            }
+            llassert(!mReuse);
+
+            LLVector3 vertex, normal;
+            LLVector2 tex0, tex1;
+            mPatchp->eval(x, y, stride, &vertex, &normal, &tex0, &tex1);
+            if (!mReuse)
+            {
+                mCached.mVertices.push_back(vertex);
+                mCached.mNormals.push_back(normal);
+                mCached.mTexCoords0.push_back(tex0);
+                mCached.mTexCoords1.push_back(tex1);
+            }
+            *(mVerticesp++) = vertex;
+            *(mNormalsp++) = normal;
+            *(mTexCoords0p++) = tex0;
+            *(mTexCoords1p++) = tex1;
+        }
+
+    private:
+        const LLSurfacePatch* mPatchp;
+        LLVOSurfacePatch::CachedGeom& mCached;
+        const bool mReuse;
+        size_t mNext;
+        LLStrider<LLVector3>& mVerticesp;
+        LLStrider<LLVector3>& mNormalsp;
+        LLStrider<LLVector2>& mTexCoords0p;
+        LLStrider<LLVector2>& mTexCoords1p;
+    };
+}
+
 LLVOSurfacePatch::LLVOSurfacePatch(const LLUUID &id, const LLPCode pcode, LLViewerRegion *regionp)
     :   LLStaticViewerObject(id, LL_VO_SURFACE_PATCH, regionp),
         mDirtiedPatch(false),
@@ -78,6 +144,7 @@ void LLVOSurfacePatch::markDead()
         mPatchp->clearVObj();
         mPatchp = NULL;
     }
+    clearGeomCache();
     LLViewerObject::markDead();
 }
 
@@ -315,6 +382,9 @@ void LLVOSurfacePatch::updateMainGeometry(LLFace *facep,
     {
         facep->mCenterAgent = mPatchp->getPointAgent(8, 8);
 
+        LLTerrainGeomWriter writer(mPatchp, getCachedGeom(GEOM_MAIN, render_stride, 0),
+                                   verticesp, normalsp, texCoords0p, texCoords1p);
+
         // Generate patch points first
         for (j = 0; j < vert_size; j++)
         {
@@ -322,11 +392,7 @@ void LLVOSurfacePatch::updateMainGeometry(LLFace *facep,
             {
                 x = i * render_stride;
                 y = j * render_stride;
-                mPatchp->eval(x, y, render_stride, verticesp.get(), normalsp.get(), texCoords0p.get(), texCoords1p.get());
-                verticesp++;
-                normalsp++;
-                texCoords0p++;
-                texCoords1p++;
+                writer.addVertex(x, y, render_stride);
             }
         }
 
@@ -408,6 +474,9 @@ void LLVOSurfacePatch::updateNorthGeometry(LLFace *facep,
     //
     //
 
+    LLTerrainGeomWriter writer(mPatchp, getCachedGeom(GEOM_NORTH, render_stride, north_stride),
+                               verticesp, normalsp, texCoords0p, texCoords1p);
+
     // Stride lengths are the same
     if (north_stride == render_stride)
     {
@@ -421,11 +490,7 @@ void LLVOSurfacePatch::updateNorthGeometry(LLFace *facep,
             x = i * render_stride;
             y = 16 - render_stride;
 
-            mPatchp->eval(x, y, render_stride, verticesp.get(), normalsp.get(), texCoords0p.get(), texCoords1p.get());
-            verticesp++;
-            normalsp++;
-            texCoords0p++;
-            texCoords1p++;
+            writer.addVertex(x, y, render_stride);
         }
 
         // North patch
@@ -433,11 +498,7 @@ void LLVOSurfacePatch::updateNorthGeometry(LLFace *facep,
         {
             x = i * render_stride;
             y = 16;
-            mPatchp->eval(x, y, render_stride, verticesp.get(), normalsp.get(), texCoords0p.get(), texCoords1p.get());
-            verticesp++;
-            normalsp++;
-            texCoords0p++;
-            texCoords1p++;
+            writer.addVertex(x, y, render_stride);
         }
 
 
@@ -469,11 +530,7 @@ void LLVOSurfacePatch::updateNorthGeometry(LLFace *facep,
             x = i * render_stride;
             y = 16 - render_stride;
 
-            mPatchp->eval(x, y, render_stride, verticesp.get(), normalsp.get(), texCoords0p.get(), texCoords1p.get());
-            verticesp++;
-            normalsp++;
-            texCoords0p++;
-            texCoords1p++;
+            writer.addVertex(x, y, render_stride);
         }
 
         // Iterate through the north patch's points
@@ -482,11 +539,7 @@ void LLVOSurfacePatch::updateNorthGeometry(LLFace *facep,
             x = i * render_stride;
             y = 16;
 
-            mPatchp->eval(x, y, render_stride, verticesp.get(), normalsp.get(), texCoords0p.get(), texCoords1p.get());
-            verticesp++;
-            normalsp++;
-            texCoords0p++;
-            texCoords1p++;
+            writer.addVertex(x, y, render_stride);
         }
 
 
@@ -525,11 +578,7 @@ void LLVOSurfacePatch::updateNorthGeometry(LLFace *facep,
             x = i * north_stride;
             y = 16 - render_stride;
 
-            mPatchp->eval(x, y, render_stride, verticesp.get(), normalsp.get(), texCoords0p.get(), texCoords1p.get());
-            verticesp++;
-            normalsp++;
-            texCoords0p++;
-            texCoords1p++;
+            writer.addVertex(x, y, render_stride);
         }
 
         // Iterate through the north patch's points
@@ -538,11 +587,7 @@ void LLVOSurfacePatch::updateNorthGeometry(LLFace *facep,
             x = i * north_stride;
             y = 16;
 
-            mPatchp->eval(x, y, render_stride, verticesp.get(), normalsp.get(), texCoords0p.get(), texCoords1p.get());
-            verticesp++;
-            normalsp++;
-            texCoords0p++;
-            texCoords1p++;
+            writer.addVertex(x, y, render_stride);
         }
 
         for (i = 0; i < length; i++)
@@ -593,6 +638,9 @@ void LLVOSurfacePatch::updateEastGeometry(LLFace *facep,
 
     U32 east_stride = mLastEastStride;
 
+    LLTerrainGeomWriter writer(mPatchp, getCachedGeom(GEOM_EAST, render_stride, east_stride),
+                               verticesp, normalsp, texCoords0p, texCoords1p);
+
     // Stride lengths are the same
     if (east_stride == render_stride)
     {
@@ -606,11 +654,7 @@ void LLVOSurfacePatch::updateEastGeometry(LLFace *facep,
             x = 16 - render_stride;
             y = i * render_stride;
 
-            mPatchp->eval(x, y, render_stride, verticesp.get(), normalsp.get(), texCoords0p.get(), texCoords1p.get());
-            verticesp++;
-            normalsp++;
-            texCoords0p++;
-            texCoords1p++;
+            writer.addVertex(x, y, render_stride);
         }
 
         // East patch
@@ -618,11 +662,7 @@ void LLVOSurfacePatch::updateEastGeometry(LLFace *facep,
         {
             x = 16;
             y = i * render_stride;
-            mPatchp->eval(x, y, render_stride, verticesp.get(), normalsp.get(), texCoords0p.get(), texCoords1p.get());
-            verticesp++;
-            normalsp++;
-            texCoords0p++;
-            texCoords1p++;
+            writer.addVertex(x, y, render_stride);
         }
 
 
@@ -654,11 +694,7 @@ void LLVOSurfacePatch::updateEastGeometry(LLFace *facep,
             x = 16 - render_stride;
             y = i * render_stride;
 
-            mPatchp->eval(x, y, render_stride, verticesp.get(), normalsp.get(), texCoords0p.get(), texCoords1p.get());
-            verticesp++;
-            normalsp++;
-            texCoords0p++;
-            texCoords1p++;
+            writer.addVertex(x, y, render_stride);
         }
         // Iterate through the east patch's points
         for (i = 0; i <= length; i+=2)
@@ -666,11 +702,7 @@ void LLVOSurfacePatch::updateEastGeometry(LLFace *facep,
             x = 16;
             y = i * render_stride;
 
-            mPatchp->eval(x, y, render_stride, verticesp.get(), normalsp.get(), texCoords0p.get(), texCoords1p.get());
-            verticesp++;
-            normalsp++;
-            texCoords0p++;
-            texCoords1p++;
+            writer.addVertex(x, y, render_stride);
         }
 
         for (i = 0; i < length; i++)
@@ -708,11 +740,7 @@ void LLVOSurfacePatch::updateEastGeometry(LLFace *facep,
             x = 16 - render_stride;
             y = i * east_stride;
 
-            mPatchp->eval(x, y, render_stride, verticesp.get(), normalsp.get(), texCoords0p.get(), texCoords1p.get());
-            verticesp++;
-            normalsp++;
-            texCoords0p++;
-            texCoords1p++;
+            writer.addVertex(x, y, render_stride);
         }
         // Iterate through the east patch's points
         for (i = 0; i <= length; i++)
@@ -720,11 +748,7 @@ void LLVOSurfacePatch::updateEastGeometry(LLFace *facep,
             x = 16;
             y = i * east_stride;
 
-            mPatchp->eval(x, y, render_stride, verticesp.get(), normalsp.get(), texCoords0p.get(), texCoords1p.get());
-            verticesp++;
-            normalsp++;
-            texCoords0p++;
-            texCoords1p++;
+            writer.addVertex(x, y, render_stride);
         }
 
         for (i = 0; i < length; i++)
@@ -767,6 +791,7 @@ void LLVOSurfacePatch::setPatch(LLSurfacePatch *patchp)
 void LLVOSurfacePatch::dirtyPatch()
 {
     mDirtiedPatch = true;
+    clearGeomCache();
     dirtyGeom();
     mDirtyTerrain = true;
     LLVector3 center = mPatchp->getCenterRegion();
@@ -792,6 +817,44 @@ void LLVOSurfacePatch::dirtyGeom()
     }
 }
 
+void LLVOSurfacePatch::clearGeomCache()
+{
+    for (U32 section = 0; section < GEOM_SECTIONS; ++section)
+    {
+        mGeomCache[section].clear();
+    }
+}
+
+LLVOSurfacePatch::CachedGeom& LLVOSurfacePatch::getCachedGeom(U32 section, U32 stride, U32 neighbor_stride)
+{
+    std::vector<CachedGeom>& cache = mGeomCache[section];
+
+    // Strides change one LOD step at a time as the camera moves, so only the
+    // neighboring steps are likely to come back soon.  Dropping the others
+    // keeps the cache within a small multiple of the geometry drawn.
+    auto near_stride = [](U32 cached, U32 current) { return cached <= current * 2 && cached * 2 >= current; };
+    cache.erase(std::remove_if(cache.begin(), cache.end(),
+                               [&](const CachedGeom& geom)
+                               {
+                                   return !near_stride(geom.mStride, stride)
+                                       || !near_stride(geom.mNeighborStride, neighbor_stride);
+                               }),
+                cache.end());
+
+    for (CachedGeom& geom : cache)
+    {
+        if (geom.mStride == stride && geom.mNeighborStride == neighbor_stride)
+        {
+            return geom;
+        }
+    }
+
+    cache.emplace_back();
+    cache.back().mStride = stride;
+    cache.back().mNeighborStride = neighbor_stride;
+    return cache.back();
+}
+
 void LLVOSurfacePatch::getGeomSizesMain(const S32 stride, S32 &num_vertices, S32 &num_indices)
 {
     S32 patch_size = mPatchp->getSurface()->getGridsPerPatchEdge();
@@ -29,10 +29,12 @@
 
 #include "llviewerobject.h"
 #include "llstrider.h"
+#include "v2math.h"
+
+#include <vector>
 
 class LLSurfacePatch;
 class LLDrawPool;
-class LLVector2;
 class LLFacePool;
 class LLFace;
 
@@ -73,6 +75,25 @@ public:
     void dirtyPatch();
     void dirtyGeom();
 
+    // Drops the vertex data kept for the render strides already built, when
+    // the heights, normals or composition it was evaluated from change.
+    // dirtyPatch() does it; a render stride change keeps it.
+    void clearGeomCache();
+
+    // Vertex data of one section of the patch geometry (the main grid, or
+    // the strip stitching it to its north or east neighbor) at one render
+    // stride, as LLSurfacePatch::eval() works it out.  The strips also
+    // depend on the neighbor's stride.
+    struct CachedGeom
+    {
+        U32                     mStride = 0;
+        U32                     mNeighborStride = 0;
+        std::vector<LLVector3>  mVertices;
+        std::vector<LLVector3>  mNormals;
+        std::vector<LLVector2>  mTexCoords0;
+        std::vector<LLVector2>  mTexCoords1;
+    };
+
     /*virtual*/ bool lineSegmentIntersect(const LLVector4a& start, const LLVector4a& end,
                                           S32 face = -1,                        // which face to check, -1 = ALL_SIDES
                                           bool pick_transparent = false,
@@ -101,6 +122,19 @@ protected:
     S32             mLastStride;
     S32             mLastLength;
 
+    enum
+    {
+        GEOM_MAIN = 0,
+        GEOM_NORTH,
+        GEOM_EAST,
+        GEOM_SECTIONS
+    };
+    std::vector<CachedGeom> mGeomCache[GEOM_SECTIONS];
+
+    // The cached section for these strides, added empty if there is none.
+    // Strides more than one LOD step from these are dropped.
+    CachedGeom& getCachedGeom(U32 section, U32 stride, U32 neighbor_stride);
+
     void getGeomSizesMain(const S32 stride, S32 &num_vertices, S32 &num_indices);
     void getGeomSizesNorth(const S32 stride, const S32 north_stride,
                                   S32 &num_vertices, S32 &num_indices);
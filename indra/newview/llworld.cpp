@@ -53,6 +53,7 @@
 #include "llvlcomposition.h"
 #include "llvoavatar.h"
 #include "llvocache.h"
+#include "llvocacheprefetch.h"
 #include "llvowater.h"
 #include "message.h"
 #include "pipeline.h"
@@ -152,6 +153,7 @@ void LLWorld::resetClass()
     LLDrawable::incrementVisible();
 
     LLSceneMonitor::deleteSingleton();
+    LLVOCachePrefetcher::deleteSingleton();
 }
 // <AW: opensim-limits>
 void LLWorld::refreshLimits()
@@ -1185,6 +1187,8 @@ void LLWorld::updateRegions(F32 max_update_time)
         LLViewerRegion::idleCleanup(max_time);
     }
 
+    LLVOCachePrefetcher::getInstance()->idle();
+
     sample(sNumActiveCachedObjects, mNumOfActiveCachedObjects);
 }
 